@@ -3,6 +3,8 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <gtest/gtest.h>
+#include <graphic/opengl/context/ParallelCompile.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
 
 class OpenGLComponentTest : public ::testing::Test
 {
@@ -32,12 +34,15 @@ public:
 
         // Make the window's context current
         glfwMakeContextCurrent(window);
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
 
         // Initialize GLEW
         if (glewInit() != GLEW_OK)
         {
             throw std::runtime_error("Failed to initialize GLEW.");
         }
+        // Before the first shader compile, for the hint to apply to it
+        cenpy::graphic::opengl::context::enableParallelShaderCompile();
     }
 
     void TearDown() override
@@ -11,15 +11,20 @@
 #include <graphic/opengl/pipeline/component/shader/Freer.hpp>
 #include <graphic/opengl/pipeline/component/shader/Loader.hpp>
 #include <graphic/opengl/pipeline/component/shader/Reader.hpp>
+#include <graphic/opengl/pipeline/component/shader/Preprocessor.hpp>
+#include <graphic/opengl/pipeline/component/shader/Compiler.hpp>
 #include <graphic/opengl/pipeline/component/pass/ShaderAttacher.hpp>
 #include <graphic/opengl/pipeline/component/pass/UniformReader.hpp>
 #include <graphic/opengl/pipeline/component/pass/AttributeReader.hpp>
 #include <graphic/opengl/pipeline/component/pass/Loader.hpp>
+#include <graphic/opengl/pipeline/component/pass/BinaryLoader.hpp>
+#include <graphic/opengl/pipeline/component/pass/Poller.hpp>
 #include <graphic/opengl/pipeline/component/pass/User.hpp>
 #include <graphic/opengl/pipeline/component/pass/Freer.hpp>
 
 #include <graphic/Api.hpp>
 #include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/pipeline/cache/ProgramBinaryCache.hpp>
 #include <OpenGLComponentTests.hpp>
 
 #include <filesystem>
@@ -55,7 +60,7 @@ TEST_F(PassTest, UniformManagementTest)
     pipeline::Pass<api::OpenGL, profile::Pass::Classic> pass({vertexShader, fragmentShader});
     pass.load();
 
-    float testValue = 5.0f;
+    int testValue = 5;
 
     ASSERT_NO_THROW(pass.withUniform("testUniform", testValue));
 
@@ -63,7 +68,53 @@ TEST_F(PassTest, UniformManagementTest)
     ASSERT_TRUE(uniforms.contains("testUniform"));
     auto uniform = uniforms.at("testUniform");
     ASSERT_NE(uniform, nullptr);
-    ASSERT_EQ(uniform->get<float>(), testValue);
+    ASSERT_EQ(uniform->get<int>(), testValue);
+}
+
+TEST_F(PassTest, AsyncLoadTest)
+{
+    pipeline::Pass<api::OpenGL, profile::Pass::Classic> pass({vertexShader, fragmentShader});
+    pass.loadAsync();
+
+    // The driver may finish the link at any time, poll until it does
+    while (!pass.poll())
+    {
+        ASSERT_TRUE(pass.isPending());
+    }
+
+    ASSERT_TRUE(pass.getUniforms().contains("testUniform"));
+}
+
+TEST_F(PassTest, ProgramBinaryRoundTripTest)
+{
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats == 0)
+    {
+        GTEST_SKIP() << "The driver exposes no program binary format";
+    }
+    const auto directory = std::filesystem::temp_directory_path() / "cenpy-program-binary-round-trip";
+    std::filesystem::remove_all(directory);
+    auto binaryCache = std::make_shared<cenpy::graphic::opengl::pipeline::cache::OpenGLProgramBinaryCache>(directory);
+
+    // The first load compiles and links, then stores the binary
+    pipeline::Pass<api::OpenGL, profile::Pass::Classic> compiled({vertexShader, fragmentShader});
+    compiled.getContext()->setProgramBinaryCache(binaryCache);
+    compiled.load();
+    ASSERT_FALSE(compiled.getContext()->isLoadedFromBinary());
+    ASSERT_EQ(binaryCache->getStores(), 1);
+
+    // The second load restores the same program from the binary
+    pipeline::Pass<api::OpenGL, profile::Pass::Classic> restored({vertexShader, fragmentShader});
+    restored.getContext()->setProgramBinaryCache(binaryCache);
+    restored.load();
+    EXPECT_TRUE(restored.getContext()->isLoadedFromBinary());
+    EXPECT_EQ(binaryCache->getHits(), 1);
+    EXPECT_TRUE(restored.isReady());
+    ASSERT_TRUE(restored.getUniforms().contains("testUniform"));
+    EXPECT_NO_THROW(restored.withUniform("testUniform", 5));
+
+    std::filesystem::remove_all(directory);
 }
 
 TEST_F(PassTest, InvalidUniformTest)
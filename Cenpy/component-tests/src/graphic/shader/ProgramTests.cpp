@@ -13,13 +13,18 @@
 #include <graphic/opengl/pipeline/component/shader/Freer.hpp>
 #include <graphic/opengl/pipeline/component/shader/Loader.hpp>
 #include <graphic/opengl/pipeline/component/shader/Reader.hpp>
+#include <graphic/opengl/pipeline/component/shader/Preprocessor.hpp>
+#include <graphic/opengl/pipeline/component/shader/Compiler.hpp>
 #include <graphic/opengl/pipeline/component/pass/ShaderAttacher.hpp>
 #include <graphic/opengl/pipeline/component/pass/UniformReader.hpp>
 #include <graphic/opengl/pipeline/component/pass/AttributeReader.hpp>
 #include <graphic/opengl/pipeline/component/pass/Loader.hpp>
+#include <graphic/opengl/pipeline/component/pass/BinaryLoader.hpp>
+#include <graphic/opengl/pipeline/component/pass/Poller.hpp>
 #include <graphic/opengl/pipeline/component/pass/User.hpp>
 #include <graphic/opengl/pipeline/component/pass/Freer.hpp>
 #include <graphic/opengl/pipeline/component/pipeline/Resetter.hpp>
+#include <graphic/opengl/pipeline/component/pipeline/Drawer.hpp>
 #include <graphic/opengl/pipeline/component/pipeline/User.hpp>
 
 #include <graphic/Api.hpp>
@@ -4,6 +4,8 @@
 #include <graphic/opengl/profile/Shader.hpp>
 #include <graphic/opengl/validator/Validator.hpp>
 #include <graphic/opengl/pipeline/component/shader/Reader.hpp>
+#include <graphic/opengl/pipeline/component/shader/Preprocessor.hpp>
+#include <graphic/opengl/pipeline/component/shader/Compiler.hpp>
 #include <graphic/opengl/pipeline/component/shader/Loader.hpp>
 #include <graphic/opengl/pipeline/component/shader/Freer.hpp>
 #include <graphic/opengl/pipeline/component/attribute/Binder.hpp>
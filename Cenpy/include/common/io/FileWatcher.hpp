@@ -0,0 +1,144 @@
+#pragma once
+
+#include <filesystem>
+#include <format>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace cenpy::common::io
+{
+    /**
+     * @class FileWatcher
+     * @brief Reports the watched files written since the last poll, without ever blocking.
+     *
+     * On Linux the directories of the watched files are watched through inotify: editors often
+     * replace a file rather than write it in place, which a watch on the file itself would miss.
+     * Elsewhere the modification times of the files are compared on each poll.
+     *
+     * Paths are compared in their lexically normal generic form, as the shader contexts store them.
+     */
+    class FileWatcher
+    {
+    public:
+        /**
+         * @brief Creates a watcher with no file watched.
+         * @throws TraceableException if the system watcher cannot be created.
+         */
+        FileWatcher()
+        {
+#if defined(__linux__)
+            m_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (m_descriptor < 0)
+            {
+                throw exception::TraceableException<std::runtime_error>(std::format("ERROR::IO::WATCHER_NOT_CREATED\nerrno {}", errno));
+            }
+#endif
+        }
+
+        FileWatcher(const FileWatcher &) = delete;
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        ~FileWatcher()
+        {
+#if defined(__linux__)
+            close(m_descriptor);
+#endif
+        }
+
+        /**
+         * @brief Watches a file. Watching a file twice has no effect.
+         * @param path Path of the file to watch.
+         * @throws TraceableException if the directory of the file cannot be watched.
+         */
+        void watch(const std::filesystem::path &path)
+        {
+            const std::filesystem::path file = path.lexically_normal();
+            if (!m_files.insert(file.generic_string()).second)
+            {
+                return;
+            }
+#if defined(__linux__)
+            const std::string directory = file.has_parent_path() ? file.parent_path().generic_string() : std::string(".");
+            const int watch = inotify_add_watch(m_descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+            if (watch < 0)
+            {
+                m_files.erase(file.generic_string());
+                throw exception::TraceableException<std::runtime_error>(std::format("ERROR::IO::FILE_NOT_WATCHED\n{}", file.generic_string()));
+            }
+            m_directories[watch] = file.has_parent_path() ? file.parent_path() : std::filesystem::path();
+#else
+            std::error_code error;
+            m_writeTimes[file.generic_string()] = std::filesystem::last_write_time(file, error);
+#endif
+        }
+
+        /**
+         * @brief Returns the watched files written since the last poll, each once.
+         * @return Lexically normal paths of the changed files.
+         */
+        [[nodiscard]] std::vector<std::filesystem::path> poll()
+        {
+            std::vector<std::filesystem::path> changed;
+#if defined(__linux__)
+            std::unordered_set<std::string> seen;
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length = 0;
+            while ((length = read(m_descriptor, buffer, sizeof(buffer))) > 0)
+            {
+                for (ssize_t offset = 0; offset < length;)
+                {
+                    const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                    auto directory = m_directories.find(event->wd);
+                    if (event->len == 0 || directory == m_directories.end())
+                    {
+                        continue;
+                    }
+                    std::string file = (directory->second / event->name).lexically_normal().generic_string();
+                    if (m_files.contains(file) && seen.insert(file).second)
+                    {
+                        changed.emplace_back(std::move(file));
+                    }
+                }
+            }
+#else
+            for (auto &[file, writeTime] : m_writeTimes)
+            {
+                std::error_code error;
+                const auto current = std::filesystem::last_write_time(file, error);
+                if (!error && current != writeTime)
+                {
+                    writeTime = current;
+                    changed.emplace_back(file);
+                }
+            }
+#endif
+            return changed;
+        }
+
+        [[nodiscard]] std::size_t getWatchedCount() const
+        {
+            return m_files.size();
+        }
+
+    private:
+        std::unordered_set<std::string> m_files; ///< Normalized paths of the watched files.
+#if defined(__linux__)
+        int m_descriptor = -1;                                       ///< inotify instance.
+        std::unordered_map<int, std::filesystem::path> m_directories; ///< Watched directories, by watch descriptor.
+#else
+        std::unordered_map<std::string, std::filesystem::file_time_type> m_writeTimes; ///< Last seen write times, by file.
+#endif
+    };
+}
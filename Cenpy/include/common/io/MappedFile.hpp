@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <string_view>
+#include <utility>
+#include <common/exception/TraceableException.hpp>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cenpy::common::io
+{
+    /**
+     * @class MappedFile
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * The content is paged in by the system on first access instead of being copied through a
+     * stream, and stays mapped until the object is destroyed. Views returned by view() are only
+     * valid as long as the mapping is alive.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief Maps the file at the given path.
+         * @param path Path of the file to map.
+         * @throws TraceableException if the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const std::filesystem::path &path)
+        {
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+            HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                throw exception::TraceableException<std::runtime_error>(std::format("ERROR::IO::FILE_NOT_OPENED\n{}", path.string()));
+            }
+            LARGE_INTEGER size{};
+            GetFileSizeEx(file, &size);
+            m_size = static_cast<std::size_t>(size.QuadPart);
+            if (m_size != 0)
+            {
+                // The view keeps the mapping alive, both handles can be closed once it is created.
+                HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                m_data = mapping ? static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+                if (mapping)
+                {
+                    CloseHandle(mapping);
+                }
+            }
+            CloseHandle(file);
+#else
+            int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file < 0)
+            {
+                throw exception::TraceableException<std::runtime_error>(std::format("ERROR::IO::FILE_NOT_OPENED\n{}", path.string()));
+            }
+            struct stat status{};
+            fstat(file, &status);
+            m_size = static_cast<std::size_t>(status.st_size);
+            if (m_size != 0)
+            {
+                // The mapping keeps the file alive, the descriptor can be closed once it is created.
+                void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+                m_data = data == MAP_FAILED ? nullptr : static_cast<const char *>(data);
+                if (m_data)
+                {
+                    madvise(data, m_size, MADV_SEQUENTIAL);
+                }
+            }
+            close(file);
+#endif
+            if (m_size != 0 && !m_data)
+            {
+                throw exception::TraceableException<std::runtime_error>(std::format("ERROR::IO::FILE_NOT_MAPPED\n{}", path.string()));
+            }
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept
+            : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+        {
+        }
+
+        MappedFile &operator=(MappedFile &&other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        ~MappedFile()
+        {
+            unmap();
+        }
+
+        [[nodiscard]] std::string_view view() const
+        {
+            return m_data ? std::string_view(m_data, m_size) : std::string_view();
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return m_size;
+        }
+
+    private:
+        void unmap()
+        {
+            if (!m_data)
+            {
+                return;
+            }
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+            UnmapViewOfFile(m_data);
+#else
+            munmap(const_cast<char *>(m_data), m_size);
+#endif
+            m_data = nullptr;
+        }
+
+        const char *m_data = nullptr; ///< Start of the mapping, nullptr for an empty file.
+        std::size_t m_size = 0;       ///< Size of the file.
+    };
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cenpy::common::thread
+{
+    /**
+     * @class WorkerPool
+     * @brief Fixed set of worker threads running queued tasks.
+     *
+     * Tasks are run in submission order by the first idle worker. Destroying the pool waits for
+     * the running tasks and drops the queued ones.
+     */
+    class WorkerPool
+    {
+    public:
+        explicit WorkerPool(std::size_t workers = std::max(1u, std::thread::hardware_concurrency()))
+        {
+            m_workers.reserve(workers);
+            for (std::size_t i = 0; i < workers; ++i)
+            {
+                m_workers.emplace_back([this](std::stop_token stop)
+                                       { work(stop); });
+            }
+        }
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        ~WorkerPool()
+        {
+            for (auto &worker : m_workers)
+            {
+                worker.request_stop();
+            }
+            m_wake.notify_all();
+        }
+
+        /**
+         * @brief Get the pool shared by the whole process, with one worker per hardware thread.
+         * @return The process-wide pool.
+         */
+        static WorkerPool &shared()
+        {
+            static WorkerPool instance;
+            return instance;
+        }
+
+        /**
+         * @brief Queues a task.
+         * @param task Callable without arguments.
+         * @return Future of the result of the task, rethrowing what the task threw.
+         */
+        template <typename F>
+        auto submit(F &&task) -> std::future<std::invoke_result_t<F>>
+        {
+            auto packaged = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(task));
+            auto future = packaged->get_future();
+            {
+                std::scoped_lock lock(m_mutex);
+                m_tasks.emplace_back([packaged]()
+                                     { (*packaged)(); });
+            }
+            m_wake.notify_one();
+            return future;
+        }
+
+        /**
+         * @brief Calls body(i) for every i in [0, count) on the workers and the calling thread.
+         *
+         * Returns once every call is done. The first exception thrown by a call stops the
+         * remaining ones from starting and is rethrown. Must not be called from a task of the same
+         * pool: the helpers it queues could wait behind the task that waits for them.
+         *
+         * @param count Number of calls.
+         * @param body Callable taking the index of the call.
+         */
+        template <typename F>
+        void parallelFor(std::size_t count, F &&body)
+        {
+            std::atomic<std::size_t> next = 0;
+            auto run = [&next, &body, count]()
+            {
+                for (std::size_t i = next++; i < count; i = next++)
+                {
+                    try
+                    {
+                        body(i);
+                    }
+                    catch (...)
+                    {
+                        next = count;
+                        throw;
+                    }
+                }
+            };
+
+            std::vector<std::future<void>> helpers;
+            // The calling thread takes its share, so one call never waits for a worker.
+            const std::size_t helpersCount = count == 0 ? 0 : std::min(count - 1, m_workers.size());
+            helpers.reserve(helpersCount);
+            for (std::size_t i = 0; i < helpersCount; ++i)
+            {
+                helpers.push_back(submit(run));
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                run();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            // The helpers reference this frame, they must all be done before leaving it.
+            for (auto &helper : helpers)
+            {
+                try
+                {
+                    helper.get();
+                }
+                catch (...)
+                {
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        [[nodiscard]] std::size_t getWorkersCount() const
+        {
+            return m_workers.size();
+        }
+
+    private:
+        void work(std::stop_token stop)
+        {
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(m_mutex);
+                    if (!m_wake.wait(lock, stop, [this]()
+                                     { return !m_tasks.empty(); }))
+                    {
+                        return;
+                    }
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_wake;
+        std::deque<std::function<void()>> m_tasks;
+        std::vector<std::jthread> m_workers; ///< Declared last, so the workers stop before the queue is destroyed.
+    };
+}
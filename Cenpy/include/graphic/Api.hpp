@@ -15,6 +15,7 @@ namespace cenpy::graphic
             class OpenGLShaderContext;
             class OpenGLPassContext;
             class OpenGLUniformContext;
+            class OpenGLUniformBlockContext;
             class OpenGLAttributeContext;
             class OpenGLPipelineContext;
         }
@@ -42,6 +43,7 @@ namespace cenpy::graphic
             using ShaderContext = graphic::opengl::context::OpenGLShaderContext;
             using PassContext = graphic::opengl::context::OpenGLPassContext;
             using UniformContext = graphic::opengl::context::OpenGLUniformContext;
+            using UniformBlockContext = graphic::opengl::context::OpenGLUniformBlockContext;
             using AttributeContext = graphic::opengl::context::OpenGLAttributeContext;
             using PipelineContext = graphic::opengl::context::OpenGLPipelineContext;
             using Validator = graphic::opengl::validator::Validator;
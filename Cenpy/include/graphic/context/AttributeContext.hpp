@@ -5,6 +5,8 @@
 #include <format>
 #include <any>
 #include <memory>
+#include <span>
+#include <cstddef>
 #include <common/exception/TraceableException.hpp>
 
 namespace cenpy::graphic::context
@@ -47,9 +49,58 @@ namespace cenpy::graphic::context
                 }
             }
             m_value = value;
+            m_bytes = value ? std::as_bytes(std::span<const T>(value.get(), 1)) : std::span<const std::byte>();
+            m_stride = sizeof(T);
+        }
+
+        /**
+         * @brief Set the values of the attribute, one per vertex, to upload.
+         *
+         * The values are not copied: they must outlive the upload, after which clearValues drops
+         * the view of them.
+         *
+         * @param values Values of the vertices.
+         */
+        template <typename T>
+        void setValues(std::span<const T> values)
+        {
+            m_value.reset();
+            m_bytes = std::as_bytes(values);
+            m_stride = sizeof(T);
+        }
+
+        /**
+         * @brief Forgets the values set by setValues, once uploaded, so no view of them is kept.
+         */
+        void clearValues()
+        {
+            if (!m_value.has_value())
+            {
+                m_bytes = {};
+            }
+        }
+
+        /**
+         * @brief Get the bytes to upload, as set by setValue or setValues.
+         * @return The bytes of the values.
+         */
+        [[nodiscard]] std::span<const std::byte> getBytes() const
+        {
+            return m_bytes;
+        }
+
+        /**
+         * @brief Get the number of bytes between the values of two consecutive vertices.
+         * @return The size of the type of the values.
+         */
+        [[nodiscard]] std::size_t getStride() const
+        {
+            return m_stride;
         }
 
     private:
-        std::any m_value; ///< The value of the attribute variable.
+        std::any m_value;                   ///< The value of the attribute variable.
+        std::span<const std::byte> m_bytes; ///< Bytes of the values to upload.
+        std::size_t m_stride = 0;           ///< Size of the value of one vertex.
     };
 }
@@ -2,17 +2,47 @@
 
 #pragma once
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <memory>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <format>
+#include <initializer_list>
 #include <utils.hpp>
+#include <common/exception/TraceableException.hpp>
 #include <graphic/Api.hpp>
 #include <graphic/pipeline/Shader.hpp>
 #include <graphic/pipeline/Uniform.hpp>
 #include <graphic/pipeline/Attribute.hpp>
 
+namespace cenpy::graphic::pipeline
+{
+    template <typename API>
+    class IPass;
+}
+
 namespace cenpy::graphic::context
 {
     namespace pipeline = cenpy::graphic::pipeline;
+
+    /**
+     * @brief Set of variant keys of a pass, bit i standing for its i-th key.
+     */
+    using VariantMask = std::uint64_t;
+
+    /**
+     * @enum PassLoadState
+     * @brief Progress of the load of a pass.
+     */
+    enum class PassLoadState
+    {
+        UNLOADED, ///< The program of the pass does not exist.
+        PENDING,  ///< The program is submitted and the driver is still compiling or linking it.
+        READY     ///< The program is linked and its uniforms and attributes are read.
+    };
+
     /**
      * @class PassContext
      * @brief Abstract base class for pass context.
@@ -44,6 +74,16 @@ namespace cenpy::graphic::context
          */
         void addUniform(const std::string &name, std::shared_ptr<pipeline::Uniform<API>> uniform)
         {
+            if (auto it = m_uniformHandles.find(name); it != m_uniformHandles.end())
+            {
+                m_uniformSlots[it->second.index] = uniform.get();
+            }
+            else
+            {
+                m_uniformHandles[name] = pipeline::UniformHandle{static_cast<std::uint32_t>(m_uniformSlots.size())};
+                m_uniformSlots.push_back(uniform.get());
+                m_pendingUniforms.resize((m_uniformSlots.size() + PENDING_WORD_BITS - 1) / PENDING_WORD_BITS, 0);
+            }
             m_uniforms[name] = uniform;
         }
 
@@ -82,6 +122,37 @@ namespace cenpy::graphic::context
             return nullptr;
         }
 
+        /**
+         * @brief Resolve the handle of the uniform with the given name.
+         * @param name Name of the uniform to resolve.
+         * @return Handle of the uniform, invalid if no uniform has this name.
+         */
+        [[nodiscard]] pipeline::UniformHandle getUniformHandle(std::string_view name) const
+        {
+            if (auto it = m_uniformHandles.find(name); it != m_uniformHandles.end())
+            {
+                return it->second;
+            }
+            return pipeline::UniformHandle{};
+        }
+
+        /**
+         * @brief Get the uniform designated by the given handle.
+         *
+         * The lookup is a plain index into the flat uniform array, no hashing nor reference counting.
+         *
+         * @param handle Handle of the uniform to get.
+         * @return Uniform designated by the handle, nullptr if the handle is not valid for this pass.
+         */
+        [[nodiscard]] pipeline::Uniform<API> *getUniform(pipeline::UniformHandle handle) const
+        {
+            if (handle.index < m_uniformSlots.size())
+            {
+                return m_uniformSlots[handle.index];
+            }
+            return nullptr;
+        }
+
         /**
          * @brief Get the attribute with the given name.
          * @param name Name of the attribute to get.
@@ -132,9 +203,245 @@ namespace cenpy::graphic::context
             return m_attributes;
         }
 
+        /**
+         * @brief Get the number of uniform sets skipped because the value was already uploaded.
+         * @return Number of uniform cache hits for this pass.
+         */
+        [[nodiscard]] std::size_t getUniformCacheHits() const
+        {
+            std::size_t hits = 0;
+            for (const auto &[name, uniform] : m_uniforms)
+            {
+                hits += uniform->getContext()->getCacheHits();
+            }
+            return hits;
+        }
+
+        /**
+         * @brief Get the number of uniform uploads performed.
+         * @return Number of uniform uploads for this pass.
+         */
+        [[nodiscard]] std::size_t getUniformUploads() const
+        {
+            std::size_t uploads = 0;
+            for (const auto &[name, uniform] : m_uniforms)
+            {
+                uploads += uniform->getContext()->getUploads();
+            }
+            return uploads;
+        }
+
+        /**
+         * @brief Forces every uniform of the pass to be uploaded on its next set.
+         */
+        void invalidateUniformCache()
+        {
+            for (const auto &[name, uniform] : m_uniforms)
+            {
+                uniform->getContext()->invalidate();
+            }
+        }
+
+        /**
+         * @brief Records whether the program of the pass was created from a cached binary.
+         * @param loaded True if the shaders do not need to be compiled and linked.
+         */
+        void setLoadedFromBinary(bool loaded)
+        {
+            m_loadedFromBinary = loaded;
+        }
+
+        [[nodiscard]] bool isLoadedFromBinary() const
+        {
+            return m_loadedFromBinary;
+        }
+
+        void setLoadState(PassLoadState state)
+        {
+            m_loadState = state;
+        }
+
+        [[nodiscard]] PassLoadState getLoadState() const
+        {
+            return m_loadState;
+        }
+
+        /**
+         * @brief Enables or disables the deferred upload of the uniforms set through the pass.
+         * @param deferred True to stage the sets and upload them when the pass is used.
+         */
+        void setDeferredUniforms(bool deferred)
+        {
+            m_deferredUniforms = deferred;
+        }
+
+        [[nodiscard]] bool isDeferredUniforms() const
+        {
+            return m_deferredUniforms;
+        }
+
+        /**
+         * @brief Flags the uniform designated by the handle as staged and waiting for the next commit.
+         * @param handle Handle of the staged uniform.
+         */
+        void markUniformPending(pipeline::UniformHandle handle)
+        {
+            m_pendingUniforms[handle.index / PENDING_WORD_BITS] |= std::uint64_t{1} << (handle.index % PENDING_WORD_BITS);
+        }
+
+        /**
+         * @brief Get the number of uniforms waiting for the next commit.
+         * @return Number of staged uniforms.
+         */
+        [[nodiscard]] std::size_t getPendingUniformsCount() const
+        {
+            std::size_t count = 0;
+            for (std::uint64_t word : m_pendingUniforms)
+            {
+                count += std::popcount(word);
+            }
+            return count;
+        }
+
+        /**
+         * @brief Uploads the staged uniforms, in handle order, and clears the pending set.
+         *
+         * Must be called with the pass bound. Only the flagged uniforms are visited, a whole word
+         * of clean uniforms is skipped at once.
+         */
+        void commitUniforms()
+        {
+            for (std::size_t word = 0; word < m_pendingUniforms.size(); ++word)
+            {
+                std::uint64_t bits = m_pendingUniforms[word];
+                m_pendingUniforms[word] = 0;
+                while (bits != 0)
+                {
+                    const std::size_t index = word * PENDING_WORD_BITS + std::countr_zero(bits);
+                    m_uniformSlots[index]->commit();
+                    bits &= bits - 1;
+                }
+            }
+        }
+
+        /**
+         * @brief Declares the keys the variants of the pass are made of.
+         * @param keys Names of the macros a variant can define, at most 64.
+         * @throws std::runtime_error if there are too many keys.
+         */
+        void setVariantKeys(std::vector<std::string> keys)
+        {
+            if (keys.size() > VARIANT_KEYS_MAX)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::PASS::TOO_MANY_VARIANT_KEYS\n{} keys, at most {}", keys.size(), VARIANT_KEYS_MAX));
+            }
+            m_variantKeys = std::move(keys);
+        }
+
+        [[nodiscard]] const std::vector<std::string> &getVariantKeys() const
+        {
+            return m_variantKeys;
+        }
+
+        /**
+         * @brief Get the mask of a set of variant keys.
+         * @param keys Names of the keys, in any order.
+         * @return The mask of the keys.
+         * @throws std::runtime_error if a key has not been declared.
+         */
+        [[nodiscard]] VariantMask getVariantMask(std::initializer_list<std::string_view> keys) const
+        {
+            VariantMask mask = 0;
+            for (std::string_view key : keys)
+            {
+                auto it = std::ranges::find(m_variantKeys, key);
+                if (it == m_variantKeys.end())
+                {
+                    throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::PASS::UNKNOWN_VARIANT_KEY\n{}", key));
+                }
+                mask |= VariantMask{1} << std::distance(m_variantKeys.begin(), it);
+            }
+            return mask;
+        }
+
+        /**
+         * @brief Get the macros a variant defines, in the order of the keys.
+         * @param mask Mask of the variant.
+         * @return Names of the keys of the mask.
+         */
+        [[nodiscard]] std::vector<std::string> getVariantDefines(VariantMask mask) const
+        {
+            std::vector<std::string> defines;
+            for (std::size_t key = 0; key < m_variantKeys.size(); ++key)
+            {
+                if (mask & (VariantMask{1} << key))
+                {
+                    defines.push_back(m_variantKeys[key]);
+                }
+            }
+            return defines;
+        }
+
+        void addVariant(VariantMask mask, std::shared_ptr<pipeline::IPass<API>> variant)
+        {
+            m_variants[mask] = std::move(variant);
+        }
+
+        /**
+         * @brief Get the variant of the given mask, if it has been created.
+         * @param mask Mask of the variant.
+         * @return The variant, nullptr if it has not been created.
+         */
+        [[nodiscard]] std::shared_ptr<pipeline::IPass<API>> getVariant(VariantMask mask) const
+        {
+            if (auto it = m_variants.find(mask); it != m_variants.end())
+            {
+                return it->second;
+            }
+            return nullptr;
+        }
+
+        [[nodiscard]] std::size_t getVariantsCount() const
+        {
+            return m_variants.size();
+        }
+
+        /**
+         * @brief Drops the variants of the pass, which frees them once no longer used elsewhere.
+         */
+        void clearVariants()
+        {
+            m_variants.clear();
+        }
+
+        /**
+         * @brief Takes the settings of another pass, e.g. the one a variant is created from or the one rebuilt.
+         *
+         * The variant keys are kept so masks resolve the same, but not the variants themselves,
+         * which link the shaders of the other pass.
+         *
+         * @param other Context to take the settings from.
+         */
+        void inheritSettings(const PassContext<API> &other)
+        {
+            m_deferredUniforms = other.m_deferredUniforms;
+            m_variantKeys = other.m_variantKeys;
+        }
+
     private:
+        static constexpr std::size_t VARIANT_KEYS_MAX = 64; ///< Keys a variant mask can hold.
+        static constexpr std::size_t PENDING_WORD_BITS = 64; ///< Uniforms tracked per word of the pending set.
+
         std::vector<std::shared_ptr<pipeline::IShader<API>>> m_shaders;
         std::unordered_map<std::string, std::shared_ptr<pipeline::Uniform<API>>, collection_utils::StringHash, collection_utils::StringEqual> m_uniforms;
+        std::unordered_map<std::string, pipeline::UniformHandle, collection_utils::StringHash, collection_utils::StringEqual> m_uniformHandles;
+        std::vector<pipeline::Uniform<API> *> m_uniformSlots; ///< Uniforms indexed by handle, owned by m_uniforms.
+        std::vector<std::uint64_t> m_pendingUniforms;         ///< Bitset of the staged uniforms, indexed by handle.
+        PassLoadState m_loadState = PassLoadState::UNLOADED;  ///< Progress of the load of the pass.
+        bool m_loadedFromBinary = false;                      ///< Whether the program was created from a cached binary.
+        bool m_deferredUniforms = false;                      ///< Whether sets through the pass are staged until use.
         std::unordered_map<std::string, std::shared_ptr<pipeline::IAttribute<API>>, collection_utils::StringHash, collection_utils::StringEqual> m_attributes;
+        std::vector<std::string> m_variantKeys;                                  ///< Macros a variant can define, by bit of the mask.
+        std::unordered_map<VariantMask, std::shared_ptr<pipeline::IPass<API>>> m_variants; ///< Variants created so far, by mask.
     };
 }
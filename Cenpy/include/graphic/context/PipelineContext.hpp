@@ -3,8 +3,11 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <graphic/Api.hpp>
 #include <graphic/pipeline/Pass.hpp>
+#include <graphic/pipeline/UniformBlock.hpp>
+#include <graphic/render/RenderQueue.hpp>
 
 namespace cenpy::graphic::context
 {
@@ -40,8 +43,34 @@ namespace cenpy::graphic::context
             return m_currentPass;
         }
 
+        void addUniformBlock(std::shared_ptr<pipeline::IUniformBlock<API>> block)
+        {
+            m_uniformBlocks.push_back(block);
+        }
+
+        [[nodiscard]] const std::vector<std::shared_ptr<pipeline::IUniformBlock<API>>> &getUniformBlocks() const
+        {
+            return m_uniformBlocks;
+        }
+
+        /**
+         * @brief Set the commands drawn by the next call to the drawer, all of the current pass.
+         * @param commands Consecutive commands of the sorted queue, empty once the queue is drawn.
+         */
+        void setCurrentCommands(std::span<const render::RenderCommand> commands)
+        {
+            m_currentCommands = commands;
+        }
+
+        [[nodiscard]] std::span<const render::RenderCommand> getCurrentCommands() const
+        {
+            return m_currentCommands;
+        }
+
     private:
         std::vector<std::shared_ptr<pipeline::IPass<API>>> m_passes;
+        std::vector<std::shared_ptr<pipeline::IUniformBlock<API>>> m_uniformBlocks;
         int m_currentPass = -1;
+        std::span<const render::RenderCommand> m_currentCommands;
     };
 }
\ No newline at end of file
@@ -2,6 +2,13 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
 namespace cenpy::graphic::context
 {
     enum class ShaderType
@@ -52,17 +59,75 @@ namespace cenpy::graphic::context
         virtual void setShaderCode(const std::string &shaderCode)
         {
             m_shaderCode = shaderCode;
+            m_shaderSource = {};
+            m_shaderSourceOwner.reset();
+        }
+
+        /**
+         * @brief Set the code as a view of a buffer owned elsewhere, without copying it.
+         * @param shaderSource View of the code.
+         * @param owner Keeps the viewed buffer alive and unchanged as long as the context uses it.
+         */
+        virtual void setShaderSource(std::string_view shaderSource, std::shared_ptr<const void> owner)
+        {
+            m_shaderCode.clear();
+            m_shaderSource = shaderSource;
+            m_shaderSourceOwner = std::move(owner);
+        }
+
+        [[nodiscard]] virtual std::string_view getShaderCode() const
+        {
+            return m_shaderSourceOwner ? m_shaderSource : std::string_view(m_shaderCode);
+        }
+
+        /**
+         * @brief Set the files included by the shader source, as resolved by the preprocessor.
+         * @param includes Normalized paths of the included files.
+         */
+        virtual void setIncludes(std::vector<std::string> includes)
+        {
+            m_includes = std::move(includes);
+        }
+
+        [[nodiscard]] virtual const std::vector<std::string> &getIncludes() const
+        {
+            return m_includes;
+        }
+
+        /**
+         * @brief Set the macros defined before the code of the shader, to compile one of its variants.
+         * @param defines Names of the macros to define.
+         */
+        virtual void setDefines(std::vector<std::string> defines)
+        {
+            m_defines = std::move(defines);
+        }
+
+        [[nodiscard]] virtual const std::vector<std::string> &getDefines() const
+        {
+            return m_defines;
         }
 
-        [[nodiscard]] virtual const std::string &getShaderCode() const
+        /**
+         * @brief Tells whether the shader must be compiled again when the given file changes.
+         * @param path Path of the changed file.
+         * @return True if the file is the shader source or one of the files it includes.
+         */
+        [[nodiscard]] bool dependsOn(const std::filesystem::path &path) const
         {
-            return m_shaderCode;
+            const std::string normalized = path.lexically_normal().generic_string();
+            return std::filesystem::path(getShaderPath()).lexically_normal().generic_string() == normalized ||
+                   std::ranges::find(getIncludes(), normalized) != getIncludes().end();
         }
 
     private:
-        ShaderType m_shaderType;  ///< Shader type
-        std::string m_shaderPath; // Path to the shader source code
-        std::string m_shaderCode; // The code of the shader
+        ShaderType m_shaderType;                         ///< Shader type
+        std::string m_shaderPath;                        // Path to the shader source code
+        std::string m_shaderCode;                        // The code of the shader
+        std::string_view m_shaderSource;                 ///< The code of the shader, when viewed from m_shaderSourceOwner
+        std::shared_ptr<const void> m_shaderSourceOwner; ///< Owner of the viewed code, if any
+        std::vector<std::string> m_includes;             ///< Files included by the code, the edges of the dependency graph
+        std::vector<std::string> m_defines;              ///< Macros defined before the code, for variants
     };
 
 }
\ No newline at end of file
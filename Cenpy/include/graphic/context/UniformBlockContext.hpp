@@ -0,0 +1,394 @@
+// UniformBlockContext.hpp
+
+#pragma once
+#include <GL/glew.h>
+#include <string>
+#include <string_view>
+#include <format>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utils.hpp>
+#include <common/exception/TraceableException.hpp>
+
+namespace cenpy::graphic::context
+{
+    /**
+     * @struct UniformBlockMember
+     * @brief Declaration and std140 layout of a member of a uniform block.
+     *
+     * Only the name, type and array size are declared by the user, the layout fields are computed
+     * by the UniformBlockContext when the member is added. An array of one element, which reflection
+     * reports with the same size as a scalar, is told apart by isArray or by the "[0]" suffix GL
+     * gives to the name of array members.
+     */
+    struct UniformBlockMember
+    {
+        std::string name;            ///< Name of the member in the block.
+        GLenum type = GL_NONE;       ///< GL type of the member.
+        std::uint32_t arraySize = 1; ///< Number of elements, 1 for non array members.
+        bool isArray = false;        ///< Whether the member is an array, set for any array size once added.
+        std::size_t offset = 0;      ///< Offset of the member from the start of the block.
+        std::size_t arrayStride = 0; ///< Distance between two elements of an array member.
+        std::size_t matrixStride = 0; ///< Distance between two columns of a matrix member.
+    };
+
+    /**
+     * @class UniformBlockContext
+     * @brief Abstract base class for uniform block context.
+     *
+     * The UniformBlockContext holds a CPU copy of a uniform block packed with the std140 rules, so
+     * the same bytes can be uploaded in one call and shared by every pass declaring the block.
+     * Members are declared in the order of the GLSL block, and writes only extend the dirty range
+     * when they actually change the staged bytes.
+     */
+    template <typename API>
+    class UniformBlockContext
+    {
+    public:
+        virtual ~UniformBlockContext() = default;
+
+        void setBlockName(std::string_view name)
+        {
+            m_blockName = name;
+        }
+
+        [[nodiscard]] const std::string &getBlockName() const
+        {
+            return m_blockName;
+        }
+
+        void setBindingPoint(std::uint32_t bindingPoint)
+        {
+            m_bindingPoint = bindingPoint;
+        }
+
+        [[nodiscard]] std::uint32_t getBindingPoint() const
+        {
+            return m_bindingPoint;
+        }
+
+        /**
+         * @brief Append a member to the block, placing it according to the std140 rules.
+         * @param member Member to append, only the name, type and array size are read.
+         */
+        void addMember(UniformBlockMember member)
+        {
+            if (member.name.ends_with(ARRAY_SUFFIX))
+            {
+                member.name.resize(member.name.size() - ARRAY_SUFFIX.size());
+                member.isArray = true;
+            }
+            member.isArray = member.isArray || member.arraySize > 1;
+            if (m_memberIndices.contains(member.name))
+            {
+                throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM_BLOCK::MEMBER_ALREADY_DEFINED\nMember {} is already defined in block {}", member.name, m_blockName));
+            }
+            const Std140Type layout = std140Type(member.type);
+            if (layout.scalarSize == 0 || member.arraySize == 0)
+            {
+                throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM_BLOCK::UNSUPPORTED_TYPE\nMember {} has an unsupported type ({})", member.name, member.type));
+            }
+
+            // Vectors of 3 components align like vectors of 4.
+            const std::size_t vectorSize = layout.scalarSize * layout.rows;
+            const std::size_t vectorAlign = layout.scalarSize * (layout.rows == 3 ? 4 : layout.rows);
+
+            std::size_t align = vectorAlign;
+            std::size_t elementSize = vectorSize;
+            member.matrixStride = 0;
+            if (layout.columns > 1)
+            {
+                // A matrix is laid out as an array of column vectors, and array elements are rounded to a vec4.
+                member.matrixStride = roundUp(vectorAlign, VEC4_ALIGNMENT);
+                align = member.matrixStride;
+                elementSize = member.matrixStride * layout.columns;
+            }
+            if (member.isArray)
+            {
+                align = roundUp(align, VEC4_ALIGNMENT);
+                member.arrayStride = roundUp(elementSize, align);
+            }
+            else
+            {
+                member.arrayStride = elementSize;
+            }
+
+            member.offset = roundUp(m_end, align);
+            // The member after an array starts past the padding of its last element, at the array alignment.
+            m_end = member.offset + (member.isArray ? member.arrayStride * member.arraySize : elementSize);
+            m_data.resize(roundUp(m_end, VEC4_ALIGNMENT), std::byte{0});
+            m_dirtyBegin = 0;
+            m_dirtyEnd = m_data.size();
+
+            m_memberIndices[member.name] = m_members.size();
+            m_members.push_back(std::move(member));
+        }
+
+        /**
+         * @brief Get the member with the given name.
+         * @param name Name of the member.
+         * @return The member, nullptr if the block has no such member.
+         */
+        [[nodiscard]] const UniformBlockMember *getMember(std::string_view name) const
+        {
+            if (auto it = m_memberIndices.find(name); it != m_memberIndices.end())
+            {
+                return &m_members[it->second];
+            }
+            return nullptr;
+        }
+
+        [[nodiscard]] const std::vector<UniformBlockMember> &getMembers() const
+        {
+            return m_members;
+        }
+
+        /**
+         * @brief Write a value in the staging copy of the block.
+         *
+         * Matrices are written column by column at the matrix stride of the member, as std140 pads
+         * every column to a vec4.
+         *
+         * @param name Name of the member to write.
+         * @param value Value to write.
+         * @param index Element to write for array members.
+         */
+        template <typename T>
+        void setValue(std::string_view name, const T &value, std::uint32_t index = 0)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Uniform block value must be trivially copyable");
+
+            const UniformBlockMember *member = findMember(name, API::UniformContext::template Setter<T>::glType, typeid(T).name(), index);
+            const std::size_t offset = member->offset + member->arrayStride * index;
+            const auto *source = reinterpret_cast<const std::byte *>(&value);
+            if (member->matrixStride == 0)
+            {
+                write(offset, source, sizeof(T));
+                return;
+            }
+            const Std140Type layout = std140Type(member->type);
+            const std::size_t columnSize = sizeof(T) / layout.columns;
+            for (std::size_t column = 0; column < layout.columns; ++column)
+            {
+                write(offset + column * member->matrixStride, source + column * columnSize, columnSize);
+            }
+        }
+
+        /**
+         * @brief Write a boolean in the staging copy of the block.
+         *
+         * A GLSL bool takes 4 bytes in a block, it is written as an int holding 0 or 1.
+         *
+         * @param name Name of the member to write.
+         * @param value Value to write.
+         * @param index Element to write for array members.
+         */
+        void setValue(std::string_view name, bool value, std::uint32_t index = 0)
+        {
+            const UniformBlockMember *member = findMember(name, GL_BOOL, "bool", index);
+            const std::int32_t stored = value ? 1 : 0;
+            write(member->offset + member->arrayStride * index, reinterpret_cast<const std::byte *>(&stored), sizeof(stored));
+        }
+
+        /**
+         * @brief Get the staging copy of the block, packed with the std140 rules.
+         * @return The bytes of the block.
+         */
+        [[nodiscard]] const std::vector<std::byte> &getData() const
+        {
+            return m_data;
+        }
+
+        /**
+         * @brief Get the size of the block, rounded up to a vec4 as std140 requires.
+         * @return The size of the block in bytes.
+         */
+        [[nodiscard]] std::size_t getDataSize() const
+        {
+            return m_data.size();
+        }
+
+        /**
+         * @brief Returns whether the staging copy differs from the uploaded buffer.
+         * @return True if a range of the block must be uploaded.
+         */
+        [[nodiscard]] bool isDirty() const
+        {
+            return m_dirtyBegin < m_dirtyEnd;
+        }
+
+        [[nodiscard]] std::size_t getDirtyOffset() const
+        {
+            return m_dirtyBegin;
+        }
+
+        [[nodiscard]] std::size_t getDirtySize() const
+        {
+            return isDirty() ? m_dirtyEnd - m_dirtyBegin : 0;
+        }
+
+        /**
+         * @brief Marks the dirty range as uploaded.
+         */
+        void markUploaded()
+        {
+            m_dirtyBegin = m_data.size();
+            m_dirtyEnd = 0;
+            ++m_uploads;
+        }
+
+        /**
+         * @brief Forces the whole block to be uploaded again, e.g. after the buffer has been recreated.
+         */
+        void invalidate()
+        {
+            m_dirtyBegin = 0;
+            m_dirtyEnd = m_data.size();
+        }
+
+        /**
+         * @brief Returns the number of uploads performed.
+         * @return The number of uploads.
+         */
+        [[nodiscard]] std::size_t getUploads() const
+        {
+            return m_uploads;
+        }
+
+    private:
+        static constexpr std::size_t VEC4_ALIGNMENT = 16;        ///< Alignment std140 applies to array elements and matrix columns.
+        static constexpr std::string_view ARRAY_SUFFIX = "[0]"; ///< Suffix of the reflected name of an array member.
+
+        struct Std140Type
+        {
+            std::size_t scalarSize; ///< Size of one component, 0 if the type is not supported.
+            std::size_t rows;       ///< Components per column.
+            std::size_t columns;    ///< Columns, 1 for scalars and vectors.
+        };
+
+        static constexpr std::size_t roundUp(std::size_t value, std::size_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        static constexpr Std140Type std140Type(GLenum type)
+        {
+            switch (type)
+            {
+            case GL_FLOAT:
+            case GL_INT:
+            case GL_UNSIGNED_INT:
+            case GL_BOOL:
+                return {4, 1, 1};
+            case GL_FLOAT_VEC2:
+            case GL_INT_VEC2:
+            case GL_UNSIGNED_INT_VEC2:
+            case GL_BOOL_VEC2:
+                return {4, 2, 1};
+            case GL_FLOAT_VEC3:
+            case GL_INT_VEC3:
+            case GL_UNSIGNED_INT_VEC3:
+            case GL_BOOL_VEC3:
+                return {4, 3, 1};
+            case GL_FLOAT_VEC4:
+            case GL_INT_VEC4:
+            case GL_UNSIGNED_INT_VEC4:
+            case GL_BOOL_VEC4:
+                return {4, 4, 1};
+            case GL_DOUBLE:
+                return {8, 1, 1};
+            case GL_DOUBLE_VEC2:
+                return {8, 2, 1};
+            case GL_DOUBLE_VEC3:
+                return {8, 3, 1};
+            case GL_DOUBLE_VEC4:
+                return {8, 4, 1};
+            case GL_FLOAT_MAT2:
+                return {4, 2, 2};
+            case GL_FLOAT_MAT3:
+                return {4, 3, 3};
+            case GL_FLOAT_MAT4:
+                return {4, 4, 4};
+            case GL_FLOAT_MAT2x3:
+                return {4, 3, 2};
+            case GL_FLOAT_MAT2x4:
+                return {4, 4, 2};
+            case GL_FLOAT_MAT3x2:
+                return {4, 2, 3};
+            case GL_FLOAT_MAT3x4:
+                return {4, 4, 3};
+            case GL_FLOAT_MAT4x2:
+                return {4, 2, 4};
+            case GL_FLOAT_MAT4x3:
+                return {4, 3, 4};
+            case GL_DOUBLE_MAT2:
+                return {8, 2, 2};
+            case GL_DOUBLE_MAT3:
+                return {8, 3, 3};
+            case GL_DOUBLE_MAT4:
+                return {8, 4, 4};
+            case GL_DOUBLE_MAT2x3:
+                return {8, 3, 2};
+            case GL_DOUBLE_MAT2x4:
+                return {8, 4, 2};
+            case GL_DOUBLE_MAT3x2:
+                return {8, 2, 3};
+            case GL_DOUBLE_MAT3x4:
+                return {8, 4, 3};
+            case GL_DOUBLE_MAT4x2:
+                return {8, 2, 4};
+            case GL_DOUBLE_MAT4x3:
+                return {8, 3, 4};
+            default:
+                return {0, 0, 0};
+            }
+        }
+
+        /**
+         * @brief Get a member to write, checking the type of the value and the element index.
+         */
+        const UniformBlockMember *findMember(std::string_view name, GLenum type, std::string_view typeName, std::uint32_t index) const
+        {
+            const UniformBlockMember *member = getMember(name);
+            if (member == nullptr)
+            {
+                throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM_BLOCK::SET::MEMBER_NOT_FOUND\nMember {} not found in block {}", name, m_blockName));
+            }
+            if (type != member->type)
+            {
+                throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM_BLOCK::SET::TYPE_MISMATCH: The type of the value ({}) does not match the type of the member {} ({})", typeName, name, member->type));
+            }
+            if (index >= member->arraySize)
+            {
+                throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM_BLOCK::SET::INDEX_OUT_OF_RANGE\nIndex {} is out of range for member {} of size {}", index, name, member->arraySize));
+            }
+            return member;
+        }
+
+        void write(std::size_t offset, const std::byte *source, std::size_t size)
+        {
+            if (std::memcmp(m_data.data() + offset, source, size) == 0)
+            {
+                return;
+            }
+            std::memcpy(m_data.data() + offset, source, size);
+            m_dirtyBegin = std::min(m_dirtyBegin, offset);
+            m_dirtyEnd = std::max(m_dirtyEnd, offset + size);
+        }
+
+        std::string m_blockName;                                                                                 ///< Name of the block in the shaders.
+        std::uint32_t m_bindingPoint = 0;                                                                        ///< Binding point the block is bound to.
+        std::vector<UniformBlockMember> m_members;                                                               ///< Members in declaration order.
+        std::unordered_map<std::string, std::size_t, collection_utils::StringHash, collection_utils::StringEqual> m_memberIndices; ///< Member index by name.
+        std::vector<std::byte> m_data;                                                                           ///< std140 staging copy of the block.
+        std::size_t m_end = 0;                                                                                   ///< End of the last member, before the final padding.
+        std::size_t m_dirtyBegin = 0;                                                                            ///< Start of the range to upload.
+        std::size_t m_dirtyEnd = 0;                                                                              ///< End of the range to upload.
+        std::size_t m_uploads = 0;                                                                               ///< Number of uploads performed.
+    };
+}
@@ -3,49 +3,192 @@
 #pragma once
 #include <string>
 #include <format>
-#include <any>
+#include <array>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <glm/glm.hpp>
 #include <common/exception/TraceableException.hpp>
 
 namespace cenpy::graphic::context
 {
+    /**
+     * @class UniformContext
+     * @brief Abstract base class for uniform context.
+     *
+     * The UniformContext stores the value of a uniform variable inline, in a buffer sized for the
+     * largest GLSL type (dmat4). The stored value is tagged with the type of the setter that wrote
+     * it, as mapped by API::UniformContext::valueTypeOf, e.g. its GL type for OpenGL, so setting a
+     * value never allocates and type checks are a single integer compare.
+     * The (more expensive) compatibility check against the reflected type is only performed when
+     * the tag changes, which in practice means once, on the first set.
+     *
+     * The stored value also acts as a shadow of the last uploaded one: a value equal to the
+     * uploaded one leaves the context clean, and the uniform skips the API call.
+     */
     template <typename API>
     class UniformContext
     {
     public:
+        using ValueType = std::uint32_t; ///< Tag of the type of a value, defined by the API.
+
+        static constexpr std::size_t MAX_VALUE_SIZE = sizeof(glm::dmat4); ///< Size of the largest GLSL type.
+        static constexpr ValueType NO_VALUE_TYPE = 0;                      ///< Tag of a context without value.
+
         virtual ~UniformContext() = default;
 
         template <typename T>
         const T &getValue() const
         {
-            if (m_value.has_value())
+            if (m_valueType != valueTypeOf<T>())
             {
-                try
-                {
-                    std::any_cast<T>(&m_value);
-                }
-                catch (const std::bad_any_cast &)
-                {
-                    throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM::SET::TYPE_MISMATCH: The type of the value ({}) does not match the type of the uniform variable ({})", typeid(T).name(), typeid(m_value).name()));
-                }
+                throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM::GET::TYPE_MISMATCH: The type of the value ({}) does not match the type of the uniform variable ({})", typeid(T).name(), m_valueType));
             }
-            return *std::any_cast<T>(&m_value);
+            return *std::launder(reinterpret_cast<const T *>(m_value.data()));
         }
 
         template <typename T>
         void setValue(const T &value)
         {
-            try
+            static_assert(sizeof(T) <= MAX_VALUE_SIZE, "Uniform value does not fit in the inline storage");
+            static_assert(std::is_trivially_copyable_v<T>, "Uniform value must be trivially copyable");
+
+            constexpr ValueType valueType = valueTypeOf<T>();
+            if (m_valueType != valueType)
             {
-                std::any_cast<T>(&m_value);
+                if (m_valueType != NO_VALUE_TYPE || !isCompatible(valueType))
+                {
+                    throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM::SET::TYPE_MISMATCH: The type of the value ({}) does not match the type of the uniform variable ({})", typeid(value).name(), m_valueType));
+                }
+                m_valueType = valueType;
             }
-            catch (const std::bad_any_cast &)
+            if (!m_dirty && std::memcmp(m_value.data(), &value, sizeof(T)) == 0)
             {
-                throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM::SET::TYPE_MISMATCH: The type of the value ({}) does not match the type of the uniform variable ({})", typeid(value).name(), typeid(m_value).name()));
+                return;
             }
-            m_value = value;
+            std::construct_at(reinterpret_cast<T *>(m_value.data()), value);
+            m_dirty = true;
+        }
+
+        /**
+         * @brief Returns whether the stored value differs from the last uploaded one.
+         * @return True if the value must be uploaded.
+         */
+        [[nodiscard]] bool isDirty() const
+        {
+            return m_dirty;
+        }
+
+        /**
+         * @brief Marks the stored value as uploaded.
+         */
+        void markUploaded()
+        {
+            m_dirty = false;
+            ++m_uploads;
+        }
+
+        /**
+         * @brief Records a set that was skipped because the value was already uploaded.
+         */
+        void markCacheHit()
+        {
+            ++m_cacheHits;
+        }
+
+        /**
+         * @brief Forces the next set to upload, e.g. after the program has been relinked.
+         */
+        void invalidate()
+        {
+            m_dirty = true;
+        }
+
+        /**
+         * @brief Takes over the value of another context, e.g. the one of a uniform before its pass was relinked.
+         *
+         * The value is taken only if this uniform accepts its type, and then waits for its upload.
+         *
+         * @param previous Context holding the value to take over.
+         * @return True if the value was taken over.
+         */
+        bool restoreValue(const UniformContext<API> &previous)
+        {
+            if (!previous.hasValue() ||
+                (m_valueType != previous.m_valueType && (m_valueType != NO_VALUE_TYPE || !isCompatible(previous.m_valueType))))
+            {
+                return false;
+            }
+            m_valueType = previous.m_valueType;
+            m_value = previous.m_value;
+            m_dirty = true;
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of sets that skipped the upload.
+         * @return The number of cache hits.
+         */
+        [[nodiscard]] std::size_t getCacheHits() const
+        {
+            return m_cacheHits;
+        }
+
+        /**
+         * @brief Returns the number of uploads performed.
+         * @return The number of uploads.
+         */
+        [[nodiscard]] std::size_t getUploads() const
+        {
+            return m_uploads;
+        }
+
+        /**
+         * @brief Returns whether a value has been set.
+         * @return True if a value has been set, false otherwise.
+         */
+        [[nodiscard]] bool hasValue() const
+        {
+            return m_valueType != NO_VALUE_TYPE;
+        }
+
+        /**
+         * @brief Returns the type tag of the stored value.
+         * @return The type of the stored value, NO_VALUE_TYPE if no value has been set.
+         */
+        [[nodiscard]] ValueType getValueType() const
+        {
+            return m_valueType;
+        }
+
+    protected:
+        /**
+         * @brief Checks that a value of the given type can be stored in this uniform.
+         *
+         * Called only when the type tag changes. API-specific contexts override this to reject
+         * the types they have no setter for and compare against the reflected type of the uniform.
+         *
+         * @param valueType Type tag of the value to store.
+         * @return True if the value type is accepted.
+         */
+        [[nodiscard]] virtual bool isCompatible(ValueType valueType) const
+        {
+            return valueType != NO_VALUE_TYPE;
         }
 
     private:
-        std::any m_value; ///< The value of the uniform variable.
+        template <typename T>
+        static constexpr ValueType valueTypeOf()
+        {
+            return API::UniformContext::template valueTypeOf<T>();
+        }
+
+        ValueType m_valueType = NO_VALUE_TYPE;                ///< The type tag of the stored value.
+        bool m_dirty = true;                                  ///< Whether the stored value has not been uploaded yet.
+        std::size_t m_cacheHits = 0;                          ///< Number of sets that skipped the upload.
+        std::size_t m_uploads = 0;                            ///< Number of uploads performed.
+        alignas(glm::dmat4) std::array<std::byte, MAX_VALUE_SIZE> m_value{}; ///< Inline storage of the value.
     };
-}
\ No newline at end of file
+}
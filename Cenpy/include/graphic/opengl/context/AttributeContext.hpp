@@ -2,6 +2,8 @@
 
 #pragma once
 #include <GL/glew.h>
+#include <cstddef>
+#include <memory>
 #include <graphic/Api.hpp>
 #include <graphic/context/AttributeContext.hpp>
 
@@ -17,6 +19,11 @@ namespace cenpy::graphic
         class OpenGLUnbinder;
     }
 
+    namespace opengl::pipeline::buffer
+    {
+        class OpenGLStreamingRing;
+    }
+
     namespace opengl::context
     {
         class OpenGLAttributeContext : public graphic::context::AttributeContext<graphic::api::OpenGL>
@@ -83,12 +90,46 @@ namespace cenpy::graphic
                 return m_usage;
             }
 
+            /**
+             * @brief Set the bytes allocated to the buffer, reused while the values fit.
+             * @param capacity Allocated bytes.
+             */
+            void setCapacity(std::size_t capacity)
+            {
+                m_capacity = capacity;
+            }
+
+            [[nodiscard]] std::size_t getCapacity() const
+            {
+                return m_capacity;
+            }
+
+            /**
+             * @brief Streams the values through a ring instead of the buffer of the attribute.
+             *
+             * Each set writes the values into the segment of the current frame of the ring and
+             * sources the attribute from there.
+             *
+             * @param ring Ring to stream through, nullptr to upload to the attribute buffer again.
+             */
+            void setStreamingRing(std::shared_ptr<opengl::pipeline::buffer::OpenGLStreamingRing> ring)
+            {
+                m_streamingRing = std::move(ring);
+            }
+
+            [[nodiscard]] const std::shared_ptr<opengl::pipeline::buffer::OpenGLStreamingRing> &getStreamingRing() const
+            {
+                return m_streamingRing;
+            }
+
         private:
-            GLuint m_attributeId; ///< OpenGL attribute ID
-            GLuint m_size;        ///< The size of the attribute variable.
-            GLenum m_type;        ///< The type of the attribute variable.
-            GLuint m_bufferId;    ///< OpenGL VBO buffer ID
-            GLenum m_usage;       ///< The drawing mode of the attribute variable.
+            GLuint m_attributeId = 0;         ///< OpenGL attribute ID
+            GLuint m_size = 0;                ///< The size of the attribute variable.
+            GLenum m_type = GL_FLOAT;         ///< The type of the attribute variable.
+            GLuint m_bufferId = 0;            ///< OpenGL VBO buffer ID
+            GLenum m_usage = GL_STATIC_DRAW;  ///< The drawing mode of the attribute variable.
+            std::size_t m_capacity = 0;       ///< Bytes allocated to the buffer.
+            std::shared_ptr<opengl::pipeline::buffer::OpenGLStreamingRing> m_streamingRing; ///< Ring the values are streamed through, if any.
         };
     }
 }
\ No newline at end of file
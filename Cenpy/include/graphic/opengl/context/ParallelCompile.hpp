@@ -0,0 +1,60 @@
+// file: ParallelCompile.hpp
+
+#pragma once
+
+#include <optional>
+#include <GL/glew.h>
+
+namespace cenpy::graphic::opengl::context
+{
+    namespace detail
+    {
+        /// Support of KHR_parallel_shader_compile by the context current on this thread, unset until queried.
+        inline thread_local std::optional<bool> parallelShaderCompileSupport;
+    }
+
+    /**
+     * @brief Lets the driver compile and link shaders on as many threads as it can use.
+     *
+     * The hint applies to the whole context and only to the compiles submitted after it, so call
+     * it once per context, right after glewInit and before the first shader is compiled. The
+     * support is cached for isParallelShaderCompileSupported.
+     *
+     * @return True if KHR_parallel_shader_compile is available.
+     */
+    inline bool enableParallelShaderCompile()
+    {
+        detail::parallelShaderCompileSupport = glewIsSupported("GL_KHR_parallel_shader_compile") == GL_TRUE;
+        if (!*detail::parallelShaderCompileSupport)
+        {
+            return false;
+        }
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        return true;
+    }
+
+    /**
+     * @brief Tells whether the current context supports KHR_parallel_shader_compile.
+     *
+     * The extension is only queried the first time, or after forgetParallelShaderCompile, as
+     * glewIsSupported parses the extension string on each call.
+     *
+     * @return True if KHR_parallel_shader_compile is available.
+     */
+    inline bool isParallelShaderCompileSupported()
+    {
+        if (!detail::parallelShaderCompileSupport)
+        {
+            detail::parallelShaderCompileSupport = glewIsSupported("GL_KHR_parallel_shader_compile") == GL_TRUE;
+        }
+        return *detail::parallelShaderCompileSupport;
+    }
+
+    /**
+     * @brief Forgets the cached support, call it when the context of this thread is destroyed or changed.
+     */
+    inline void forgetParallelShaderCompile()
+    {
+        detail::parallelShaderCompileSupport.reset();
+    }
+}
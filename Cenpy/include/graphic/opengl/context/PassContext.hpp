@@ -3,6 +3,11 @@
 #pragma once
 
 #include <GL/glew.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utils.hpp>
 #include <graphic/Api.hpp>
 #include <graphic/context/PassContext.hpp>
 
@@ -13,6 +18,12 @@ namespace cenpy::graphic
         template <auto PROFILE>
         class OpenGLLoader;
         template <auto PROFILE>
+        class OpenGLLinker;
+        template <auto PROFILE>
+        class OpenGLPassPoller;
+        template <auto PROFILE>
+        class OpenGLPassWaiter;
+        template <auto PROFILE>
         class OpenGLPassFreer;
         template <auto PROFILE>
         class OpenGLShaderAttacher;
@@ -22,10 +33,28 @@ namespace cenpy::graphic
         class OpenGLPassAttributeReader;
         template <auto PROFILE>
         class OpenGLPassUser;
+        template <auto PROFILE>
+        class OpenGLPassBinaryLoader;
+    }
+
+    namespace opengl::pipeline::cache
+    {
+        class OpenGLProgramBinaryCache;
     }
 
     namespace opengl::context
     {
+        /**
+         * @struct OpenGLPassUniformBlock
+         * @brief Reflected uniform block of a program, with the binding point it is currently set to.
+         */
+        struct OpenGLPassUniformBlock
+        {
+            GLuint index = GL_INVALID_INDEX;   ///< Index of the block in the program.
+            GLint dataSize = 0;                ///< Size of the block reported by the driver.
+            GLuint binding = GL_INVALID_INDEX; ///< Binding point assigned with glUniformBlockBinding, if any.
+        };
+
         /**
          * @class OpenGLPassContext
          * @brief OpenGL-specific implementation of PassContext.
@@ -40,6 +69,12 @@ namespace cenpy::graphic
             template <auto PROFILE>
             using Loader = opengl::pipeline::component::pass::OpenGLLoader<PROFILE>;
             template <auto PROFILE>
+            using Linker = opengl::pipeline::component::pass::OpenGLLinker<PROFILE>;
+            template <auto PROFILE>
+            using Poller = opengl::pipeline::component::pass::OpenGLPassPoller<PROFILE>;
+            template <auto PROFILE>
+            using Waiter = opengl::pipeline::component::pass::OpenGLPassWaiter<PROFILE>;
+            template <auto PROFILE>
             using Freer = opengl::pipeline::component::pass::OpenGLPassFreer<PROFILE>;
             template <auto PROFILE>
             using ShaderAttacher = opengl::pipeline::component::pass::OpenGLShaderAttacher<PROFILE>;
@@ -49,6 +84,8 @@ namespace cenpy::graphic
             using AttributeReader = opengl::pipeline::component::pass::OpenGLPassAttributeReader<PROFILE>;
             template <auto PROFILE>
             using User = opengl::pipeline::component::pass::OpenGLPassUser<PROFILE>;
+            template <auto PROFILE>
+            using BinaryLoader = opengl::pipeline::component::pass::OpenGLPassBinaryLoader<PROFILE>;
 
             void setPassID(GLuint passID)
             {
@@ -60,8 +97,73 @@ namespace cenpy::graphic
                 return m_passID;
             }
 
+            /**
+             * @brief Set the cache the program binary of the pass is loaded from and stored to.
+             * @param cache Program binary cache, nullptr to always compile the pass.
+             */
+            void setProgramBinaryCache(std::shared_ptr<opengl::pipeline::cache::OpenGLProgramBinaryCache> cache)
+            {
+                m_programBinaryCache = std::move(cache);
+            }
+
+            const std::shared_ptr<opengl::pipeline::cache::OpenGLProgramBinaryCache> &getProgramBinaryCache() const
+            {
+                return m_programBinaryCache;
+            }
+
+            /**
+             * @brief Takes the settings of another pass, e.g. the one a variant is created from.
+             * @param other Context to take the settings from.
+             */
+            void inheritSettings(const OpenGLPassContext &other)
+            {
+                graphic::context::PassContext<graphic::api::OpenGL>::inheritSettings(other);
+                m_programBinaryCache = other.m_programBinaryCache;
+            }
+
+            /**
+             * @brief Records whether the driver compiles and links the pass on its own threads.
+             * @param parallelCompile True if GL_COMPLETION_STATUS_KHR can be queried for the program.
+             */
+            void setParallelCompile(bool parallelCompile)
+            {
+                m_parallelCompile = parallelCompile;
+            }
+
+            bool isParallelCompile() const
+            {
+                return m_parallelCompile;
+            }
+
+            void addUniformBlock(const std::string &name, GLuint index, GLint dataSize)
+            {
+                m_uniformBlocks[name] = OpenGLPassUniformBlock{index, dataSize};
+            }
+
+            /**
+             * @brief Get the reflected uniform block with the given name.
+             * @param name Name of the block.
+             * @return The block, nullptr if the program does not declare it.
+             */
+            OpenGLPassUniformBlock *getUniformBlock(std::string_view name)
+            {
+                if (auto it = m_uniformBlocks.find(name); it != m_uniformBlocks.end())
+                {
+                    return &it->second;
+                }
+                return nullptr;
+            }
+
+            const std::unordered_map<std::string, OpenGLPassUniformBlock, collection_utils::StringHash, collection_utils::StringEqual> &getUniformBlocks() const
+            {
+                return m_uniformBlocks;
+            }
+
         private:
-            GLuint m_passID; // OpenGL pipeline ID
+            GLuint m_passID = 0; // OpenGL pipeline ID
+            std::shared_ptr<opengl::pipeline::cache::OpenGLProgramBinaryCache> m_programBinaryCache; ///< Cache of the linked program, if any.
+            bool m_parallelCompile = false; ///< Whether KHR_parallel_shader_compile is available for the program.
+            std::unordered_map<std::string, OpenGLPassUniformBlock, collection_utils::StringHash, collection_utils::StringEqual> m_uniformBlocks; ///< Reflected uniform blocks by name.
         };
     }
 }
\ No newline at end of file
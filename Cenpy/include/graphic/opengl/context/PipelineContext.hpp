@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <graphic/Api.hpp>
 #include <graphic/context/PipelineContext.hpp>
 
@@ -13,6 +14,12 @@ namespace cenpy::graphic
         class OpenGLPipelineUser;
         template <auto PROFILE>
         class OpenGLPipelineResetter;
+        template <auto PROFILE>
+        class OpenGLPipelineDrawer;
+    }
+    namespace opengl::pipeline::buffer
+    {
+        class OpenGLIndirectBuffer;
     }
     namespace opengl::context
     {
@@ -23,6 +30,25 @@ namespace cenpy::graphic
             using User = opengl::pipeline::component::pipeline::OpenGLPipelineUser<PROFILE>;
             template <auto PROFILE>
             using Resetter = opengl::pipeline::component::pipeline::OpenGLPipelineResetter<PROFILE>;
+            template <auto PROFILE>
+            using Drawer = opengl::pipeline::component::pipeline::OpenGLPipelineDrawer<PROFILE>;
+
+            /**
+             * @brief Set the buffers the indirect drawer packs the commands into.
+             * @param indirectBuffer Buffers of the pipeline, created by the first indirect draw if not set.
+             */
+            void setIndirectBuffer(std::shared_ptr<opengl::pipeline::buffer::OpenGLIndirectBuffer> indirectBuffer)
+            {
+                m_indirectBuffer = std::move(indirectBuffer);
+            }
+
+            [[nodiscard]] std::shared_ptr<opengl::pipeline::buffer::OpenGLIndirectBuffer> getIndirectBuffer() const
+            {
+                return m_indirectBuffer;
+            }
+
+        private:
+            std::shared_ptr<opengl::pipeline::buffer::OpenGLIndirectBuffer> m_indirectBuffer;
         };
     }
 }
\ No newline at end of file
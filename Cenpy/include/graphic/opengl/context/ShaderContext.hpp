@@ -2,6 +2,7 @@
 
 #pragma once
 #include <GL/glew.h>
+#include <memory>
 #include <graphic/Api.hpp>
 #include <graphic/context/ShaderContext.hpp>
 #include <common/exception/TraceableException.hpp>
@@ -14,10 +15,19 @@ namespace cenpy::graphic
         template <auto PROFILE>
         class OpenGLShaderLoader;
         template <auto PROFILE>
+        class OpenGLShaderCompiler;
+        template <auto PROFILE>
         class OpenGLShaderFreer;
         template <auto PROFILE>
         class OpenGLShaderReader;
+        template <auto PROFILE>
+        class OpenGLShaderPreprocessor;
     }
+    namespace opengl::pipeline::cache
+    {
+        class OpenGLShaderCache;
+    }
+
     namespace opengl::context
     {
         /**
@@ -34,9 +44,13 @@ namespace cenpy::graphic
             template <auto PROFILE>
             using Loader = opengl::pipeline::component::shader::OpenGLShaderLoader<PROFILE>;
             template <auto PROFILE>
+            using Compiler = opengl::pipeline::component::shader::OpenGLShaderCompiler<PROFILE>;
+            template <auto PROFILE>
             using Freer = opengl::pipeline::component::shader::OpenGLShaderFreer<PROFILE>;
             template <auto PROFILE>
             using Reader = opengl::pipeline::component::shader::OpenGLShaderReader<PROFILE>;
+            template <auto PROFILE>
+            using Preprocessor = opengl::pipeline::component::shader::OpenGLShaderPreprocessor<PROFILE>;
 
             void setShaderID(GLuint shaderID)
             {
@@ -48,6 +62,29 @@ namespace cenpy::graphic
                 return m_shaderID;
             }
 
+            /**
+             * @brief Set the cache the shader object is shared through.
+             * @param cache Shader cache, nullptr to compile a private shader object.
+             */
+            void setShaderCache(std::shared_ptr<opengl::pipeline::cache::OpenGLShaderCache> cache)
+            {
+                m_shaderCache = std::move(cache);
+            }
+
+            const std::shared_ptr<opengl::pipeline::cache::OpenGLShaderCache> &getShaderCache() const
+            {
+                return m_shaderCache;
+            }
+
+            /**
+             * @brief Shares the settings of another shader, e.g. the one a variant is created from.
+             * @param other Context to take the settings from.
+             */
+            void inheritSettings(const OpenGLShaderContext &other)
+            {
+                m_shaderCache = other.m_shaderCache;
+            }
+
             /**
              * @brief Converts the ShaderType enum to the corresponding OpenGL shader type.
              *
@@ -77,7 +114,8 @@ namespace cenpy::graphic
             }
 
         private:
-            GLuint m_shaderID; ///< OpenGL shader ID
+            GLuint m_shaderID = 0; ///< OpenGL shader ID
+            std::shared_ptr<opengl::pipeline::cache::OpenGLShaderCache> m_shaderCache; ///< Cache sharing the shader object, if any.
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+// UniformBlockContext.hpp
+
+#pragma once
+#include <GL/glew.h>
+#include <graphic/Api.hpp>
+#include <graphic/context/UniformBlockContext.hpp>
+
+namespace cenpy::graphic
+{
+    namespace opengl::pipeline::component::uniformblock
+    {
+        template <auto PROFILE>
+        class OpenGLUniformBlockLoader;
+        template <auto PROFILE>
+        class OpenGLUniformBlockUpdater;
+        template <auto PROFILE>
+        class OpenGLUniformBlockBinder;
+        template <auto PROFILE>
+        class OpenGLUniformBlockFreer;
+    }
+
+    namespace opengl::context
+    {
+        /**
+         * @class OpenGLUniformBlockContext
+         * @brief OpenGL-specific implementation of UniformBlockContext.
+         *
+         * Holds the uniform buffer object backing the block.
+         */
+        class OpenGLUniformBlockContext : public graphic::context::UniformBlockContext<graphic::api::OpenGL>
+        {
+        public:
+            template <auto PROFILE>
+            using Loader = opengl::pipeline::component::uniformblock::OpenGLUniformBlockLoader<PROFILE>;
+            template <auto PROFILE>
+            using Updater = opengl::pipeline::component::uniformblock::OpenGLUniformBlockUpdater<PROFILE>;
+            template <auto PROFILE>
+            using Binder = opengl::pipeline::component::uniformblock::OpenGLUniformBlockBinder<PROFILE>;
+            template <auto PROFILE>
+            using Freer = opengl::pipeline::component::uniformblock::OpenGLUniformBlockFreer<PROFILE>;
+
+            void setBufferID(GLuint bufferId)
+            {
+                m_bufferId = bufferId;
+            }
+
+            GLuint getBufferID() const
+            {
+                return m_bufferId;
+            }
+
+        private:
+            GLuint m_bufferId = 0; ///< OpenGL UBO buffer ID
+        };
+    }
+}
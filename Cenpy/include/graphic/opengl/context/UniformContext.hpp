@@ -21,6 +21,17 @@ namespace cenpy::graphic
             template <typename T>
             using Setter = opengl::pipeline::component::uniform::OpenGLUniformSetter<T>;
 
+            /**
+             * @brief Get the type tag of the values of a C++ type: the GL type of its setter.
+             * @tparam T Type of the value.
+             * @return The GL type, GL_INVALID_ENUM if no setter uploads it.
+             */
+            template <typename T>
+            static constexpr ValueType valueTypeOf()
+            {
+                return Setter<T>::glType;
+            }
+
             void setUniformID(GLuint uniformId)
             {
                 m_uniformId = uniformId;
@@ -51,10 +62,76 @@ namespace cenpy::graphic
                 return m_size;
             }
 
+        protected:
+            /**
+             * @brief Checks a value type against the reflected type of the uniform.
+             *
+             * Samplers and booleans are set through their integer counterparts, as glUniform1i does.
+             * If the uniform has not been reflected yet, any supported type is accepted.
+             *
+             * @param valueType GL type of the value to store.
+             * @return True if the value type matches the reflected type.
+             */
+            [[nodiscard]] bool isCompatible(ValueType valueType) const override
+            {
+                if (valueType == GL_INVALID_ENUM || valueType == GL_NONE)
+                {
+                    return false;
+                }
+                return m_type == GL_NONE || getSetterType(m_type) == valueType;
+            }
+
         private:
-            GLuint m_uniformId; ///< OpenGL shader ID
-            GLuint m_size;      ///< The size of the uniform variable.
-            GLenum m_type;      ///< The type of the uniform variable.
+            /**
+             * @brief Converts a reflected uniform type to the GL type of the setter that uploads it.
+             *
+             * @param type The reflected type of the uniform.
+             * @return The GL type expected from the value.
+             */
+            static GLenum getSetterType(GLenum type)
+            {
+                switch (type)
+                {
+                case GL_BOOL:
+                case GL_SAMPLER_1D:
+                case GL_SAMPLER_2D:
+                case GL_SAMPLER_3D:
+                case GL_SAMPLER_CUBE:
+                case GL_SAMPLER_1D_SHADOW:
+                case GL_SAMPLER_2D_SHADOW:
+                case GL_SAMPLER_1D_ARRAY:
+                case GL_SAMPLER_2D_ARRAY:
+                case GL_SAMPLER_1D_ARRAY_SHADOW:
+                case GL_SAMPLER_2D_ARRAY_SHADOW:
+                case GL_SAMPLER_2D_MULTISAMPLE:
+                case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+                case GL_SAMPLER_CUBE_SHADOW:
+                case GL_SAMPLER_BUFFER:
+                case GL_SAMPLER_2D_RECT:
+                case GL_SAMPLER_2D_RECT_SHADOW:
+                case GL_INT_SAMPLER_2D:
+                case GL_INT_SAMPLER_3D:
+                case GL_INT_SAMPLER_CUBE:
+                case GL_INT_SAMPLER_2D_ARRAY:
+                case GL_UNSIGNED_INT_SAMPLER_2D:
+                case GL_UNSIGNED_INT_SAMPLER_3D:
+                case GL_UNSIGNED_INT_SAMPLER_CUBE:
+                case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+                    return GL_INT;
+                case GL_BOOL_VEC2:
+                    return GL_INT_VEC2;
+                case GL_BOOL_VEC3:
+                    return GL_INT_VEC3;
+                case GL_BOOL_VEC4:
+                    return GL_INT_VEC4;
+                default:
+                    return type;
+                }
+            }
+
+            GLuint m_uniformId = 0; ///< OpenGL shader ID
+            GLuint m_size = 0;      ///< The size of the uniform variable.
+            GLenum m_type = GL_NONE; ///< The type of the uniform variable.
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,312 @@
+// file: SpriteBatch.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/pipeline/vertex/VertexLayout.hpp>
+#include <graphic/render/RenderQueue.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::batch
+{
+    /**
+     * @struct Sprite
+     * @brief A textured quad, as the game logic describes it.
+     */
+    struct Sprite
+    {
+        std::array<float, 2> position{0.0f, 0.0f};            ///< Position of the bottom left corner.
+        std::array<float, 2> size{1.0f, 1.0f};                ///< Width and height.
+        std::array<float, 4> uvRect{0.0f, 0.0f, 1.0f, 1.0f};  ///< Texture coordinates of the bottom left and top right corners.
+        std::array<std::uint8_t, 4> tint{255, 255, 255, 255}; ///< RGBA color the texture is multiplied by.
+        std::uint32_t layer = 0;                              ///< Layer, drawn in increasing order, up to RenderQueue::MAX_LAYER.
+        int pass = 0;                                         ///< Pass of the pipeline drawing the sprite.
+        GLuint texture = 0;                                   ///< Texture of the sprite, 0 for none.
+    };
+
+    /**
+     * @struct SpriteInstance
+     * @brief Per-sprite attributes, as the vertex shader reads them.
+     */
+    struct SpriteInstance
+    {
+        std::array<float, 2> position;     ///< instancePosition, location 1.
+        std::array<float, 2> size;         ///< instanceSize, location 2.
+        std::array<float, 4> uvRect;       ///< instanceUV, location 3.
+        std::array<std::uint8_t, 4> tint;  ///< instanceTint, location 4, normalized.
+        float layer;                       ///< instanceLayer, location 5.
+    };
+    static_assert(sizeof(SpriteInstance) == 40, "SpriteInstance must match the instance layout of OpenGLSpriteBatch");
+
+    /**
+     * @class OpenGLSpriteBatch
+     * @brief Draws sprites as instances of a shared unit quad, one draw per layer, pass and texture.
+     *
+     * The quad, its indices and the instance buffer are created once. Each frame, the sprites are
+     * sorted by layer, pass and texture, their attributes are streamed into the instance buffer in
+     * that order, and each run of sprites sharing a layer, pass and texture is pushed to the
+     * render queue as a single instanced command. Within a run, the sprites keep the order they
+     * were added in.
+     *
+     * The vertex shader reads the corner of the quad, in [0, 1], at location 0 as "corner", and
+     * the SpriteInstance attributes at locations 1 to 5.
+     *
+     * With GL_ARB_base_instance (core since OpenGL 4.2), every run sources from one vertex array
+     * through its first instance. Without it, each run gets a vertex array whose instance
+     * attributes point at the run, re-pointed when the run moves in the buffer.
+     *
+     * Vertex arrays are not shared between GL contexts: use one batch per context.
+     */
+    class OpenGLSpriteBatch
+    {
+    public:
+        static constexpr GLuint CORNER_LOCATION = 0;   ///< Location of the corner of the quad.
+        static constexpr GLuint INSTANCE_LOCATION = 1; ///< Location of the first instance attribute.
+
+        OpenGLSpriteBatch() : m_baseInstance(glewIsSupported("GL_ARB_base_instance"))
+        {
+            m_instanceLayout.add("instancePosition", 2)
+                .add("instanceSize", 2)
+                .add("instanceUV", 4)
+                .add("instanceTint", 4, GL_UNSIGNED_BYTE, true)
+                .add("instanceLayer", 1);
+
+            constexpr std::array<GLfloat, 8> corners{0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f};
+            std::array<GLuint, 3> buffers{};
+            glGenBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+            m_quadBuffer = buffers[0];
+            m_indexBuffer = buffers[1];
+            m_instanceBuffer = buffers[2];
+
+            auto &state = cache::OpenGLStateCache::current();
+            state.bindBuffer(GL_ARRAY_BUFFER, m_quadBuffer);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners.data(), GL_STATIC_DRAW);
+            if (m_baseInstance)
+            {
+                m_vertexArrays.push_back(build());
+            }
+        }
+
+        OpenGLSpriteBatch(const OpenGLSpriteBatch &) = delete;
+        OpenGLSpriteBatch &operator=(const OpenGLSpriteBatch &) = delete;
+
+        ~OpenGLSpriteBatch()
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            for (const auto &vertexArray : m_vertexArrays)
+            {
+                glDeleteVertexArrays(1, &vertexArray.id);
+                state.forgetVertexArray(vertexArray.id);
+            }
+            std::array<GLuint, 3> buffers{m_quadBuffer, m_indexBuffer, m_instanceBuffer};
+            glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+            for (GLuint buffer : buffers)
+            {
+                state.forgetBuffer(buffer);
+            }
+        }
+
+        /**
+         * @brief Records a sprite for the next submit.
+         * @param sprite Sprite to draw.
+         * @throws TraceableException if the layer or the pass is out of range.
+         */
+        void add(const Sprite &sprite)
+        {
+            m_sprites.push_back({render::RenderQueue::makeKey(sprite.layer, sprite.pass, sprite.texture, 0.0f),
+                                 sprite.pass,
+                                 sprite.texture,
+                                 {sprite.position, sprite.size, sprite.uvRect, sprite.tint, static_cast<float>(sprite.layer)}});
+        }
+
+        /**
+         * @brief Streams the recorded sprites and pushes one command per layer, pass and texture.
+         * @param queue Queue the commands are pushed to.
+         */
+        void submit(render::RenderQueue &queue)
+        {
+            m_commands = 0;
+            if (m_sprites.empty())
+            {
+                return;
+            }
+            std::ranges::stable_sort(m_sprites, {}, &Entry::key);
+            m_instances.clear();
+            for (const auto &entry : m_sprites)
+            {
+                m_instances.push_back(entry.instance);
+            }
+            upload();
+
+            std::size_t run = 0;
+            for (std::size_t first = 0; first < m_sprites.size();)
+            {
+                std::size_t last = first + 1;
+                while (last < m_sprites.size() && m_sprites[last].key == m_sprites[first].key && m_sprites[last].texture == m_sprites[first].texture)
+                {
+                    ++last;
+                }
+                render::RenderCommand command;
+                command.key = m_sprites[first].key;
+                command.pass = m_sprites[first].pass;
+                command.texture = m_sprites[first].texture;
+                command.count = 6;
+                command.indexed = true;
+                command.instanceCount = static_cast<std::uint32_t>(last - first);
+                if (m_baseInstance)
+                {
+                    command.vertexArray = m_vertexArrays.front().id;
+                    command.firstInstance = static_cast<std::uint32_t>(first);
+                }
+                else
+                {
+                    command.vertexArray = pointAt(run, first);
+                }
+                queue.push(command);
+                ++m_commands;
+                ++run;
+                first = last;
+            }
+            m_sprites.clear();
+        }
+
+        /**
+         * @brief Get the number of sprites recorded since the last submit.
+         * @return Number of sprites.
+         */
+        [[nodiscard]] std::size_t size() const
+        {
+            return m_sprites.size();
+        }
+
+        /**
+         * @brief Get the number of commands the last submit pushed, i.e. its draw calls.
+         * @return Number of commands.
+         */
+        [[nodiscard]] std::size_t getCommandsCount() const
+        {
+            return m_commands;
+        }
+
+        [[nodiscard]] const vertex::OpenGLVertexLayout &getInstanceLayout() const
+        {
+            return m_instanceLayout;
+        }
+
+    private:
+        struct Entry
+        {
+            std::uint64_t key;       ///< Layer, pass and texture, see RenderQueue::makeKey.
+            int pass;                ///< Pass of the sprite.
+            GLuint texture;          ///< Texture of the sprite.
+            SpriteInstance instance; ///< Attributes of the sprite.
+        };
+
+        struct VertexArray
+        {
+            GLuint id;          ///< Vertex array object.
+            std::size_t first;  ///< First instance its instance attributes point at.
+        };
+
+        /**
+         * @brief Copies the instances into the instance buffer, orphaning its previous storage.
+         */
+        void upload()
+        {
+            const auto bytes = static_cast<GLsizeiptr>(m_instances.size() * sizeof(SpriteInstance));
+            cache::OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+            if (bytes > m_capacity)
+            {
+                m_capacity = std::max(bytes, m_capacity * 2);
+            }
+            glBufferData(GL_ARRAY_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_instances.data());
+        }
+
+        /**
+         * @brief Creates a vertex array sourcing the quad and the instances from the first one.
+         * @return The vertex array.
+         */
+        VertexArray build()
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            GLuint id = 0;
+            glGenVertexArrays(1, &id);
+            state.bindVertexArray(id);
+            state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+            if (!m_indicesUploaded)
+            {
+                constexpr std::array<GLuint, 6> indices{0, 1, 2, 2, 3, 0};
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices.data(), GL_STATIC_DRAW);
+                m_indicesUploaded = true;
+            }
+            state.bindBuffer(GL_ARRAY_BUFFER, m_quadBuffer);
+            glEnableVertexAttribArray(CORNER_LOCATION);
+            glVertexAttribPointer(CORNER_LOCATION, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+            for (const auto &element : m_instanceLayout.getElements())
+            {
+                glEnableVertexAttribArray(INSTANCE_LOCATION + element.location);
+                glVertexAttribDivisor(INSTANCE_LOCATION + element.location, 1);
+            }
+            VertexArray vertexArray{id, 0};
+            point(vertexArray);
+            return vertexArray;
+        }
+
+        /**
+         * @brief Get the vertex array of a run, when base instances are not supported.
+         * @param run Index of the run in the frame.
+         * @param first First instance of the run.
+         * @return The vertex array, its instance attributes pointing at the run.
+         */
+        GLuint pointAt(std::size_t run, std::size_t first)
+        {
+            if (run == m_vertexArrays.size())
+            {
+                m_vertexArrays.push_back(build());
+            }
+            VertexArray &vertexArray = m_vertexArrays[run];
+            if (vertexArray.first != first)
+            {
+                vertexArray.first = first;
+                cache::OpenGLStateCache::current().bindVertexArray(vertexArray.id);
+                point(vertexArray);
+            }
+            return vertexArray.id;
+        }
+
+        /**
+         * @brief Points the instance attributes of the bound vertex array at its first instance.
+         * @param vertexArray Bound vertex array.
+         */
+        void point(const VertexArray &vertexArray) const
+        {
+            cache::OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+            const std::size_t base = vertexArray.first * sizeof(SpriteInstance);
+            for (const auto &element : m_instanceLayout.getElements())
+            {
+                glVertexAttribPointer(INSTANCE_LOCATION + element.location, element.components, element.componentType,
+                                      element.normalized ? GL_TRUE : GL_FALSE, m_instanceLayout.getStride(),
+                                      reinterpret_cast<const void *>(static_cast<std::uintptr_t>(base + element.offset)));
+            }
+        }
+
+        bool m_baseInstance;                          ///< Whether GL_ARB_base_instance is supported.
+        vertex::OpenGLVertexLayout m_instanceLayout;  ///< Layout of SpriteInstance.
+        GLuint m_quadBuffer = 0;                      ///< Corners of the unit quad.
+        GLuint m_indexBuffer = 0;                     ///< Indices of the two triangles of the quad.
+        GLuint m_instanceBuffer = 0;                  ///< Attributes of the sprites of the frame.
+        GLsizeiptr m_capacity = 0;                    ///< Bytes allocated for the instance buffer.
+        bool m_indicesUploaded = false;               ///< Whether the index buffer was filled.
+        std::vector<VertexArray> m_vertexArrays;      ///< The vertex array, or one per run without base instances.
+        std::vector<Entry> m_sprites;                 ///< Sprites recorded since the last submit.
+        std::vector<SpriteInstance> m_instances;      ///< Attributes of the sorted sprites, as uploaded.
+        std::size_t m_commands = 0;                   ///< Commands pushed by the last submit.
+    };
+}
@@ -0,0 +1,221 @@
+// file: IndirectBuffer.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/render/RenderQueue.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::buffer
+{
+    /**
+     * @struct DrawRecord
+     * @brief Per-draw data of an indirect draw, as the shaders read it from the draw data buffer.
+     *
+     * The shaders declare the std430 buffer
+     * @code
+     * struct DrawRecord { uint data; uint firstInstance; uint instanceCount; int baseVertex; };
+     * layout(std430, binding = 0) readonly buffer DrawData { DrawRecord draws[]; };
+     * @endcode
+     * and read draws[gl_DrawID] (GL_ARB_shader_draw_parameters).
+     */
+    struct DrawRecord
+    {
+        std::uint32_t data;          ///< RenderCommand::drawData.
+        std::uint32_t firstInstance; ///< First instance of the draw.
+        std::uint32_t instanceCount; ///< Number of instances of the draw.
+        std::int32_t baseVertex;     ///< Base vertex of the draw.
+    };
+
+    /**
+     * @class OpenGLIndirectBuffer
+     * @brief Packs render commands into a draw indirect buffer and their per-draw data into a
+     * shader storage buffer, to submit them with one multi-draw per batch.
+     *
+     * Consecutive commands sharing a vertex array, a texture, a primitive and whether they are
+     * indexed form a batch. The commands of a frame are written at once, each buffer is orphaned
+     * and filled by one call. Before drawing a batch, bindRecords() binds its per-draw records to
+     * the draw data binding point, so gl_DrawID, which restarts at 0 with each multi-draw, indexes
+     * them directly.
+     *
+     * Requires GL_ARB_multi_draw_indirect and GL_ARB_shader_storage_buffer_object, core since
+     * OpenGL 4.3, and GL_ARB_shader_draw_parameters, core since OpenGL 4.6, for gl_DrawID.
+     */
+    class OpenGLIndirectBuffer
+    {
+    public:
+        static constexpr GLuint DRAW_DATA_BINDING = 0; ///< Default binding point of the draw data buffer.
+
+        /**
+         * @struct Batch
+         * @brief Commands drawn by a single multi-draw.
+         */
+        struct Batch
+        {
+            const render::RenderCommand *command; ///< First command, holding the shared state.
+            GLsizei drawCount;                    ///< Number of commands.
+            GLintptr indirectOffset;              ///< Offset of the first draw in the draw indirect buffer.
+            GLintptr recordsOffset;               ///< Offset of the first record in the draw data buffer.
+        };
+
+        /**
+         * @brief Creates the buffers.
+         * @param binding Binding point of the draw data buffer in the shaders.
+         * @throws TraceableException if multi-draw indirect, shader storage buffers or gl_DrawID are not supported.
+         */
+        explicit OpenGLIndirectBuffer(GLuint binding = DRAW_DATA_BINDING) : m_binding(binding)
+        {
+            if (!glewIsSupported("GL_ARB_multi_draw_indirect") || !glewIsSupported("GL_ARB_shader_storage_buffer_object"))
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::BUFFER::INDIRECT_NOT_SUPPORTED");
+            }
+            if (!glewIsSupported("GL_ARB_shader_draw_parameters") && !glewIsSupported("GL_VERSION_4_6"))
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::BUFFER::DRAW_PARAMETERS_NOT_SUPPORTED");
+            }
+            GLint alignment = 0;
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            m_recordsAlignment = std::max<std::size_t>(1, static_cast<std::size_t>(alignment) / sizeof(DrawRecord));
+            std::array<GLuint, 2> buffers{};
+            glGenBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+            m_indirectBuffer = buffers[0];
+            m_recordsBuffer = buffers[1];
+        }
+
+        OpenGLIndirectBuffer(const OpenGLIndirectBuffer &) = delete;
+        OpenGLIndirectBuffer &operator=(const OpenGLIndirectBuffer &) = delete;
+
+        ~OpenGLIndirectBuffer()
+        {
+            std::array<GLuint, 2> buffers{m_indirectBuffer, m_recordsBuffer};
+            glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+            for (GLuint buffer : buffers)
+            {
+                cache::OpenGLStateCache::current().forgetBuffer(buffer);
+            }
+        }
+
+        /**
+         * @brief Writes the draws and the records of commands, replacing the previous ones.
+         *
+         * The draw indirect buffer is left bound, the multi-draws source from it.
+         *
+         * @param commands Commands to draw, which must outlive the batches.
+         * @return The batches, in command order.
+         */
+        const std::vector<Batch> &write(std::span<const render::RenderCommand> commands)
+        {
+            m_batches.clear();
+            m_draws.clear();
+            m_records.clear();
+            for (std::size_t first = 0; first < commands.size();)
+            {
+                std::size_t last = first + 1;
+                while (last < commands.size() && sharesBatch(commands[first], commands[last]))
+                {
+                    ++last;
+                }
+                // gl_DrawID restarts with each batch: its records start at an aligned offset.
+                m_records.resize((m_records.size() + m_recordsAlignment - 1) / m_recordsAlignment * m_recordsAlignment);
+                m_batches.push_back({&commands[first], static_cast<GLsizei>(last - first),
+                                     static_cast<GLintptr>(m_draws.size() * sizeof(GLuint)),
+                                     static_cast<GLintptr>(m_records.size() * sizeof(DrawRecord))});
+                for (const auto &command : commands.subspan(first, last - first))
+                {
+                    append(command);
+                }
+                first = last;
+            }
+            upload(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer, m_indirectCapacity, std::as_bytes(std::span(m_draws)));
+            upload(GL_SHADER_STORAGE_BUFFER, m_recordsBuffer, m_recordsCapacity, std::as_bytes(std::span(m_records)));
+            return m_batches;
+        }
+
+        /**
+         * @brief Binds the records of a batch to the draw data binding point.
+         * @param batch Batch about to be drawn.
+         */
+        void bindRecords(const Batch &batch) const
+        {
+            cache::OpenGLStateCache::current().bindBufferRange(GL_SHADER_STORAGE_BUFFER, m_binding, m_recordsBuffer, batch.recordsOffset,
+                                                               static_cast<GLsizeiptr>(batch.drawCount * sizeof(DrawRecord)));
+        }
+
+        [[nodiscard]] const std::vector<Batch> &getBatches() const
+        {
+            return m_batches;
+        }
+
+        [[nodiscard]] GLuint getIndirectBufferID() const
+        {
+            return m_indirectBuffer;
+        }
+
+        [[nodiscard]] GLuint getRecordsBufferID() const
+        {
+            return m_recordsBuffer;
+        }
+
+    private:
+        static bool sharesBatch(const render::RenderCommand &first, const render::RenderCommand &command)
+        {
+            return command.vertexArray == first.vertexArray && command.texture == first.texture &&
+                   command.primitive == first.primitive && command.indexed == first.indexed;
+        }
+
+        /**
+         * @brief Appends the draw and the record of a command.
+         *
+         * Indexed draws follow the layout of DrawElementsIndirectCommand, the others the one of
+         * DrawArraysIndirectCommand.
+         *
+         * @param command Command to append.
+         */
+        void append(const render::RenderCommand &command)
+        {
+            if (command.indexed)
+            {
+                m_draws.insert(m_draws.end(), {command.count, command.instanceCount, command.first,
+                                               static_cast<GLuint>(command.baseVertex), command.firstInstance});
+            }
+            else
+            {
+                m_draws.insert(m_draws.end(), {command.count, command.instanceCount, command.first, command.firstInstance});
+            }
+            m_records.push_back({command.drawData, command.firstInstance, command.instanceCount, command.baseVertex});
+        }
+
+        /**
+         * @brief Fills a buffer, orphaning its previous storage.
+         * @param target Target to bind the buffer to.
+         * @param buffer Buffer to fill.
+         * @param capacity Bytes allocated for the buffer, grown if needed.
+         * @param bytes Data to copy.
+         */
+        static void upload(GLenum target, GLuint buffer, GLsizeiptr &capacity, std::span<const std::byte> bytes)
+        {
+            const auto size = static_cast<GLsizeiptr>(bytes.size());
+            cache::OpenGLStateCache::current().bindBuffer(target, buffer);
+            capacity = size > capacity ? std::max(size, capacity * 2) : capacity;
+            glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(target, 0, size, bytes.data());
+        }
+
+        GLuint m_binding;                     ///< Binding point of the draw data buffer.
+        std::size_t m_recordsAlignment = 1;   ///< Records between two offsets the draw data buffer can be bound at.
+        GLuint m_indirectBuffer = 0;          ///< Draw indirect buffer.
+        GLuint m_recordsBuffer = 0;           ///< Draw data buffer.
+        GLsizeiptr m_indirectCapacity = 0;    ///< Bytes allocated for the draw indirect buffer.
+        GLsizeiptr m_recordsCapacity = 0;     ///< Bytes allocated for the draw data buffer.
+        std::vector<GLuint> m_draws;          ///< Draw indirect commands, packed.
+        std::vector<DrawRecord> m_records;    ///< Per-draw records, each batch starting aligned.
+        std::vector<Batch> m_batches;         ///< Batches of the last write.
+    };
+}
@@ -0,0 +1,219 @@
+// file: StreamingRing.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <span>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::buffer
+{
+    /**
+     * @class OpenGLStreamingRing
+     * @brief Persistently mapped buffer the CPU writes per-frame vertices into while the GPU reads
+     * the previous frames.
+     *
+     * The buffer is split into SEGMENTS segments, one per frame in flight. A frame writes into its
+     * own segment, then endFrame() fences it; beginFrame() moves to the next segment, waiting for
+     * its fence only if the GPU is still reading it, which with three segments happens when the
+     * CPU runs more than two frames ahead. The writes need neither a buffer call nor a flush: the
+     * mapping is coherent.
+     *
+     * Requires GL_ARB_buffer_storage (core since OpenGL 4.4). Without it, stream the vertices
+     * through the attribute setter, which orphans the buffer of dynamic attributes.
+     */
+    class OpenGLStreamingRing
+    {
+    public:
+        static constexpr std::size_t SEGMENTS = 3;
+
+        /**
+         * @struct Allocation
+         * @brief Range of the current segment reserved for a write.
+         */
+        struct Allocation
+        {
+            std::byte *data;  ///< Mapped memory to write to.
+            GLintptr offset;  ///< Offset of the range in the buffer, to source the vertices from.
+        };
+
+        /**
+         * @brief Creates and maps the buffer.
+         * @param target Target the buffer is bound to, e.g. GL_ARRAY_BUFFER.
+         * @param segmentSize Bytes a frame can write.
+         * @throws TraceableException if buffer storage is not supported or the buffer cannot be mapped.
+         */
+        OpenGLStreamingRing(GLenum target, std::size_t segmentSize) : m_target(target), m_segmentSize(segmentSize)
+        {
+            if (!glewIsSupported("GL_ARB_buffer_storage"))
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::BUFFER::STORAGE_NOT_SUPPORTED");
+            }
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            const auto size = static_cast<GLsizeiptr>(m_segmentSize * SEGMENTS);
+            glGenBuffers(1, &m_bufferID);
+            cache::OpenGLStateCache::current().bindBuffer(m_target, m_bufferID);
+            glBufferStorage(m_target, size, nullptr, flags);
+            m_mapped = static_cast<std::byte *>(glMapBufferRange(m_target, 0, size, flags));
+            if (m_mapped == nullptr)
+            {
+                release();
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::BUFFER::MAP_FAILED\n{} bytes", size));
+            }
+        }
+
+        OpenGLStreamingRing(const OpenGLStreamingRing &) = delete;
+        OpenGLStreamingRing &operator=(const OpenGLStreamingRing &) = delete;
+
+        ~OpenGLStreamingRing()
+        {
+            release();
+        }
+
+        /**
+         * @brief Moves to the next segment, waiting for the GPU to be done reading it.
+         * @throws TraceableException if waiting for the GPU fails.
+         */
+        void beginFrame()
+        {
+            m_segment = (m_segment + 1) % SEGMENTS;
+            m_head = 0;
+            GLsync &fence = m_fences[m_segment];
+            if (fence == nullptr)
+            {
+                return;
+            }
+            GLenum status = glClientWaitSync(fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED)
+            {
+                ++m_stalls;
+                do
+                {
+                    status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+                } while (status == GL_TIMEOUT_EXPIRED);
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+            if (status == GL_WAIT_FAILED)
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::BUFFER::FENCE_WAIT_FAILED");
+            }
+        }
+
+        /**
+         * @brief Fences the segment of the frame, once its draws are submitted.
+         *
+         * Ending the frame again replaces its fence, the new one also covering the earlier draws.
+         */
+        void endFrame()
+        {
+            GLsync &fence = m_fences[m_segment];
+            if (fence != nullptr)
+            {
+                glDeleteSync(fence);
+            }
+            fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        /**
+         * @brief Reserves a range of the current segment.
+         * @param bytes Size of the range.
+         * @param alignment Alignment of the offset of the range, a power of two.
+         * @return The reserved range.
+         * @throws TraceableException if the segment has not enough room left.
+         */
+        Allocation allocate(std::size_t bytes, std::size_t alignment = 4)
+        {
+            const std::size_t start = (m_head + alignment - 1) & ~(alignment - 1);
+            if (start + bytes > m_segmentSize)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::BUFFER::RING_SEGMENT_OVERFLOW\n{} bytes requested, {} left", bytes, m_segmentSize - std::min(start, m_segmentSize)));
+            }
+            m_head = start + bytes;
+            const std::size_t offset = m_segment * m_segmentSize + start;
+            return {m_mapped + offset, static_cast<GLintptr>(offset)};
+        }
+
+        /**
+         * @brief Copies values into the current segment.
+         * @param values Values to copy.
+         * @return Offset of the values in the buffer.
+         * @throws TraceableException if the segment has not enough room left.
+         */
+        template <typename T>
+        GLintptr write(std::span<const T> values)
+        {
+            return write(std::as_bytes(values), std::max<std::size_t>(alignof(T), 4));
+        }
+
+        GLintptr write(std::span<const std::byte> bytes, std::size_t alignment = 4)
+        {
+            Allocation allocation = allocate(bytes.size(), alignment);
+            std::memcpy(allocation.data, bytes.data(), bytes.size());
+            return allocation.offset;
+        }
+
+        [[nodiscard]] GLuint getBufferID() const
+        {
+            return m_bufferID;
+        }
+
+        [[nodiscard]] GLenum getTarget() const
+        {
+            return m_target;
+        }
+
+        [[nodiscard]] std::size_t getSegmentSize() const
+        {
+            return m_segmentSize;
+        }
+
+        /**
+         * @brief Get the number of frames that had to wait for the GPU to release their segment.
+         * @return Number of stalls.
+         */
+        [[nodiscard]] std::size_t getStalls() const
+        {
+            return m_stalls;
+        }
+
+    private:
+        static constexpr GLuint64 WAIT_TIMEOUT = 1'000'000; ///< Nanoseconds of each wait for a fence.
+
+        void release()
+        {
+            for (GLsync &fence : m_fences)
+            {
+                if (fence != nullptr)
+                {
+                    glDeleteSync(fence);
+                    fence = nullptr;
+                }
+            }
+            if (m_bufferID != 0)
+            {
+                // Deleting the buffer unmaps it.
+                glDeleteBuffers(1, &m_bufferID);
+                cache::OpenGLStateCache::current().forgetBuffer(m_bufferID);
+                m_bufferID = 0;
+            }
+            m_mapped = nullptr;
+        }
+
+        GLenum m_target;                          ///< Target the buffer is bound to.
+        std::size_t m_segmentSize;                ///< Bytes of each segment.
+        GLuint m_bufferID = 0;                    ///< OpenGL buffer ID.
+        std::byte *m_mapped = nullptr;            ///< Persistent mapping of the whole buffer.
+        std::array<GLsync, SEGMENTS> m_fences{};  ///< Fence of the last frame written in each segment.
+        std::size_t m_segment = 0;                ///< Segment of the current frame.
+        std::size_t m_head = 0;                   ///< Bytes used in the current segment.
+        std::size_t m_stalls = 0;                 ///< Frames that waited for the GPU.
+    };
+}
@@ -0,0 +1,110 @@
+// file: FusedPassCache.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <graphic/context/ShaderContext.hpp>
+#include <graphic/pipeline/Pass.hpp>
+#include <graphic/pipeline/Shader.hpp>
+#include <graphic/render/PassFusion.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::cache
+{
+    /**
+     * @class OpenGLFusedPassCache
+     * @brief Keeps the passes generated for the chains of point-wise stages.
+     *
+     * A chain is looked up by its generated fragment shader, so graphs fusing the same stages in
+     * the same order, or a graph compiled again after a resize, share one program instead of
+     * compiling it again. The passes live as long as the cache.
+     *
+     * @tparam API Graphic API of the passes.
+     */
+    template <typename API>
+    class OpenGLFusedPassCache
+    {
+    public:
+        /// Creates a pass, not loaded yet, from the vertex and fragment shader sources.
+        using Factory = std::function<std::shared_ptr<graphic::pipeline::IPass<API>>(std::string_view, const std::string &)>;
+
+        /**
+         * @brief Creates an empty cache.
+         * @param factory Creates the passes, see makeFactory.
+         */
+        explicit OpenGLFusedPassCache(Factory factory) : m_factory(std::move(factory))
+        {
+        }
+
+        /**
+         * @brief Makes a factory compiling the generated sources with the given profiles.
+         * @tparam PASS_PROFILE Profile of the passes.
+         * @tparam SHADER_PROFILE Profile of their shaders.
+         * @return The factory.
+         */
+        template <auto PASS_PROFILE, auto SHADER_PROFILE>
+        [[nodiscard]] static Factory makeFactory()
+        {
+            return [](std::string_view vertexCode, const std::string &fragmentCode)
+            {
+                // The sources are set up front, so the shaders are never read from their path: it
+                // only tells the fused programs apart in the shader and binary caches.
+                const std::string path = std::format("fused/{:016x}", std::hash<std::string>{}(fragmentCode));
+                auto vertex = std::make_shared<graphic::pipeline::Shader<API, SHADER_PROFILE>>(path + ".vert", graphic::context::ShaderType::VERTEX);
+                vertex->getContext()->setShaderCode(std::string(vertexCode));
+                auto fragment = std::make_shared<graphic::pipeline::Shader<API, SHADER_PROFILE>>(path + ".frag", graphic::context::ShaderType::FRAGMENT);
+                fragment->getContext()->setShaderCode(fragmentCode);
+                return std::make_shared<graphic::pipeline::Pass<API, PASS_PROFILE>>(std::initializer_list<std::shared_ptr<graphic::pipeline::IShader<API>>>{vertex, fragment});
+            };
+        }
+
+        /**
+         * @brief Get the pass executing a chain of stages, generating and loading it on first use.
+         * @param stages Stages of the chain, in order.
+         * @return The loaded pass.
+         * @throws std::runtime_error if the chain cannot be generated, or its pass fails to compile or link.
+         */
+        std::shared_ptr<graphic::pipeline::IPass<API>> acquire(const std::vector<render::FusedStage> &stages)
+        {
+            std::string code = render::PassFusion::generate(stages);
+            if (auto it = m_passes.find(code); it != m_passes.end())
+            {
+                ++m_hits;
+                return it->second;
+            }
+            ++m_misses;
+            auto pass = m_factory(render::PassFusion::getVertexShader(), code);
+            pass->load();
+            m_passes.emplace(std::move(code), pass);
+            return pass;
+        }
+
+        [[nodiscard]] std::size_t getSize() const
+        {
+            return m_passes.size();
+        }
+
+        [[nodiscard]] std::size_t getHits() const
+        {
+            return m_hits;
+        }
+
+        [[nodiscard]] std::size_t getMisses() const
+        {
+            return m_misses;
+        }
+
+    private:
+        Factory m_factory;                                                                        ///< Creates the passes.
+        std::unordered_map<std::string, std::shared_ptr<graphic::pipeline::IPass<API>>> m_passes; ///< Passes by fragment shader source.
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+    };
+}
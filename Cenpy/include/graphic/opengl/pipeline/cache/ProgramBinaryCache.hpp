@@ -0,0 +1,211 @@
+// file: ProgramBinaryCache.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <cstddef>
+#include <format>
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::cache
+{
+    /**
+     * @class OpenGLProgramBinaryCache
+     * @brief On-disk cache of linked program binaries, to skip compiling and linking on later runs.
+     *
+     * There is one entry per pass, named after the types, paths and variant macros of its shaders,
+     * so the variants of a pass do not overwrite each other. An entry stores
+     * the binary returned by glGetProgramBinary along with a hash of the shader sources, their types
+     * and the driver vendor, renderer and version strings. An entry whose hash no longer matches is
+     * a miss and is overwritten by the next store, so editing a shader or updating the driver
+     * invalidates it without leaving stale files behind.
+     */
+    class OpenGLProgramBinaryCache
+    {
+    public:
+        explicit OpenGLProgramBinaryCache(std::filesystem::path directory) : m_directory(std::move(directory))
+        {
+        }
+
+        [[nodiscard]] const std::filesystem::path &getDirectory() const
+        {
+            return m_directory;
+        }
+
+        /**
+         * @brief Creates the program of the pass from its cached binary.
+         *
+         * The shader sources must have been read, but need not be compiled.
+         *
+         * @param context Context of the pass, receives the program ID on a hit.
+         * @return True if the program was created from the cache, false if it must be compiled.
+         */
+        bool load(graphic::api::OpenGL::PassContext &context)
+        {
+            std::ifstream file(entryPath(context), std::ios::binary);
+            EntryHeader header{};
+            if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != MAGIC || header.sourceHash != sourceHash(context))
+            {
+                ++m_misses;
+                return false;
+            }
+            std::vector<char> binary(header.length);
+            if (!file.read(binary.data(), binary.size()))
+            {
+                ++m_misses;
+                return false;
+            }
+
+            GLuint passID = glCreateProgram();
+            glProgramBinary(passID, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+            GLint isLinked = GL_FALSE;
+            glGetProgramiv(passID, GL_LINK_STATUS, &isLinked);
+            if (isLinked == GL_FALSE)
+            {
+                // The driver is free to reject a binary it produced, e.g. after an update.
+                glDeleteProgram(passID);
+                ++m_misses;
+                return false;
+            }
+            context.setPassID(passID);
+            ++m_hits;
+            return true;
+        }
+
+        /**
+         * @brief Stores the binary of the linked program of the pass.
+         *
+         * Failing to write the cache is not an error: the program is simply compiled again on the next run.
+         *
+         * @param context Context of the pass, with a linked program.
+         */
+        void store(const graphic::api::OpenGL::PassContext &context)
+        {
+            GLuint passID = context.getPassID();
+            GLint length = 0;
+            glGetProgramiv(passID, GL_PROGRAM_BINARY_LENGTH, &length);
+            if (length <= 0)
+            {
+                return;
+            }
+            std::vector<char> binary(length);
+            GLenum format = 0;
+            glGetProgramBinary(passID, length, &length, &format, binary.data());
+
+            EntryHeader header{MAGIC, format, sourceHash(context), static_cast<std::uint64_t>(length)};
+            std::error_code error;
+            std::filesystem::create_directories(m_directory, error);
+            // Write aside and rename, so a concurrent run never reads a partial entry.
+            const std::filesystem::path path = entryPath(context);
+            std::filesystem::path temporary = path;
+            temporary += ".tmp";
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                file.write(binary.data(), length);
+                if (!file)
+                {
+                    return;
+                }
+            }
+            std::filesystem::rename(temporary, path, error);
+            if (!error)
+            {
+                ++m_stores;
+            }
+        }
+
+        [[nodiscard]] std::size_t getHits() const
+        {
+            return m_hits;
+        }
+
+        [[nodiscard]] std::size_t getMisses() const
+        {
+            return m_misses;
+        }
+
+        [[nodiscard]] std::size_t getStores() const
+        {
+            return m_stores;
+        }
+
+    private:
+        static constexpr std::uint32_t MAGIC = 0x31425043; ///< "CPB1", guards against foreign or truncated files.
+
+        struct EntryHeader
+        {
+            std::uint32_t magic;
+            std::uint32_t format;     ///< Binary format returned by glGetProgramBinary.
+            std::uint64_t sourceHash; ///< Hash of the sources, their types and the driver.
+            std::uint64_t length;     ///< Size of the binary following the header.
+        };
+
+        static constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+        static constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+        static std::uint64_t hash(std::uint64_t seed, std::string_view bytes)
+        {
+            for (unsigned char byte : bytes)
+            {
+                seed = (seed ^ byte) * FNV_PRIME;
+            }
+            // Separate the fields, so "ab"+"c" and "a"+"bc" do not collide.
+            return (seed ^ 0xff) * FNV_PRIME;
+        }
+
+        static std::uint64_t hash(std::uint64_t seed, GLenum value)
+        {
+            return hash(seed, std::string_view(reinterpret_cast<const char *>(&value), sizeof(value)));
+        }
+
+        static std::string_view driverString(GLenum name)
+        {
+            const auto *value = reinterpret_cast<const char *>(glGetString(name));
+            return value ? std::string_view(value) : std::string_view();
+        }
+
+        static std::uint64_t sourceHash(const graphic::api::OpenGL::PassContext &context)
+        {
+            std::uint64_t seed = FNV_OFFSET_BASIS;
+            seed = hash(seed, driverString(GL_VENDOR));
+            seed = hash(seed, driverString(GL_RENDERER));
+            seed = hash(seed, driverString(GL_VERSION));
+            for (const auto &shader : context.getShaders())
+            {
+                seed = hash(seed, shader->getContext()->getGLShaderType());
+                seed = hash(seed, shader->getContext()->getShaderCode());
+            }
+            return seed;
+        }
+
+        std::filesystem::path entryPath(const graphic::api::OpenGL::PassContext &context) const
+        {
+            std::uint64_t seed = FNV_OFFSET_BASIS;
+            for (const auto &shader : context.getShaders())
+            {
+                const auto &shaderContext = shader->getContext();
+                seed = hash(seed, shaderContext->getGLShaderType());
+                seed = hash(seed, shaderContext->getShaderPath().empty() ? shaderContext->getShaderCode() : std::string_view(shaderContext->getShaderPath()));
+                for (const auto &define : shaderContext->getDefines())
+                {
+                    seed = hash(seed, define);
+                }
+            }
+            return m_directory / std::format("{:016x}.bin", seed);
+        }
+
+        std::filesystem::path m_directory; ///< Directory holding the entries.
+        std::size_t m_hits = 0;            ///< Programs created from the cache.
+        std::size_t m_misses = 0;          ///< Programs that had to be compiled.
+        std::size_t m_stores = 0;          ///< Entries written.
+    };
+}
@@ -0,0 +1,139 @@
+// file: ShaderCache.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::cache
+{
+    /**
+     * @class OpenGLShaderCache
+     * @brief Shares compiled shader objects between the shaders with the same type, path and source.
+     *
+     * The first shader to be compiled creates the shader object, the next ones reuse its ID and take
+     * a reference on it. The object is deleted when the last reference is released, so passes
+     * sharing a shader keep it alive for each other. Shaders opt in by setting the cache on their
+     * context, usually the process-wide one returned by shared().
+     */
+    class OpenGLShaderCache
+    {
+    public:
+        /**
+         * @brief Get the cache shared by the whole process.
+         * @return The process-wide cache.
+         */
+        static const std::shared_ptr<OpenGLShaderCache> &shared()
+        {
+            static const auto instance = std::make_shared<OpenGLShaderCache>();
+            return instance;
+        }
+
+        /**
+         * @brief Takes a reference on the shader object compiled from the same source, if any.
+         * @param context Context of the shader, with its source read.
+         * @return The ID of the shared shader object, 0 if the shader must be compiled.
+         */
+        GLuint acquire(const graphic::api::OpenGL::ShaderContext &context)
+        {
+            auto it = m_shaderIDs.find(key(context));
+            if (it == m_shaderIDs.end() || m_entries.at(it->second).code != context.getShaderCode())
+            {
+                ++m_misses;
+                return 0;
+            }
+            ++m_entries.at(it->second).references;
+            ++m_hits;
+            return it->second;
+        }
+
+        /**
+         * @brief Shares a newly compiled shader object, the caller holding the first reference.
+         * @param context Context of the shader the object was compiled from.
+         * @param shaderID ID of the shader object.
+         */
+        void add(const graphic::api::OpenGL::ShaderContext &context, GLuint shaderID)
+        {
+            // Another shader with a hash collision keeps its slot, this one stays private.
+            if (auto [it, inserted] = m_shaderIDs.try_emplace(key(context), shaderID); inserted)
+            {
+                m_entries[shaderID] = Entry{it->first, std::string(context.getShaderCode()), 1};
+            }
+        }
+
+        /**
+         * @brief Drops a reference on a shader object, deleting it with its last reference.
+         *
+         * Objects that are not shared through the cache are deleted at once.
+         *
+         * @param shaderID ID of the shader object.
+         */
+        void release(GLuint shaderID)
+        {
+            auto it = m_entries.find(shaderID);
+            if (it == m_entries.end())
+            {
+                glDeleteShader(shaderID);
+                return;
+            }
+            if (--it->second.references == 0)
+            {
+                m_shaderIDs.erase(it->second.key);
+                m_entries.erase(it);
+                glDeleteShader(shaderID);
+            }
+        }
+
+        /**
+         * @brief Get the number of references held on a shader object.
+         * @param shaderID ID of the shader object.
+         * @return Number of shaders using the object, 0 if it is not shared through the cache.
+         */
+        [[nodiscard]] std::size_t getReferences(GLuint shaderID) const
+        {
+            auto it = m_entries.find(shaderID);
+            return it == m_entries.end() ? 0 : it->second.references;
+        }
+
+        [[nodiscard]] std::size_t getSize() const
+        {
+            return m_entries.size();
+        }
+
+        [[nodiscard]] std::size_t getHits() const
+        {
+            return m_hits;
+        }
+
+        [[nodiscard]] std::size_t getMisses() const
+        {
+            return m_misses;
+        }
+
+    private:
+        struct Entry
+        {
+            std::string key;        ///< Key of the object in m_shaderIDs.
+            std::string code;       ///< Source compiled into the object, to tell hash collisions apart.
+            std::size_t references; ///< Number of shaders using the object.
+        };
+
+        static std::string key(const graphic::api::OpenGL::ShaderContext &context)
+        {
+            return std::format("{}:{:016x}:{}", context.getGLShaderType(), std::hash<std::string_view>{}(context.getShaderCode()), context.getShaderPath());
+        }
+
+        std::unordered_map<std::string, GLuint> m_shaderIDs; ///< Shared objects by key.
+        std::unordered_map<GLuint, Entry> m_entries;         ///< Shared objects by ID.
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+    };
+}
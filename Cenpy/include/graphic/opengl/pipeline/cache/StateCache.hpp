@@ -0,0 +1,348 @@
+// file: StateCache.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace cenpy::graphic::opengl::pipeline::cache
+{
+    /**
+     * @class OpenGLStateCache
+     * @brief Shadows the GL bindings to skip the binds of objects that are already bound.
+     *
+     * The OpenGL components bind programs, buffers, vertex arrays, textures and framebuffers through the cache of the GL context current
+     * on the calling thread, returned by current(). A bind matching the shadowed binding is not
+     * issued and counted as skipped.
+     *
+     * The shadow is only right as long as every bind goes through the cache. Call invalidate()
+     * after making another GL context current on the thread, or after code outside the components
+     * changed the bindings: the next bind of each kind is then issued.
+     *
+     * Element array bindings belong to the vertex array object and are not shadowed.
+     */
+    class OpenGLStateCache
+    {
+    public:
+        OpenGLStateCache()
+        {
+            invalidate();
+        }
+
+        /**
+         * @brief Get the cache of the GL context current on the calling thread.
+         * @return The cache of the thread.
+         */
+        static OpenGLStateCache &current()
+        {
+            thread_local OpenGLStateCache instance;
+            return instance;
+        }
+
+        /**
+         * @brief Makes a program current, unless it already is.
+         * @param program Program to use, 0 for none.
+         * @return True if glUseProgram was called.
+         */
+        bool useProgram(GLuint program)
+        {
+            if (m_program == program)
+            {
+                ++m_skipped;
+                return false;
+            }
+            glUseProgram(program);
+            m_program = program;
+            ++m_issued;
+            return true;
+        }
+
+        /**
+         * @brief Binds a buffer to a target, unless it already is.
+         * @param target Target to bind the buffer to.
+         * @param buffer Buffer to bind, 0 for none.
+         * @return True if glBindBuffer was called.
+         */
+        bool bindBuffer(GLenum target, GLuint buffer)
+        {
+            GLuint *binding = bufferBinding(target);
+            if (binding && *binding == buffer)
+            {
+                ++m_skipped;
+                return false;
+            }
+            glBindBuffer(target, buffer);
+            if (binding)
+            {
+                *binding = buffer;
+            }
+            ++m_issued;
+            return true;
+        }
+
+        /**
+         * @brief Binds a buffer to an indexed binding point, unless it already is.
+         *
+         * As glBindBufferBase does, this also binds the buffer to the generic target.
+         *
+         * @param target Indexed target, e.g. GL_UNIFORM_BUFFER.
+         * @param index Binding point.
+         * @param buffer Buffer to bind.
+         * @return True if glBindBufferBase was called.
+         */
+        bool bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+        {
+            const std::uint64_t key = (std::uint64_t{target} << 32) | index;
+            if (auto it = m_indexedBindings.find(key); it != m_indexedBindings.end() && it->second == buffer)
+            {
+                ++m_skipped;
+                return false;
+            }
+            glBindBufferBase(target, index, buffer);
+            m_indexedBindings[key] = buffer;
+            if (GLuint *binding = bufferBinding(target))
+            {
+                *binding = buffer;
+            }
+            ++m_issued;
+            return true;
+        }
+
+        /**
+         * @brief Binds a range of a buffer to an indexed binding point.
+         *
+         * Ranges are not shadowed: the bind is always issued, and the next bindBufferBase of the
+         * binding point too. As glBindBufferRange does, this also binds the buffer to the generic
+         * target.
+         *
+         * @param target Indexed target, e.g. GL_SHADER_STORAGE_BUFFER.
+         * @param index Binding point.
+         * @param buffer Buffer to bind.
+         * @param offset Start of the range, a multiple of the offset alignment of the target.
+         * @param size Bytes of the range.
+         */
+        void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+        {
+            glBindBufferRange(target, index, buffer, offset, size);
+            m_indexedBindings.erase((std::uint64_t{target} << 32) | index);
+            if (GLuint *binding = bufferBinding(target))
+            {
+                *binding = buffer;
+            }
+            ++m_issued;
+        }
+
+        /**
+         * @brief Binds a vertex array object, unless it already is.
+         * @param vertexArray Vertex array to bind, 0 for none.
+         * @return True if glBindVertexArray was called.
+         */
+        bool bindVertexArray(GLuint vertexArray)
+        {
+            if (m_vertexArray == vertexArray)
+            {
+                ++m_skipped;
+                return false;
+            }
+            glBindVertexArray(vertexArray);
+            m_vertexArray = vertexArray;
+            ++m_issued;
+            return true;
+        }
+
+        /**
+         * @brief Binds a texture to a texture unit, unless it already is.
+         *
+         * The active texture unit is only changed when the texture has to be bound.
+         *
+         * @param unit Texture unit, from 0.
+         * @param target Texture target, e.g. GL_TEXTURE_2D.
+         * @param texture Texture to bind, 0 for none.
+         * @return True if glBindTexture was called.
+         */
+        bool bindTexture(GLuint unit, GLenum target, GLuint texture)
+        {
+            const std::uint64_t key = (std::uint64_t{target} << 32) | unit;
+            if (auto it = m_textureBindings.find(key); it != m_textureBindings.end() && it->second == texture)
+            {
+                ++m_skipped;
+                return false;
+            }
+            if (m_activeTexture != unit)
+            {
+                glActiveTexture(GL_TEXTURE0 + unit);
+                m_activeTexture = unit;
+            }
+            glBindTexture(target, texture);
+            m_textureBindings[key] = texture;
+            ++m_issued;
+            return true;
+        }
+
+        /**
+         * @brief Binds a framebuffer for drawing and reading, unless it already is.
+         * @param framebuffer Framebuffer to bind, 0 for the default one.
+         * @return True if glBindFramebuffer was called.
+         */
+        bool bindFramebuffer(GLuint framebuffer)
+        {
+            if (m_framebuffer == framebuffer)
+            {
+                ++m_skipped;
+                return false;
+            }
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            m_framebuffer = framebuffer;
+            ++m_issued;
+            return true;
+        }
+
+        /**
+         * @brief Forgets a deleted program.
+         *
+         * A deleted program stays current until another one is used, but its name can be reused
+         * afterwards: the next useProgram is issued whatever the program.
+         *
+         * @param program The deleted program.
+         */
+        void forgetProgram(GLuint program)
+        {
+            if (m_program == program)
+            {
+                m_program = UNKNOWN;
+            }
+        }
+
+        /**
+         * @brief Forgets the bindings of a deleted buffer, which GL reverts to 0.
+         * @param buffer The deleted buffer.
+         */
+        void forgetBuffer(GLuint buffer)
+        {
+            for (GLuint &binding : m_bufferBindings)
+            {
+                if (binding == buffer)
+                {
+                    binding = 0;
+                }
+            }
+            std::erase_if(m_indexedBindings, [buffer](const auto &binding)
+                          { return binding.second == buffer; });
+        }
+
+        /**
+         * @brief Forgets a deleted vertex array, which GL unbinds.
+         * @param vertexArray The deleted vertex array.
+         */
+        void forgetVertexArray(GLuint vertexArray)
+        {
+            if (m_vertexArray == vertexArray)
+            {
+                m_vertexArray = 0;
+            }
+        }
+
+        /**
+         * @brief Forgets the bindings of a deleted texture, which GL reverts to 0.
+         * @param texture The deleted texture.
+         */
+        void forgetTexture(GLuint texture)
+        {
+            for (auto &[key, binding] : m_textureBindings)
+            {
+                if (binding == texture)
+                {
+                    binding = 0;
+                }
+            }
+        }
+
+        /**
+         * @brief Forgets a deleted framebuffer, which GL reverts to the default one.
+         * @param framebuffer The deleted framebuffer.
+         */
+        void forgetFramebuffer(GLuint framebuffer)
+        {
+            if (m_framebuffer == framebuffer)
+            {
+                m_framebuffer = 0;
+            }
+        }
+
+        /**
+         * @brief Forgets every shadowed binding: the next bind of each kind is issued.
+         */
+        void invalidate()
+        {
+            m_program = UNKNOWN;
+            m_vertexArray = UNKNOWN;
+            m_framebuffer = UNKNOWN;
+            m_activeTexture = UNKNOWN;
+            m_bufferBindings.fill(UNKNOWN);
+            m_indexedBindings.clear();
+            m_textureBindings.clear();
+        }
+
+        /**
+         * @brief Get the number of binds skipped because the object was already bound.
+         * @return Number of skipped binds.
+         */
+        [[nodiscard]] std::size_t getSkipped() const
+        {
+            return m_skipped;
+        }
+
+        /**
+         * @brief Get the number of binds issued to the driver.
+         * @return Number of issued binds.
+         */
+        [[nodiscard]] std::size_t getIssued() const
+        {
+            return m_issued;
+        }
+
+        void resetStatistics()
+        {
+            m_skipped = 0;
+            m_issued = 0;
+        }
+
+    private:
+        static constexpr GLuint UNKNOWN = ~GLuint{0}; ///< Binding never set through the cache, or lost.
+
+        static constexpr std::array<GLenum, 9> BUFFER_TARGETS = {
+            GL_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_SHADER_STORAGE_BUFFER, GL_DRAW_INDIRECT_BUFFER,
+            GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER, GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            GL_TEXTURE_BUFFER};
+
+        /**
+         * @brief Get the shadow of the binding of a target.
+         * @param target Buffer target.
+         * @return The shadowed binding, nullptr if the target is not shadowed.
+         */
+        GLuint *bufferBinding(GLenum target)
+        {
+            for (std::size_t slot = 0; slot < BUFFER_TARGETS.size(); ++slot)
+            {
+                if (BUFFER_TARGETS[slot] == target)
+                {
+                    return &m_bufferBindings[slot];
+                }
+            }
+            return nullptr;
+        }
+
+        GLuint m_program = UNKNOWN;                                         ///< Current program.
+        GLuint m_vertexArray = UNKNOWN;                                     ///< Bound vertex array object.
+        GLuint m_framebuffer = UNKNOWN;                                     ///< Framebuffer bound for drawing and reading.
+        std::array<GLuint, BUFFER_TARGETS.size()> m_bufferBindings{};      ///< Bound buffers, by slot of BUFFER_TARGETS.
+        std::unordered_map<std::uint64_t, GLuint> m_indexedBindings;        ///< Buffers bound to indexed binding points, by target and index.
+        GLuint m_activeTexture = UNKNOWN;                                   ///< Active texture unit.
+        std::unordered_map<std::uint64_t, GLuint> m_textureBindings;        ///< Textures bound to the units, by target and unit.
+        std::size_t m_skipped = 0;                                          ///< Binds skipped.
+        std::size_t m_issued = 0;                                           ///< Binds issued.
+    };
+}
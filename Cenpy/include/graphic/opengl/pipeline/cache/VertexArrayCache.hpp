@@ -0,0 +1,175 @@
+// file: VertexArrayCache.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <unordered_map>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/pipeline/vertex/VertexLayout.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::cache
+{
+    /**
+     * @class OpenGLVertexArrayCache
+     * @brief Builds a vertex array object once per pass layout and mesh, and binds it afterwards.
+     *
+     * A vertex array records the attribute pointers and the buffers they source from: once built,
+     * switching meshes is a single glBindVertexArray, skipped by the state cache when the mesh is
+     * already bound. The vertex arrays are keyed by the layout the pass reads, the layout of the
+     * mesh and its buffers, so passes reflecting the same attributes share them.
+     *
+     * Vertex arrays are not shared between GL contexts: use one cache per context.
+     */
+    class OpenGLVertexArrayCache
+    {
+    public:
+        /**
+         * @struct Mesh
+         * @brief Buffers of a mesh and the layout of its vertices.
+         */
+        struct Mesh
+        {
+            const vertex::OpenGLVertexLayout &layout; ///< Layout of the vertices in the vertex buffer.
+            GLuint vertexBuffer;                      ///< Buffer of the interleaved vertices.
+            GLuint indexBuffer = 0;                   ///< Buffer of the indices, 0 if not indexed.
+        };
+
+        OpenGLVertexArrayCache() = default;
+        OpenGLVertexArrayCache(const OpenGLVertexArrayCache &) = delete;
+        OpenGLVertexArrayCache &operator=(const OpenGLVertexArrayCache &) = delete;
+
+        ~OpenGLVertexArrayCache()
+        {
+            clear();
+        }
+
+        /**
+         * @brief Get the vertex array sourcing the attributes a pass reads from a mesh, building it if needed.
+         * @param passLayout Attributes the pass reads, see OpenGLVertexLayout::fromPass.
+         * @param mesh Mesh to read.
+         * @return The vertex array.
+         * @throws TraceableException if the mesh lacks an attribute the pass reads.
+         */
+        GLuint get(const vertex::OpenGLVertexLayout &passLayout, const Mesh &mesh)
+        {
+            std::string key = std::format("{}|{}|{}|{}", passLayout.getSignature(), mesh.layout.getSignature(), mesh.vertexBuffer, mesh.indexBuffer);
+            if (auto it = m_vertexArrays.find(key); it != m_vertexArrays.end())
+            {
+                return it->second.vertexArray;
+            }
+            GLuint vertexArray = build(passLayout, mesh);
+            m_vertexArrays.emplace(std::move(key), Entry{vertexArray, mesh.vertexBuffer, mesh.indexBuffer});
+            return vertexArray;
+        }
+
+        /**
+         * @brief Binds the vertex array sourcing the attributes a pass reads from a mesh.
+         * @param passLayout Attributes the pass reads.
+         * @param mesh Mesh to read.
+         * @return The bound vertex array.
+         * @throws TraceableException if the mesh lacks an attribute the pass reads.
+         */
+        GLuint bind(const vertex::OpenGLVertexLayout &passLayout, const Mesh &mesh)
+        {
+            GLuint vertexArray = get(passLayout, mesh);
+            OpenGLStateCache::current().bindVertexArray(vertexArray);
+            return vertexArray;
+        }
+
+        /**
+         * @brief Deletes the vertex arrays sourcing from a buffer, before the buffer is deleted.
+         * @param buffer Vertex or index buffer.
+         */
+        void forgetBuffer(GLuint buffer)
+        {
+            std::erase_if(m_vertexArrays, [buffer](const auto &entry)
+                          {
+                              if (entry.second.vertexBuffer != buffer && entry.second.indexBuffer != buffer)
+                              {
+                                  return false;
+                              }
+                              release(entry.second.vertexArray);
+                              return true; });
+        }
+
+        /**
+         * @brief Deletes every vertex array.
+         */
+        void clear()
+        {
+            for (const auto &[key, entry] : m_vertexArrays)
+            {
+                release(entry.vertexArray);
+            }
+            m_vertexArrays.clear();
+        }
+
+        [[nodiscard]] std::size_t getVertexArraysCount() const
+        {
+            return m_vertexArrays.size();
+        }
+
+    private:
+        struct Entry
+        {
+            GLuint vertexArray;  ///< Vertex array object.
+            GLuint vertexBuffer; ///< Buffer its attributes source from.
+            GLuint indexBuffer;  ///< Buffer of its indices, 0 if none.
+        };
+
+        static GLuint build(const vertex::OpenGLVertexLayout &passLayout, const Mesh &mesh)
+        {
+            for (const auto &attribute : passLayout.getElements())
+            {
+                if (mesh.layout.find(attribute.name) == nullptr)
+                {
+                    throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::VERTEX_LAYOUT::MISSING_ATTRIBUTE\n{}", attribute.name));
+                }
+            }
+
+            auto &state = OpenGLStateCache::current();
+            GLuint vertexArray = 0;
+            glGenVertexArrays(1, &vertexArray);
+            state.bindVertexArray(vertexArray);
+            state.bindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+            if (mesh.indexBuffer != 0)
+            {
+                state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.indexBuffer);
+            }
+            for (const auto &attribute : passLayout.getElements())
+            {
+                const vertex::VertexElement &source = *mesh.layout.find(attribute.name);
+                const GLuint columnSize = static_cast<GLuint>(source.components) * vertex::VertexElement::componentSize(source.componentType);
+                for (GLuint column = 0; column < attribute.locations; ++column)
+                {
+                    const GLuint location = attribute.location + column;
+                    const auto *offset = reinterpret_cast<const void *>(static_cast<std::uintptr_t>(source.offset + column * columnSize));
+                    glEnableVertexAttribArray(location);
+                    if (source.isInteger())
+                    {
+                        glVertexAttribIPointer(location, source.components, source.componentType, mesh.layout.getStride(), offset);
+                    }
+                    else
+                    {
+                        glVertexAttribPointer(location, source.components, source.componentType, source.normalized ? GL_TRUE : GL_FALSE,
+                                              mesh.layout.getStride(), offset);
+                    }
+                }
+            }
+            return vertexArray;
+        }
+
+        static void release(GLuint vertexArray)
+        {
+            glDeleteVertexArrays(1, &vertexArray);
+            OpenGLStateCache::current().forgetVertexArray(vertexArray);
+        }
+
+        std::unordered_map<std::string, Entry> m_vertexArrays; ///< Vertex arrays, by pass layout, mesh layout and buffers.
+    };
+}
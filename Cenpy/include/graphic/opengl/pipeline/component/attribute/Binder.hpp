@@ -9,6 +9,7 @@
 #include <graphic/opengl/context/AttributeContext.hpp>
 #include <graphic/Api.hpp>
 #include <graphic/opengl/profile/Attribute.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::attribute
 {
@@ -33,7 +34,7 @@ namespace cenpy::graphic::opengl::pipeline::component::attribute
                 glGenBuffers(1, &VBO);
                 attribute->setBufferID(VBO);
             }
-            glBindBuffer(GL_ARRAY_BUFFER, attribute->getBufferID());
+            cache::OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, attribute->getBufferID());
         }
     };
 }
@@ -6,12 +6,29 @@
 #include <string>
 #include <memory>
 #include <any>
+#include <cstdint>
+#include <algorithm>
 #include <graphic/opengl/context/AttributeContext.hpp>
 #include <graphic/Api.hpp>
 #include <graphic/opengl/profile/Attribute.hpp>
+#include <graphic/opengl/pipeline/buffer/StreamingRing.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/pipeline/vertex/VertexLayout.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::attribute
 {
+    /**
+     * @class OpenGLSetter
+     * @brief Uploads the values of an attribute and sources the attribute from them.
+     *
+     * The buffer storage is allocated when the values outgrow it and reused otherwise: static
+     * attributes are updated in place, dynamic and streamed ones orphan the storage first so the
+     * update never waits for the draws still reading the previous values. An attribute streaming
+     * through a ring writes to the mapped segment of the frame instead.
+     *
+     * The components of each location are derived from the reflected type, as for a vertex
+     * layout: a matrix or an array sources one location per column or element.
+     */
     template <typename A>
     class OpenGLSetter
     {
@@ -22,13 +39,60 @@ namespace cenpy::graphic::opengl::pipeline::component::attribute
             {
                 throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::ATTRIBUTE::SET::NON_OPENGL_CONTEXT"));
             }
-            if (attribute->getBufferID() == 0)
+            const auto bytes = attribute->getBytes();
+            GLintptr offset = 0;
+            if (const auto &ring = attribute->getStreamingRing())
             {
-                throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::ATTRIBUTE::SET::BUFFER_ID_NOT_SET"));
+                offset = ring->write(bytes);
+                cache::OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, ring->getBufferID());
             }
-            std::shared_ptr<A> attrValue = attribute->getValue<A>();
-            glBufferData(GL_ARRAY_BUFFER, sizeof(attrValue.get()), attrValue.get(), attribute->getGLUsage());
-            glVertexAttribPointer(attribute->getAttributeID(), attribute->getGLSize(), attribute->getGLType(), GL_FALSE, sizeof(attrValue.get()), (void *)nullptr);
+            else
+            {
+                if (attribute->getBufferID() == 0)
+                {
+                    throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::ATTRIBUTE::SET::BUFFER_ID_NOT_SET"));
+                }
+                cache::OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, attribute->getBufferID());
+                upload(attribute, bytes);
+            }
+            point(attribute, offset);
+        }
+
+    private:
+        static void point(const std::shared_ptr<typename graphic::api::OpenGL::AttributeContext> &attribute, GLintptr offset)
+        {
+            const vertex::VertexElement element = vertex::OpenGLVertexLayout::fromGLType(attribute->getGLType());
+            const GLuint locations = element.locations * std::max<GLuint>(1, attribute->getGLSize());
+            const GLuint locationSize = static_cast<GLuint>(element.components) * vertex::VertexElement::componentSize(element.componentType);
+            const auto stride = static_cast<GLsizei>(attribute->getStride());
+            for (GLuint location = 0; location < locations; ++location)
+            {
+                const auto *pointer = reinterpret_cast<const void *>(static_cast<std::uintptr_t>(offset + location * locationSize));
+                if (element.isInteger())
+                {
+                    glVertexAttribIPointer(attribute->getAttributeID() + location, element.components, element.componentType, stride, pointer);
+                }
+                else
+                {
+                    glVertexAttribPointer(attribute->getAttributeID() + location, element.components, element.componentType, GL_FALSE, stride, pointer);
+                }
+            }
+        }
+
+        static void upload(const std::shared_ptr<typename graphic::api::OpenGL::AttributeContext> &attribute, std::span<const std::byte> bytes)
+        {
+            const auto size = static_cast<GLsizeiptr>(bytes.size());
+            if (bytes.size() > attribute->getCapacity())
+            {
+                glBufferData(GL_ARRAY_BUFFER, size, bytes.data(), attribute->getGLUsage());
+                attribute->setCapacity(bytes.size());
+                return;
+            }
+            if (attribute->getGLUsage() != GL_STATIC_DRAW)
+            {
+                glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(attribute->getCapacity()), nullptr, attribute->getGLUsage());
+            }
+            glBufferSubData(GL_ARRAY_BUFFER, 0, size, bytes.data());
         }
     };
 }
@@ -9,6 +9,7 @@
 #include <graphic/opengl/context/AttributeContext.hpp>
 #include <graphic/Api.hpp>
 #include <graphic/opengl/profile/Attribute.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::attribute
 {
@@ -31,7 +32,7 @@ namespace cenpy::graphic::opengl::pipeline::component::attribute
             {
                 throw cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::ATTRIBUTE::UNBIND::BUFFER_ID_NOT_SET"));
             }
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            cache::OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, 0);
         }
     };
 }
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/pipeline/cache/ProgramBinaryCache.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/profile/Pass.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::pass
+{
+    /**
+     * @class OpenGLPassBinaryLoader
+     * @brief Creates the program of a pass from the program binary cache of its context, if any.
+     *
+     * On a hit the program is ready to use and the pass skips compiling and linking its shaders.
+     */
+    template <auto PROFILE>
+    class OpenGLPassBinaryLoader
+    {
+    };
+
+    template <>
+    class OpenGLPassBinaryLoader<graphic::opengl::profile::Pass::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::PassContext> openglContext)
+        {
+            if (!openglContext)
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::PASS::NON_OPENGL_CONTEXT");
+            }
+
+            const auto &binaryCache = openglContext->getProgramBinaryCache();
+            openglContext->setLoadedFromBinary(binaryCache && binaryCache->load(*openglContext));
+        }
+    };
+}
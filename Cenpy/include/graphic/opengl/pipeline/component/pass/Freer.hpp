@@ -7,6 +7,7 @@
 #include <graphic/opengl/context/PassContext.hpp>
 #include <graphic/opengl/context/ShaderContext.hpp>
 #include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
 #include <graphic/opengl/profile/Pass.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::pass
@@ -41,7 +42,8 @@ namespace cenpy::graphic::opengl::pipeline::component::pass
                 // Optionally detach shaders before deleting the pipeline
                 for (const auto &shader : openglContext->getShaders())
                 {
-                    if (auto oglShaderContext = shader->getContext())
+                    // Shaders of a program created from a cached binary are never compiled.
+                    if (auto oglShaderContext = shader->getContext(); oglShaderContext && oglShaderContext->getShaderID() != 0)
                     {
                         glDetachShader(passID, oglShaderContext->getShaderID());
                     }
@@ -49,6 +51,7 @@ namespace cenpy::graphic::opengl::pipeline::component::pass
 
                 // Delete the OpenGL pipeline
                 glDeleteProgram(passID);
+                cache::OpenGLStateCache::current().forgetProgram(passID);
                 openglContext->setPassID(0); // Reset the pipeline ID in the context
             }
         }
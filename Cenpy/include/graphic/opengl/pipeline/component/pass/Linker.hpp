@@ -0,0 +1,60 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <format>
+#include <memory>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/ParallelCompile.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/pipeline/component/pass/ShaderAttacher.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/profile/Pass.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::pass
+{
+    /**
+     * @class OpenGLLinker
+     * @brief Creates the program of a pass and submits its link to the driver.
+     *
+     * The link status is not queried, the program is complete once OpenGLPassPoller reports it.
+     * When KHR_parallel_shader_compile is available the pass records it, so the poller can ask
+     * for the completion status without waiting.
+     */
+    template <auto PROFILE>
+    class OpenGLLinker
+    {
+    };
+
+    template <>
+    class OpenGLLinker<graphic::opengl::profile::Pass::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::PassContext> openglContext)
+        {
+            if (!openglContext)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::NON_OPENGL_CONTEXT"));
+            }
+
+            GLuint passID = glCreateProgram();
+            if (passID == 0)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM_CREATION_FAILED\nFailed to create shader pipeline."));
+            }
+
+            // Save the created pipeline ID in the context
+            openglContext->setPassID(passID);
+            cenpy::graphic::api::OpenGL::PassContext::ShaderAttacher<graphic::opengl::profile::Pass::Classic>::on(openglContext);
+
+            if (openglContext->getProgramBinaryCache())
+            {
+                glProgramParameteri(passID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            }
+
+            // The compiler threads are set once per context, see enableParallelShaderCompile.
+            openglContext->setParallelCompile(graphic::opengl::context::isParallelShaderCompileSupported());
+
+            glLinkProgram(passID);
+        }
+    };
+}
@@ -4,7 +4,8 @@
 #include <memory>
 #include <graphic/Api.hpp>
 #include <graphic/opengl/context/PassContext.hpp>
-#include <graphic/opengl/pipeline/component/pass/ShaderAttacher.hpp>
+#include <graphic/opengl/pipeline/component/pass/Linker.hpp>
+#include <graphic/opengl/pipeline/cache/ProgramBinaryCache.hpp>
 #include <graphic/opengl/profile/Pass.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::pass
@@ -20,29 +21,20 @@ namespace cenpy::graphic::opengl::pipeline::component::pass
     public:
         static void on(std::shared_ptr<typename graphic::api::OpenGL::PassContext> openglContext)
         {
-            if (!openglContext)
-            {
-                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::NON_OPENGL_CONTEXT"));
-            }
-
-            GLuint passID = glCreateProgram();
-            if (passID == 0)
-            {
-                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM_CREATION_FAILED\nFailed to create shader pipeline."));
-            }
-
-            // Save the created pipeline ID in the context
-            openglContext->setPassID(passID);
-            cenpy::graphic::api::OpenGL::PassContext::ShaderAttacher<graphic::opengl::profile::Pass::Classic>::on(openglContext);
-
-            // Link the pipeline
-            glLinkProgram(passID);
+            OpenGLLinker<graphic::opengl::profile::Pass::Classic>::on(openglContext);
 
+            GLuint passID = openglContext->getPassID();
             if (!checkLinkErrors(passID))
             {
                 glDeleteProgram(passID);
+                openglContext->setPassID(0);
                 throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::LINK_FAILED"));
             }
+
+            if (const auto &binaryCache = openglContext->getProgramBinaryCache())
+            {
+                binaryCache->store(*openglContext);
+            }
         }
 
         /**
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <format>
+#include <memory>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/pipeline/component/pass/Waiter.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/profile/Pass.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::pass
+{
+    /**
+     * @class OpenGLPassPoller
+     * @brief Checks whether the link submitted by OpenGLLinker is complete, without blocking.
+     *
+     * GL_COMPLETION_STATUS_KHR is queried first: while it is false the pass stays pending and the
+     * call returns at once. The link status is then checked by OpenGLPassWaiter: without
+     * KHR_parallel_shader_compile it waits for the driver the first time the pass is polled.
+     */
+    template <auto PROFILE>
+    class OpenGLPassPoller
+    {
+    };
+
+    template <>
+    class OpenGLPassPoller<graphic::opengl::profile::Pass::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::PassContext> openglContext)
+        {
+            if (!openglContext)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::NON_OPENGL_CONTEXT"));
+            }
+
+            GLuint passID = openglContext->getPassID();
+            if (openglContext->isParallelCompile())
+            {
+                GLint completed = GL_FALSE;
+                glGetProgramiv(passID, GL_COMPLETION_STATUS_KHR, &completed);
+                if (completed == GL_FALSE)
+                {
+                    return;
+                }
+            }
+
+            OpenGLPassWaiter<graphic::opengl::profile::Pass::Classic>::on(openglContext);
+        }
+    };
+}
@@ -15,6 +15,8 @@ namespace cenpy::graphic::opengl::pipeline::component::pass
      *
      * This class specializes in reading uniform variables from an OpenGL shader pipeline.
      * It extracts the details of each uniform and populates them into the provided map.
+     * Members of uniform blocks are not loose uniforms: they are skipped, and the blocks
+     * themselves are recorded in the context so a pipeline can bind its shared buffers to them.
      */
     template <auto PROFILE>
     class OpenGLPassUniformReader
@@ -49,6 +51,14 @@ namespace cenpy::graphic::opengl::pipeline::component::pass
                 GLenum type = 0;
                 glGetActiveUniform(passID, i, sizeof(uniformName), &nameLength, &size, &type, uniformName);
 
+                GLuint uniformIndex = i;
+                GLint blockIndex = -1;
+                glGetActiveUniformsiv(passID, 1, &uniformIndex, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+                if (blockIndex != -1)
+                {
+                    continue;
+                }
+
                 GLuint location = glGetUniformLocation(passID, uniformName);
 
                 // Create a Uniform object and store it in the map
@@ -59,6 +69,19 @@ namespace cenpy::graphic::opengl::pipeline::component::pass
                 auto uniform = std::make_shared<graphic::pipeline::Uniform<graphic::api::OpenGL>>(uniformContext);
                 openglContext->addUniform(std::string(uniformName), uniform);
             }
+
+            GLint numBlocks = 0;
+            glGetProgramiv(passID, GL_ACTIVE_UNIFORM_BLOCKS, &numBlocks);
+
+            for (GLint i = 0; i < numBlocks; ++i)
+            {
+                char blockName[256];
+                GLsizei nameLength = 0;
+                GLint dataSize = 0;
+                glGetActiveUniformBlockName(passID, i, sizeof(blockName), &nameLength, blockName);
+                glGetActiveUniformBlockiv(passID, i, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+                openglContext->addUniformBlock(std::string(blockName, nameLength), i, dataSize);
+            }
         }
     };
 }
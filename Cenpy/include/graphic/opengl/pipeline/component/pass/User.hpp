@@ -6,6 +6,7 @@
 #include <graphic/Api.hpp>
 #include <graphic/opengl/context/PassContext.hpp>
 #include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
 #include <graphic/opengl/pipeline/component/pass/User.hpp>
 #include <graphic/opengl/profile/Pass.hpp>
 
@@ -16,7 +17,8 @@ namespace cenpy::graphic::opengl::pipeline::component::pass
      * @brief OpenGL implementation of IPassUser.
      *
      * Handles the activation of a shader pass in an OpenGL context. This includes setting the
-     * current OpenGL pipeline to the one associated with the shader pass.
+     * current OpenGL pipeline to the one associated with the shader pass, then uploading the
+     * uniforms staged while the pass was not bound.
      */
     template <auto PROFILE>
     class OpenGLPassUser
@@ -36,7 +38,8 @@ namespace cenpy::graphic::opengl::pipeline::component::pass
             }
 
             // Set the OpenGL pipeline for this pass as the current active pipeline
-            glUseProgram(openglContext->getPassID());
+            cache::OpenGLStateCache::current().useProgram(openglContext->getPassID());
+            openglContext->commitUniforms();
         }
     };
 }
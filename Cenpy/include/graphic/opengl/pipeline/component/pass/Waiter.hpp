@@ -0,0 +1,54 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <format>
+#include <memory>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/pipeline/component/pass/Loader.hpp>
+#include <graphic/opengl/pipeline/cache/ProgramBinaryCache.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/profile/Pass.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::pass
+{
+    /**
+     * @class OpenGLPassWaiter
+     * @brief Waits for the link submitted by OpenGLLinker to complete.
+     *
+     * The link status is queried directly, so the calling thread sleeps in the driver until the
+     * program is linked, while the links submitted before it carry on.
+     */
+    template <auto PROFILE>
+    class OpenGLPassWaiter
+    {
+    };
+
+    template <>
+    class OpenGLPassWaiter<graphic::opengl::profile::Pass::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::PassContext> openglContext)
+        {
+            if (!openglContext)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::NON_OPENGL_CONTEXT"));
+            }
+
+            GLuint passID = openglContext->getPassID();
+            if (!OpenGLLoader<graphic::opengl::profile::Pass::Classic>::checkLinkErrors(passID))
+            {
+                glDeleteProgram(passID);
+                openglContext->setPassID(0);
+                openglContext->setLoadState(graphic::context::PassLoadState::UNLOADED);
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::LINK_FAILED"));
+            }
+
+            if (const auto &binaryCache = openglContext->getProgramBinaryCache())
+            {
+                binaryCache->store(*openglContext);
+            }
+            openglContext->setLoadState(graphic::context::PassLoadState::READY);
+        }
+    };
+}
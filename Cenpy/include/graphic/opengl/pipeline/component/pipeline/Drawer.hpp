@@ -0,0 +1,176 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <GL/glew.h>
+#include <graphic/Api.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/context/PipelineContext.hpp>
+#include <graphic/opengl/pipeline/buffer/IndirectBuffer.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/profile/Pipeline.hpp>
+#include <graphic/render/RenderQueue.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::pipeline
+{
+    /**
+     * @class OpenGLPipelineDrawer
+     * @brief Draws the current commands of the pipeline with the pass in use, one draw call each.
+     *
+     * The texture and the vertex array are bound through the state cache: consecutive commands
+     * sharing them, as a sorted queue yields, bind them once. Commands of several instances are drawn
+     * instanced; a first instance other than 0 needs GL_ARB_base_instance (core since OpenGL 4.2).
+     */
+    template <auto PROFILE>
+    class OpenGLPipelineDrawer
+    {
+    };
+
+    template <>
+    class OpenGLPipelineDrawer<graphic::opengl::profile::Pipeline::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::PipelineContext> context)
+        {
+            if (!context)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::NON_VALID_CONTEXT"));
+            }
+            const auto commands = context->getCurrentCommands();
+            if (commands.empty())
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_QUEUE::NO_CURRENT_COMMAND"));
+            }
+            for (const auto &command : commands)
+            {
+                draw(command);
+            }
+        }
+
+        /**
+         * @brief Converts a primitive to its GL mode.
+         * @param primitive Primitive of a command.
+         * @return The GL primitive mode.
+         */
+        static GLenum toGL(render::Primitive primitive)
+        {
+            switch (primitive)
+            {
+            case render::Primitive::TRIANGLE_STRIP:
+                return GL_TRIANGLE_STRIP;
+            case render::Primitive::LINES:
+                return GL_LINES;
+            case render::Primitive::POINTS:
+                return GL_POINTS;
+            default:
+                return GL_TRIANGLES;
+            }
+        }
+
+    private:
+        static void draw(const render::RenderCommand &command)
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            if (command.texture != 0)
+            {
+                state.bindTexture(0, GL_TEXTURE_2D, command.texture);
+            }
+            state.bindVertexArray(command.vertexArray);
+            const GLenum primitive = toGL(command.primitive);
+            const auto count = static_cast<GLsizei>(command.count);
+            const auto instances = static_cast<GLsizei>(command.instanceCount);
+            if (command.indexed)
+            {
+                const auto *indices = reinterpret_cast<const void *>(static_cast<std::uintptr_t>(command.first) * sizeof(GLuint));
+                if (command.baseVertex != 0 && command.firstInstance != 0)
+                {
+                    glDrawElementsInstancedBaseVertexBaseInstance(primitive, count, GL_UNSIGNED_INT, indices, instances, command.baseVertex, command.firstInstance);
+                }
+                else if (command.baseVertex != 0)
+                {
+                    glDrawElementsInstancedBaseVertex(primitive, count, GL_UNSIGNED_INT, indices, instances, command.baseVertex);
+                }
+                else if (command.firstInstance != 0)
+                {
+                    glDrawElementsInstancedBaseInstance(primitive, count, GL_UNSIGNED_INT, indices, instances, command.firstInstance);
+                }
+                else if (command.instanceCount != 1)
+                {
+                    glDrawElementsInstanced(primitive, count, GL_UNSIGNED_INT, indices, instances);
+                }
+                else
+                {
+                    glDrawElements(primitive, count, GL_UNSIGNED_INT, indices);
+                }
+            }
+            else
+            {
+                const auto first = static_cast<GLint>(command.first);
+                if (command.firstInstance != 0)
+                {
+                    glDrawArraysInstancedBaseInstance(primitive, first, count, instances, command.firstInstance);
+                }
+                else if (command.instanceCount != 1)
+                {
+                    glDrawArraysInstanced(primitive, first, count, instances);
+                }
+                else
+                {
+                    glDrawArrays(primitive, first, count);
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Draws the current commands of the pipeline with one multi-draw indirect per batch of
+     * commands sharing a vertex array, a texture and a primitive.
+     *
+     * Meshes packed in shared buffers, each command giving its first index and base vertex, are
+     * drawn by one call whatever their mesh. The shaders read the RenderCommand::drawData of their
+     * draw from the draw data buffer, see DrawRecord.
+     */
+    template <>
+    class OpenGLPipelineDrawer<graphic::opengl::profile::Pipeline::Indirect>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::PipelineContext> context)
+        {
+            if (!context)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::NON_VALID_CONTEXT"));
+            }
+            const auto commands = context->getCurrentCommands();
+            if (commands.empty())
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_QUEUE::NO_CURRENT_COMMAND"));
+            }
+            if (!context->getIndirectBuffer())
+            {
+                context->setIndirectBuffer(std::make_shared<buffer::OpenGLIndirectBuffer>());
+            }
+            auto indirectBuffer = context->getIndirectBuffer();
+
+            auto &state = cache::OpenGLStateCache::current();
+            for (const auto &batch : indirectBuffer->write(commands))
+            {
+                if (batch.command->texture != 0)
+                {
+                    state.bindTexture(0, GL_TEXTURE_2D, batch.command->texture);
+                }
+                state.bindVertexArray(batch.command->vertexArray);
+                indirectBuffer->bindRecords(batch);
+                const GLenum primitive = OpenGLPipelineDrawer<graphic::opengl::profile::Pipeline::Classic>::toGL(batch.command->primitive);
+                const auto *indirect = reinterpret_cast<const void *>(static_cast<std::uintptr_t>(batch.indirectOffset));
+                if (batch.command->indexed)
+                {
+                    glMultiDrawElementsIndirect(primitive, GL_UNSIGNED_INT, indirect, batch.drawCount, 0);
+                }
+                else
+                {
+                    glMultiDrawArraysIndirect(primitive, indirect, batch.drawCount, 0);
+                }
+            }
+        }
+    };
+}
@@ -26,4 +26,9 @@ namespace cenpy::graphic::opengl::pipeline::component::pipeline
             context->setCurrentPass(-1);
         }
     };
+
+    template <>
+    class OpenGLPipelineResetter<graphic::opengl::profile::Pipeline::Indirect> : public OpenGLPipelineResetter<graphic::opengl::profile::Pipeline::Classic>
+    {
+    };
 }
@@ -4,6 +4,8 @@
 #include <graphic/Api.hpp>
 #include <common/exception/TraceableException.hpp>
 #include <graphic/opengl/context/PipelineContext.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
 #include <graphic/opengl/profile/Pipeline.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::pipeline
@@ -23,7 +25,38 @@ namespace cenpy::graphic::opengl::pipeline::component::pipeline
             {
                 throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::NON_VALID_CONTEXT"));
             }
-            context->getPass(context->getCurrentPass())->use();
+            auto pass = context->getPass(context->getCurrentPass());
+            for (const auto &block : context->getUniformBlocks())
+            {
+                // Staged changes are uploaded in one call. The bind is skipped by the state cache while
+                // the buffer stays bound, whichever pass a sorted queue uses first.
+                block->update();
+                block->bind();
+                bindUniformBlock(pass->getContext(), block->getContext());
+            }
+            pass->use();
         }
+
+    private:
+        static void bindUniformBlock(const std::shared_ptr<typename graphic::api::OpenGL::PassContext> &passContext,
+                                     const std::shared_ptr<typename graphic::api::OpenGL::UniformBlockContext> &blockContext)
+        {
+            auto *passBlock = passContext->getUniformBlock(blockContext->getBlockName());
+            if (passBlock == nullptr || passBlock->binding == blockContext->getBindingPoint())
+            {
+                return;
+            }
+            if (static_cast<std::size_t>(passBlock->dataSize) != blockContext->getDataSize())
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::UNIFORM_BLOCK::LAYOUT_MISMATCH\nBlock {} is {} bytes in the program but {} bytes once packed as std140", blockContext->getBlockName(), passBlock->dataSize, blockContext->getDataSize()));
+            }
+            glUniformBlockBinding(passContext->getPassID(), passBlock->index, blockContext->getBindingPoint());
+            passBlock->binding = blockContext->getBindingPoint();
+        }
+    };
+
+    template <>
+    class OpenGLPipelineUser<graphic::opengl::profile::Pipeline::Indirect> : public OpenGLPipelineUser<graphic::opengl::profile::Pipeline::Classic>
+    {
     };
 }
@@ -0,0 +1,69 @@
+// file: Compiler.hpp
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+#include <graphic/opengl/profile/Shader.hpp>
+#include <graphic/opengl/pipeline/cache/ShaderCache.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::shader
+{
+    /**
+     * @class OpenGLShaderCompiler
+     * @brief Submits the compilation of a shader to the driver.
+     *
+     * The compile status is not queried, so the call returns as soon as the work is queued: with
+     * KHR_parallel_shader_compile the driver compiles on its own threads until the status is asked.
+     * A shader with a shader cache reuses the object of an identical shader compiled before it.
+     */
+    template <auto PROFILE>
+    class OpenGLShaderCompiler
+    {
+    };
+
+    template <>
+    class OpenGLShaderCompiler<graphic::opengl::profile::Shader::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::ShaderContext> openglContext)
+        {
+            // Already compiled, e.g. when a pass is linked again after another of its shaders changed.
+            if (openglContext->getShaderID() != 0)
+            {
+                return;
+            }
+
+            const auto &shaderCache = openglContext->getShaderCache();
+            if (shaderCache)
+            {
+                if (GLuint sharedID = shaderCache->acquire(*openglContext); sharedID != 0)
+                {
+                    openglContext->setShaderID(sharedID);
+                    return;
+                }
+            }
+
+            GLuint shaderID = glCreateShader(openglContext->getGLShaderType());
+            // The code is a view, possibly of a mapped file: pass its length rather than relying on a terminator.
+            std::string_view shaderCode = openglContext->getShaderCode();
+            const GLchar *shaderCodeData = shaderCode.data();
+            const auto shaderCodeLength = static_cast<GLint>(shaderCode.size());
+            glShaderSource(shaderID, 1, &shaderCodeData, &shaderCodeLength);
+            glCompileShader(shaderID);
+            if (shaderCache)
+            {
+                shaderCache->add(*openglContext, shaderID);
+            }
+
+            openglContext->setShaderID(shaderID);
+        }
+    };
+
+    template <>
+    class OpenGLShaderCompiler<graphic::opengl::profile::Shader::Mapped> : public OpenGLShaderCompiler<graphic::opengl::profile::Shader::Classic>
+    {
+    };
+}
@@ -7,6 +7,7 @@
 #include <graphic/Api.hpp>
 #include <graphic/opengl/context/ShaderContext.hpp>
 #include <graphic/opengl/profile/Shader.hpp>
+#include <graphic/opengl/pipeline/cache/ShaderCache.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::shader
 {
@@ -32,9 +33,22 @@ namespace cenpy::graphic::opengl::pipeline::component::shader
 
             if (shaderID != 0)
             {
-                glDeleteShader(shaderID);
+                if (const auto &shaderCache = openglContext->getShaderCache())
+                {
+                    // Shared objects outlive their shader until the last user releases them.
+                    shaderCache->release(shaderID);
+                }
+                else
+                {
+                    glDeleteShader(shaderID);
+                }
                 openglContext->setShaderID(0); // Reset the shader ID in the context
             }
         }
     };
+
+    template <>
+    class OpenGLShaderFreer<graphic::opengl::profile::Shader::Mapped> : public OpenGLShaderFreer<graphic::opengl::profile::Shader::Classic>
+    {
+    };
 }
@@ -9,6 +9,7 @@
 #include <graphic/Api.hpp>
 #include <graphic/opengl/context/ShaderContext.hpp>
 #include <graphic/opengl/profile/Shader.hpp>
+#include <graphic/opengl/pipeline/component/shader/Compiler.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::shader
 {
@@ -30,21 +31,23 @@ namespace cenpy::graphic::opengl::pipeline::component::shader
     public:
         static void on(std::shared_ptr<typename graphic::api::OpenGL::ShaderContext> openglContext)
         {
-            // Create a shader object
-            GLuint shaderID = glCreateShader(openglContext->getGLShaderType());
-            const char *shaderCodeCStr = openglContext->getShaderCode().c_str();
-            glShaderSource(shaderID, 1, &shaderCodeCStr, nullptr);
-            glCompileShader(shaderID);
+            OpenGLShaderCompiler<graphic::opengl::profile::Shader::Classic>::on(openglContext);
 
             // Check for shader compile errors
-            if (!checkCompileErrors(shaderID))
+            if (GLuint shaderID = openglContext->getShaderID(); !checkCompileErrors(shaderID))
             {
-                glDeleteShader(shaderID); // Don't leak the shader.
+                // Don't leak the shader.
+                if (const auto &shaderCache = openglContext->getShaderCache())
+                {
+                    shaderCache->release(shaderID);
+                }
+                else
+                {
+                    glDeleteShader(shaderID);
+                }
+                openglContext->setShaderID(0);
                 throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::COMPILATION_FAILED\n"));
             }
-
-            // Store the shader ID in the OpenGL context
-            openglContext->setShaderID(shaderID);
         }
 
     private:
@@ -66,4 +69,9 @@ namespace cenpy::graphic::opengl::pipeline::component::shader
             return true;
         }
     };
+
+    template <>
+    class OpenGLShaderLoader<graphic::opengl::profile::Shader::Mapped> : public OpenGLShaderLoader<graphic::opengl::profile::Shader::Classic>
+    {
+    };
 }
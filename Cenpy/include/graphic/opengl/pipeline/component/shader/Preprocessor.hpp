@@ -0,0 +1,235 @@
+// file: Preprocessor.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <common/io/MappedFile.hpp>
+#include <graphic/opengl/profile/Shader.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::shader
+{
+    /**
+     * @class OpenGLShaderPreprocessor
+     * @brief Resolves the #include directives of a shader source read by OpenGLShaderReader.
+     *
+     * A directive is only recognized at the start of a line, after blanks, and outside of comments.
+     * An included path is relative to the including file. Each file is included once per shader,
+     * further includes of it are dropped, which also breaks include cycles. #line directives keep
+     * the compile errors pointing at the right line: an included file is reported as the source
+     * string of its index in the shader includes, plus one, the shader itself being 0.
+     *
+     * The included files are recorded in the context, so the shaders depending on a changed file
+     * can be found and compiled again. The macros of a variant are defined after #version.
+     * A source without #include nor macro to define is left untouched.
+     */
+    template <auto PROFILE>
+    class OpenGLShaderPreprocessor
+    {
+    };
+
+    template <>
+    class OpenGLShaderPreprocessor<graphic::opengl::profile::Shader::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::ShaderContext> context)
+        {
+            std::vector<std::string> includes;
+            const bool hasIncludes = hasIncludeDirective(context->getShaderCode());
+            if (!hasIncludes && context->getDefines().empty())
+            {
+                context->setIncludes(std::move(includes));
+                return;
+            }
+
+            std::string expanded;
+            if (hasIncludes)
+            {
+                expand(context->getShaderCode(), std::filesystem::path(context->getShaderPath()), 0, expanded, includes);
+            }
+            else
+            {
+                expanded = context->getShaderCode();
+            }
+            define(expanded, context->getDefines());
+            context->setShaderCode(expanded);
+            context->setIncludes(std::move(includes));
+        }
+
+    private:
+        static constexpr std::string_view INCLUDE_DIRECTIVE = "#include";
+        static constexpr std::string_view VERSION_DIRECTIVE = "#version";
+
+        /**
+         * @brief Defines the macros of a variant, right after #version which must stay the first directive.
+         */
+        static void define(std::string &code, const std::vector<std::string> &defines)
+        {
+            if (defines.empty())
+            {
+                return;
+            }
+            std::size_t position = 0;
+            const std::size_t start = code.find_first_not_of(" \t\r\n");
+            if (start != std::string::npos && std::string_view(code).substr(start).starts_with(VERSION_DIRECTIVE))
+            {
+                position = code.find('\n', start);
+                if (position == std::string::npos)
+                {
+                    code.push_back('\n');
+                    position = code.size() - 1;
+                }
+                ++position;
+            }
+            std::string block;
+            for (const auto &define : defines)
+            {
+                block.append(std::format("#define {}\n", define));
+            }
+            block.append(std::format("#line {} 0\n", std::ranges::count(code.begin(), code.begin() + position, '\n') + 1));
+            code.insert(position, block);
+        }
+
+        /**
+         * @brief Get the #include directive a line starts with, if any.
+         * @param line Line of code.
+         * @param inComment Whether the line starts inside a block comment.
+         * @return The directive without its leading blanks, empty if the line is not one.
+         */
+        static std::string_view includeDirective(std::string_view line, bool inComment)
+        {
+            if (inComment)
+            {
+                return {};
+            }
+            std::string_view directive = line.substr(std::min(line.find_first_not_of(" \t"), line.size()));
+            return directive.starts_with(INCLUDE_DIRECTIVE) ? directive : std::string_view();
+        }
+
+        /**
+         * @brief Tells whether a block comment is still open at the end of a line.
+         * @param line Line of code.
+         * @param inComment Whether the line starts inside a block comment.
+         * @return True if the next line starts inside a block comment.
+         */
+        static bool endsInComment(std::string_view line, bool inComment)
+        {
+            for (std::size_t at = 0; at + 1 < line.size(); ++at)
+            {
+                if (inComment && line[at] == '*' && line[at + 1] == '/')
+                {
+                    inComment = false;
+                    ++at;
+                }
+                else if (!inComment && line[at] == '/' && line[at + 1] == '/')
+                {
+                    break;
+                }
+                else if (!inComment && line[at] == '/' && line[at + 1] == '*')
+                {
+                    inComment = true;
+                    ++at;
+                }
+            }
+            return inComment;
+        }
+
+        /**
+         * @brief Tells whether a source has an #include directive, a commented out one does not count.
+         */
+        static bool hasIncludeDirective(std::string_view code)
+        {
+            if (code.find(INCLUDE_DIRECTIVE) == std::string_view::npos)
+            {
+                return false;
+            }
+            bool inComment = false;
+            while (!code.empty())
+            {
+                const std::size_t end = code.find('\n');
+                std::string_view line = code.substr(0, end);
+                code = end == std::string_view::npos ? std::string_view() : code.substr(end + 1);
+                if (!includeDirective(line, inComment).empty())
+                {
+                    return true;
+                }
+                inComment = endsInComment(line, inComment);
+            }
+            return false;
+        }
+
+        static void expand(std::string_view code, const std::filesystem::path &file, std::size_t sourceIndex,
+                           std::string &expanded, std::vector<std::string> &includes)
+        {
+            std::size_t lineNumber = 0;
+            bool inComment = false;
+            while (!code.empty())
+            {
+                const std::size_t end = code.find('\n');
+                std::string_view line = code.substr(0, end);
+                code = end == std::string_view::npos ? std::string_view() : code.substr(end + 1);
+                ++lineNumber;
+
+                std::string_view directive = includeDirective(line, inComment);
+                inComment = endsInComment(line, inComment);
+                if (directive.empty())
+                {
+                    expanded.append(line);
+                    expanded.push_back('\n');
+                    continue;
+                }
+
+                const std::string included = (file.parent_path() / includedName(directive, file)).lexically_normal().generic_string();
+                if (std::ranges::find(includes, included) != includes.end())
+                {
+                    // Keep the line count of the source.
+                    expanded.push_back('\n');
+                    continue;
+                }
+                includes.push_back(included);
+                const std::size_t includedIndex = includes.size();
+                common::io::MappedFile includedFile = map(included, file);
+                expanded.append(std::format("#line 1 {}\n", includedIndex));
+                expand(includedFile.view(), included, includedIndex, expanded, includes);
+                expanded.append(std::format("#line {} {}\n", lineNumber + 1, sourceIndex));
+            }
+        }
+
+        static std::string_view includedName(std::string_view directive, const std::filesystem::path &file)
+        {
+            const std::size_t open = directive.find_first_of("\"<", INCLUDE_DIRECTIVE.size());
+            const std::size_t close = open == std::string_view::npos ? open : directive.find(directive[open] == '"' ? '"' : '>', open + 1);
+            if (close == std::string_view::npos)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::INVALID_INCLUDE\n{}: {}", file.generic_string(), directive));
+            }
+            return directive.substr(open + 1, close - open - 1);
+        }
+
+        static common::io::MappedFile map(const std::string &included, const std::filesystem::path &file)
+        {
+            try
+            {
+                return common::io::MappedFile(included);
+            }
+            catch (const std::runtime_error &)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::INCLUDE_NOT_FOUND\n{} included from {}", included, file.generic_string()));
+            }
+        }
+    };
+
+    template <>
+    class OpenGLShaderPreprocessor<graphic::opengl::profile::Shader::Mapped> : public OpenGLShaderPreprocessor<graphic::opengl::profile::Shader::Classic>
+    {
+    };
+}
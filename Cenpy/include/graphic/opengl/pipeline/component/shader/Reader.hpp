@@ -9,6 +9,7 @@
 #include <sstream>
 #include <format>
 #include <common/exception/TraceableException.hpp>
+#include <common/io/MappedFile.hpp>
 #include <graphic/opengl/profile/Shader.hpp>
 
 namespace cenpy::graphic::opengl::pipeline::component::shader
@@ -46,4 +47,25 @@ namespace cenpy::graphic::opengl::pipeline::component::shader
             }
         }
     };
+
+    template <>
+    class OpenGLShaderReader<graphic::opengl::profile::Shader::Mapped>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::ShaderContext> context)
+        {
+            try
+            {
+                // Copied once out of the mapping, which is released right away: the code is read
+                // again long after, e.g. by the program binary cache, and an editor may truncate
+                // the file in the meantime, which would fault on a page of a still mapped file.
+                const common::io::MappedFile shaderFile(context->getShaderPath());
+                context->setShaderCode(std::string(shaderFile.view()));
+            }
+            catch (const std::runtime_error &e)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ\n{}", e.what()));
+            }
+        }
+    };
 }
@@ -27,7 +27,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<GLfloat>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform1f(uniform->getUniformID(), uniform->getValue<GLfloat>());
             }
@@ -41,7 +41,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<GLint>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform1i(uniform->getUniformID(), uniform->getValue<GLint>());
             }
@@ -55,7 +55,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<GLuint>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform1ui(uniform->getUniformID(), uniform->getValue<GLuint>());
             }
@@ -69,7 +69,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<GLdouble>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform1d(uniform->getUniformID(), uniform->getValue<GLdouble>());
             }
@@ -83,7 +83,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::vec2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform2fv(uniform->getUniformID(), uniform->getGLSize(), &uniform->getValue<glm::vec2>()[0]);
             }
@@ -97,7 +97,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::vec3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform3fv(uniform->getUniformID(), uniform->getGLSize(), &uniform->getValue<glm::vec3>()[0]);
             }
@@ -111,7 +111,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::vec4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform4fv(uniform->getUniformID(), uniform->getGLSize(), &uniform->getValue<glm::vec4>()[0]);
             }
@@ -125,7 +125,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dvec2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform2dv(uniform->getUniformID(), uniform->getGLSize(), &uniform->getValue<glm::dvec2>()[0]);
             };
@@ -139,7 +139,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dvec3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform3dv(uniform->getUniformID(), uniform->getGLSize(), &uniform->getValue<glm::dvec3>()[0]);
             };
@@ -153,7 +153,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dvec4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform4dv(uniform->getUniformID(), uniform->getGLSize(), &uniform->getValue<glm::dvec4>()[0]);
             };
@@ -165,7 +165,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::ivec2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform2iv(uniform->getUniformID(), uniform->getGLSize(), glm::value_ptr(uniform->getValue<glm::ivec2>()));
             }
@@ -177,7 +177,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::ivec3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform3iv(uniform->getUniformID(), uniform->getGLSize(), glm::value_ptr(uniform->getValue<glm::ivec3>()));
             }
@@ -189,7 +189,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::ivec4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform4iv(uniform->getUniformID(), uniform->getGLSize(), glm::value_ptr(uniform->getValue<glm::ivec4>()));
             }
@@ -201,7 +201,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::uvec2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform2uiv(uniform->getUniformID(), uniform->getGLSize(), glm::value_ptr(uniform->getValue<glm::uvec2>()));
             }
@@ -213,7 +213,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::uvec3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform3uiv(uniform->getUniformID(), uniform->getGLSize(), glm::value_ptr(uniform->getValue<glm::uvec3>()));
             }
@@ -225,7 +225,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::uvec4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniform4uiv(uniform->getUniformID(), uniform->getGLSize(), glm::value_ptr(uniform->getValue<glm::uvec4>()));
             }
@@ -237,7 +237,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix2fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat2>()));
             }
@@ -249,7 +249,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix3fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat3>()));
             }
@@ -261,7 +261,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix4fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat4>()));
             }
@@ -273,7 +273,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat2x3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix2x3fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat2x3>()));
             }
@@ -285,7 +285,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat3x2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix3x2fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat3x2>()));
             }
@@ -297,7 +297,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat2x4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix2x4fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat2x4>()));
             }
@@ -309,7 +309,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat4x2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix4x2fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat4x2>()));
             }
@@ -321,7 +321,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat3x4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix3x4fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat3x4>()));
             }
@@ -333,7 +333,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::mat4x3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix4x3fv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::mat4x3>()));
             }
@@ -349,7 +349,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix2dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat2>()));
             }
@@ -361,7 +361,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix3dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat3>()));
             }
@@ -373,7 +373,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix4dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat4>()));
             }
@@ -385,7 +385,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat2x3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix2x3dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat2x3>()));
             }
@@ -397,7 +397,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat3x2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix3x2dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat3x2>()));
             }
@@ -409,7 +409,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat2x4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix2x4dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat2x4>()));
             }
@@ -421,7 +421,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat4x2>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix4x2dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat4x2>()));
             }
@@ -433,7 +433,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat3x4>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix3x4dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat3x4>()));
             }
@@ -445,7 +445,7 @@ namespace cenpy::graphic::opengl::pipeline
         template <>
         struct OpenGLUniformSetter<glm::dmat4x3>
         {
-            static void on(std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> uniform)
+            static void on(const std::shared_ptr<cenpy::graphic::opengl::context::OpenGLUniformContext> &uniform)
             {
                 glUniformMatrix4x3dv(uniform->getUniformID(), uniform->getGLSize(), GL_FALSE, glm::value_ptr(uniform->getValue<glm::dmat4x3>()));
             }
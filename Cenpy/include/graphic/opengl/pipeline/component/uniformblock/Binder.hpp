@@ -0,0 +1,41 @@
+// file: Binder
+
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/profile/UniformBlock.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::uniformblock
+{
+    /**
+     * @class OpenGLUniformBlockBinder
+     * @brief Binds the uniform buffer of a block to its binding point.
+     */
+    template <auto PROFILE>
+    class OpenGLUniformBlockBinder
+    {
+    };
+
+    template <>
+    class OpenGLUniformBlockBinder<graphic::opengl::profile::UniformBlock::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::UniformBlockContext> block)
+        {
+            if (!block)
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::BIND::NON_OPENGL_CONTEXT");
+            }
+            if (block->getBufferID() == 0)
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::BIND::BUFFER_ID_NOT_SET");
+            }
+            cache::OpenGLStateCache::current().bindBufferBase(GL_UNIFORM_BUFFER, block->getBindingPoint(), block->getBufferID());
+        }
+    };
+}
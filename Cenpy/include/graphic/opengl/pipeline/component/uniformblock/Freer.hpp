@@ -0,0 +1,44 @@
+// file: Freer
+
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/profile/UniformBlock.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::uniformblock
+{
+    /**
+     * @class OpenGLUniformBlockFreer
+     * @brief Deletes the uniform buffer of a block.
+     */
+    template <auto PROFILE>
+    class OpenGLUniformBlockFreer
+    {
+    };
+
+    template <>
+    class OpenGLUniformBlockFreer<graphic::opengl::profile::UniformBlock::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::UniformBlockContext> block)
+        {
+            if (!block)
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::FREE::NON_OPENGL_CONTEXT");
+            }
+            GLuint UBO = block->getBufferID();
+            if (UBO != 0)
+            {
+                glDeleteBuffers(1, &UBO);
+                cache::OpenGLStateCache::current().forgetBuffer(UBO);
+                block->setBufferID(0);
+                block->invalidate();
+            }
+        }
+    };
+}
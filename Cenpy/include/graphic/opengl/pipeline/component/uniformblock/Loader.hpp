@@ -0,0 +1,45 @@
+// file: Loader
+
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/profile/UniformBlock.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::uniformblock
+{
+    /**
+     * @class OpenGLUniformBlockLoader
+     * @brief Creates the uniform buffer of a block and uploads its whole staging copy.
+     */
+    template <auto PROFILE>
+    class OpenGLUniformBlockLoader
+    {
+    };
+
+    template <>
+    class OpenGLUniformBlockLoader<graphic::opengl::profile::UniformBlock::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::UniformBlockContext> block)
+        {
+            if (!block)
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::LOAD::NON_OPENGL_CONTEXT");
+            }
+            if (block->getBufferID() == 0)
+            {
+                GLuint UBO = 0;
+                glGenBuffers(1, &UBO);
+                block->setBufferID(UBO);
+            }
+            cache::OpenGLStateCache::current().bindBuffer(GL_UNIFORM_BUFFER, block->getBufferID());
+            glBufferData(GL_UNIFORM_BUFFER, block->getDataSize(), block->getData().data(), GL_DYNAMIC_DRAW);
+            block->markUploaded();
+        }
+    };
+}
@@ -0,0 +1,47 @@
+// file: Updater
+
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/profile/UniformBlock.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::component::uniformblock
+{
+    /**
+     * @class OpenGLUniformBlockUpdater
+     * @brief Uploads the dirty range of a block, if any, in a single glBufferSubData.
+     */
+    template <auto PROFILE>
+    class OpenGLUniformBlockUpdater
+    {
+    };
+
+    template <>
+    class OpenGLUniformBlockUpdater<graphic::opengl::profile::UniformBlock::Classic>
+    {
+    public:
+        static void on(std::shared_ptr<typename graphic::api::OpenGL::UniformBlockContext> block)
+        {
+            if (!block)
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::UPDATE::NON_OPENGL_CONTEXT");
+            }
+            if (!block->isDirty())
+            {
+                return;
+            }
+            if (block->getBufferID() == 0)
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::UPDATE::BUFFER_ID_NOT_SET");
+            }
+            cache::OpenGLStateCache::current().bindBuffer(GL_UNIFORM_BUFFER, block->getBufferID());
+            glBufferSubData(GL_UNIFORM_BUFFER, block->getDirtyOffset(), block->getDirtySize(), block->getData().data() + block->getDirtyOffset());
+            block->markUploaded();
+        }
+    };
+}
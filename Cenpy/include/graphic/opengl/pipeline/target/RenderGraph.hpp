@@ -0,0 +1,391 @@
+// file: RenderGraph.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/FusedPassCache.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/pipeline/target/RenderTargetPool.hpp>
+#include <graphic/pipeline/Pipeline.hpp>
+#include <graphic/render/PassFusion.hpp>
+#include <graphic/render/RenderGraph.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::target
+{
+    /**
+     * @class OpenGLRenderGraph
+     * @brief Executes the passes of a pipeline as a render graph, rendering to pooled targets.
+     *
+     * Each node uses a pass of the pipeline, rendering to the targets it writes with the targets it
+     * reads bound to the texture units, the first read on unit 0. Its draw callback issues the
+     * draws, e.g. a fullscreen triangle or the commands of a queue.
+     *
+     * compile() schedules the graph and takes a texture per slot from the pool, so transient
+     * targets whose lifetimes do not overlap share one, then creates the framebuffer of each node.
+     * execute() runs the nodes in order without allocating anything; it compiles first only when
+     * the graph changed, e.g. after resize().
+     *
+     * Point-wise nodes are not passes of the pipeline but stages, chained by compile() with the
+     * point-wise nodes around them into one generated pass, taken from the fused pass cache. A
+     * chain draws a fullscreen triangle with the source of its first stage on unit 0, and renders
+     * to the target of its last stage: the targets between its stages are never allocated.
+     *
+     * @tparam API Graphic API of the pipeline.
+     */
+    template <typename API>
+    class OpenGLRenderGraph
+    {
+    public:
+        using Draw = std::function<void()>;
+        /// Sets the uniforms of a point-wise stage on the pass in use, from their handles in declaration order, invalid if unused.
+        using Bind = std::function<void(graphic::pipeline::IPass<API> &, const std::vector<graphic::pipeline::UniformHandle> &)>;
+
+        /**
+         * @brief Creates an empty graph over a pipeline.
+         * @param pipeline Pipeline whose passes the nodes use. It must outlive the graph.
+         * @param pool Pool of the targets. It must outlive the graph.
+         * @param fusedPasses Passes of the chains of point-wise nodes, needed to add point-wise nodes.
+         */
+        OpenGLRenderGraph(graphic::pipeline::IPipeline<API> &pipeline, OpenGLRenderTargetPool &pool,
+                          std::shared_ptr<cache::OpenGLFusedPassCache<API>> fusedPasses = nullptr)
+            : m_pipeline(pipeline), m_pool(pool), m_fusedPasses(std::move(fusedPasses))
+        {
+        }
+
+        OpenGLRenderGraph(const OpenGLRenderGraph &) = delete;
+        OpenGLRenderGraph &operator=(const OpenGLRenderGraph &) = delete;
+
+        ~OpenGLRenderGraph()
+        {
+            releaseSlots();
+            if (m_vertexArray != 0)
+            {
+                glDeleteVertexArrays(1, &m_vertexArray);
+                cache::OpenGLStateCache::current().forgetVertexArray(m_vertexArray);
+            }
+        }
+
+        /**
+         * @brief Declares a transient target, allocated from the pool.
+         * @param name Name of the target.
+         * @param desc Size and format of the target.
+         * @return The target.
+         */
+        int addTarget(const std::string &name, const render::TargetDesc &desc)
+        {
+            return m_graph.addTarget(name, desc);
+        }
+
+        /**
+         * @brief Declares the default framebuffer as an output of the graph.
+         * @param width Width of the window.
+         * @param height Height of the window.
+         * @return The target. A node writing it writes no other target.
+         */
+        int importBackbuffer(int width, int height)
+        {
+            const int target = m_graph.importTarget("backbuffer", {width, height, render::TargetFormat::RGBA8});
+            m_imported[target] = 0;
+            return target;
+        }
+
+        /**
+         * @brief Declares a texture living outside the graph as an output of it.
+         * @param name Name of the target.
+         * @param desc Size and format of the texture.
+         * @param texture The texture, owned by the caller.
+         * @return The target.
+         */
+        int importTexture(const std::string &name, const render::TargetDesc &desc, GLuint texture)
+        {
+            const int target = m_graph.importTarget(name, desc);
+            m_imported[target] = texture;
+            return target;
+        }
+
+        /**
+         * @brief Resizes a target, keeping its format. The graph compiles again on next execution.
+         * @param target Target to resize.
+         * @param width New width.
+         * @param height New height.
+         */
+        void resize(int target, int width, int height)
+        {
+            m_graph.setDesc(target, {width, height, m_graph.getDesc(target).format});
+        }
+
+        /**
+         * @brief Declares a node using a pass of the pipeline.
+         * @param name Name of the node.
+         * @param pass Pass of the pipeline used.
+         * @param reads Targets bound to the texture units, in order.
+         * @param writes Targets rendered to: colors in attachment order, and at most one depth target.
+         * @param draw Issues the draws of the node, the pass in use.
+         * @return The node.
+         * @throws TraceableException if a target is unknown or both read and written.
+         */
+        int addPass(const std::string &name, int pass, const std::vector<int> &reads, const std::vector<int> &writes, Draw draw)
+        {
+            const int node = m_graph.addPass(name, reads, writes);
+            m_nodes.push_back({pass, std::move(draw), std::nullopt, {}});
+            return node;
+        }
+
+        /**
+         * @brief Declares a point-wise node, fused with the point-wise nodes around it.
+         * @param name Name of the node.
+         * @param stage Body of the node and its uniforms.
+         * @param source Target sampled, bound to unit 0.
+         * @param target Color target rendered to.
+         * @param bind Sets the uniforms of the stage each time it executes.
+         * @return The node.
+         * @throws TraceableException if the graph has no fused pass cache, or a target is invalid.
+         */
+        int addPointwisePass(const std::string &name, render::PointwiseStage stage, int source, int target, Bind bind = {})
+        {
+            if (!m_fusedPasses)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_GRAPH::NO_FUSED_PASS_CACHE\nPoint-wise pass {} needs a fused pass cache", name));
+            }
+            const int node = m_graph.addPointwisePass(name, source, target);
+            m_nodes.push_back({NO_PASS, {}, std::move(stage), std::move(bind)});
+            return node;
+        }
+
+        /**
+         * @brief Enables or disables the fusion of the point-wise nodes. The graph compiles again on next execution.
+         * @param fusion False to execute each point-wise node on its own, e.g. to compare the results.
+         */
+        void setFusion(bool fusion)
+        {
+            m_graph.setFusion(fusion);
+        }
+
+        /**
+         * @brief Schedules the graph, assigns the textures and creates the framebuffers.
+         * @throws TraceableException if the graph has a cycle, or a node mixes the backbuffer with other targets.
+         */
+        void compile()
+        {
+            m_graph.compile();
+            releaseSlots();
+            for (const auto &desc : m_graph.getSlots())
+            {
+                m_slotTextures.push_back(m_pool.acquire(desc));
+            }
+            m_pool.trim();
+
+            m_steps.clear();
+            for (int node : m_graph.getOrder())
+            {
+                Step step{node, 0, {}, {}, nullptr, {}};
+                std::vector<GLuint> colors;
+                GLuint depth = 0;
+                bool backbuffer = false;
+                for (int target : m_graph.getOutputs(node))
+                {
+                    const render::TargetDesc &desc = m_graph.getDesc(target);
+                    step.viewport = desc;
+                    if (auto imported = m_imported.find(target); imported != m_imported.end() && imported->second == 0)
+                    {
+                        backbuffer = true;
+                    }
+                    else if (desc.format == render::TargetFormat::DEPTH24_STENCIL8)
+                    {
+                        depth = getTexture(target);
+                    }
+                    else
+                    {
+                        colors.push_back(getTexture(target));
+                    }
+                }
+                if (backbuffer && (!colors.empty() || depth != 0))
+                {
+                    throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_GRAPH::BACKBUFFER_WITH_TARGETS\nPass {} writes the backbuffer along with other targets", m_graph.getPassName(node)));
+                }
+                if (!backbuffer && (!colors.empty() || depth != 0))
+                {
+                    step.framebuffer = m_pool.getFramebuffer(colors, depth);
+                }
+                for (int target : m_graph.getInputs(node))
+                {
+                    step.textures.push_back(getTexture(target));
+                }
+                if (m_nodes[node].stage)
+                {
+                    fuse(step);
+                }
+                m_steps.push_back(std::move(step));
+            }
+        }
+
+        /**
+         * @brief Runs the nodes in order, then resets the pipeline.
+         * @throws TraceableException if the graph must be compiled again and cannot be.
+         */
+        void execute()
+        {
+            if (!m_graph.isCompiled())
+            {
+                compile();
+            }
+            auto &state = cache::OpenGLStateCache::current();
+            for (const auto &step : m_steps)
+            {
+                state.bindFramebuffer(step.framebuffer);
+                glViewport(0, 0, step.viewport.width, step.viewport.height);
+                for (std::size_t unit = 0; unit < step.textures.size(); ++unit)
+                {
+                    state.bindTexture(static_cast<GLuint>(unit), GL_TEXTURE_2D, step.textures[unit]);
+                }
+                if (step.fusedPass)
+                {
+                    drawFused(step);
+                    continue;
+                }
+                const Node &node = m_nodes[step.node];
+                m_pipeline.use(node.pass);
+                if (node.draw)
+                {
+                    node.draw();
+                }
+            }
+            state.bindFramebuffer(0);
+            m_pipeline.reset();
+        }
+
+        /**
+         * @brief Get the texture of a target, e.g. to read an intermediate result.
+         * @param target Target of the graph.
+         * @return The texture, 0 for the backbuffer or a target not compiled yet.
+         */
+        [[nodiscard]] GLuint getTexture(int target) const
+        {
+            if (auto imported = m_imported.find(target); imported != m_imported.end())
+            {
+                return imported->second;
+            }
+            const int slot = m_graph.getSlot(target);
+            return slot < 0 || slot >= static_cast<int>(m_slotTextures.size()) ? 0 : m_slotTextures[slot];
+        }
+
+        [[nodiscard]] const render::RenderGraph &getGraph() const
+        {
+            return m_graph;
+        }
+
+    private:
+        static constexpr int NO_PASS = -1;
+
+        struct Node
+        {
+            int pass;                                    ///< Pass of the pipeline used, NO_PASS for a point-wise node.
+            Draw draw;                                   ///< Issues the draws.
+            std::optional<render::PointwiseStage> stage; ///< Body of a point-wise node.
+            Bind bind;                                   ///< Sets the uniforms of a point-wise node.
+        };
+
+        struct FusedBinding
+        {
+            int node;                                              ///< Point-wise node of the stage.
+            std::vector<graphic::pipeline::UniformHandle> handles; ///< Uniforms of the stage in the fused pass.
+        };
+
+        struct Step
+        {
+            int node;                                                 ///< Node executed.
+            GLuint framebuffer;                                       ///< Framebuffer rendered to, 0 for the backbuffer.
+            render::TargetDesc viewport;                              ///< Size of the targets written.
+            std::vector<GLuint> textures;                             ///< Textures of the targets read, by unit.
+            std::shared_ptr<graphic::pipeline::IPass<API>> fusedPass; ///< Pass of a chain of point-wise nodes.
+            std::vector<FusedBinding> bindings;                       ///< Uniforms of each stage of the chain.
+        };
+
+        /**
+         * @brief Takes the pass of the chain of point-wise nodes a step executes, and resolves their uniforms.
+         *
+         * A stage writing a normalized intermediate target is clamped, as it would be unfused.
+         *
+         * @param step Step of the first node of the chain.
+         */
+        void fuse(Step &step)
+        {
+            const std::vector<int> &chain = m_graph.getChain(step.node);
+            std::vector<render::FusedStage> stages;
+            for (std::size_t index = 0; index < chain.size(); ++index)
+            {
+                const bool intermediate = index + 1 < chain.size();
+                const render::TargetFormat format = m_graph.getDesc(m_graph.getWrites(chain[index]).front()).format;
+                stages.push_back({&*m_nodes[chain[index]].stage, intermediate && format == render::TargetFormat::RGBA8});
+            }
+            step.fusedPass = m_fusedPasses->acquire(stages);
+
+            const auto &uniforms = step.fusedPass->getUniforms();
+            for (std::size_t index = 0; index < chain.size(); ++index)
+            {
+                const Node &node = m_nodes[chain[index]];
+                FusedBinding binding{chain[index], {}};
+                for (const auto &uniform : node.stage->uniforms)
+                {
+                    // A uniform the compiler optimized out keeps an invalid handle, that bind must skip.
+                    const std::string name = render::PassFusion::getUniformName(index, uniform.name);
+                    binding.handles.push_back(uniforms.contains(name) ? step.fusedPass->getUniformHandle(name) : graphic::pipeline::UniformHandle{});
+                }
+                step.bindings.push_back(std::move(binding));
+            }
+        }
+
+        /**
+         * @brief Draws the fullscreen triangle of a chain of point-wise nodes, its uniforms set.
+         * @param step Step of the chain.
+         */
+        void drawFused(const Step &step)
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            step.fusedPass->use();
+            for (const auto &binding : step.bindings)
+            {
+                if (const Bind &bind = m_nodes[binding.node].bind)
+                {
+                    bind(*step.fusedPass, binding.handles);
+                }
+            }
+            if (m_vertexArray == 0)
+            {
+                // The triangle has no attributes, but a core profile draws with a vertex array bound.
+                glGenVertexArrays(1, &m_vertexArray);
+            }
+            state.bindVertexArray(m_vertexArray);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+
+        void releaseSlots()
+        {
+            for (GLuint texture : m_slotTextures)
+            {
+                m_pool.release(texture);
+            }
+            m_slotTextures.clear();
+        }
+
+        graphic::pipeline::IPipeline<API> &m_pipeline;                   ///< Pipeline whose passes are used.
+        OpenGLRenderTargetPool &m_pool;                                  ///< Pool of the textures and framebuffers.
+        std::shared_ptr<cache::OpenGLFusedPassCache<API>> m_fusedPasses; ///< Passes of the chains of point-wise nodes.
+        render::RenderGraph m_graph;                                     ///< Schedule of the nodes.
+        std::vector<Node> m_nodes;                                       ///< Nodes, by index in the graph.
+        std::unordered_map<int, GLuint> m_imported;                      ///< Textures of the imported targets, 0 for the backbuffer.
+        std::vector<GLuint> m_slotTextures;                              ///< Texture of each slot of the graph.
+        std::vector<Step> m_steps;                                       ///< Compiled nodes, in execution order.
+        GLuint m_vertexArray = 0;                                        ///< Empty vertex array of the fullscreen triangles.
+    };
+}
@@ -0,0 +1,226 @@
+// file: RenderTargetPool.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/render/RenderGraph.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::target
+{
+    /**
+     * @class OpenGLRenderTargetPool
+     * @brief Keeps the textures and framebuffers of the render targets to reuse them.
+     *
+     * acquire() hands out a released texture of the same description before creating one, so
+     * compiling a render graph again only allocates the targets whose size or format changed.
+     * The framebuffers are cached by attachments. trim() deletes the released textures and the
+     * framebuffers attaching them.
+     */
+    class OpenGLRenderTargetPool
+    {
+    public:
+        OpenGLRenderTargetPool() = default;
+        OpenGLRenderTargetPool(const OpenGLRenderTargetPool &) = delete;
+        OpenGLRenderTargetPool &operator=(const OpenGLRenderTargetPool &) = delete;
+
+        ~OpenGLRenderTargetPool()
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            for (const auto &[attachments, framebuffer] : m_framebuffers)
+            {
+                glDeleteFramebuffers(1, &framebuffer);
+                state.forgetFramebuffer(framebuffer);
+            }
+            for (const auto &texture : m_textures)
+            {
+                glDeleteTextures(1, &texture.name);
+                state.forgetTexture(texture.name);
+            }
+        }
+
+        /**
+         * @brief Get a texture of a description, reusing a released one if any.
+         * @param desc Size and format of the texture.
+         * @return The texture, used until released.
+         */
+        GLuint acquire(const render::TargetDesc &desc)
+        {
+            for (auto &texture : m_textures)
+            {
+                if (!texture.used && texture.desc == desc)
+                {
+                    texture.used = true;
+                    return texture.name;
+                }
+            }
+            const auto [internalFormat, format, type] = toGL(desc.format);
+            GLuint name = 0;
+            glGenTextures(1, &name);
+            cache::OpenGLStateCache::current().bindTexture(0, GL_TEXTURE_2D, name);
+            glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(internalFormat), desc.width, desc.height, 0, format, type, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            m_textures.push_back({name, desc, true});
+            ++m_allocations;
+            return name;
+        }
+
+        /**
+         * @brief Gives a texture back to the pool. It is kept until trimmed.
+         * @param texture Texture returned by acquire.
+         */
+        void release(GLuint texture)
+        {
+            for (auto &pooled : m_textures)
+            {
+                if (pooled.name == texture)
+                {
+                    pooled.used = false;
+                }
+            }
+        }
+
+        /**
+         * @brief Get the framebuffer rendering to textures of the pool, creating it once.
+         * @param colors Textures attached to the color attachments, in order.
+         * @param depth Texture attached to the depth and stencil attachment, 0 for none.
+         * @return The framebuffer.
+         * @throws TraceableException if the framebuffer is not complete.
+         */
+        GLuint getFramebuffer(const std::vector<GLuint> &colors, GLuint depth)
+        {
+            std::vector<GLuint> attachments = colors;
+            attachments.push_back(depth);
+            if (auto it = m_framebuffers.find(attachments); it != m_framebuffers.end())
+            {
+                return it->second;
+            }
+
+            GLuint framebuffer = 0;
+            glGenFramebuffers(1, &framebuffer);
+            cache::OpenGLStateCache::current().bindFramebuffer(framebuffer);
+            std::vector<GLenum> drawBuffers;
+            for (std::size_t color = 0; color < colors.size(); ++color)
+            {
+                glFramebufferTexture2D(GL_FRAMEBUFFER, static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + color), GL_TEXTURE_2D, colors[color], 0);
+                drawBuffers.push_back(static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + color));
+            }
+            if (depth != 0)
+            {
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+            }
+            if (drawBuffers.empty())
+            {
+                drawBuffers.push_back(GL_NONE);
+            }
+            glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+            if (const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER); status != GL_FRAMEBUFFER_COMPLETE)
+            {
+                glDeleteFramebuffers(1, &framebuffer);
+                cache::OpenGLStateCache::current().forgetFramebuffer(framebuffer);
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_GRAPH::INCOMPLETE_FRAMEBUFFER\nStatus {:#x} with {} color attachments", status, colors.size()));
+            }
+            m_framebuffers.emplace(std::move(attachments), framebuffer);
+            return framebuffer;
+        }
+
+        /**
+         * @brief Deletes the released textures and the framebuffers attaching them.
+         */
+        void trim()
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            std::erase_if(m_framebuffers, [this, &state](const auto &entry)
+                          {
+                              for (GLuint attachment : entry.first)
+                              {
+                                  if (isReleased(attachment))
+                                  {
+                                      glDeleteFramebuffers(1, &entry.second);
+                                      state.forgetFramebuffer(entry.second);
+                                      return true;
+                                  }
+                              }
+                              return false; });
+            std::erase_if(m_textures, [&state](const Texture &texture)
+                          {
+                              if (texture.used)
+                              {
+                                  return false;
+                              }
+                              glDeleteTextures(1, &texture.name);
+                              state.forgetTexture(texture.name);
+                              return true; });
+        }
+
+        /**
+         * @brief Get the number of textures held, used or released.
+         * @return Number of textures.
+         */
+        [[nodiscard]] std::size_t getTexturesCount() const
+        {
+            return m_textures.size();
+        }
+
+        /**
+         * @brief Get the number of textures created since the pool was.
+         * @return Number of allocations.
+         */
+        [[nodiscard]] std::size_t getAllocations() const
+        {
+            return m_allocations;
+        }
+
+        /**
+         * @brief Converts a target format to the formats of its texture.
+         * @param format Format of a target.
+         * @return The internal format, and the format and type of its pixels.
+         */
+        static std::tuple<GLenum, GLenum, GLenum> toGL(render::TargetFormat format)
+        {
+            switch (format)
+            {
+            case render::TargetFormat::RGBA16F:
+                return {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT};
+            case render::TargetFormat::DEPTH24_STENCIL8:
+                return {GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8};
+            default:
+                return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE};
+            }
+        }
+
+    private:
+        struct Texture
+        {
+            GLuint name;             ///< GL name of the texture.
+            render::TargetDesc desc; ///< Size and format of the texture.
+            bool used;               ///< Whether the texture is acquired.
+        };
+
+        /**
+         * @brief Tells whether a texture is a released texture of the pool.
+         * @param name Texture attached to a framebuffer, possibly imported from outside the pool.
+         * @return True if the texture is about to be trimmed.
+         */
+        [[nodiscard]] bool isReleased(GLuint name) const
+        {
+            return std::ranges::any_of(m_textures, [name](const Texture &texture)
+                                       { return texture.name == name && !texture.used; });
+        }
+
+        std::vector<Texture> m_textures;                        ///< Textures created, used or released.
+        std::map<std::vector<GLuint>, GLuint> m_framebuffers;   ///< Framebuffers, by color attachments then depth attachment.
+        std::size_t m_allocations = 0;                          ///< Textures created.
+    };
+}
@@ -0,0 +1,438 @@
+// file: AsyncTextureLoader.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <format>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+#include <common/thread/WorkerPool.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::texture
+{
+    /**
+     * @struct DecodedImage
+     * @brief Pixels of a decoded image file, or the blocks of its compressed mip chain.
+     */
+    struct DecodedImage
+    {
+        int width = 0;                                 ///< Width of the image.
+        int height = 0;                                ///< Height of the image.
+        std::vector<std::uint8_t> rgba;                ///< Pixels, 4 bytes each, rows in the order they are uploaded: bottom row first.
+        GLenum compressedFormat = 0;                   ///< Internal format of the compressed levels, 0 for RGBA pixels.
+        std::vector<std::vector<std::uint8_t>> levels; ///< Blocks of the compressed mip chain, base level first.
+    };
+
+    /**
+     * @class OpenGLTextureHandle
+     * @brief Texture being loaded, bound as the placeholder of its loader until it is ready.
+     *
+     * The handle owns the texture; the placeholder belongs to the loader.
+     */
+    class OpenGLTextureHandle
+    {
+    public:
+        enum class State
+        {
+            DECODING,
+            UPLOADING,
+            READY,
+            FAILED
+        };
+
+        OpenGLTextureHandle(std::string path, GLuint placeholder) : m_path(std::move(path)), m_placeholder(placeholder)
+        {
+        }
+
+        OpenGLTextureHandle(const OpenGLTextureHandle &) = delete;
+        OpenGLTextureHandle &operator=(const OpenGLTextureHandle &) = delete;
+
+        ~OpenGLTextureHandle()
+        {
+            if (m_texture != 0)
+            {
+                glDeleteTextures(1, &m_texture);
+                cache::OpenGLStateCache::current().forgetTexture(m_texture);
+            }
+        }
+
+        /**
+         * @brief Get the texture to bind: the loaded texture once ready, the placeholder until then.
+         * @return The texture to draw with.
+         */
+        [[nodiscard]] GLuint getTexture() const
+        {
+            return m_state == State::READY ? m_texture : m_placeholder;
+        }
+
+        [[nodiscard]] bool isReady() const
+        {
+            return m_state == State::READY;
+        }
+
+        [[nodiscard]] State getState() const
+        {
+            return m_state;
+        }
+
+        [[nodiscard]] const std::string &getPath() const
+        {
+            return m_path;
+        }
+
+        /**
+         * @brief Get why the texture failed to load.
+         * @return The error, empty unless FAILED.
+         */
+        [[nodiscard]] const std::string &getError() const
+        {
+            return m_error;
+        }
+
+        [[nodiscard]] int getWidth() const
+        {
+            return m_width;
+        }
+
+        [[nodiscard]] int getHeight() const
+        {
+            return m_height;
+        }
+
+        /**
+         * @brief Get the bytes of the compressed mip chain of the texture.
+         * @return Bytes of every level, 0 for an RGBA texture or until ready.
+         */
+        [[nodiscard]] std::size_t getCompressedBytes() const
+        {
+            return m_compressedBytes;
+        }
+
+    private:
+        friend class OpenGLAsyncTextureLoader;
+
+        std::string m_path;                ///< File of the texture.
+        GLuint m_placeholder;              ///< Texture bound until the texture is ready.
+        GLuint m_texture = 0;              ///< Loaded texture, created when its upload starts.
+        State m_state = State::DECODING;   ///< Progress of the load.
+        std::string m_error;               ///< Why the load failed.
+        int m_width = 0;                   ///< Width of the texture, once decoded.
+        int m_height = 0;                  ///< Height of the texture, once decoded.
+        std::size_t m_compressedBytes = 0; ///< Bytes of the compressed levels, once ready.
+    };
+
+    /**
+     * @class OpenGLAsyncTextureLoader
+     * @brief Decodes image files on a worker pool and uploads them across frames.
+     *
+     * load() queues the decoding of a file and returns a handle bound as a 1x1 transparent
+     * placeholder. update(), called once per frame on the thread of the GL context, collects the
+     * decoded images and uploads at most a budget of bytes: a large image is uploaded a band of
+     * rows per frame, so switching backgrounds never stalls a frame. The rows are staged through a
+     * pixel buffer object, orphaned for each band, so the copy to the texture runs asynchronously.
+     * The mipmaps are generated once the last band is uploaded, then the handle is ready.
+     *
+     * A compressed image comes with its mip chain, and no mipmap is generated. Its levels count
+     * against the same budget: a level larger than the bytes left in the frame is uploaded a band
+     * of rows of blocks per frame, at least one.
+     *
+     * The decoder runs on the workers: it must be thread-safe and return 8 bits RGBA pixels, bottom
+     * row first as OpenGL expects them, e.g. by calling stbi_load with 4 desired channels after
+     * stbi_set_flip_vertically_on_load(true), or compressed levels the driver supports, stored in
+     * the same row order. It reports a failure by throwing.
+     */
+    class OpenGLAsyncTextureLoader
+    {
+    public:
+        using Decoder = std::function<DecodedImage(const std::string &)>;
+
+        static constexpr std::size_t DEFAULT_BUDGET = 4 * 1024 * 1024; ///< Bytes uploaded per frame by default.
+
+        /**
+         * @brief Creates the placeholder texture and the pixel buffer.
+         * @param decoder Decodes an image file into RGBA pixels.
+         * @param budget Bytes uploaded per frame. A frame uploads at least one row.
+         * @param pool Pool whose workers decode the files.
+         */
+        explicit OpenGLAsyncTextureLoader(Decoder decoder, std::size_t budget = DEFAULT_BUDGET,
+                                          common::thread::WorkerPool &pool = common::thread::WorkerPool::shared())
+            : m_decoder(std::move(decoder)), m_budget(budget), m_pool(pool)
+        {
+            constexpr std::array<std::uint8_t, 4> transparent{0, 0, 0, 0};
+            glGenTextures(1, &m_placeholder);
+            cache::OpenGLStateCache::current().bindTexture(0, GL_TEXTURE_2D, m_placeholder);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, transparent.data());
+            glGenBuffers(1, &m_pixelBuffer);
+        }
+
+        OpenGLAsyncTextureLoader(const OpenGLAsyncTextureLoader &) = delete;
+        OpenGLAsyncTextureLoader &operator=(const OpenGLAsyncTextureLoader &) = delete;
+
+        ~OpenGLAsyncTextureLoader()
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            glDeleteBuffers(1, &m_pixelBuffer);
+            state.forgetBuffer(m_pixelBuffer);
+            glDeleteTextures(1, &m_placeholder);
+            state.forgetTexture(m_placeholder);
+        }
+
+        /**
+         * @brief Queues the loading of an image file.
+         * @param path File to decode.
+         * @return The handle of the texture, which deletes it once released.
+         */
+        std::shared_ptr<OpenGLTextureHandle> load(const std::string &path)
+        {
+            auto handle = std::make_shared<OpenGLTextureHandle>(path, m_placeholder);
+            m_decodes.push_back({handle, m_pool.submit([decoder = m_decoder, path]()
+                                                       { return decoder(path); })});
+            return handle;
+        }
+
+        /**
+         * @brief Collects the decoded images and uploads the next rows, within the budget.
+         *
+         * Call it once per frame, on the thread of the GL context.
+         *
+         * @return Bytes uploaded.
+         */
+        std::size_t update()
+        {
+            collect();
+
+            std::size_t uploaded = 0;
+            while (!m_uploads.empty() && uploaded < m_budget)
+            {
+                Upload &upload = m_uploads.front();
+                uploaded += upload.image.compressedFormat != 0 ? uploadLevel(upload, m_budget - uploaded) : uploadRows(upload, m_budget - uploaded);
+                if (upload.image.compressedFormat != 0 ? upload.nextLevel == upload.image.levels.size() : upload.nextRow == upload.image.height)
+                {
+                    finish(upload);
+                    m_uploads.pop_front();
+                }
+            }
+            if (uploaded != 0)
+            {
+                // Texture uploads outside the loader read client memory again.
+                cache::OpenGLStateCache::current().bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            return uploaded;
+        }
+
+        /**
+         * @brief Get the number of textures still decoding or uploading.
+         * @return Number of pending loads.
+         */
+        [[nodiscard]] std::size_t getPendingCount() const
+        {
+            return m_decodes.size() + m_uploads.size();
+        }
+
+        [[nodiscard]] GLuint getPlaceholder() const
+        {
+            return m_placeholder;
+        }
+
+    private:
+        struct Decode
+        {
+            std::shared_ptr<OpenGLTextureHandle> handle; ///< Handle of the texture.
+            std::future<DecodedImage> image;             ///< Image decoded by a worker.
+        };
+
+        struct Upload
+        {
+            std::shared_ptr<OpenGLTextureHandle> handle; ///< Handle of the texture.
+            DecodedImage image;                          ///< Pixels to upload.
+            int nextRow = 0;                             ///< First row not uploaded yet.
+            std::size_t nextLevel = 0;                   ///< First compressed level not uploaded yet.
+            int nextBlockRow = 0;                        ///< First row of blocks of that level not uploaded yet.
+        };
+
+        /**
+         * @brief Moves the decoded images to the upload queue, in completion order.
+         */
+        void collect()
+        {
+            std::erase_if(m_decodes, [this](Decode &decode)
+                          {
+                              if (decode.image.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                              {
+                                  return false;
+                              }
+                              try
+                              {
+                                  DecodedImage image = decode.image.get();
+                                  if (image.compressedFormat != 0)
+                                  {
+                                      if (image.width <= 0 || image.height <= 0 || image.levels.empty() || std::ranges::any_of(image.levels, [](const auto &level) { return level.empty(); }))
+                                      {
+                                          throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::TEXTURE::INVALID_IMAGE\n{}: {}x{} with {} levels", decode.handle->m_path, image.width, image.height, image.levels.size()));
+                                      }
+                                  }
+                                  else if (image.width <= 0 || image.height <= 0 || image.rgba.size() != static_cast<std::size_t>(image.width) * image.height * 4)
+                                  {
+                                      throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::TEXTURE::INVALID_IMAGE\n{}: {}x{} with {} bytes", decode.handle->m_path, image.width, image.height, image.rgba.size()));
+                                  }
+                                  decode.handle->m_width = image.width;
+                                  decode.handle->m_height = image.height;
+                                  decode.handle->m_state = OpenGLTextureHandle::State::UPLOADING;
+                                  m_uploads.push_back({decode.handle, std::move(image)});
+                              }
+                              catch (const std::exception &e)
+                              {
+                                  decode.handle->m_state = OpenGLTextureHandle::State::FAILED;
+                                  decode.handle->m_error = e.what();
+                              }
+                              return true; });
+        }
+
+        /**
+         * @brief Uploads the next band of rows of an image through the pixel buffer.
+         * @param upload Image being uploaded.
+         * @param budget Bytes left this frame.
+         * @return Bytes uploaded.
+         */
+        std::size_t uploadRows(Upload &upload, std::size_t budget)
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            const std::size_t rowSize = static_cast<std::size_t>(upload.image.width) * 4;
+            if (upload.handle->m_texture == 0)
+            {
+                glGenTextures(1, &upload.handle->m_texture);
+                state.bindTexture(0, GL_TEXTURE_2D, upload.handle->m_texture);
+                state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, upload.image.width, upload.image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            }
+            const int rows = static_cast<int>(std::clamp<std::size_t>(budget / rowSize, 1, static_cast<std::size_t>(upload.image.height - upload.nextRow)));
+            const std::size_t bytes = rowSize * rows;
+
+            stage(upload.image.rgba.data() + rowSize * upload.nextRow, bytes);
+            state.bindTexture(0, GL_TEXTURE_2D, upload.handle->m_texture);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, upload.nextRow, upload.image.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            upload.nextRow += rows;
+            return bytes;
+        }
+
+        /**
+         * @brief Uploads the next compressed level of an image through the pixel buffer, or its next band of rows of blocks.
+         *
+         * A level fitting in the budget is uploaded at once. A larger one is allocated first, then
+         * filled a band of whole rows of blocks at a time.
+         *
+         * @param upload Image being uploaded.
+         * @param budget Bytes left this frame.
+         * @return Bytes uploaded.
+         */
+        std::size_t uploadLevel(Upload &upload, std::size_t budget)
+        {
+            auto &state = cache::OpenGLStateCache::current();
+            if (upload.handle->m_texture == 0)
+            {
+                glGenTextures(1, &upload.handle->m_texture);
+                state.bindTexture(0, GL_TEXTURE_2D, upload.handle->m_texture);
+                // The chain may stop before 1x1; the texture is complete with the levels it has.
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(upload.image.levels.size() - 1));
+            }
+            const auto level = static_cast<GLint>(upload.nextLevel);
+            const std::vector<std::uint8_t> &blocks = upload.image.levels[upload.nextLevel];
+            const GLsizei width = std::max(1, upload.image.width >> level);
+            const GLsizei height = std::max(1, upload.image.height >> level);
+
+            if (upload.nextBlockRow == 0 && blocks.size() <= budget)
+            {
+                stage(blocks.data(), blocks.size());
+                state.bindTexture(0, GL_TEXTURE_2D, upload.handle->m_texture);
+                glCompressedTexImage2D(GL_TEXTURE_2D, level, upload.image.compressedFormat, width, height, 0, static_cast<GLsizei>(blocks.size()), nullptr);
+                ++upload.nextLevel;
+                return blocks.size();
+            }
+
+            state.bindTexture(0, GL_TEXTURE_2D, upload.handle->m_texture);
+            if (upload.nextBlockRow == 0)
+            {
+                state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                glCompressedTexImage2D(GL_TEXTURE_2D, level, upload.image.compressedFormat, width, height, 0, static_cast<GLsizei>(blocks.size()), nullptr);
+            }
+            const int blockRows = (height + 3) / 4;
+            const std::size_t rowSize = blocks.size() / blockRows;
+            const int rows = static_cast<int>(std::clamp<std::size_t>(budget / rowSize, 1, static_cast<std::size_t>(blockRows - upload.nextBlockRow)));
+            const std::size_t bytes = rowSize * rows;
+            const GLint y = upload.nextBlockRow * 4;
+
+            stage(blocks.data() + rowSize * upload.nextBlockRow, bytes);
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, std::min(rows * 4, height - y), upload.image.compressedFormat, static_cast<GLsizei>(bytes), nullptr);
+            upload.nextBlockRow += rows;
+            if (upload.nextBlockRow == blockRows)
+            {
+                upload.nextBlockRow = 0;
+                ++upload.nextLevel;
+            }
+            return bytes;
+        }
+
+        /**
+         * @brief Copies bytes to the pixel buffer, orphaning its previous content, and leaves it bound.
+         * @param data Bytes to upload.
+         * @param bytes Number of bytes.
+         */
+        void stage(const std::uint8_t *data, std::size_t bytes) const
+        {
+            cache::OpenGLStateCache::current().bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBuffer);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+            void *staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (staging != nullptr)
+            {
+                std::memcpy(staging, data, bytes);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+            else
+            {
+                glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), data);
+            }
+        }
+
+        /**
+         * @brief Generates the mipmaps of an uploaded texture, unless it came with them, and makes its handle ready.
+         * @param upload Uploaded image.
+         */
+        static void finish(Upload &upload)
+        {
+            cache::OpenGLStateCache::current().bindTexture(0, GL_TEXTURE_2D, upload.handle->m_texture);
+            const bool mipmapped = upload.image.compressedFormat == 0 || upload.image.levels.size() > 1;
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            if (upload.image.compressedFormat == 0)
+            {
+                glGenerateMipmap(GL_TEXTURE_2D);
+            }
+            for (const auto &level : upload.image.levels)
+            {
+                upload.handle->m_compressedBytes += level.size();
+            }
+            upload.handle->m_state = OpenGLTextureHandle::State::READY;
+        }
+
+        Decoder m_decoder;                  ///< Decodes the files, on the workers.
+        std::size_t m_budget;               ///< Bytes uploaded per frame.
+        common::thread::WorkerPool &m_pool; ///< Workers decoding the files.
+        GLuint m_placeholder = 0;           ///< Texture bound until a texture is ready.
+        GLuint m_pixelBuffer = 0;           ///< Staging buffer of the uploads.
+        std::vector<Decode> m_decodes;      ///< Files being decoded.
+        std::deque<Upload> m_uploads;       ///< Decoded images being uploaded, in order.
+    };
+}
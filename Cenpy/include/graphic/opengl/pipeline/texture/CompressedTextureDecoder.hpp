@@ -0,0 +1,136 @@
+// file: CompressedTextureDecoder.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <common/io/MappedFile.hpp>
+#include <graphic/opengl/pipeline/texture/AsyncTextureLoader.hpp>
+#include <graphic/texture/Ktx2.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::texture
+{
+    /**
+     * @class OpenGLCompressedTextureDecoder
+     * @brief Decoder of the texture loader preferring the precompressed KTX2 of an image file.
+     *
+     * Decoding "name.png" reads "name.ktx2" instead when it exists and the driver supports its
+     * format, giving the blocks of its stored mip chain. Otherwise, or when the KTX2 cannot be
+     * read, the image goes through the fallback decoder, uploaded as RGBA with generated mipmaps.
+     * A KTX2 storing its top row first falls back too: its blocks cannot be flipped in general,
+     * and it would be upside down next to the fallback, which gives the bottom row first. This is
+     * the default of most external tools, so their KTX2, BC7 and ETC2 included, only load when
+     * written bottom row first, e.g. with toktx --lower_left_maps_to_s0t0, which records it as
+     * KTXorientation "ru"; the texture converter always does.
+     *
+     * The supported formats are queried on construction, on the thread of the GL context; decoding
+     * does not call GL and runs on the workers of the loader.
+     */
+    class OpenGLCompressedTextureDecoder
+    {
+    public:
+        /**
+         * @brief Queries the compressed formats supported by the driver.
+         * @param fallback Decodes an image file into RGBA pixels.
+         */
+        explicit OpenGLCompressedTextureDecoder(OpenGLAsyncTextureLoader::Decoder fallback) : m_fallback(std::move(fallback))
+        {
+            namespace vk_format = graphic::texture::vk_format;
+            if (glewIsSupported("GL_EXT_texture_compression_s3tc"))
+            {
+                m_formats[vk_format::BC1_RGB_UNORM] = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                m_formats[vk_format::BC1_RGBA_UNORM] = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                m_formats[vk_format::BC3_UNORM] = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            }
+            if (glewIsSupported("GL_EXT_texture_compression_s3tc") && glewIsSupported("GL_EXT_texture_sRGB"))
+            {
+                m_formats[vk_format::BC1_RGB_SRGB] = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+                m_formats[vk_format::BC1_RGBA_SRGB] = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+                m_formats[vk_format::BC3_SRGB] = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            }
+            if (glewIsSupported("GL_ARB_texture_compression_bptc"))
+            {
+                m_formats[vk_format::BC7_UNORM] = GL_COMPRESSED_RGBA_BPTC_UNORM;
+                m_formats[vk_format::BC7_SRGB] = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+            }
+            if (glewIsSupported("GL_ARB_ES3_compatibility"))
+            {
+                m_formats[vk_format::ETC2_RGB8_UNORM] = GL_COMPRESSED_RGB8_ETC2;
+                m_formats[vk_format::ETC2_RGB8_SRGB] = GL_COMPRESSED_SRGB8_ETC2;
+                m_formats[vk_format::ETC2_RGBA8_UNORM] = GL_COMPRESSED_RGBA8_ETC2_EAC;
+                m_formats[vk_format::ETC2_RGBA8_SRGB] = GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+            }
+        }
+
+        /**
+         * @brief Decodes an image file, from its KTX2 when possible.
+         * @param path File of the image.
+         * @return The compressed levels of the KTX2, or the RGBA pixels of the fallback.
+         */
+        DecodedImage operator()(const std::string &path) const
+        {
+            if (auto compressed = readCompressed(std::filesystem::path(path).replace_extension(".ktx2")))
+            {
+                return std::move(*compressed);
+            }
+            return m_fallback(path);
+        }
+
+        /**
+         * @brief Get the internal format uploading a KTX2 format.
+         * @param format VkFormat of the KTX2.
+         * @return The GL internal format, 0 if the driver does not support it.
+         */
+        [[nodiscard]] GLenum getInternalFormat(std::uint32_t format) const
+        {
+            auto it = m_formats.find(format);
+            return it == m_formats.end() ? 0 : it->second;
+        }
+
+    private:
+        /**
+         * @brief Reads a KTX2 file if it exists, stores its bottom row first and the driver supports its format.
+         * @param path File to read.
+         * @return The compressed levels, nothing to fall back.
+         */
+        std::optional<DecodedImage> readCompressed(const std::filesystem::path &path) const
+        {
+            std::error_code error;
+            if (!std::filesystem::is_regular_file(path, error))
+            {
+                return std::nullopt;
+            }
+            try
+            {
+                common::io::MappedFile file(path);
+                graphic::texture::CompressedImage compressed = graphic::texture::Ktx2::read(file.view(), path.string());
+                const GLenum format = getInternalFormat(compressed.format);
+                if (format == 0 || !compressed.bottomUp)
+                {
+                    return std::nullopt;
+                }
+                DecodedImage image{compressed.width, compressed.height, {}, format, {}};
+                for (auto &level : compressed.levels)
+                {
+                    image.levels.push_back(std::move(level.data));
+                }
+                return image;
+            }
+            catch (const std::runtime_error &)
+            {
+                // A broken KTX2 must not hide its source image.
+                return std::nullopt;
+            }
+        }
+
+        OpenGLAsyncTextureLoader::Decoder m_fallback;          ///< Decodes the images without usable KTX2.
+        std::unordered_map<std::uint32_t, GLenum> m_formats; ///< GL internal formats of the supported VkFormats.
+    };
+}
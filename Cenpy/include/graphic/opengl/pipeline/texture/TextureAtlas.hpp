@@ -0,0 +1,323 @@
+// file: TextureAtlas.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/texture/SkylinePacker.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::texture
+{
+    /**
+     * @struct AtlasRegion
+     * @brief Where an image of the atlas is, to draw it.
+     */
+    struct AtlasRegion
+    {
+        GLuint texture = 0;                                   ///< Texture of the page holding the image.
+        std::array<float, 4> uvRect{0.0f, 0.0f, 1.0f, 1.0f};  ///< Texture coordinates of the bottom left and top right corners.
+        int width = 0;                                        ///< Width of the image.
+        int height = 0;                                       ///< Height of the image.
+    };
+
+    /**
+     * @class OpenGLTextureAtlas
+     * @brief Packs many small RGBA images into a few large textures, so the sprites using them
+     * share a texture and are batched together.
+     *
+     * Each page is a GL_TEXTURE_2D packed by a SkylinePacker. An added image goes to the first page
+     * it fits in; the images already placed do not move. Each image is surrounded by a border
+     * repeating its edge texels, so linear filtering never reads its neighbours.
+     *
+     * Removed images leave holes the skyline cannot reuse. When an image fits no page, the page
+     * with the most removed area is repacked with its remaining images, if they all fit along with
+     * the new one; the moved images are uploaded again, and their regions change. Otherwise a page
+     * is created. Look the regions up by name each frame rather than keeping them.
+     *
+     * The atlas keeps a copy of the pixels of its images, to repack them without reading the GPU.
+     */
+    class OpenGLTextureAtlas
+    {
+    public:
+        /**
+         * @brief Creates an empty atlas. Pages are created as the images are added.
+         * @param pageSize Width and height of the pages.
+         * @param padding Texels repeating the edges of each image.
+         */
+        explicit OpenGLTextureAtlas(int pageSize = 2048, int padding = 1) : m_pageSize(pageSize), m_padding(padding)
+        {
+        }
+
+        OpenGLTextureAtlas(const OpenGLTextureAtlas &) = delete;
+        OpenGLTextureAtlas &operator=(const OpenGLTextureAtlas &) = delete;
+
+        ~OpenGLTextureAtlas()
+        {
+            for (const auto &page : m_pages)
+            {
+                glDeleteTextures(1, &page.texture);
+                cache::OpenGLStateCache::current().forgetTexture(page.texture);
+            }
+        }
+
+        /**
+         * @brief Adds an image, replacing the image of the same name.
+         * @param name Name the image is looked up by.
+         * @param width Width of the image.
+         * @param height Height of the image.
+         * @param rgba Pixels, 4 bytes each, rows from the bottom.
+         * @return The region of the image.
+         * @throws TraceableException if the pixels do not match the size, or the image cannot fit a page.
+         */
+        const AtlasRegion &add(const std::string &name, int width, int height, std::span<const std::uint8_t> rgba)
+        {
+            if (width <= 0 || height <= 0 || rgba.size() != static_cast<std::size_t>(width) * height * 4)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::TEXTURE_ATLAS::INVALID_IMAGE\n{}: {}x{} with {} bytes", name, width, height, rgba.size()));
+            }
+            if (width + 2 * m_padding > m_pageSize || height + 2 * m_padding > m_pageSize)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::TEXTURE_ATLAS::IMAGE_TOO_LARGE\n{}: {}x{} in pages of {}", name, width, height, m_pageSize));
+            }
+            remove(name);
+
+            Image image;
+            image.width = width;
+            image.height = height;
+            image.pixels = pad(width, height, rgba);
+            auto &entry = m_images.emplace(name, std::move(image)).first->second;
+            place(entry);
+            return entry.region;
+        }
+
+        /**
+         * @brief Removes an image. Its area is reused once its page is repacked.
+         * @param name Name of the image.
+         * @return True if the atlas held the image.
+         */
+        bool remove(const std::string &name)
+        {
+            auto it = m_images.find(name);
+            if (it == m_images.end())
+            {
+                return false;
+            }
+            Page &page = m_pages[it->second.page];
+            page.freedArea += paddedArea(it->second);
+            if (--page.images == 0)
+            {
+                page.packer.reset();
+                page.freedArea = 0;
+            }
+            m_images.erase(it);
+            return true;
+        }
+
+        /**
+         * @brief Get the region of an image.
+         * @param name Name of the image.
+         * @return The region, nullptr if the atlas has no image of this name.
+         */
+        [[nodiscard]] const AtlasRegion *find(const std::string &name) const
+        {
+            auto it = m_images.find(name);
+            return it == m_images.end() ? nullptr : &it->second.region;
+        }
+
+        [[nodiscard]] std::size_t getPagesCount() const
+        {
+            return m_pages.size();
+        }
+
+        [[nodiscard]] std::size_t getImagesCount() const
+        {
+            return m_images.size();
+        }
+
+        /**
+         * @brief Get the number of pages repacked to make room.
+         * @return Number of repacks.
+         */
+        [[nodiscard]] std::size_t getRepacks() const
+        {
+            return m_repacks;
+        }
+
+    private:
+        struct Image
+        {
+            int width = 0;                     ///< Width of the image.
+            int height = 0;                    ///< Height of the image.
+            std::vector<std::uint8_t> pixels;  ///< Pixels with their border.
+            std::size_t page = 0;              ///< Page holding the image.
+            graphic::texture::PackedRect rect; ///< Area of the image and its border in the page.
+            AtlasRegion region;                ///< Region of the image.
+        };
+
+        struct Page
+        {
+            GLuint texture;                         ///< Texture of the page.
+            graphic::texture::SkylinePacker packer; ///< Packing of the page.
+            std::size_t images = 0;                 ///< Images in the page.
+            std::int64_t freedArea = 0;             ///< Area of the removed images still under the skyline.
+        };
+
+        [[nodiscard]] std::int64_t paddedArea(const Image &image) const
+        {
+            return static_cast<std::int64_t>(image.width + 2 * m_padding) * (image.height + 2 * m_padding);
+        }
+
+        /**
+         * @brief Places a new image: in a page with room, in a repacked page, or in a new page.
+         * @param image Image to place.
+         */
+        void place(Image &image)
+        {
+            const int width = image.width + 2 * m_padding;
+            const int height = image.height + 2 * m_padding;
+            for (std::size_t index = 0; index < m_pages.size(); ++index)
+            {
+                if (auto rect = m_pages[index].packer.insert(width, height))
+                {
+                    store(image, index, *rect);
+                    return;
+                }
+            }
+
+            auto fragmented = std::ranges::max_element(m_pages, {}, &Page::freedArea);
+            if (fragmented != m_pages.end() && fragmented->freedArea >= paddedArea(image) &&
+                repack(static_cast<std::size_t>(fragmented - m_pages.begin()), image))
+            {
+                return;
+            }
+
+            m_pages.push_back(createPage());
+            store(image, m_pages.size() - 1, *m_pages.back().packer.insert(width, height));
+        }
+
+        /**
+         * @brief Packs the images of a page again, along with a new image, tallest first.
+         * @param index Page to repack.
+         * @param added Image to place.
+         * @return False, leaving the page untouched, if the images do not all fit.
+         */
+        bool repack(std::size_t index, Image &added)
+        {
+            std::vector<Image *> images{&added};
+            for (auto &[name, image] : m_images)
+            {
+                if (&image != &added && image.page == index)
+                {
+                    images.push_back(&image);
+                }
+            }
+            std::ranges::sort(images, [](const Image *left, const Image *right)
+                              { return left->height != right->height ? left->height > right->height : left->width > right->width; });
+
+            graphic::texture::SkylinePacker packer(m_pageSize, m_pageSize);
+            std::vector<graphic::texture::PackedRect> rects;
+            for (const Image *image : images)
+            {
+                auto rect = packer.insert(image->width + 2 * m_padding, image->height + 2 * m_padding);
+                if (!rect)
+                {
+                    return false;
+                }
+                rects.push_back(*rect);
+            }
+
+            Page &page = m_pages[index];
+            page.packer = packer;
+            page.images = 0;
+            page.freedArea = 0;
+            for (std::size_t image = 0; image < images.size(); ++image)
+            {
+                store(*images[image], index, rects[image]);
+            }
+            ++m_repacks;
+            return true;
+        }
+
+        /**
+         * @brief Uploads an image into its area of a page and computes its region.
+         * @param image Image to store.
+         * @param index Page of the image.
+         * @param rect Area of the image and its border.
+         */
+        void store(Image &image, std::size_t index, const graphic::texture::PackedRect &rect)
+        {
+            Page &page = m_pages[index];
+            ++page.images;
+            image.page = index;
+            image.rect = rect;
+
+            const auto size = static_cast<float>(m_pageSize);
+            image.region.texture = page.texture;
+            image.region.width = image.width;
+            image.region.height = image.height;
+            image.region.uvRect = {static_cast<float>(rect.x + m_padding) / size, static_cast<float>(rect.y + m_padding) / size,
+                                   static_cast<float>(rect.x + m_padding + image.width) / size, static_cast<float>(rect.y + m_padding + image.height) / size};
+
+            cache::OpenGLStateCache::current().bindTexture(0, GL_TEXTURE_2D, page.texture);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+        }
+
+        /**
+         * @brief Creates the texture of a page.
+         * @return The empty page.
+         */
+        Page createPage() const
+        {
+            GLuint texture = 0;
+            glGenTextures(1, &texture);
+            cache::OpenGLStateCache::current().bindTexture(0, GL_TEXTURE_2D, texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_pageSize, m_pageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            return Page{texture, graphic::texture::SkylinePacker(m_pageSize, m_pageSize)};
+        }
+
+        /**
+         * @brief Surrounds an image with the border repeating its edge texels.
+         * @param width Width of the image.
+         * @param height Height of the image.
+         * @param rgba Pixels of the image.
+         * @return Pixels of the image and its border.
+         */
+        std::vector<std::uint8_t> pad(int width, int height, std::span<const std::uint8_t> rgba) const
+        {
+            const int paddedWidth = width + 2 * m_padding;
+            const int paddedHeight = height + 2 * m_padding;
+            std::vector<std::uint8_t> pixels(static_cast<std::size_t>(paddedWidth) * paddedHeight * 4);
+            for (int y = 0; y < paddedHeight; ++y)
+            {
+                const int sourceY = std::clamp(y - m_padding, 0, height - 1);
+                for (int x = 0; x < paddedWidth; ++x)
+                {
+                    const int sourceX = std::clamp(x - m_padding, 0, width - 1);
+                    std::copy_n(rgba.begin() + (static_cast<std::ptrdiff_t>(sourceY) * width + sourceX) * 4, 4,
+                                pixels.begin() + (static_cast<std::ptrdiff_t>(y) * paddedWidth + x) * 4);
+                }
+            }
+            return pixels;
+        }
+
+        int m_pageSize;                                  ///< Width and height of the pages.
+        int m_padding;                                   ///< Border around each image.
+        std::vector<Page> m_pages;                       ///< Pages, in creation order.
+        std::unordered_map<std::string, Image> m_images; ///< Images, by name.
+        std::size_t m_repacks = 0;                       ///< Pages repacked.
+    };
+}
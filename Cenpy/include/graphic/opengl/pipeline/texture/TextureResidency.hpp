@@ -0,0 +1,230 @@
+// file: TextureResidency.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <graphic/opengl/pipeline/texture/AsyncTextureLoader.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::texture
+{
+    /**
+     * @class OpenGLTextureResidency
+     * @brief Keeps the textures used by the game within a GPU memory budget.
+     *
+     * Textures are requested by file each frame through use(), which loads them with the loader
+     * on first use and returns the texture to bind. A texture counts its mip chain once ready,
+     * RGBA8 unless it was loaded compressed. update() ends the frame: while the resident bytes
+     * exceed the budget, the least recently used textures are evicted, except the ones used during
+     * the frame. An evicted texture is loaded again on its next use, the placeholder being bound
+     * meanwhile. A texture that failed to load is dropped the same way, counted by getFailures(),
+     * and tried again on its next use.
+     */
+    class OpenGLTextureResidency
+    {
+    public:
+        /**
+         * @brief Creates an empty residency.
+         * @param loader Loader of the textures. It must outlive the residency.
+         * @param budget Bytes the resident textures may use.
+         */
+        OpenGLTextureResidency(OpenGLAsyncTextureLoader &loader, std::size_t budget) : m_loader(loader), m_budget(budget)
+        {
+        }
+
+        OpenGLTextureResidency(const OpenGLTextureResidency &) = delete;
+        OpenGLTextureResidency &operator=(const OpenGLTextureResidency &) = delete;
+
+        /**
+         * @brief Marks a texture used this frame, loading it if it is not resident.
+         * @param path File of the texture.
+         * @return The texture to bind, the placeholder until it is ready.
+         */
+        GLuint use(const std::string &path)
+        {
+            auto it = m_textures.find(path);
+            if (it == m_textures.end())
+            {
+                if (m_evicted.erase(path) != 0)
+                {
+                    ++m_reloads;
+                }
+                m_recency.push_front(path);
+                it = m_textures.emplace(path, Entry{m_loader.load(path), 0, m_recency.begin(), m_frame}).first;
+            }
+            else
+            {
+                m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+                it->second.frame = m_frame;
+            }
+            return it->second.handle->getTexture();
+        }
+
+        /**
+         * @brief Ends the frame: runs the loader, accounts the new textures and evicts over budget.
+         *
+         * Call it once per frame, on the thread of the GL context, after drawing.
+         */
+        void update()
+        {
+            m_loader.update();
+            for (auto it = m_textures.begin(); it != m_textures.end();)
+            {
+                Entry &entry = it->second;
+                if (entry.handle->getState() == OpenGLTextureHandle::State::FAILED)
+                {
+                    ++m_failures;
+                    m_lastError = entry.handle->getError();
+                    m_recency.erase(entry.recency);
+                    it = m_textures.erase(it);
+                    continue;
+                }
+                if (entry.bytes == 0 && entry.handle->isReady())
+                {
+                    entry.bytes = entry.handle->getCompressedBytes() != 0 ? entry.handle->getCompressedBytes() : textureBytes(entry.handle->getWidth(), entry.handle->getHeight());
+                    m_residentBytes += entry.bytes;
+                }
+                ++it;
+            }
+            evict();
+            ++m_frame;
+        }
+
+        /**
+         * @brief Changes the budget. Textures are evicted at the end of the frame.
+         * @param budget Bytes the resident textures may use.
+         */
+        void setBudget(std::size_t budget)
+        {
+            m_budget = budget;
+        }
+
+        [[nodiscard]] std::size_t getBudget() const
+        {
+            return m_budget;
+        }
+
+        /**
+         * @brief Get the bytes of the ready textures.
+         * @return Resident bytes, mipmaps included.
+         */
+        [[nodiscard]] std::size_t getResidentBytes() const
+        {
+            return m_residentBytes;
+        }
+
+        [[nodiscard]] std::size_t getEvictions() const
+        {
+            return m_evictions;
+        }
+
+        /**
+         * @brief Get the number of evicted textures loaded again.
+         * @return Number of reloads.
+         */
+        [[nodiscard]] std::size_t getReloads() const
+        {
+            return m_reloads;
+        }
+
+        /**
+         * @brief Get the number of loads that failed, each texture being tried again on its next use.
+         * @return Number of failed loads.
+         */
+        [[nodiscard]] std::size_t getFailures() const
+        {
+            return m_failures;
+        }
+
+        /**
+         * @brief Get why the last failed load failed.
+         * @return The error of the loader, empty if no load failed.
+         */
+        [[nodiscard]] const std::string &getLastError() const
+        {
+            return m_lastError;
+        }
+
+        [[nodiscard]] bool isResident(const std::string &path) const
+        {
+            auto it = m_textures.find(path);
+            return it != m_textures.end() && it->second.handle->isReady();
+        }
+
+        /**
+         * @brief Computes the bytes of an RGBA8 texture and its mip chain.
+         * @param width Width of the texture.
+         * @param height Height of the texture.
+         * @return Bytes of every level.
+         */
+        [[nodiscard]] static std::size_t textureBytes(int width, int height)
+        {
+            std::size_t bytes = 0;
+            for (;;)
+            {
+                bytes += static_cast<std::size_t>(width) * height * 4;
+                if (width == 1 && height == 1)
+                {
+                    return bytes;
+                }
+                width = std::max(1, width / 2);
+                height = std::max(1, height / 2);
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<OpenGLTextureHandle> handle; ///< Handle of the texture, deleting it once evicted.
+            std::size_t bytes;                           ///< Bytes accounted, 0 until ready.
+            std::list<std::string>::iterator recency;    ///< Place in the recency order.
+            std::uint64_t frame;                         ///< Last frame the texture was used.
+        };
+
+        /**
+         * @brief Evicts the least recently used ready textures until the budget is met.
+         */
+        void evict()
+        {
+            auto path = m_recency.end();
+            while (m_residentBytes > m_budget && path != m_recency.begin())
+            {
+                --path;
+                Entry &entry = m_textures.at(*path);
+                if (entry.frame == m_frame)
+                {
+                    // The textures before were used this frame too.
+                    return;
+                }
+                if (entry.bytes == 0)
+                {
+                    continue;
+                }
+                m_residentBytes -= entry.bytes;
+                ++m_evictions;
+                m_evicted.insert(*path);
+                m_textures.erase(*path);
+                path = m_recency.erase(path);
+            }
+        }
+
+        OpenGLAsyncTextureLoader &m_loader;                  ///< Loader of the textures.
+        std::size_t m_budget;                                ///< Bytes the resident textures may use.
+        std::unordered_map<std::string, Entry> m_textures;   ///< Textures loaded or loading, by file.
+        std::list<std::string> m_recency;                    ///< Files, most recently used first.
+        std::unordered_set<std::string> m_evicted;           ///< Files evicted and not loaded again.
+        std::uint64_t m_frame = 0;                           ///< Current frame.
+        std::size_t m_residentBytes = 0;                     ///< Bytes of the ready textures.
+        std::size_t m_evictions = 0;                         ///< Textures evicted.
+        std::size_t m_reloads = 0;                           ///< Evicted textures loaded again.
+        std::size_t m_failures = 0;                          ///< Loads that failed.
+        std::string m_lastError;                             ///< Error of the last failed load.
+    };
+}
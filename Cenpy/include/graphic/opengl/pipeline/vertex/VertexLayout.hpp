@@ -0,0 +1,243 @@
+// file: VertexLayout.hpp
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <graphic/Api.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/context/AttributeContext.hpp>
+
+namespace cenpy::graphic::opengl::pipeline::vertex
+{
+    /**
+     * @struct VertexElement
+     * @brief An attribute of an interleaved vertex.
+     */
+    struct VertexElement
+    {
+        std::string name;             ///< Name of the attribute in the shaders.
+        GLuint location = 0;          ///< Location of the attribute, when reflected from a pass.
+        GLint components = 0;         ///< Components per location, 1 to 4.
+        GLenum componentType = 0;     ///< Type of the components, e.g. GL_FLOAT.
+        GLuint locations = 1;         ///< Consecutive locations used, the columns of a matrix.
+        GLuint offset = 0;            ///< Offset of the attribute in the vertex.
+        bool normalized = false;      ///< Whether integer components are normalized to [0, 1] or [-1, 1].
+
+        /**
+         * @brief Get the bytes of the attribute in the vertex.
+         * @return Size of the attribute.
+         */
+        [[nodiscard]] GLuint getSize() const
+        {
+            return static_cast<GLuint>(components) * locations * componentSize(componentType);
+        }
+
+        /**
+         * @brief Whether the attribute is read as integers by the shaders.
+         * @return True for integer attributes which are not normalized.
+         */
+        [[nodiscard]] bool isInteger() const
+        {
+            return !normalized && componentType != GL_FLOAT && componentType != GL_HALF_FLOAT && componentType != GL_DOUBLE;
+        }
+
+        /**
+         * @brief Get the bytes of a component.
+         * @param type Type of the component.
+         * @return Size of the component.
+         * @throws TraceableException if the type is not a component type.
+         */
+        static GLuint componentSize(GLenum type)
+        {
+            switch (type)
+            {
+            case GL_BYTE:
+            case GL_UNSIGNED_BYTE:
+                return 1;
+            case GL_SHORT:
+            case GL_UNSIGNED_SHORT:
+            case GL_HALF_FLOAT:
+                return 2;
+            case GL_INT:
+            case GL_UNSIGNED_INT:
+            case GL_FLOAT:
+                return 4;
+            case GL_DOUBLE:
+                return 8;
+            default:
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::VERTEX_LAYOUT::UNSUPPORTED_TYPE\n{:#x}", type));
+            }
+        }
+    };
+
+    /**
+     * @class OpenGLVertexLayout
+     * @brief Interleaved layout of the vertices of a mesh: the attributes of a vertex follow each
+     * other, and the vertices follow each other every stride bytes.
+     *
+     * A layout is either described by the mesh, attribute by attribute, or built from the
+     * attributes a pass reflected, to lay out meshes exactly as the pass reads them.
+     */
+    class OpenGLVertexLayout
+    {
+    public:
+        /**
+         * @brief Appends an attribute to the vertex.
+         * @param name Name of the attribute in the shaders.
+         * @param components Components of the attribute, 1 to 4.
+         * @param componentType Type of the components.
+         * @param normalized Whether integer components are normalized.
+         * @param locations Consecutive locations used, the columns of a matrix.
+         * @return This layout, to chain the calls.
+         * @throws TraceableException if the type is not a component type.
+         */
+        OpenGLVertexLayout &add(std::string name, GLint components, GLenum componentType = GL_FLOAT, bool normalized = false, GLuint locations = 1)
+        {
+            VertexElement element;
+            element.name = std::move(name);
+            element.location = m_elements.empty() ? 0 : m_elements.back().location + m_elements.back().locations;
+            element.components = components;
+            element.componentType = componentType;
+            element.normalized = normalized;
+            element.locations = locations;
+            append(std::move(element));
+            return *this;
+        }
+
+        /**
+         * @brief Builds the layout reading the attributes a pass reflected, in location order.
+         * @param pass Context of the pass, whose attributes were read.
+         * @return The layout.
+         * @throws TraceableException if an attribute has a type no vertex layout can hold.
+         */
+        static OpenGLVertexLayout fromPass(const graphic::api::OpenGL::PassContext &pass)
+        {
+            std::vector<VertexElement> elements;
+            for (const auto &[name, attribute] : pass.getAttributes())
+            {
+                const auto &context = attribute->getContext();
+                VertexElement element = fromGLType(context->getGLType());
+                element.name = name;
+                element.location = context->getAttributeID();
+                element.locations *= std::max<GLuint>(1, context->getGLSize());
+                elements.push_back(std::move(element));
+            }
+            std::ranges::sort(elements, {}, &VertexElement::location);
+
+            OpenGLVertexLayout layout;
+            for (auto &element : elements)
+            {
+                layout.append(std::move(element));
+            }
+            return layout;
+        }
+
+        /**
+         * @brief Converts the type of a reflected attribute to its components.
+         * @param type Type returned by glGetActiveAttrib.
+         * @return The element, without name, location nor offset.
+         * @throws TraceableException if no vertex attribute can have the type.
+         */
+        static VertexElement fromGLType(GLenum type)
+        {
+            auto make = [](GLint components, GLenum componentType, GLuint locations = 1)
+            {
+                VertexElement element;
+                element.components = components;
+                element.componentType = componentType;
+                element.locations = locations;
+                return element;
+            };
+            switch (type)
+            {
+            case GL_FLOAT:
+                return make(1, GL_FLOAT);
+            case GL_FLOAT_VEC2:
+                return make(2, GL_FLOAT);
+            case GL_FLOAT_VEC3:
+                return make(3, GL_FLOAT);
+            case GL_FLOAT_VEC4:
+                return make(4, GL_FLOAT);
+            case GL_INT:
+                return make(1, GL_INT);
+            case GL_INT_VEC2:
+                return make(2, GL_INT);
+            case GL_INT_VEC3:
+                return make(3, GL_INT);
+            case GL_INT_VEC4:
+                return make(4, GL_INT);
+            case GL_UNSIGNED_INT:
+                return make(1, GL_UNSIGNED_INT);
+            case GL_UNSIGNED_INT_VEC2:
+                return make(2, GL_UNSIGNED_INT);
+            case GL_UNSIGNED_INT_VEC3:
+                return make(3, GL_UNSIGNED_INT);
+            case GL_UNSIGNED_INT_VEC4:
+                return make(4, GL_UNSIGNED_INT);
+            case GL_FLOAT_MAT2:
+                return make(2, GL_FLOAT, 2);
+            case GL_FLOAT_MAT3:
+                return make(3, GL_FLOAT, 3);
+            case GL_FLOAT_MAT4:
+                return make(4, GL_FLOAT, 4);
+            default:
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::VERTEX_LAYOUT::UNSUPPORTED_TYPE\n{:#x}", type));
+            }
+        }
+
+        [[nodiscard]] const std::vector<VertexElement> &getElements() const
+        {
+            return m_elements;
+        }
+
+        /**
+         * @brief Get an attribute of the vertex.
+         * @param name Name of the attribute.
+         * @return The attribute, nullptr if the vertex has none of this name.
+         */
+        [[nodiscard]] const VertexElement *find(std::string_view name) const
+        {
+            auto it = std::ranges::find(m_elements, name, &VertexElement::name);
+            return it == m_elements.end() ? nullptr : &*it;
+        }
+
+        /**
+         * @brief Get the bytes between two consecutive vertices.
+         * @return Size of a vertex.
+         */
+        [[nodiscard]] GLsizei getStride() const
+        {
+            return static_cast<GLsizei>(m_stride);
+        }
+
+        /**
+         * @brief Get a description identifying the layout, to key caches by.
+         * @return Names, locations, types and offsets of the attributes.
+         */
+        [[nodiscard]] const std::string &getSignature() const
+        {
+            return m_signature;
+        }
+
+    private:
+        void append(VertexElement element)
+        {
+            element.offset = m_stride;
+            m_stride += element.getSize();
+            m_signature += std::format("{}@{}:{}x{}x{:#x}{}+{};", element.name, element.location, element.locations, element.components,
+                                       element.componentType, element.normalized ? "n" : "", element.offset);
+            m_elements.push_back(std::move(element));
+        }
+
+        std::vector<VertexElement> m_elements; ///< Attributes, in vertex order.
+        GLuint m_stride = 0;                   ///< Size of a vertex.
+        std::string m_signature;               ///< Description of the layout.
+    };
+}
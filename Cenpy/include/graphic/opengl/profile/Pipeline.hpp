@@ -4,6 +4,7 @@ namespace cenpy::graphic::opengl::profile
 {
     enum class Pipeline
     {
-        Classic
+        Classic,
+        Indirect ///< Draws each batch of commands with one multi-draw indirect, see OpenGLIndirectBuffer.
     };
 }
\ No newline at end of file
@@ -4,6 +4,7 @@ namespace cenpy::graphic::opengl::profile
 {
     enum class Shader
     {
-        Classic
+        Classic,
+        Mapped ///< Like Classic, but the source files are copied once out of a memory mapping instead of through a stream.
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace cenpy::graphic::opengl::profile
+{
+    enum class UniformBlock
+    {
+        Classic
+    };
+}
@@ -16,11 +16,19 @@ namespace cenpy::graphic::opengl::validator
         requires HasComponent<typename API::PassContext::ShaderAttacher<PROFILE>>;
         requires HasComponent<typename API::PassContext::AttributeReader<PROFILE>>;
         requires HasComponent<typename API::PassContext::User<PROFILE>>;
+        requires HasComponent<typename API::PassContext::BinaryLoader<PROFILE>>;
+        requires HasComponent<typename API::PassContext::Linker<PROFILE>>;
+        requires HasComponent<typename API::PassContext::Poller<PROFILE>>;
+        requires HasComponent<typename API::PassContext::Waiter<PROFILE>>;
 
         requires HasOnMethod<typename API::PassContext::Loader<PROFILE>, typename API::PassContext>;
         requires HasOnMethod<typename API::PassContext::Freer<PROFILE>, typename API::PassContext>;
         requires HasOnMethod<typename API::PassContext::ShaderAttacher<PROFILE>, typename API::PassContext>;
         requires HasOnMethod<typename API::PassContext::AttributeReader<PROFILE>, typename API::PassContext>;
         requires HasOnMethod<typename API::PassContext::User<PROFILE>, typename API::PassContext>;
+        requires HasOnMethod<typename API::PassContext::BinaryLoader<PROFILE>, typename API::PassContext>;
+        requires HasOnMethod<typename API::PassContext::Linker<PROFILE>, typename API::PassContext>;
+        requires HasOnMethod<typename API::PassContext::Poller<PROFILE>, typename API::PassContext>;
+        requires HasOnMethod<typename API::PassContext::Waiter<PROFILE>, typename API::PassContext>;
     };
 }
\ No newline at end of file
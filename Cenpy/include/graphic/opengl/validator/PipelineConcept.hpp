@@ -12,8 +12,10 @@ namespace cenpy::graphic::opengl::validator
     concept OpenGLPipelineFlow = requires {
         requires HasComponent<typename API::PipelineContext::Resetter<PROFILE>>;
         requires HasComponent<typename API::PipelineContext::User<PROFILE>>;
+        requires HasComponent<typename API::PipelineContext::Drawer<PROFILE>>;
 
         requires HasOnMethod<typename API::PipelineContext::Resetter<PROFILE>, typename API::PipelineContext>;
         requires HasOnMethod<typename API::PipelineContext::User<PROFILE>, typename API::PipelineContext>;
+        requires HasOnMethod<typename API::PipelineContext::Drawer<PROFILE>, typename API::PipelineContext>;
     };
 }
\ No newline at end of file
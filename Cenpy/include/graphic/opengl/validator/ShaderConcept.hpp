@@ -13,9 +13,13 @@ namespace cenpy::graphic::opengl::validator
         requires HasComponent<typename API::ShaderContext::Loader<PROFILE>>;
         requires HasComponent<typename API::ShaderContext::Freer<PROFILE>>;
         requires HasComponent<typename API::ShaderContext::Reader<PROFILE>>;
+        requires HasComponent<typename API::ShaderContext::Compiler<PROFILE>>;
+        requires HasComponent<typename API::ShaderContext::Preprocessor<PROFILE>>;
 
         requires HasOnMethod<typename API::ShaderContext::Loader<PROFILE>, typename API::ShaderContext>;
         requires HasOnMethod<typename API::ShaderContext::Freer<PROFILE>, typename API::ShaderContext>;
         requires HasOnMethod<typename API::ShaderContext::Reader<PROFILE>, typename API::ShaderContext>;
+        requires HasOnMethod<typename API::ShaderContext::Compiler<PROFILE>, typename API::ShaderContext>;
+        requires HasOnMethod<typename API::ShaderContext::Preprocessor<PROFILE>, typename API::ShaderContext>;
     };
 }
\ No newline at end of file
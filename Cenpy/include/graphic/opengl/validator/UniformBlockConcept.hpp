@@ -0,0 +1,23 @@
+#pragma once
+#include <memory>
+#include <type_traits>
+#include <graphic/validator/ComponentConcept.hpp>
+
+namespace cenpy::graphic::opengl::validator
+{
+    using cenpy::graphic::validator::HasComponent;
+    using cenpy::graphic::validator::HasOnMethod;
+
+    template <typename API, auto PROFILE>
+    concept OpenGLUniformBlockFlow = requires {
+        requires HasComponent<typename API::UniformBlockContext::Loader<PROFILE>>;
+        requires HasComponent<typename API::UniformBlockContext::Updater<PROFILE>>;
+        requires HasComponent<typename API::UniformBlockContext::Binder<PROFILE>>;
+        requires HasComponent<typename API::UniformBlockContext::Freer<PROFILE>>;
+
+        requires HasOnMethod<typename API::UniformBlockContext::Loader<PROFILE>, typename API::UniformBlockContext>;
+        requires HasOnMethod<typename API::UniformBlockContext::Updater<PROFILE>, typename API::UniformBlockContext>;
+        requires HasOnMethod<typename API::UniformBlockContext::Binder<PROFILE>, typename API::UniformBlockContext>;
+        requires HasOnMethod<typename API::UniformBlockContext::Freer<PROFILE>, typename API::UniformBlockContext>;
+    };
+}
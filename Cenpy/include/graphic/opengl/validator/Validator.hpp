@@ -4,6 +4,7 @@
 #include <graphic/opengl/validator/ShaderConcept.hpp>
 #include <graphic/opengl/validator/AttributeConcept.hpp>
 #include <graphic/opengl/validator/UniformConcept.hpp>
+#include <graphic/opengl/validator/UniformBlockConcept.hpp>
 
 namespace cenpy::graphic::opengl::validator
 {
@@ -42,5 +43,11 @@ namespace cenpy::graphic::opengl::validator
         {
             return true;
         }
+        template <typename API, auto PROFILE>
+            requires OpenGLUniformBlockFlow<API, PROFILE>
+        static constexpr bool validateUniformBlock()
+        {
+            return true;
+        }
     };
 }
\ No newline at end of file
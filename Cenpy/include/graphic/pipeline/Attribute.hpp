@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <graphic/Api.hpp>
 #include <graphic/context/AttributeContext.hpp>
 #include <graphic/validator/ComponentConcept.hpp>
@@ -29,15 +30,31 @@ namespace cenpy::graphic::pipeline
         void set(std::shared_ptr<T> value)
         {
             m_context->template setValue<T>(value);
+            upload<T>();
+        }
 
-            if constexpr (graphic::validator::HasComponent<typename API::AttributeContext::Setter<std::shared_ptr<int>>>)
+        /**
+         * @brief Uploads the values of the vertices.
+         *
+         * The values are uploaded before returning: they need not outlive the call, and the
+         * context forgets them once uploaded or if the upload fails.
+         *
+         * @param values Values of the vertices, whose type gives the stride.
+         */
+        template <typename T>
+        void set(std::span<const T> values)
+        {
+            m_context->template setValues<T>(values);
+            try
             {
-                API::AttributeContext::template Setter<std::shared_ptr<int>>::on(m_context);
+                upload<T>();
             }
-            else
+            catch (...)
             {
-                throw common::exception::TraceableException<std::runtime_error>("ERROR::ATTRIBUTE::UNSUPPORTED_TYPE");
+                m_context->clearValues();
+                throw;
             }
+            m_context->clearValues();
         }
 
         void unbind()
@@ -55,6 +72,19 @@ namespace cenpy::graphic::pipeline
         virtual void bind(std::shared_ptr<typename API::AttributeContext> context) = 0;
 
     private:
+        template <typename T>
+        void upload()
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::AttributeContext::Setter<T>>)
+            {
+                API::AttributeContext::template Setter<T>::on(m_context);
+            }
+            else
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::ATTRIBUTE::UNSUPPORTED_TYPE");
+            }
+        }
+
         std::shared_ptr<typename API::AttributeContext> m_context;
     };
 
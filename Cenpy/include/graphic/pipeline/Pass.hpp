@@ -16,10 +16,13 @@
 #include <GL/glew.h>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <format>
 #include <type_traits>
 #include <unordered_map>
 #include <memory>
+#include <utility>
+#include <initializer_list>
 #include <utils.hpp>
 #include <common/exception/TraceableException.hpp>
 #include <graphic/pipeline/Shader.hpp>
@@ -30,6 +33,8 @@
 
 namespace cenpy::graphic::pipeline
 {
+    using context::VariantMask;
+
     template <typename API>
     class IPass
     {
@@ -52,15 +57,108 @@ namespace cenpy::graphic::pipeline
         {
         }
 
+        /**
+         * @brief Loads the pass, from a cached program binary when one matches the shader sources.
+         *
+         * The shaders are only compiled and linked when no cached binary can be used.
+         */
         virtual void load()
         {
             for (auto &shader : m_context->getShaders())
             {
-                shader->load();
+                shader->read();
+            }
+            loadBinary(m_context);
+            if (!m_context->isLoadedFromBinary())
+            {
+                for (auto &shader : m_context->getShaders())
+                {
+                    shader->load();
+                }
+                load(m_context);
             }
-            load(m_context);
             readUniforms(m_context);
             readAttributes(m_context);
+            m_context->setLoadState(context::PassLoadState::READY);
+        }
+
+        /**
+         * @brief Submits the compilation and link of the pass without waiting for the driver.
+         *
+         * Submit every pass first, then call poll on each of them over the next frames until it
+         * is ready: the driver works on all of them meanwhile. A pass restored from a cached
+         * binary is ready at once.
+         */
+        virtual void loadAsync()
+        {
+            for (auto &shader : m_context->getShaders())
+            {
+                shader->read();
+            }
+            loadBinary(m_context);
+            if (m_context->isLoadedFromBinary())
+            {
+                readUniforms(m_context);
+                readAttributes(m_context);
+                m_context->setLoadState(context::PassLoadState::READY);
+                return;
+            }
+            for (auto &shader : m_context->getShaders())
+            {
+                shader->compile();
+            }
+            link(m_context);
+            m_context->setLoadState(context::PassLoadState::PENDING);
+        }
+
+        /**
+         * @brief Checks, without blocking, whether a pass submitted by loadAsync is ready.
+         *
+         * The uniforms and attributes are read as soon as the link is complete.
+         *
+         * @return True if the pass is ready to be used.
+         * @throws std::runtime_error if the link failed.
+         */
+        virtual bool poll()
+        {
+            if (m_context->getLoadState() == context::PassLoadState::PENDING)
+            {
+                poll(m_context);
+                if (m_context->getLoadState() == context::PassLoadState::READY)
+                {
+                    readUniforms(m_context);
+                    readAttributes(m_context);
+                }
+            }
+            return isReady();
+        }
+
+        /**
+         * @brief Blocks until a pass submitted by loadAsync is linked, e.g. when it is needed at once.
+         *
+         * The calling thread sleeps in the driver instead of polling, and the links submitted
+         * before carry on meanwhile.
+         *
+         * @throws std::runtime_error if the link failed.
+         */
+        virtual void wait()
+        {
+            if (m_context->getLoadState() == context::PassLoadState::PENDING)
+            {
+                wait(m_context);
+                readUniforms(m_context);
+                readAttributes(m_context);
+            }
+        }
+
+        [[nodiscard]] bool isReady() const
+        {
+            return m_context->getLoadState() == context::PassLoadState::READY;
+        }
+
+        [[nodiscard]] bool isPending() const
+        {
+            return m_context->getLoadState() == context::PassLoadState::PENDING;
         }
 
         virtual void use()
@@ -68,9 +166,158 @@ namespace cenpy::graphic::pipeline
             use(m_context);
         }
 
+        /**
+         * @brief Frees the pass, and its variants.
+         */
         virtual void free()
         {
+            m_context->clearVariants();
             free(m_context);
+            m_context->setLoadState(context::PassLoadState::UNLOADED);
+        }
+
+        /**
+         * @brief Declares the keys the variants of the pass are made of.
+         *
+         * A variant defines a subset of the keys as macros before the code of each shader, e.g.
+         * TINT or MASK, and is identified by the mask of its keys.
+         *
+         * @param keys Names of the macros a variant can define, at most 64.
+         * @return A reference to the IPass object, to chain further calls.
+         * @throws std::runtime_error if there are too many keys.
+         */
+        IPass<API> &withVariantKeys(std::vector<std::string> keys)
+        {
+            m_context->setVariantKeys(std::move(keys));
+            return *this;
+        }
+
+        /**
+         * @brief Resolves the mask of a set of variant keys, to look variants up without hashing names.
+         * @param keys Names of the keys.
+         * @return The mask of the keys.
+         * @throws std::runtime_error if a key has not been declared.
+         */
+        [[nodiscard]] VariantMask getVariantMask(std::initializer_list<std::string_view> keys) const
+        {
+            return m_context->getVariantMask(keys);
+        }
+
+        /**
+         * @brief Returns the variant of the pass defining the given keys, compiling it on first use.
+         *
+         * Variants are cached by mask and live until the pass is freed. The empty mask is the
+         * pass itself.
+         *
+         * @param mask Mask of the keys, as returned by getVariantMask.
+         * @return The loaded variant.
+         * @throws std::runtime_error if the variant fails to compile or link.
+         */
+        IPass<API> &variant(VariantMask mask)
+        {
+            if (mask == 0)
+            {
+                return *this;
+            }
+            auto variant = m_context->getVariant(mask);
+            if (!variant)
+            {
+                variant = createVariant(mask);
+                m_context->addVariant(mask, variant);
+            }
+            if (variant->isPending())
+            {
+                variant->wait();
+            }
+            else if (!variant->isReady())
+            {
+                variant->load();
+            }
+            return *variant;
+        }
+
+        IPass<API> &variant(std::initializer_list<std::string_view> keys)
+        {
+            return variant(getVariantMask(keys));
+        }
+
+        /**
+         * @brief Compiles a declared set of variants up front, e.g. during a loading screen.
+         *
+         * The variants are all submitted before waiting for any of them, so the driver compiles
+         * them in parallel when it can, and the calling thread sleeps in the driver until each is
+         * linked. Variants already created are skipped.
+         *
+         * @param masks Masks of the variants to compile.
+         * @throws std::runtime_error if a variant fails to compile or link.
+         */
+        void precompileVariants(const std::vector<VariantMask> &masks)
+        {
+            std::vector<std::shared_ptr<IPass<API>>> submitted;
+            for (VariantMask mask : masks)
+            {
+                if (mask == 0 || m_context->getVariant(mask))
+                {
+                    continue;
+                }
+                auto variant = createVariant(mask);
+                m_context->addVariant(mask, variant);
+                variant->loadAsync();
+                submitted.push_back(variant);
+            }
+            for (const auto &variant : submitted)
+            {
+                variant->wait();
+            }
+        }
+
+        /**
+         * @brief Links the pass again, e.g. after one of its shaders changed, keeping the uniform values.
+         *
+         * The uniforms are reflected again from the new program, and those still declared with a
+         * compatible type get their previous value back. The values are uploaded on the next use.
+         */
+        virtual void reload()
+        {
+            const auto previous = m_context->getUniforms();
+            free();
+            load();
+            restoreUniforms(previous);
+        }
+
+        /**
+         * @brief Submits a pass of the same kind linking other shaders, leaving this pass untouched.
+         *
+         * Poll the returned pass over the next frames, then hand its program over with replaceWith.
+         *
+         * @param shaders Shaders of the new pass, e.g. those of this pass with the changed ones recreated.
+         * @return The submitted pass.
+         * @throws std::runtime_error if a shader source cannot be read.
+         */
+        [[nodiscard]] virtual std::shared_ptr<IPass<API>> rebuild(const std::vector<std::shared_ptr<IShader<API>>> &shaders) const
+        {
+            auto pass = createPass(shaders);
+            pass->getContext()->inheritSettings(*m_context);
+            pass->loadAsync();
+            return pass;
+        }
+
+        /**
+         * @brief Takes over the program of a rebuilt pass once it is ready, keeping the uniform values.
+         *
+         * The pass keeps its identity for those holding it, and its variant keys. Its former
+         * program goes to the rebuilt pass and is freed along with it. Its variants, linking the
+         * former shaders, are dropped and compiled again from the new ones on next use.
+         *
+         * @param rebuilt Ready pass returned by rebuild.
+         */
+        void replaceWith(IPass<API> &rebuilt)
+        {
+            const auto previous = m_context->getUniforms();
+            std::swap(m_context, rebuilt.m_context);
+            rebuilt.m_context->clearVariants();
+            m_context->clearVariants();
+            restoreUniforms(previous);
         }
 
         /**
@@ -79,18 +326,96 @@ namespace cenpy::graphic::pipeline
          * @tparam T The type of the uniform value.
          * @param name The name of the uniform.
          * @param value The value of the uniform.
-         * @return A reference to the IPass object.
+         * @return A reference to the IPass object, to chain further calls.
          * @throws std::runtime_error if the uniform is not found.
          */
         template <typename T>
-        std::shared_ptr<IPass<API>> withUniform(const std::string &name, const T &value)
+        IPass<API> &withUniform(std::string_view name, const T &value)
+        {
+            setUniform(getUniformHandle(name), value);
+            return *this;
+        }
+
+        /**
+         * @brief Sets the uniform designated by a pre-resolved handle, for chaining.
+         *
+         * Chaining returns the pass itself, so a chain of withUniform calls costs nothing
+         * beyond the uniform uploads.
+         *
+         * @tparam T The type of the uniform value.
+         * @param handle The handle of the uniform, as returned by getUniformHandle.
+         * @param value The value of the uniform.
+         * @return A reference to the IPass object, to chain further calls.
+         * @throws std::runtime_error if the handle does not designate a uniform of this pass.
+         */
+        template <typename T>
+        IPass<API> &withUniform(UniformHandle handle, const T &value)
+        {
+            setUniform(handle, value);
+            return *this;
+        }
+
+        /**
+         * @brief Resolves the handle of the uniform with the specified name.
+         *
+         * Resolve handles once, after the pass has been loaded, and use them with setUniform
+         * on hot paths to avoid hashing the uniform name on every set.
+         *
+         * @param name The name of the uniform.
+         * @return The handle of the uniform.
+         * @throws std::runtime_error if the uniform is not found.
+         */
+        [[nodiscard]] UniformHandle getUniformHandle(std::string_view name) const
         {
-            if (auto uniform = m_context->getUniform(name))
+            UniformHandle handle = m_context->getUniformHandle(name);
+            if (!handle.isValid())
             {
-                uniform->template set<T>(value);
-                return shared();
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::UNIFORM_NOT_FOUND\nUniform {} not found", name));
             }
-            throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::UNIFORM_NOT_FOUND\nUniform {} not found", name));
+            return handle;
+        }
+
+        /**
+         * @brief Enables or disables the deferred upload of the uniforms set through this pass.
+         *
+         * In deferred mode, setUniform and withUniform only stage the value, and the changed
+         * uniforms are uploaded together when the pass is used. Values can then be set at any
+         * time, without the pass being bound.
+         *
+         * @param deferred True to defer the uploads until the pass is used.
+         * @return A reference to the IPass object, to chain further calls.
+         */
+        IPass<API> &deferUniforms(bool deferred = true)
+        {
+            m_context->setDeferredUniforms(deferred);
+            return *this;
+        }
+
+        /**
+         * @brief Sets the value of the uniform designated by a pre-resolved handle.
+         *
+         * @tparam T The type of the uniform value.
+         * @param handle The handle of the uniform, as returned by getUniformHandle.
+         * @param value The value of the uniform.
+         * @throws std::runtime_error if the handle does not designate a uniform of this pass.
+         */
+        template <typename T>
+        void setUniform(UniformHandle handle, const T &value)
+        {
+            Uniform<API> *uniform = m_context->getUniform(handle);
+            if (!uniform)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::INVALID_UNIFORM_HANDLE\nUniform handle {} is not valid", handle.index));
+            }
+            if (m_context->isDeferredUniforms())
+            {
+                if (uniform->template stage<T>(value))
+                {
+                    m_context->markUniformPending(handle);
+                }
+                return;
+            }
+            uniform->template set<T>(value);
         }
 
         /**
@@ -133,14 +458,53 @@ namespace cenpy::graphic::pipeline
         }
 
     protected:
+        /**
+         * @brief Creates an unloaded pass of the same kind, linking the given shaders.
+         * @param shaders Shaders of the new pass.
+         * @return The new pass.
+         */
+        [[nodiscard]] virtual std::shared_ptr<IPass<API>> createPass(const std::vector<std::shared_ptr<IShader<API>>> &shaders) const = 0;
+
         virtual void load(std::shared_ptr<typename API::PassContext> context) = 0;
+        virtual void loadBinary(std::shared_ptr<typename API::PassContext> context) = 0;
+        virtual void link(std::shared_ptr<typename API::PassContext> context) = 0;
+        virtual void poll(std::shared_ptr<typename API::PassContext> context) = 0;
+        virtual void wait(std::shared_ptr<typename API::PassContext> context) = 0;
         virtual void readUniforms(std::shared_ptr<typename API::PassContext> context) = 0;
         virtual void readAttributes(std::shared_ptr<typename API::PassContext> context) = 0;
         virtual void free(std::shared_ptr<typename API::PassContext> context) = 0;
         virtual void use(std::shared_ptr<typename API::PassContext> context) = 0;
-        virtual std::shared_ptr<IPass<API>> shared() const = 0;
 
     private:
+        /**
+         * @brief Gives the uniforms still declared with a compatible type their previous value, uploaded on the next use.
+         * @param previous Uniforms of the former program, by name.
+         */
+        template <typename Uniforms>
+        void restoreUniforms(const Uniforms &previous)
+        {
+            for (const auto &[name, uniform] : m_context->getUniforms())
+            {
+                if (auto it = previous.find(name); it != previous.end() && it->second != uniform && uniform->restore(*it->second))
+                {
+                    m_context->markUniformPending(m_context->getUniformHandle(name));
+                }
+            }
+        }
+
+        std::shared_ptr<IPass<API>> createVariant(VariantMask mask) const
+        {
+            const std::vector<std::string> defines = m_context->getVariantDefines(mask);
+            std::vector<std::shared_ptr<IShader<API>>> shaders;
+            for (const auto &shader : m_context->getShaders())
+            {
+                shaders.push_back(shader->createVariant(defines));
+            }
+            auto variant = createPass(shaders);
+            variant->getContext()->inheritSettings(*m_context);
+            return variant;
+        }
+
         std::shared_ptr<typename API::PassContext> m_context; ///< The pass context.
     };
 
@@ -151,9 +515,16 @@ namespace cenpy::graphic::pipeline
     public:
         using IPass<API>::IPass;
         using IPass<API>::load;
+        using IPass<API>::poll;
+        using IPass<API>::wait;
         using IPass<API>::free;
+        using IPass<API>::reload;
         using IPass<API>::use;
 
+        // A pass owns its API program through the shared context: copies would free it twice.
+        Pass(const Pass &) = delete;
+        Pass &operator=(const Pass &) = delete;
+
         virtual ~Pass()
         {
             try
@@ -167,6 +538,16 @@ namespace cenpy::graphic::pipeline
         }
 
     protected:
+        [[nodiscard]] std::shared_ptr<IPass<API>> createPass(const std::vector<std::shared_ptr<IShader<API>>> &shaders) const override
+        {
+            auto pass = std::make_shared<Pass<API, PROFILE>>(std::initializer_list<std::shared_ptr<IShader<API>>>{});
+            for (const auto &shader : shaders)
+            {
+                pass->getContext()->addShader(shader);
+            }
+            return pass;
+        }
+
         void load(std::shared_ptr<typename API::PassContext> context) override
         {
             if constexpr (graphic::validator::HasComponent<typename API::PassContext::Loader<PROFILE>>)
@@ -175,6 +556,38 @@ namespace cenpy::graphic::pipeline
             }
         }
 
+        void loadBinary(std::shared_ptr<typename API::PassContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::PassContext::BinaryLoader<PROFILE>>)
+            {
+                API::PassContext::template BinaryLoader<PROFILE>::on(context);
+            }
+        }
+
+        void link(std::shared_ptr<typename API::PassContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::PassContext::Linker<PROFILE>>)
+            {
+                API::PassContext::template Linker<PROFILE>::on(context);
+            }
+        }
+
+        void poll(std::shared_ptr<typename API::PassContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::PassContext::Poller<PROFILE>>)
+            {
+                API::PassContext::template Poller<PROFILE>::on(context);
+            }
+        }
+
+        void wait(std::shared_ptr<typename API::PassContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::PassContext::Waiter<PROFILE>>)
+            {
+                API::PassContext::template Waiter<PROFILE>::on(context);
+            }
+        }
+
         void readUniforms(std::shared_ptr<typename API::PassContext> context) override
         {
             if constexpr (graphic::validator::HasComponent<typename API::PassContext::UniformReader<PROFILE>>)
@@ -206,10 +619,5 @@ namespace cenpy::graphic::pipeline
                 API::PassContext::template User<PROFILE>::on(context);
             }
         }
-
-        std::shared_ptr<IPass<API>> shared() const override
-        {
-            return std::make_shared<Pass<API, PROFILE>>(*this);
-        }
     };
 } // namespace cenpy::graphic::pipeline
\ No newline at end of file
@@ -5,11 +5,18 @@
 #include <format>
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
+#include <algorithm>
+#include <filesystem>
+#include <span>
 #include <utils.hpp>
 #include <common/exception/TraceableException.hpp>
+#include <common/thread/WorkerPool.hpp>
 #include <graphic/pipeline/Pass.hpp>
+#include <graphic/pipeline/UniformBlock.hpp>
 #include <graphic/context/PipelineContext.hpp>
+#include <graphic/render/RenderQueue.hpp>
 #include <graphic/validator/ComponentConcept.hpp>
 
 namespace cenpy::graphic::pipeline
@@ -38,6 +45,188 @@ namespace cenpy::graphic::pipeline
             return m_context->getPass(pass);
         }
 
+        /**
+         * @brief Share a uniform block with every pass of the pipeline.
+         *
+         * The block is uploaded and bound once per frame, when the first pass is used, and each pass
+         * declaring a block of the same name reads it from the block's binding point.
+         *
+         * @param block Block to share.
+         * @return This pipeline, to chain the calls.
+         */
+        IPipeline<API> &withUniformBlock(std::shared_ptr<IUniformBlock<API>> block)
+        {
+            m_context->addUniformBlock(block);
+            return *this;
+        }
+
+        /**
+         * @brief Reads the sources of the shaders of every pass in parallel.
+         *
+         * Call it before loading the passes to overlap the file accesses: the shaders read here
+         * are not read again when their pass is loaded. A shader shared by several passes is read
+         * once.
+         *
+         * @param pool Pool whose workers read the shaders, along with the calling thread.
+         * @throws std::runtime_error if a shader source cannot be read.
+         */
+        void readShaders(common::thread::WorkerPool &pool = common::thread::WorkerPool::shared())
+        {
+            std::vector<std::shared_ptr<IShader<API>>> shaders;
+            std::unordered_set<IShader<API> *> seen;
+            for (int pass = 0; pass < getPassesCount(); ++pass)
+            {
+                for (const auto &shader : m_context->getPass(pass)->getShaders())
+                {
+                    if (seen.insert(shader.get()).second)
+                    {
+                        shaders.push_back(shader);
+                    }
+                }
+            }
+            pool.parallelFor(shaders.size(), [&shaders](std::size_t index)
+                             { shaders[index]->read(); });
+        }
+
+        /**
+         * @brief Starts rebuilding the passes whose shaders depend on the changed files.
+         *
+         * Only the shaders whose source or includes contain one of the files are compiled again,
+         * once even if shared, into new shaders, and only the passes using them are linked again:
+         * the other passes are untouched. The links are only submitted: the passes keep their
+         * current program until pollReloads finds the new one linked. A change to a pass already
+         * being rebuilt supersedes the previous rebuild.
+         *
+         * @param changed Paths of the changed source files.
+         * @return The number of passes being rebuilt.
+         * @throws std::runtime_error listing the passes whose rebuild could not be submitted, after submitting the others.
+         */
+        int reload(const std::vector<std::filesystem::path> &changed)
+        {
+            std::unordered_map<IShader<API> *, std::shared_ptr<IShader<API>>> rebuiltShaders;
+            std::string errors;
+            int rebuilding = 0;
+            for (int pass = 0; pass < getPassesCount(); ++pass)
+            {
+                bool affected = false;
+                std::vector<std::shared_ptr<IShader<API>>> shaders;
+                for (const auto &shader : m_context->getPass(pass)->getShaders())
+                {
+                    if (!std::ranges::any_of(changed, [&shader](const auto &path)
+                                             { return shader->getContext()->dependsOn(path); }))
+                    {
+                        shaders.push_back(shader);
+                        continue;
+                    }
+                    affected = true;
+                    auto [it, inserted] = rebuiltShaders.try_emplace(shader.get());
+                    if (inserted)
+                    {
+                        // Read again from the disk, while the current shader stays attached to the current program.
+                        it->second = shader->createVariant(shader->getContext()->getDefines());
+                    }
+                    shaders.push_back(it->second);
+                }
+                if (!affected)
+                {
+                    continue;
+                }
+                std::erase_if(m_reloads, [pass](const auto &reload)
+                              { return reload.pass == pass; });
+                try
+                {
+                    m_reloads.push_back({pass, m_context->getPass(pass)->rebuild(shaders)});
+                    ++rebuilding;
+                }
+                catch (const std::exception &e)
+                {
+                    errors += std::format("\nPass {}: {}", pass, e.what());
+                }
+            }
+            if (!errors.empty())
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::PIPELINE::RELOAD_FAILED{}", errors));
+            }
+            return rebuilding;
+        }
+
+        int reload(const std::filesystem::path &changed)
+        {
+            return reload(std::vector<std::filesystem::path>{changed});
+        }
+
+        /**
+         * @brief Hands the rebuilt programs that are linked over to their passes, without blocking.
+         *
+         * Call it once per frame while isReloading. Each pass keeps its uniform values. A pass
+         * whose rebuild fails keeps its current program.
+         *
+         * @return The number of passes that now use their rebuilt program.
+         * @throws std::runtime_error listing the passes whose rebuild failed, after polling the others.
+         */
+        int pollReloads()
+        {
+            std::string errors;
+            int replaced = 0;
+            std::erase_if(m_reloads, [this, &errors, &replaced](const auto &reload)
+                          {
+                              try
+                              {
+                                  if (!reload.rebuilt->poll())
+                                  {
+                                      return false;
+                                  }
+                                  m_context->getPass(reload.pass)->replaceWith(*reload.rebuilt);
+                                  ++replaced;
+                              }
+                              catch (const std::exception &e)
+                              {
+                                  errors += std::format("\nPass {}: {}", reload.pass, e.what());
+                              }
+                              return true; });
+            if (!errors.empty())
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::PIPELINE::RELOAD_FAILED{}", errors));
+            }
+            return replaced;
+        }
+
+        [[nodiscard]] bool isReloading() const
+        {
+            return !m_reloads.empty();
+        }
+
+        /**
+         * @brief Lists the files the shaders of the pipeline are built from, to watch them.
+         *
+         * The included files are only known once the shaders have been read.
+         *
+         * @return Paths of the shader sources and of the files they include, each once.
+         */
+        [[nodiscard]] std::vector<std::string> getSourceFiles() const
+        {
+            std::vector<std::string> files;
+            std::unordered_set<std::string> seen;
+            for (int pass = 0; pass < getPassesCount(); ++pass)
+            {
+                for (const auto &shader : m_context->getPass(pass)->getShaders())
+                {
+                    if (seen.insert(shader->getContext()->getShaderPath()).second)
+                    {
+                        files.push_back(shader->getContext()->getShaderPath());
+                    }
+                    for (const auto &include : shader->getContext()->getIncludes())
+                    {
+                        if (seen.insert(include).second)
+                        {
+                            files.push_back(include);
+                        }
+                    }
+                }
+            }
+            return files;
+        }
+
         [[nodiscard]] virtual int getPassesCount() const
         {
             return m_context->getPassesCount();
@@ -65,6 +254,46 @@ namespace cenpy::graphic::pipeline
             use(m_context);
         }
 
+        /**
+         * @brief Draws the commands of a queue, then empties it.
+         *
+         * The queue is sorted first, so each pass is used once per run of commands of the same
+         * layer and the commands sharing a texture are drawn together. Each run of consecutive
+         * commands of a pass is handed to the drawer at once. The pipeline is reset once the
+         * queue is drawn.
+         *
+         * @param queue Commands of the frame.
+         * @throws std::runtime_error if a command names a pass the pipeline does not have.
+         */
+        void draw(render::RenderQueue &queue)
+        {
+            queue.sort();
+            const auto &commands = queue.getCommands();
+            for (std::size_t first = 0; first < commands.size();)
+            {
+                const int pass = commands[first].pass;
+                if (pass >= getPassesCount())
+                {
+                    throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_QUEUE::UNKNOWN_PASS\nPass {} of {}", pass, getPassesCount()));
+                }
+                std::size_t last = first + 1;
+                while (last < commands.size() && commands[last].pass == pass)
+                {
+                    ++last;
+                }
+                if (pass != m_context->getCurrentPass())
+                {
+                    use(pass);
+                }
+                m_context->setCurrentCommands(std::span(commands).subspan(first, last - first));
+                draw(m_context);
+                first = last;
+            }
+            m_context->setCurrentCommands({});
+            reset();
+            queue.clear();
+        }
+
         /**
          * @brief Resets the pipeline to its initial state. unset pipeline in OpenGL context.
          */
@@ -81,9 +310,20 @@ namespace cenpy::graphic::pipeline
     protected:
         virtual void use(std::shared_ptr<typename API::PipelineContext> context) = 0;
         virtual void reset(std::shared_ptr<typename API::PipelineContext> context) = 0;
+        virtual void draw(std::shared_ptr<typename API::PipelineContext> context) = 0;
 
     private:
+        /**
+         * @brief Rebuild of a pass submitted by reload, waiting for its link.
+         */
+        struct PendingReload
+        {
+            int pass;                            ///< Index of the rebuilt pass.
+            std::shared_ptr<IPass<API>> rebuilt; ///< Pass linking the new shaders.
+        };
+
         std::shared_ptr<typename API::PipelineContext> m_context;
+        std::vector<PendingReload> m_reloads; ///< Rebuilds not linked yet, one per pass at most.
     };
 
     template <typename API, auto PROFILE>
@@ -94,6 +334,7 @@ namespace cenpy::graphic::pipeline
         using IPipeline<API>::IPipeline;
         using IPipeline<API>::use;
         using IPipeline<API>::reset;
+        using IPipeline<API>::draw;
 
     protected:
         void use(std::shared_ptr<typename API::PipelineContext> context) override
@@ -111,6 +352,14 @@ namespace cenpy::graphic::pipeline
                 API::PipelineContext::template Resetter<PROFILE>::on(context);
             }
         }
+
+        void draw(std::shared_ptr<typename API::PipelineContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::PipelineContext::Drawer<PROFILE>>)
+            {
+                API::PipelineContext::template Drawer<PROFILE>::on(context);
+            }
+        }
     };
 
 } // namespace cenpy::graphic::pipeline
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include <GLFW/glfw3.h>
 #include <memory>
 #include <string>
+#include <vector>
 #include <format>
 #include <fstream>
 #include <common/exception/TraceableException.hpp>
@@ -96,6 +97,18 @@ namespace cenpy::graphic::pipeline
             return m_context;
         }
 
+        /**
+         * @brief Reads the shader source and resolves its includes, unless it has already been read.
+         */
+        virtual void read()
+        {
+            if (m_context && m_context->getShaderCode().empty())
+            {
+                read(m_context);
+                preprocess(m_context);
+            }
+        }
+
         /**
          * @brief Loads the shader into the rendering system.
          */
@@ -103,14 +116,25 @@ namespace cenpy::graphic::pipeline
         {
             if (m_context)
             {
-                if (m_context->getShaderCode().empty())
-                {
-                    read(m_context);
-                }
+                read();
                 load(m_context);
             }
         }
 
+        /**
+         * @brief Submits the compilation of the shader without waiting for its result.
+         *
+         * Errors are reported when the pass linking the shader is polled.
+         */
+        virtual void compile()
+        {
+            if (m_context)
+            {
+                read();
+                compile(m_context);
+            }
+        }
+
         /**
          * @brief Frees the shader resources.
          */
@@ -122,10 +146,37 @@ namespace cenpy::graphic::pipeline
             }
         }
 
+        /**
+         * @brief Reads the shader source again from the disk and recompiles it.
+         *
+         * The passes linking the shader must be linked again to use the new code.
+         */
+        virtual void reload()
+        {
+            if (m_context)
+            {
+                free();
+                m_context->setShaderCode("");
+                load();
+            }
+        }
+
+        /**
+         * @brief Creates a shader compiled from the same source, with macros defined before its code.
+         *
+         * The variant shares the settings of this shader and is neither read nor compiled yet.
+         *
+         * @param defines Names of the macros to define.
+         * @return The variant shader.
+         */
+        [[nodiscard]] virtual std::shared_ptr<IShader<API>> createVariant(std::vector<std::string> defines) const = 0;
+
     protected:
         virtual void load(std::shared_ptr<typename API::ShaderContext> context) = 0;
+        virtual void compile(std::shared_ptr<typename API::ShaderContext> context) = 0;
         virtual void free(std::shared_ptr<typename API::ShaderContext> context) = 0;
         virtual void read(std::shared_ptr<typename API::ShaderContext> context) = 0;
+        virtual void preprocess(std::shared_ptr<typename API::ShaderContext> context) = 0;
 
     private:
         std::shared_ptr<typename API::ShaderContext> m_context; // API-specific shader context
@@ -138,13 +189,24 @@ namespace cenpy::graphic::pipeline
     public:
         using IShader<API>::IShader;
         using IShader<API>::load;
+        using IShader<API>::compile;
         using IShader<API>::free;
+        using IShader<API>::reload;
 
         ~Shader()
         {
             free();
         }
 
+        [[nodiscard]] std::shared_ptr<IShader<API>> createVariant(std::vector<std::string> defines) const override
+        {
+            const auto &context = this->getContext();
+            auto variant = std::make_shared<Shader<API, PROFILE>>(context->getShaderPath(), context->getShaderType());
+            variant->getContext()->inheritSettings(*context);
+            variant->getContext()->setDefines(std::move(defines));
+            return variant;
+        }
+
     protected:
         void free(std::shared_ptr<typename API::ShaderContext> context) override
         {
@@ -162,6 +224,14 @@ namespace cenpy::graphic::pipeline
             }
         }
 
+        void compile(std::shared_ptr<typename API::ShaderContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::ShaderContext::template Compiler<PROFILE>>)
+            {
+                API::ShaderContext::template Compiler<PROFILE>::on(context);
+            }
+        }
+
         void read(std::shared_ptr<typename API::ShaderContext> context) override
         {
             if constexpr (graphic::validator::HasComponent<typename API::ShaderContext::template Reader<PROFILE>>)
@@ -169,5 +239,13 @@ namespace cenpy::graphic::pipeline
                 API::ShaderContext::template Reader<PROFILE>::on(context);
             }
         }
+
+        void preprocess(std::shared_ptr<typename API::ShaderContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::ShaderContext::template Preprocessor<PROFILE>>)
+            {
+                API::ShaderContext::template Preprocessor<PROFILE>::on(context);
+            }
+        }
     };
 } // namespace cenpy::graphic::pipeline
\ No newline at end of file
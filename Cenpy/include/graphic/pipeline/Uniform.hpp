@@ -13,6 +13,8 @@
 #pragma once
 
 #include <type_traits>
+#include <cstdint>
+#include <limits>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <string>
@@ -29,6 +31,27 @@
 
 namespace cenpy::graphic::pipeline
 {
+    /**
+     * @struct UniformHandle
+     * @brief Compact handle to a uniform of a pass, resolved once from its name.
+     *
+     * A handle is an index into the flat uniform array of the pass context. It stays valid
+     * until the uniforms of the pass are read again (e.g. when the pass is reloaded).
+     */
+    struct UniformHandle
+    {
+        static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index = INVALID_INDEX; ///< Index of the uniform in the pass context.
+
+        [[nodiscard]] constexpr bool isValid() const
+        {
+            return index != INVALID_INDEX;
+        }
+
+        constexpr bool operator==(const UniformHandle &) const = default;
+    };
+
     /**
      * @class Uniform
      * @brief Abstract base class for representing uniform variables in shaders.
@@ -57,14 +80,40 @@ namespace cenpy::graphic::pipeline
          * setting the value.
          *
          * @param value The value to set the uniform variable to.
+         * @note The API call is skipped when the value equals the last uploaded one.
          */
         template <typename T>
         void set(const T &value)
+        {
+            if (stage(value))
+            {
+                commit();
+            }
+        }
+
+        /**
+         * @brief Stores the value of the uniform variable without uploading it.
+         *
+         * The value is uploaded by the next commit, which lets a pass gather the sets made while
+         * it is not bound and upload them when it is used.
+         *
+         * @param value The value to set the uniform variable to.
+         * @return True if the value differs from the last uploaded one and must be committed.
+         */
+        template <typename T>
+        bool stage(const T &value)
         {
             if constexpr (graphic::validator::HasComponent<typename API::UniformContext::template Setter<T>>)
             {
                 m_context->template setValue<T>(value);
-                API::UniformContext::template Setter<T>::on(m_context);
+                if (!m_context->isDirty())
+                {
+                    m_context->markCacheHit();
+                    return false;
+                }
+                // The type tag of a uniform never changes once set, neither does its setter.
+                m_commit = &API::UniformContext::template Setter<T>::on;
+                return true;
             }
             else
             {
@@ -72,6 +121,34 @@ namespace cenpy::graphic::pipeline
             }
         }
 
+        /**
+         * @brief Uploads the staged value, if it has not been uploaded yet.
+         */
+        void commit()
+        {
+            if (m_commit && m_context->isDirty())
+            {
+                m_commit(m_context);
+                m_context->markUploaded();
+            }
+        }
+
+        /**
+         * @brief Stages the value of another uniform of the same name, e.g. after the pass has been relinked.
+         *
+         * @param previous Uniform whose value is taken over.
+         * @return True if a value was staged and must be committed.
+         */
+        bool restore(const Uniform<API> &previous)
+        {
+            if (!previous.m_commit || !m_context->restoreValue(*previous.m_context))
+            {
+                return false;
+            }
+            m_commit = previous.m_commit;
+            return true;
+        }
+
         /**
          * @brief Gets the value of the uniform variable.
          *
@@ -93,7 +170,10 @@ namespace cenpy::graphic::pipeline
         }
 
     private:
+        using CommitFunction = void (*)(const std::shared_ptr<typename API::UniformContext> &);
+
         std::shared_ptr<typename API::UniformContext> m_context; // API-specific shader context
+        CommitFunction m_commit = nullptr;                       // Setter of the staged value type
     };
 
 } // namespace cenpy::graphic::pipeline
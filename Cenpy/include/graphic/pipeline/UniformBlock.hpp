@@ -0,0 +1,159 @@
+#pragma once
+
+#include <memory>
+#include <iostream>
+#include <string_view>
+#include <initializer_list>
+#include <graphic/Api.hpp>
+#include <graphic/context/UniformBlockContext.hpp>
+#include <graphic/validator/ComponentConcept.hpp>
+
+namespace cenpy::graphic::pipeline
+{
+    /**
+     * @class IUniformBlock
+     * @brief A block of uniforms backed by a single API buffer, shared by every pass declaring it.
+     *
+     * Values are staged on the CPU and only the changed range is uploaded, once, by update(). The
+     * buffer is created on the first update, so a block can be filled before any pass is loaded.
+     */
+    template <typename API>
+    class IUniformBlock
+    {
+    public:
+        IUniformBlock(std::string_view name, std::uint32_t bindingPoint,
+                      const std::initializer_list<graphic::context::UniformBlockMember> &members,
+                      std::shared_ptr<typename API::UniformBlockContext> context)
+            : m_context(context)
+        {
+            m_context->setBlockName(name);
+            m_context->setBindingPoint(bindingPoint);
+            for (const auto &member : members)
+            {
+                m_context->addMember(member);
+            }
+        }
+
+        IUniformBlock(std::string_view name, std::uint32_t bindingPoint,
+                      const std::initializer_list<graphic::context::UniformBlockMember> &members)
+            : IUniformBlock(name, bindingPoint, members, std::make_shared<typename API::UniformBlockContext>())
+        {
+        }
+
+        virtual ~IUniformBlock() = default;
+
+        /**
+         * @brief Stage a value of the block; nothing is uploaded until the next update.
+         * @param member Name of the member to set.
+         * @param value Value to set.
+         * @param index Element to set for array members.
+         * @return This block, to chain the sets.
+         */
+        template <typename T>
+        IUniformBlock<API> &set(std::string_view member, const T &value, std::uint32_t index = 0)
+        {
+            m_context->setValue(member, value, index);
+            return *this;
+        }
+
+        /**
+         * @brief Upload the staged changes, creating the buffer the first time.
+         */
+        virtual void update()
+        {
+            if (!m_loaded)
+            {
+                load(m_context);
+                m_loaded = true;
+                return;
+            }
+            update(m_context);
+        }
+
+        virtual void bind()
+        {
+            bind(m_context);
+        }
+
+        virtual void free()
+        {
+            free(m_context);
+            m_loaded = false;
+        }
+
+        [[nodiscard]] virtual std::shared_ptr<typename API::UniformBlockContext> getContext() const
+        {
+            return m_context;
+        }
+
+    protected:
+        virtual void load(std::shared_ptr<typename API::UniformBlockContext> context) = 0;
+        virtual void update(std::shared_ptr<typename API::UniformBlockContext> context) = 0;
+        virtual void bind(std::shared_ptr<typename API::UniformBlockContext> context) = 0;
+        virtual void free(std::shared_ptr<typename API::UniformBlockContext> context) = 0;
+
+    private:
+        std::shared_ptr<typename API::UniformBlockContext> m_context; ///< The block context.
+        bool m_loaded = false;                                        ///< Whether the API buffer has been created.
+    };
+
+    template <typename API, auto PROFILE>
+        requires(API::Validator::template validateUniformBlock<API, PROFILE>())
+    class UniformBlock : public IUniformBlock<API>
+    {
+    public:
+        using IUniformBlock<API>::IUniformBlock;
+        using IUniformBlock<API>::update;
+        using IUniformBlock<API>::bind;
+        using IUniformBlock<API>::free;
+
+        // A block owns its API buffer through the shared context: copies would free it twice.
+        UniformBlock(const UniformBlock &) = delete;
+        UniformBlock &operator=(const UniformBlock &) = delete;
+
+        virtual ~UniformBlock()
+        {
+            try
+            {
+                free();
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << e.what() << std::endl;
+            }
+        }
+
+    protected:
+        void load(std::shared_ptr<typename API::UniformBlockContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::UniformBlockContext::Loader<PROFILE>>)
+            {
+                API::UniformBlockContext::template Loader<PROFILE>::on(context);
+            }
+        }
+
+        void update(std::shared_ptr<typename API::UniformBlockContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::UniformBlockContext::Updater<PROFILE>>)
+            {
+                API::UniformBlockContext::template Updater<PROFILE>::on(context);
+            }
+        }
+
+        void bind(std::shared_ptr<typename API::UniformBlockContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::UniformBlockContext::Binder<PROFILE>>)
+            {
+                API::UniformBlockContext::template Binder<PROFILE>::on(context);
+            }
+        }
+
+        void free(std::shared_ptr<typename API::UniformBlockContext> context) override
+        {
+            if constexpr (graphic::validator::HasComponent<typename API::UniformBlockContext::Freer<PROFILE>>)
+            {
+                API::UniformBlockContext::template Freer<PROFILE>::on(context);
+            }
+        }
+    };
+} // namespace cenpy::graphic::pipeline
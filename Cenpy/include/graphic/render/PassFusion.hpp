@@ -0,0 +1,160 @@
+// file: PassFusion.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+
+namespace cenpy::graphic::render
+{
+    /**
+     * @struct PointwiseUniform
+     * @brief Uniform of a point-wise stage, e.g. {"vec3", "tint"}.
+     */
+    struct PointwiseUniform
+    {
+        std::string type;
+        std::string name;
+    };
+
+    /**
+     * @struct PointwiseStage
+     * @brief Body of a point-wise pass, to be chained with others into one fragment shader.
+     *
+     * The body is GLSL statements updating `vec4 color`, the texel of the source or the result of
+     * the previous stage, with `vec2 uv` the coordinates of the texel. They use the uniforms of the
+     * stage by name, e.g. "color.rgb *= tint;".
+     */
+    struct PointwiseStage
+    {
+        std::string name;                       ///< Name of the stage, for the generated code.
+        std::string body;                       ///< Statements updating color.
+        std::vector<PointwiseUniform> uniforms; ///< Uniforms the body uses.
+    };
+
+    /**
+     * @struct FusedStage
+     * @brief Stage of a fused chain.
+     */
+    struct FusedStage
+    {
+        const PointwiseStage *stage;
+        bool saturate = false; ///< Whether to clamp the result to [0, 1], as a normalized intermediate target did.
+    };
+
+    /**
+     * @class PassFusion
+     * @brief Generates the shaders executing a chain of point-wise stages in a single fullscreen draw.
+     *
+     * Each stage becomes a function of the fragment shader, called in order on the texel of the
+     * source bound to unit 0. The uniforms of the stage at index i are declared as s<i>_<name> and
+     * the body sees them under their own name, so a chain can hold the same stage twice with
+     * different values. The vertex shader draws a triangle covering the viewport from three
+     * vertices without attributes.
+     */
+    class PassFusion
+    {
+    public:
+        /**
+         * @brief Get the vertex shader of the fused passes.
+         * @return The source of the shader.
+         */
+        [[nodiscard]] static std::string_view getVertexShader()
+        {
+            return "#version 330 core\n"
+                   "out vec2 v_uv;\n"
+                   "void main()\n"
+                   "{\n"
+                   "    v_uv = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n"
+                   "    gl_Position = vec4(v_uv * 2.0 - 1.0, 0.0, 1.0);\n"
+                   "}\n";
+        }
+
+        /**
+         * @brief Generates the fragment shader chaining stages.
+         * @param stages Stages, in order.
+         * @return The source of the shader.
+         * @throws TraceableException if the chain is empty or a name is not a GLSL identifier.
+         */
+        [[nodiscard]] static std::string generate(const std::vector<FusedStage> &stages)
+        {
+            if (stages.empty())
+            {
+                throw common::exception::TraceableException<std::runtime_error>("ERROR::PASS_FUSION::EMPTY_CHAIN\nNo stage to fuse");
+            }
+            std::string code = "#version 330 core\n"
+                               "in vec2 v_uv;\n"
+                               "out vec4 fragColor;\n"
+                               "uniform sampler2D u_source;\n";
+            for (std::size_t index = 0; index < stages.size(); ++index)
+            {
+                const PointwiseStage &stage = *stages[index].stage;
+                checkIdentifier(stage.name, stage.name);
+                code += std::format("\n// {}\n", stage.name);
+                for (const auto &uniform : stage.uniforms)
+                {
+                    checkIdentifier(stage.name, uniform.name);
+                    code += std::format("uniform {} {};\n", uniform.type, getUniformName(index, uniform.name));
+                }
+                code += std::format("void stage{}(inout vec4 color, vec2 uv)\n{{\n", index);
+                for (const auto &uniform : stage.uniforms)
+                {
+                    code += std::format("#define {} {}\n", uniform.name, getUniformName(index, uniform.name));
+                }
+                code += stage.body;
+                code += '\n';
+                for (const auto &uniform : stage.uniforms)
+                {
+                    code += std::format("#undef {}\n", uniform.name);
+                }
+                code += "}\n";
+            }
+
+            code += "\nvoid main()\n{\n    vec4 color = texture(u_source, v_uv);\n";
+            for (std::size_t index = 0; index < stages.size(); ++index)
+            {
+                code += std::format("    stage{}(color, v_uv);\n", index);
+                if (stages[index].saturate)
+                {
+                    code += "    color = clamp(color, 0.0, 1.0);\n";
+                }
+            }
+            code += "    fragColor = color;\n}\n";
+            return code;
+        }
+
+        /**
+         * @brief Get the name a uniform of a stage is declared with in the fused shader.
+         * @param index Index of the stage in the chain.
+         * @param name Name of the uniform in the stage.
+         * @return The name of the uniform in the program.
+         */
+        [[nodiscard]] static std::string getUniformName(std::size_t index, std::string_view name)
+        {
+            return std::format("s{}_{}", index, name);
+        }
+
+    private:
+        static void checkIdentifier(std::string_view stage, std::string_view name)
+        {
+            const auto isLetter = [](char c)
+            { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; };
+            const auto isDigit = [](char c)
+            { return c >= '0' && c <= '9'; };
+            bool valid = !name.empty() && isLetter(name.front());
+            for (char c : name)
+            {
+                valid = valid && (isLetter(c) || isDigit(c));
+            }
+            if (!valid)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::PASS_FUSION::INVALID_NAME\nStage {} uses {}, not a GLSL identifier", stage, name));
+            }
+        }
+    };
+}
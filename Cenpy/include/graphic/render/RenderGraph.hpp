@@ -0,0 +1,588 @@
+// file: RenderGraph.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+
+namespace cenpy::graphic::render
+{
+    /**
+     * @brief Formats of the render targets.
+     */
+    enum class TargetFormat
+    {
+        RGBA8,
+        RGBA16F,
+        DEPTH24_STENCIL8
+    };
+
+    /**
+     * @struct TargetDesc
+     * @brief Size and format of a render target. Targets of equal descriptions can share memory.
+     */
+    struct TargetDesc
+    {
+        int width = 0;
+        int height = 0;
+        TargetFormat format = TargetFormat::RGBA8;
+
+        bool operator==(const TargetDesc &) const = default;
+    };
+
+    /**
+     * @class RenderGraph
+     * @brief Schedules passes from the targets they read and write, and assigns the targets memory.
+     *
+     * Transient targets live within the frame: they are allocated by whoever executes the graph.
+     * Imported targets, such as the backbuffer, live outside of it and are the outputs of the
+     * graph. A target is complete once every pass writing it ran: its readers run after all its
+     * writers, and its writers run in the order they were added.
+     *
+     * compile() culls the passes none of whose targets reaches an imported one, orders the others,
+     * favouring the order they were added in, and computes the lifetime of each transient target,
+     * from the first to the last pass using it. Targets of equal descriptions whose lifetimes do
+     * not overlap share a slot: the executor allocates one texture per slot. Compile once, and
+     * again when the graph or the size of a target changes, not each frame.
+     *
+     * Point-wise passes compute each texel from the same texel of their source only, e.g. a tint
+     * or a vignette. When fusion is enabled, compile() chains a point-wise pass with the point-wise
+     * pass reading its target when nothing else uses that target: the chain executes as its first
+     * pass, reading its source and writing the target of its last pass, and the intermediate
+     * targets are never allocated.
+     */
+    class RenderGraph
+    {
+    public:
+        /**
+         * @brief Declares a transient target.
+         * @param name Name of the target, for the errors.
+         * @param desc Size and format of the target.
+         * @return The target, to declare the passes using it.
+         */
+        int addTarget(const std::string &name, const TargetDesc &desc)
+        {
+            m_targets.push_back({name, desc, false});
+            m_compiled = false;
+            return static_cast<int>(m_targets.size() - 1);
+        }
+
+        /**
+         * @brief Declares a target living outside the graph, one of its outputs.
+         * @param name Name of the target, for the errors.
+         * @param desc Size and format of the target.
+         * @return The target, to declare the passes using it.
+         */
+        int importTarget(const std::string &name, const TargetDesc &desc)
+        {
+            m_targets.push_back({name, desc, true});
+            m_compiled = false;
+            return static_cast<int>(m_targets.size() - 1);
+        }
+
+        /**
+         * @brief Changes the description of a target, e.g. when the window is resized.
+         * @param target Target to describe.
+         * @param desc New size and format of the target.
+         */
+        void setDesc(int target, const TargetDesc &desc)
+        {
+            if (m_targets.at(target).desc != desc)
+            {
+                m_targets[target].desc = desc;
+                m_compiled = false;
+            }
+        }
+
+        /**
+         * @brief Declares a pass.
+         * @param name Name of the pass, for the errors.
+         * @param reads Targets the pass samples.
+         * @param writes Targets the pass renders to.
+         * @return The pass.
+         * @throws TraceableException if a target is unknown, or both read and written by the pass.
+         */
+        int addPass(const std::string &name, const std::vector<int> &reads, const std::vector<int> &writes)
+        {
+            for (int target : reads)
+            {
+                checkTarget(name, target);
+                if (std::ranges::find(writes, target) != writes.end())
+                {
+                    throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_GRAPH::FEEDBACK_LOOP\nPass {} reads and writes {}", name, m_targets[target].name));
+                }
+            }
+            for (int target : writes)
+            {
+                checkTarget(name, target);
+            }
+            m_passes.push_back({name, reads, writes});
+            m_compiled = false;
+            return static_cast<int>(m_passes.size() - 1);
+        }
+
+        /**
+         * @brief Declares a point-wise pass, which can be fused with the point-wise passes around it.
+         * @param name Name of the pass, for the errors.
+         * @param source Target the pass samples.
+         * @param target Color target the pass renders to.
+         * @return The pass.
+         * @throws TraceableException if a target is unknown, the same, or the target is a depth target.
+         */
+        int addPointwisePass(const std::string &name, int source, int target)
+        {
+            checkTarget(name, target);
+            if (m_targets[target].desc.format == TargetFormat::DEPTH24_STENCIL8)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_GRAPH::POINTWISE_DEPTH\nPoint-wise pass {} renders to depth target {}", name, m_targets[target].name));
+            }
+            const int pass = addPass(name, {source}, {target});
+            m_passes[pass].pointwise = true;
+            return pass;
+        }
+
+        /**
+         * @brief Enables or disables the fusion of the point-wise passes, e.g. to compare the results.
+         * @param fusion True to fuse the chains of point-wise passes, the default.
+         */
+        void setFusion(bool fusion)
+        {
+            if (m_fusion != fusion)
+            {
+                m_fusion = fusion;
+                m_compiled = false;
+            }
+        }
+
+        [[nodiscard]] bool isFusion() const
+        {
+            return m_fusion;
+        }
+
+        /**
+         * @brief Orders the passes and assigns a slot to each transient target used.
+         * @throws TraceableException if the passes depend on each other in a cycle.
+         */
+        void compile()
+        {
+            const std::size_t passCount = m_passes.size();
+            fuse();
+            std::vector<std::vector<int>> writers(m_targets.size());
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                if (isExecuted(static_cast<int>(pass)))
+                {
+                    for (int target : getOutputs(static_cast<int>(pass)))
+                    {
+                        writers[target].push_back(static_cast<int>(pass));
+                    }
+                }
+            }
+
+            // A pass depends on every writer of the targets it reads, and on the previous writers of the targets it writes.
+            std::vector<std::vector<int>> dependencies(passCount);
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                if (!isExecuted(static_cast<int>(pass)))
+                {
+                    continue;
+                }
+                for (int target : getInputs(static_cast<int>(pass)))
+                {
+                    dependencies[pass].insert(dependencies[pass].end(), writers[target].begin(), writers[target].end());
+                }
+                for (int target : getOutputs(static_cast<int>(pass)))
+                {
+                    auto self = std::ranges::find(writers[target], static_cast<int>(pass));
+                    if (self != writers[target].begin())
+                    {
+                        dependencies[pass].push_back(*std::prev(self));
+                    }
+                }
+            }
+
+            cull(dependencies);
+            order(dependencies);
+            assignSlots();
+            m_compiled = true;
+        }
+
+        [[nodiscard]] bool isCompiled() const
+        {
+            return m_compiled;
+        }
+
+        /**
+         * @brief Get the passes to execute, in order.
+         * @return Indices of the passes not culled.
+         */
+        [[nodiscard]] const std::vector<int> &getOrder() const
+        {
+            return m_order;
+        }
+
+        [[nodiscard]] bool isCulled(int pass) const
+        {
+            return std::ranges::find(m_order, pass) == m_order.end();
+        }
+
+        /**
+         * @brief Get the slot of a transient target.
+         * @param target Target of the graph.
+         * @return Index of the slot, -1 for an imported or unused target.
+         */
+        [[nodiscard]] int getSlot(int target) const
+        {
+            return m_slotOfTarget.at(target);
+        }
+
+        /**
+         * @brief Get the descriptions of the slots, one texture each.
+         * @return Size and format of each slot.
+         */
+        [[nodiscard]] const std::vector<TargetDesc> &getSlots() const
+        {
+            return m_slots;
+        }
+
+        [[nodiscard]] int getTargetsCount() const
+        {
+            return static_cast<int>(m_targets.size());
+        }
+
+        [[nodiscard]] const TargetDesc &getDesc(int target) const
+        {
+            return m_targets.at(target).desc;
+        }
+
+        [[nodiscard]] bool isImported(int target) const
+        {
+            return m_targets.at(target).imported;
+        }
+
+        [[nodiscard]] const std::vector<int> &getReads(int pass) const
+        {
+            return m_passes.at(pass).reads;
+        }
+
+        [[nodiscard]] const std::vector<int> &getWrites(int pass) const
+        {
+            return m_passes.at(pass).writes;
+        }
+
+        [[nodiscard]] const std::string &getPassName(int pass) const
+        {
+            return m_passes.at(pass).name;
+        }
+
+        [[nodiscard]] bool isPointwise(int pass) const
+        {
+            return m_passes.at(pass).pointwise;
+        }
+
+        /**
+         * @brief Get the passes a pass executes once compiled.
+         * @param pass Pass of the graph.
+         * @return The pass then the passes fused into it, in order; empty if the pass is fused into another.
+         */
+        [[nodiscard]] const std::vector<int> &getChain(int pass) const
+        {
+            return m_chains.at(pass);
+        }
+
+        /**
+         * @brief Get the targets a compiled pass samples.
+         * @param pass Pass executed.
+         * @return The targets read by the pass, the first of its chain.
+         */
+        [[nodiscard]] const std::vector<int> &getInputs(int pass) const
+        {
+            return m_passes.at(m_chains.at(pass).front()).reads;
+        }
+
+        /**
+         * @brief Get the targets a compiled pass renders to.
+         * @param pass Pass executed.
+         * @return The targets written by the last pass of its chain.
+         */
+        [[nodiscard]] const std::vector<int> &getOutputs(int pass) const
+        {
+            return m_passes.at(m_chains.at(pass).back()).writes;
+        }
+
+    private:
+        struct Target
+        {
+            std::string name; ///< Name of the target.
+            TargetDesc desc;  ///< Size and format of the target.
+            bool imported;    ///< Whether the target lives outside the graph.
+        };
+
+        struct Pass
+        {
+            std::string name;        ///< Name of the pass.
+            std::vector<int> reads;  ///< Targets sampled.
+            std::vector<int> writes; ///< Targets rendered to.
+            bool pointwise = false;  ///< Whether each texel only depends on the same texel of the source.
+        };
+
+        [[nodiscard]] bool isExecuted(int pass) const
+        {
+            return !m_chains[pass].empty();
+        }
+
+        /**
+         * @brief Chains each point-wise pass with the point-wise pass reading its target.
+         *
+         * The intermediate target must be transient, of the size of the target of the chain, and
+         * used by these two passes only; the target of the next pass must have no other writer, so
+         * executing the chain in place of its first pass does not reorder the writes. Passes reading
+         * each other in a cycle are not fused, as no pass would execute them: they are scheduled
+         * like any other pass, and order() reports the cycle.
+         */
+        void fuse()
+        {
+            const std::size_t passCount = m_passes.size();
+            m_chains.assign(passCount, {});
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                m_chains[pass].push_back(static_cast<int>(pass));
+            }
+            if (!m_fusion)
+            {
+                return;
+            }
+
+            std::vector<int> writersCount(m_targets.size(), 0);
+            std::vector<std::vector<int>> readers(m_targets.size());
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                for (int target : m_passes[pass].writes)
+                {
+                    ++writersCount[target];
+                }
+                for (int target : m_passes[pass].reads)
+                {
+                    readers[target].push_back(static_cast<int>(pass));
+                }
+            }
+
+            constexpr int NONE = -1;
+            std::vector<int> next(passCount, NONE);
+            std::vector<bool> fused(passCount, false);
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                if (!m_passes[pass].pointwise)
+                {
+                    continue;
+                }
+                const int target = m_passes[pass].writes.front();
+                if (m_targets[target].imported || writersCount[target] != 1 || readers[target].size() != 1)
+                {
+                    continue;
+                }
+                const int reader = readers[target].front();
+                if (!m_passes[reader].pointwise)
+                {
+                    continue;
+                }
+                const TargetDesc &output = m_targets[m_passes[reader].writes.front()].desc;
+                if (writersCount[m_passes[reader].writes.front()] != 1 || output.width != m_targets[target].desc.width || output.height != m_targets[target].desc.height)
+                {
+                    continue;
+                }
+                next[pass] = reader;
+                fused[reader] = true;
+            }
+
+            // A point-wise pass has one source, so a fused pass no chain reaches is in a cycle.
+            std::vector<bool> chained(passCount, false);
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                if (!fused[pass])
+                {
+                    for (int link = next[pass]; link != NONE; link = next[link])
+                    {
+                        chained[link] = true;
+                    }
+                }
+            }
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                if (fused[pass] && !chained[pass])
+                {
+                    fused[pass] = false;
+                    next[pass] = NONE;
+                }
+            }
+
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                if (fused[pass])
+                {
+                    m_chains[pass].clear();
+                    continue;
+                }
+                for (int link = next[pass]; link != NONE; link = next[link])
+                {
+                    m_chains[pass].push_back(link);
+                }
+            }
+        }
+
+        void checkTarget(const std::string &pass, int target) const
+        {
+            if (target < 0 || target >= static_cast<int>(m_targets.size()))
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_GRAPH::UNKNOWN_TARGET\nPass {} uses target {} of {}", pass, target, m_targets.size()));
+            }
+        }
+
+        /**
+         * @brief Keeps the passes writing an imported target, and the passes they depend on.
+         * @param dependencies Passes each pass depends on.
+         */
+        void cull(const std::vector<std::vector<int>> &dependencies)
+        {
+            m_kept.assign(m_passes.size(), false);
+            std::vector<int> stack;
+            for (std::size_t pass = 0; pass < m_passes.size(); ++pass)
+            {
+                if (isExecuted(static_cast<int>(pass)) && std::ranges::any_of(getOutputs(static_cast<int>(pass)), [this](int target)
+                                                                               { return m_targets[target].imported; }))
+                {
+                    m_kept[pass] = true;
+                    stack.push_back(static_cast<int>(pass));
+                }
+            }
+            while (!stack.empty())
+            {
+                const int pass = stack.back();
+                stack.pop_back();
+                for (int dependency : dependencies[pass])
+                {
+                    if (!m_kept[dependency])
+                    {
+                        m_kept[dependency] = true;
+                        stack.push_back(dependency);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Sorts the kept passes topologically, the first added ready pass first.
+         * @param dependencies Passes each pass depends on.
+         */
+        void order(const std::vector<std::vector<int>> &dependencies)
+        {
+            const std::size_t passCount = m_passes.size();
+            std::vector<int> pending(passCount, 0);
+            std::vector<std::vector<int>> dependents(passCount);
+            std::size_t kept = 0;
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                if (!m_kept[pass])
+                {
+                    continue;
+                }
+                ++kept;
+                for (int dependency : dependencies[pass])
+                {
+                    ++pending[pass];
+                    dependents[dependency].push_back(static_cast<int>(pass));
+                }
+            }
+
+            m_order.clear();
+            std::vector<bool> done(passCount, false);
+            while (m_order.size() < kept)
+            {
+                std::size_t ready = 0;
+                while (ready < passCount && (!m_kept[ready] || done[ready] || pending[ready] != 0))
+                {
+                    ++ready;
+                }
+                if (ready == passCount)
+                {
+                    throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_GRAPH::CYCLE\n{} passes depend on each other", kept - m_order.size()));
+                }
+                done[ready] = true;
+                m_order.push_back(static_cast<int>(ready));
+                for (int dependent : dependents[ready])
+                {
+                    --pending[dependent];
+                }
+            }
+        }
+
+        /**
+         * @brief Gives each transient target the first free slot of its description.
+         *
+         * A slot is free for a pass once the last pass using its target ran before it: the targets
+         * of a same pass never share a slot.
+         */
+        void assignSlots()
+        {
+            constexpr int UNUSED = -1;
+            std::vector<int> first(m_targets.size(), UNUSED);
+            std::vector<int> last(m_targets.size(), UNUSED);
+            for (std::size_t position = 0; position < m_order.size(); ++position)
+            {
+                const int pass = m_order[position];
+                for (const auto *targets : {&getInputs(pass), &getOutputs(pass)})
+                {
+                    for (int target : *targets)
+                    {
+                        if (first[target] == UNUSED)
+                        {
+                            first[target] = static_cast<int>(position);
+                        }
+                        last[target] = static_cast<int>(position);
+                    }
+                }
+            }
+
+            m_slots.clear();
+            m_slotOfTarget.assign(m_targets.size(), UNUSED);
+            std::vector<int> busyUntil;
+            for (std::size_t position = 0; position < m_order.size(); ++position)
+            {
+                for (std::size_t target = 0; target < m_targets.size(); ++target)
+                {
+                    if (m_targets[target].imported || first[target] != static_cast<int>(position))
+                    {
+                        continue;
+                    }
+                    std::size_t slot = 0;
+                    while (slot < m_slots.size() && (m_slots[slot] != m_targets[target].desc || busyUntil[slot] >= static_cast<int>(position)))
+                    {
+                        ++slot;
+                    }
+                    if (slot == m_slots.size())
+                    {
+                        m_slots.push_back(m_targets[target].desc);
+                        busyUntil.push_back(UNUSED);
+                    }
+                    busyUntil[slot] = last[target];
+                    m_slotOfTarget[target] = static_cast<int>(slot);
+                }
+            }
+        }
+
+        std::vector<Target> m_targets;          ///< Declared targets.
+        std::vector<Pass> m_passes;             ///< Declared passes.
+        std::vector<bool> m_kept;               ///< Whether each pass reaches an imported target.
+        std::vector<int> m_order;               ///< Kept passes, in execution order.
+        std::vector<std::vector<int>> m_chains; ///< Passes each pass executes, empty if fused into another.
+        std::vector<int> m_slotOfTarget;        ///< Slot of each target, -1 if imported or unused.
+        std::vector<TargetDesc> m_slots;        ///< Description of each slot.
+        bool m_fusion = true;                   ///< Whether the point-wise passes are fused.
+        bool m_compiled = false;                ///< Whether the schedule matches the declarations.
+    };
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <utility>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+
+namespace cenpy::graphic::render
+{
+    /**
+     * @brief Primitives a draw command assembles its vertices into.
+     */
+    enum class Primitive
+    {
+        TRIANGLES,
+        TRIANGLE_STRIP,
+        LINES,
+        POINTS
+    };
+
+    /**
+     * @brief Order of the commands of a layer and pass sharing a texture.
+     *
+     * Opaque geometry is drawn front to back so the depth test rejects the hidden fragments,
+     * blended geometry back to front so it composes correctly.
+     */
+    enum class DepthOrder
+    {
+        FRONT_TO_BACK,
+        BACK_TO_FRONT
+    };
+
+    /**
+     * @struct RenderCommand
+     * @brief A recorded draw, submitted once the queue is sorted.
+     */
+    struct RenderCommand
+    {
+        std::uint64_t key = 0;                         ///< Sort key, see RenderQueue::makeKey.
+        int pass = 0;                                  ///< Pass of the pipeline drawing the command.
+        std::uint32_t vertexArray = 0;                 ///< Vertex array holding the vertices.
+        std::uint32_t texture = 0;                     ///< Texture bound to the first unit, 0 for none.
+        std::uint32_t first = 0;                       ///< First vertex, or first index if indexed.
+        std::uint32_t count = 0;                       ///< Number of vertices, or of indices if indexed.
+        Primitive primitive = Primitive::TRIANGLES;    ///< Primitive to draw.
+        bool indexed = false;                          ///< Whether the vertices are read through the 32 bits element array of the vertex array.
+        std::uint32_t instanceCount = 1;               ///< Number of instances drawn.
+        std::uint32_t firstInstance = 0;               ///< First instance, offsetting the per-instance attributes.
+        std::int32_t baseVertex = 0;                   ///< Added to the indices, to draw meshes packed in shared buffers.
+        std::uint32_t drawData = 0;                    ///< Value the shaders read for the draw, e.g. the index of its transform.
+    };
+
+    /**
+     * @class RenderQueue
+     * @brief Records the draws of a frame, then sorts them to minimize the state changes.
+     *
+     * The game logic pushes commands in any order. Each command is given a 64 bits key holding,
+     * from the most significant bits, its layer, its pass, its texture and its depth: sorting the
+     * keys groups the commands by layer first, then by program and by texture, and orders each
+     * group by depth. A pipeline consumes the sorted queue through IPipeline::draw.
+     *
+     * The keys are sorted by a stable least significant digit radix sort, skipping the bytes all
+     * the keys share. The buffers are kept between frames: a queue of steady size allocates no
+     * memory.
+     */
+    class RenderQueue
+    {
+    public:
+        static constexpr std::uint32_t MAX_LAYER = 0xFF;         ///< Layers are stored on 8 bits.
+        static constexpr int MAX_PASS = 0xFF;                    ///< Passes are stored on 8 bits.
+        static constexpr std::uint32_t TEXTURE_MASK = 0xFFFFFF;  ///< Textures are stored on their 24 low bits.
+        static constexpr std::uint32_t DEPTH_MASK = 0xFFFFFF;    ///< Depths are quantized to 24 bits.
+
+        /**
+         * @brief Builds the sort key of a command.
+         *
+         * Textures whose names differ only above 24 bits share their key bits: their commands may
+         * be interleaved, which costs texture switches but stays correct.
+         *
+         * @param layer Layer, drawn in increasing order, up to MAX_LAYER.
+         * @param pass Pass of the pipeline, up to MAX_PASS.
+         * @param texture Texture of the command.
+         * @param depth Depth of the command, clamped to [0, 1].
+         * @param order Order of the depths within a layer, pass and texture.
+         * @return The sort key.
+         * @throws TraceableException if the layer or the pass is out of range.
+         */
+        [[nodiscard]] static std::uint64_t makeKey(std::uint32_t layer, int pass, std::uint32_t texture, float depth,
+                                                   DepthOrder order = DepthOrder::FRONT_TO_BACK)
+        {
+            if (layer > MAX_LAYER || pass < 0 || pass > MAX_PASS)
+            {
+                throw common::exception::TraceableException<std::runtime_error>(std::format("ERROR::RENDER_QUEUE::KEY_OUT_OF_RANGE\nLayer {} and pass {} must fit in 8 bits", layer, pass));
+            }
+            auto quantized = static_cast<std::uint32_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(DEPTH_MASK));
+            if (order == DepthOrder::BACK_TO_FRONT)
+            {
+                quantized = DEPTH_MASK - quantized;
+            }
+            return (std::uint64_t{layer} << 56) | (static_cast<std::uint64_t>(pass) << 48) |
+                   (std::uint64_t{texture & TEXTURE_MASK} << 24) | quantized;
+        }
+
+        /**
+         * @brief Records a command, keyed from its layer, pass, texture and depth.
+         * @param command Command to draw, whose key is replaced.
+         * @param layer Layer of the command.
+         * @param depth Depth of the command, in [0, 1].
+         * @param order Order of the depths within the layer, pass and texture.
+         * @throws TraceableException if the layer or the pass is out of range.
+         */
+        void push(RenderCommand command, std::uint32_t layer, float depth, DepthOrder order = DepthOrder::FRONT_TO_BACK)
+        {
+            command.key = makeKey(layer, command.pass, command.texture, depth, order);
+            m_commands.push_back(command);
+            m_sorted = false;
+        }
+
+        /**
+         * @brief Records a command keeping its key, e.g. built once with makeKey for a static object.
+         * @param command Command to draw.
+         */
+        void push(const RenderCommand &command)
+        {
+            m_commands.push_back(command);
+            m_sorted = false;
+        }
+
+        /**
+         * @brief Sorts the commands by key. Commands of equal keys keep their recording order.
+         */
+        void sort()
+        {
+            if (m_sorted)
+            {
+                return;
+            }
+            m_scratch.resize(m_commands.size());
+            std::uint64_t differing = 0;
+            for (const auto &command : m_commands)
+            {
+                differing |= command.key ^ m_commands.front().key;
+            }
+            for (int shift = 0; shift < 64; shift += 8)
+            {
+                if (((differing >> shift) & 0xFF) == 0)
+                {
+                    continue;
+                }
+                std::array<std::size_t, 256> offsets{};
+                for (const auto &command : m_commands)
+                {
+                    ++offsets[(command.key >> shift) & 0xFF];
+                }
+                std::size_t offset = 0;
+                for (auto &bucket : offsets)
+                {
+                    offset += std::exchange(bucket, offset);
+                }
+                for (const auto &command : m_commands)
+                {
+                    m_scratch[offsets[(command.key >> shift) & 0xFF]++] = command;
+                }
+                m_commands.swap(m_scratch);
+            }
+            m_sorted = true;
+        }
+
+        /**
+         * @brief Drops the commands, keeping the memory for the next frame.
+         */
+        void clear()
+        {
+            m_commands.clear();
+            m_sorted = true;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return m_commands.size();
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return m_commands.empty();
+        }
+
+        /**
+         * @brief Get the commands, in key order once sorted.
+         * @return The recorded commands.
+         */
+        [[nodiscard]] const std::vector<RenderCommand> &getCommands() const
+        {
+            return m_commands;
+        }
+
+        [[nodiscard]] bool isSorted() const
+        {
+            return m_sorted;
+        }
+
+    private:
+        std::vector<RenderCommand> m_commands; ///< Recorded commands.
+        std::vector<RenderCommand> m_scratch;  ///< Destination of the radix passes, swapped with the commands.
+        bool m_sorted = true;                  ///< Whether the commands are in key order.
+    };
+}
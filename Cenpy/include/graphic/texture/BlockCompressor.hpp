@@ -0,0 +1,259 @@
+// file: BlockCompressor.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include <graphic/texture/Ktx2.hpp>
+
+namespace cenpy::graphic::texture
+{
+    /**
+     * @class BlockCompressor
+     * @brief Compresses RGBA images into BC1 or BC3 blocks, with their mip chain.
+     *
+     * Meant for offline conversion: the endpoints of a block are the corners of the bounding box
+     * of its colors, and each texel takes the nearest color of the palette they span. Opaque
+     * images are compressed to BC1, 8 bytes a block; images with alpha to BC3, which adds an 8
+     * bytes alpha block. The levels are box filtered down to 1x1 before being compressed, texels
+     * past the edge of a level repeating the edge.
+     */
+    class BlockCompressor
+    {
+    public:
+        /**
+         * @brief Compresses an image and its mip chain.
+         * @param rgba Pixels, 4 bytes each, row by row.
+         * @param width Width of the image.
+         * @param height Height of the image.
+         * @return The image in BC3 when a pixel is not opaque, BC1 otherwise.
+         */
+        [[nodiscard]] static CompressedImage compress(const std::vector<std::uint8_t> &rgba, int width, int height)
+        {
+            const bool alpha = hasAlpha(rgba);
+            CompressedImage image{alpha ? vk_format::BC3_UNORM : vk_format::BC1_RGB_UNORM, width, height, {}};
+            std::vector<std::uint8_t> level = rgba;
+            for (;;)
+            {
+                image.levels.push_back({width, height, compressLevel(level, width, height, alpha)});
+                if (width == 1 && height == 1)
+                {
+                    return image;
+                }
+                level = downsample(level, width, height);
+                width = std::max(1, width / 2);
+                height = std::max(1, height / 2);
+            }
+        }
+
+        /**
+         * @brief Compresses one level.
+         * @param rgba Pixels, 4 bytes each, row by row.
+         * @param width Width of the level.
+         * @param height Height of the level.
+         * @param alpha Whether to compress to BC3 instead of BC1.
+         * @return The blocks, row by row.
+         */
+        [[nodiscard]] static std::vector<std::uint8_t> compressLevel(const std::vector<std::uint8_t> &rgba, int width, int height, bool alpha)
+        {
+            std::vector<std::uint8_t> blocks;
+            blocks.reserve(vk_format::levelBytes(alpha ? vk_format::BC3_UNORM : vk_format::BC1_RGB_UNORM, width, height));
+            std::array<std::uint8_t, 64> block{};
+            for (int blockY = 0; blockY < height; blockY += 4)
+            {
+                for (int blockX = 0; blockX < width; blockX += 4)
+                {
+                    for (int texel = 0; texel < 16; ++texel)
+                    {
+                        const int x = std::min(blockX + texel % 4, width - 1);
+                        const int y = std::min(blockY + texel / 4, height - 1);
+                        std::copy_n(rgba.begin() + (static_cast<std::ptrdiff_t>(y) * width + x) * 4, 4, block.begin() + texel * 4);
+                    }
+                    if (alpha)
+                    {
+                        encodeAlphaBlock(block, blocks);
+                    }
+                    encodeColorBlock(block, blocks);
+                }
+            }
+            return blocks;
+        }
+
+        /**
+         * @brief Halves an image with a box filter.
+         * @param rgba Pixels, 4 bytes each, row by row.
+         * @param width Width of the image.
+         * @param height Height of the image.
+         * @return The pixels of the next level, at least 1x1.
+         */
+        [[nodiscard]] static std::vector<std::uint8_t> downsample(const std::vector<std::uint8_t> &rgba, int width, int height)
+        {
+            const int halfWidth = std::max(1, width / 2);
+            const int halfHeight = std::max(1, height / 2);
+            std::vector<std::uint8_t> half(static_cast<std::size_t>(halfWidth) * halfHeight * 4);
+            for (int y = 0; y < halfHeight; ++y)
+            {
+                const int top = std::min(y * 2, height - 1);
+                const int bottom = std::min(y * 2 + 1, height - 1);
+                for (int x = 0; x < halfWidth; ++x)
+                {
+                    const int left = std::min(x * 2, width - 1);
+                    const int right = std::min(x * 2 + 1, width - 1);
+                    for (int channel = 0; channel < 4; ++channel)
+                    {
+                        const auto texel = [&](int column, int row)
+                        { return rgba[(static_cast<std::size_t>(row) * width + column) * 4 + channel]; };
+                        const int sum = texel(left, top) + texel(right, top) + texel(left, bottom) + texel(right, bottom);
+                        half[(static_cast<std::size_t>(y) * halfWidth + x) * 4 + channel] = static_cast<std::uint8_t>((sum + 2) / 4);
+                    }
+                }
+            }
+            return half;
+        }
+
+        [[nodiscard]] static bool hasAlpha(const std::vector<std::uint8_t> &rgba)
+        {
+            for (std::size_t alpha = 3; alpha < rgba.size(); alpha += 4)
+            {
+                if (rgba[alpha] != 255)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        /**
+         * @brief Appends the BC1 color block of 16 texels, in its opaque four colors mode.
+         * @param block Texels, 4 bytes each, row by row.
+         * @param out Blocks being written.
+         */
+        static void encodeColorBlock(const std::array<std::uint8_t, 64> &block, std::vector<std::uint8_t> &out)
+        {
+            std::array<int, 3> low{255, 255, 255};
+            std::array<int, 3> high{0, 0, 0};
+            for (int texel = 0; texel < 16; ++texel)
+            {
+                for (int channel = 0; channel < 3; ++channel)
+                {
+                    low[channel] = std::min<int>(low[channel], block[texel * 4 + channel]);
+                    high[channel] = std::max<int>(high[channel], block[texel * 4 + channel]);
+                }
+            }
+            std::uint16_t color0 = to565(high);
+            std::uint16_t color1 = to565(low);
+            if (color0 < color1)
+            {
+                std::swap(color0, color1);
+            }
+
+            std::uint32_t indices = 0;
+            if (color0 != color1)
+            {
+                // color0 > color1 selects the four colors mode, without transparency.
+                const std::array<int, 3> first = from565(color0);
+                const std::array<int, 3> second = from565(color1);
+                std::array<std::array<int, 3>, 4> palette{first, second, {}, {}};
+                for (int channel = 0; channel < 3; ++channel)
+                {
+                    palette[2][channel] = (2 * first[channel] + second[channel]) / 3;
+                    palette[3][channel] = (first[channel] + 2 * second[channel]) / 3;
+                }
+                for (int texel = 0; texel < 16; ++texel)
+                {
+                    int bestDistance = std::numeric_limits<int>::max();
+                    std::uint32_t best = 0;
+                    for (std::uint32_t entry = 0; entry < 4; ++entry)
+                    {
+                        int distance = 0;
+                        for (int channel = 0; channel < 3; ++channel)
+                        {
+                            const int delta = block[texel * 4 + channel] - palette[entry][channel];
+                            distance += delta * delta;
+                        }
+                        if (distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            best = entry;
+                        }
+                    }
+                    indices |= best << (texel * 2);
+                }
+            }
+            append(out, color0, 2);
+            append(out, color1, 2);
+            append(out, indices, 4);
+        }
+
+        /**
+         * @brief Appends the BC3 alpha block of 16 texels, in its eight alphas mode.
+         * @param block Texels, 4 bytes each, row by row.
+         * @param out Blocks being written.
+         */
+        static void encodeAlphaBlock(const std::array<std::uint8_t, 64> &block, std::vector<std::uint8_t> &out)
+        {
+            int alpha0 = 0;
+            int alpha1 = 255;
+            for (int texel = 0; texel < 16; ++texel)
+            {
+                alpha0 = std::max<int>(alpha0, block[texel * 4 + 3]);
+                alpha1 = std::min<int>(alpha1, block[texel * 4 + 3]);
+            }
+
+            std::uint64_t indices = 0;
+            if (alpha0 != alpha1)
+            {
+                // alpha0 > alpha1 selects the eight alphas mode: both ends and six between.
+                std::array<int, 8> palette{alpha0, alpha1};
+                for (int step = 1; step < 7; ++step)
+                {
+                    palette[step + 1] = ((7 - step) * alpha0 + step * alpha1) / 7;
+                }
+                for (int texel = 0; texel < 16; ++texel)
+                {
+                    const int value = block[texel * 4 + 3];
+                    std::uint64_t best = 0;
+                    for (std::uint64_t entry = 1; entry < 8; ++entry)
+                    {
+                        if (std::abs(value - palette[entry]) < std::abs(value - palette[best]))
+                        {
+                            best = entry;
+                        }
+                    }
+                    indices |= best << (texel * 3);
+                }
+            }
+            out.push_back(static_cast<std::uint8_t>(alpha0));
+            out.push_back(static_cast<std::uint8_t>(alpha1));
+            append(out, indices, 6);
+        }
+
+        [[nodiscard]] static std::uint16_t to565(const std::array<int, 3> &color)
+        {
+            return static_cast<std::uint16_t>((color[0] * 31 + 127) / 255 << 11 | (color[1] * 63 + 127) / 255 << 5 | (color[2] * 31 + 127) / 255);
+        }
+
+        [[nodiscard]] static std::array<int, 3> from565(std::uint16_t color)
+        {
+            const int red = color >> 11 & 31;
+            const int green = color >> 5 & 63;
+            const int blue = color & 31;
+            return {red << 3 | red >> 2, green << 2 | green >> 4, blue << 3 | blue >> 2};
+        }
+
+        // Blocks are little endian.
+        static void append(std::vector<std::uint8_t> &out, std::uint64_t value, int bytes)
+        {
+            for (int byte = 0; byte < bytes; ++byte)
+            {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * byte)));
+            }
+        }
+    };
+}
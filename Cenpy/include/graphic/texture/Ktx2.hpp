@@ -0,0 +1,389 @@
+// file: Ktx2.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <common/exception/TraceableException.hpp>
+
+namespace cenpy::graphic::texture
+{
+    /**
+     * @brief Vulkan formats of the block compressed textures read and written as KTX2.
+     *
+     * KTX2 identifies the format of its texels by their VkFormat, whatever the API drawing them.
+     */
+    namespace vk_format
+    {
+        constexpr std::uint32_t BC1_RGB_UNORM = 131;
+        constexpr std::uint32_t BC1_RGB_SRGB = 132;
+        constexpr std::uint32_t BC1_RGBA_UNORM = 133;
+        constexpr std::uint32_t BC1_RGBA_SRGB = 134;
+        constexpr std::uint32_t BC3_UNORM = 137;
+        constexpr std::uint32_t BC3_SRGB = 138;
+        constexpr std::uint32_t BC7_UNORM = 145;
+        constexpr std::uint32_t BC7_SRGB = 146;
+        constexpr std::uint32_t ETC2_RGB8_UNORM = 147;
+        constexpr std::uint32_t ETC2_RGB8_SRGB = 148;
+        constexpr std::uint32_t ETC2_RGBA8_UNORM = 151;
+        constexpr std::uint32_t ETC2_RGBA8_SRGB = 152;
+
+        /**
+         * @brief Get the bytes of a 4x4 block of a format.
+         * @param format VkFormat of the texels.
+         * @return Bytes per block, 0 for a format that is not block compressed.
+         */
+        [[nodiscard]] constexpr std::size_t blockBytes(std::uint32_t format)
+        {
+            switch (format)
+            {
+            case BC1_RGB_UNORM:
+            case BC1_RGB_SRGB:
+            case BC1_RGBA_UNORM:
+            case BC1_RGBA_SRGB:
+            case ETC2_RGB8_UNORM:
+            case ETC2_RGB8_SRGB:
+                return 8;
+            case BC3_UNORM:
+            case BC3_SRGB:
+            case BC7_UNORM:
+            case BC7_SRGB:
+            case ETC2_RGBA8_UNORM:
+            case ETC2_RGBA8_SRGB:
+                return 16;
+            default:
+                return 0;
+            }
+        }
+
+        /**
+         * @brief Get the bytes of a mip level of a format.
+         * @param format VkFormat of the texels.
+         * @param width Width of the level.
+         * @param height Height of the level.
+         * @return Bytes of the blocks covering the level.
+         */
+        [[nodiscard]] constexpr std::size_t levelBytes(std::uint32_t format, int width, int height)
+        {
+            return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+        }
+    }
+
+    /**
+     * @struct CompressedLevel
+     * @brief Blocks of one mip level.
+     */
+    struct CompressedLevel
+    {
+        int width = 0;                  ///< Width of the level, in texels.
+        int height = 0;                 ///< Height of the level, in texels.
+        std::vector<std::uint8_t> data; ///< Blocks, row by row.
+    };
+
+    /**
+     * @struct CompressedImage
+     * @brief Block compressed 2D texture with its mip chain.
+     */
+    struct CompressedImage
+    {
+        std::uint32_t format = 0;            ///< VkFormat of the blocks.
+        int width = 0;                       ///< Width of the base level.
+        int height = 0;                      ///< Height of the base level.
+        std::vector<CompressedLevel> levels; ///< Mip chain, base level first.
+        bool bottomUp = false;               ///< Whether the rows of blocks are stored bottom first, as OpenGL expects them.
+    };
+
+    /**
+     * @class Ktx2
+     * @brief Reads and writes block compressed 2D textures in the KTX2 container.
+     *
+     * Only what the engine ships is supported: one layer, one face, no supercompression, and one
+     * of the formats of vk_format. The data format descriptor is written as the basic descriptor
+     * of the format but ignored when reading, the VkFormat being enough to upload the levels. Of
+     * the key/value data, only KTXorientation is written and read, KTX2 storing the top row first
+     * unless it says otherwise.
+     */
+    class Ktx2
+    {
+    public:
+        static constexpr std::array<std::uint8_t, 12> IDENTIFIER{0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+        /**
+         * @brief Reads a texture from the content of a KTX2 file.
+         * @param bytes Content of the file.
+         * @param name Name of the file, for the errors.
+         * @return The texture, levels copied out of the content.
+         * @throws TraceableException if the content is not a supported KTX2 texture.
+         */
+        [[nodiscard]] static CompressedImage read(std::string_view bytes, const std::string &name)
+        {
+            if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), IDENTIFIER.data(), IDENTIFIER.size()) != 0)
+            {
+                throw invalid(name, "not a KTX2 file");
+            }
+            CompressedImage image;
+            image.format = read32(bytes, 12);
+            image.width = static_cast<int>(read32(bytes, 20));
+            image.height = static_cast<int>(read32(bytes, 24));
+            const std::uint32_t depth = read32(bytes, 28);
+            const std::uint32_t layers = read32(bytes, 32);
+            const std::uint32_t faces = read32(bytes, 36);
+            const std::uint32_t levels = std::max<std::uint32_t>(read32(bytes, 40), 1);
+            const std::uint32_t supercompression = read32(bytes, 44);
+            if (vk_format::blockBytes(image.format) == 0)
+            {
+                throw invalid(name, std::format("unsupported format {}", image.format));
+            }
+            if (image.width <= 0 || image.height <= 0 || depth > 1 || layers > 1 || faces != 1)
+            {
+                throw invalid(name, "not a 2D texture");
+            }
+            if (supercompression != 0)
+            {
+                throw invalid(name, std::format("unsupported supercompression {}", supercompression));
+            }
+            if (levels > 32 || bytes.size() < HEADER_SIZE + levels * LEVEL_INDEX_SIZE)
+            {
+                throw invalid(name, "truncated level index");
+            }
+            for (std::uint32_t level = 0; level < levels; ++level)
+            {
+                const std::uint64_t offset = read64(bytes, HEADER_SIZE + level * LEVEL_INDEX_SIZE);
+                const std::uint64_t length = read64(bytes, HEADER_SIZE + level * LEVEL_INDEX_SIZE + 8);
+                CompressedLevel mip{std::max(1, image.width >> level), std::max(1, image.height >> level), {}};
+                if (length != vk_format::levelBytes(image.format, mip.width, mip.height) || offset > bytes.size() || length > bytes.size() - offset)
+                {
+                    throw invalid(name, std::format("invalid level {}", level));
+                }
+                const auto *first = reinterpret_cast<const std::uint8_t *>(bytes.data() + offset);
+                mip.data.assign(first, first + length);
+                image.levels.push_back(std::move(mip));
+            }
+            image.bottomUp = orientation(bytes, name).starts_with("ru");
+            return image;
+        }
+
+        /**
+         * @brief Writes a texture as the content of a KTX2 file.
+         *
+         * The levels are stored smallest first, each aligned on its blocks, as the format asks.
+         *
+         * @param image Texture to write. Its levels must be sized for its format.
+         * @return The content of the file.
+         */
+        [[nodiscard]] static std::vector<std::uint8_t> write(const CompressedImage &image)
+        {
+            const std::vector<std::uint8_t> descriptor = dataFormatDescriptor(image.format);
+            const std::vector<std::uint8_t> keyValues = keyValue(ORIENTATION_KEY, image.bottomUp ? "ru" : "rd");
+            const auto levels = static_cast<std::uint32_t>(image.levels.size());
+            const std::size_t descriptorOffset = HEADER_SIZE + levels * LEVEL_INDEX_SIZE;
+
+            std::vector<std::uint8_t> bytes(descriptorOffset);
+            std::copy(IDENTIFIER.begin(), IDENTIFIER.end(), bytes.begin());
+            write32(bytes, 12, image.format);
+            write32(bytes, 16, 1);
+            write32(bytes, 20, static_cast<std::uint32_t>(image.width));
+            write32(bytes, 24, static_cast<std::uint32_t>(image.height));
+            write32(bytes, 36, 1);
+            write32(bytes, 40, levels);
+            write32(bytes, 48, static_cast<std::uint32_t>(descriptorOffset));
+            write32(bytes, 52, static_cast<std::uint32_t>(descriptor.size()));
+            bytes.insert(bytes.end(), descriptor.begin(), descriptor.end());
+            write32(bytes, 56, static_cast<std::uint32_t>(bytes.size()));
+            write32(bytes, 60, static_cast<std::uint32_t>(keyValues.size()));
+            bytes.insert(bytes.end(), keyValues.begin(), keyValues.end());
+
+            const std::size_t alignment = std::lcm<std::size_t>(vk_format::blockBytes(image.format), 4);
+            for (std::uint32_t level = levels; level-- > 0;)
+            {
+                bytes.resize((bytes.size() + alignment - 1) / alignment * alignment);
+                const std::vector<std::uint8_t> &data = image.levels[level].data;
+                write64(bytes, HEADER_SIZE + level * LEVEL_INDEX_SIZE, bytes.size());
+                write64(bytes, HEADER_SIZE + level * LEVEL_INDEX_SIZE + 8, data.size());
+                write64(bytes, HEADER_SIZE + level * LEVEL_INDEX_SIZE + 16, data.size());
+                bytes.insert(bytes.end(), data.begin(), data.end());
+            }
+            return bytes;
+        }
+
+    private:
+        static constexpr std::size_t HEADER_SIZE = 80;      ///< Identifier, header and index, up to the level index.
+        static constexpr std::size_t LEVEL_INDEX_SIZE = 24; ///< Offset, length and uncompressed length of a level.
+        static constexpr std::string_view ORIENTATION_KEY = "KTXorientation";
+
+        /**
+         * @brief Builds a key/value entry, its length first and padded to 4 bytes.
+         * @param key Key of the entry.
+         * @param value Value of the entry, written NUL terminated.
+         * @return The entry.
+         */
+        static std::vector<std::uint8_t> keyValue(std::string_view key, std::string_view value)
+        {
+            const std::size_t length = key.size() + 1 + value.size() + 1;
+            std::vector<std::uint8_t> entry(4 + (length + 3) / 4 * 4);
+            write32(entry, 0, static_cast<std::uint32_t>(length));
+            std::copy(key.begin(), key.end(), entry.begin() + 4);
+            std::copy(value.begin(), value.end(), entry.begin() + 4 + key.size() + 1);
+            return entry;
+        }
+
+        /**
+         * @brief Finds the KTXorientation value in the key/value data.
+         * @param bytes Content of the file.
+         * @param name Name of the file, for the errors.
+         * @return The value without its NUL, "rd" if the file has none.
+         * @throws TraceableException if the key/value data is out of the file.
+         */
+        static std::string_view orientation(std::string_view bytes, const std::string &name)
+        {
+            const std::uint32_t offset = read32(bytes, 56);
+            const std::uint32_t length = read32(bytes, 60);
+            if (offset > bytes.size() || length > bytes.size() - offset)
+            {
+                throw invalid(name, "truncated key/value data");
+            }
+            std::string_view data = bytes.substr(offset, length);
+            while (data.size() >= 4)
+            {
+                const std::uint32_t size = read32(data, 0);
+                if (size > data.size() - 4)
+                {
+                    throw invalid(name, "truncated key/value data");
+                }
+                const std::string_view entry = data.substr(4, size);
+                if (const std::size_t end = entry.find('\0'); end != std::string_view::npos && entry.substr(0, end) == ORIENTATION_KEY)
+                {
+                    const std::string_view value = entry.substr(end + 1);
+                    return value.substr(0, value.find('\0'));
+                }
+                data.remove_prefix(std::min<std::size_t>(data.size(), 4 + (size + 3) / 4 * 4));
+            }
+            return "rd";
+        }
+
+        /**
+         * @brief Builds the basic data format descriptor of a format.
+         * @param format VkFormat of the blocks.
+         * @return The descriptor, its total size first.
+         */
+        static std::vector<std::uint8_t> dataFormatDescriptor(std::uint32_t format)
+        {
+            constexpr std::uint32_t TRANSFER_LINEAR = 1;
+            constexpr std::uint32_t TRANSFER_SRGB = 2;
+            constexpr std::uint32_t CHANNEL_COLOR = 0;
+            constexpr std::uint32_t CHANNEL_ALPHA = 15;
+
+            std::uint32_t model = 0;
+            std::vector<std::array<std::uint32_t, 2>> samples; // Channel and bit offset.
+            switch (format)
+            {
+            case vk_format::BC1_RGB_UNORM:
+            case vk_format::BC1_RGB_SRGB:
+            case vk_format::BC1_RGBA_UNORM:
+            case vk_format::BC1_RGBA_SRGB:
+                model = 128;
+                samples = {{CHANNEL_COLOR, 0}};
+                break;
+            case vk_format::BC3_UNORM:
+            case vk_format::BC3_SRGB:
+                model = 130;
+                samples = {{CHANNEL_ALPHA, 0}, {CHANNEL_COLOR, 64}};
+                break;
+            case vk_format::BC7_UNORM:
+            case vk_format::BC7_SRGB:
+                model = 134;
+                samples = {{CHANNEL_COLOR, 0}};
+                break;
+            case vk_format::ETC2_RGB8_UNORM:
+            case vk_format::ETC2_RGB8_SRGB:
+                model = 161;
+                samples = {{CHANNEL_COLOR, 0}};
+                break;
+            default:
+                model = 161;
+                samples = {{CHANNEL_ALPHA, 0}, {CHANNEL_COLOR, 64}};
+                break;
+            }
+            const bool srgb = isSrgb(format);
+            // The samples split the block evenly: 128 bits for BC7, 64 for each of BC3. Stored minus one.
+            const auto sampleBits = static_cast<std::uint32_t>(vk_format::blockBytes(format) * 8 / samples.size() - 1);
+            const auto blockSize = static_cast<std::uint32_t>(24 + 16 * samples.size());
+
+            std::vector<std::uint8_t> descriptor(4 + blockSize);
+            write32(descriptor, 0, static_cast<std::uint32_t>(descriptor.size()));
+            write32(descriptor, 4, 0);                   // Khronos basic descriptor.
+            write32(descriptor, 8, 2 | blockSize << 16); // Version 1.3.
+            write32(descriptor, 12, model | 1 << 8 | (srgb ? TRANSFER_SRGB : TRANSFER_LINEAR) << 16);
+            write32(descriptor, 16, 3 | 3 << 8);         // 4x4 blocks.
+            write32(descriptor, 20, static_cast<std::uint32_t>(vk_format::blockBytes(format)));
+            for (std::size_t sample = 0; sample < samples.size(); ++sample)
+            {
+                const std::size_t at = 28 + 16 * sample;
+                write32(descriptor, at, samples[sample][1] | sampleBits << 16 | samples[sample][0] << 24);
+                write32(descriptor, at + 8, 0);
+                write32(descriptor, at + 12, 0xFFFFFFFF);
+            }
+            return descriptor;
+        }
+
+        [[nodiscard]] static constexpr bool isSrgb(std::uint32_t format)
+        {
+            switch (format)
+            {
+            case vk_format::BC1_RGB_SRGB:
+            case vk_format::BC1_RGBA_SRGB:
+            case vk_format::BC3_SRGB:
+            case vk_format::BC7_SRGB:
+            case vk_format::ETC2_RGB8_SRGB:
+            case vk_format::ETC2_RGBA8_SRGB:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        static common::exception::TraceableException<std::runtime_error> invalid(const std::string &name, const std::string &reason)
+        {
+            return common::exception::TraceableException<std::runtime_error>(std::format("ERROR::TEXTURE::INVALID_KTX2\n{}: {}", name, reason));
+        }
+
+        // KTX2 is little endian.
+        static std::uint32_t read32(std::string_view bytes, std::size_t at)
+        {
+            std::uint32_t value = 0;
+            for (std::size_t byte = 4; byte-- > 0;)
+            {
+                value = value << 8 | static_cast<std::uint8_t>(bytes[at + byte]);
+            }
+            return value;
+        }
+
+        static std::uint64_t read64(std::string_view bytes, std::size_t at)
+        {
+            return read32(bytes, at) | static_cast<std::uint64_t>(read32(bytes, at + 4)) << 32;
+        }
+
+        static void write32(std::vector<std::uint8_t> &bytes, std::size_t at, std::uint32_t value)
+        {
+            for (std::size_t byte = 0; byte < 4; ++byte)
+            {
+                bytes[at + byte] = static_cast<std::uint8_t>(value >> (8 * byte));
+            }
+        }
+
+        static void write64(std::vector<std::uint8_t> &bytes, std::size_t at, std::uint64_t value)
+        {
+            write32(bytes, at, static_cast<std::uint32_t>(value));
+            write32(bytes, at + 4, static_cast<std::uint32_t>(value >> 32));
+        }
+    };
+}
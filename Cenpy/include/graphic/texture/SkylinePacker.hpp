@@ -0,0 +1,190 @@
+// file: SkylinePacker.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace cenpy::graphic::texture
+{
+    /**
+     * @struct PackedRect
+     * @brief Area reserved in a packed page, in texels from its top left corner.
+     */
+    struct PackedRect
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    /**
+     * @class SkylinePacker
+     * @brief Packs rectangles into a page, bottom-left first, tracking the skyline of the packed ones.
+     *
+     * The skyline is the top edge of the packed rectangles, stored as horizontal segments. A
+     * rectangle is placed on the segment where it rests lowest, the narrowest such place winning
+     * ties. Packing is online: a rectangle never moves once placed, so the rectangles can be
+     * added while the page is in use. The area under the skyline that no rectangle covers is lost
+     * until the page is reset.
+     */
+    class SkylinePacker
+    {
+    public:
+        /**
+         * @brief Creates an empty page.
+         * @param width Width of the page.
+         * @param height Height of the page.
+         */
+        SkylinePacker(int width, int height) : m_width(width), m_height(height)
+        {
+            reset();
+        }
+
+        /**
+         * @brief Places a rectangle.
+         * @param width Width of the rectangle.
+         * @param height Height of the rectangle.
+         * @return The reserved area, nothing if the rectangle does not fit.
+         */
+        std::optional<PackedRect> insert(int width, int height)
+        {
+            if (width <= 0 || height <= 0)
+            {
+                return std::nullopt;
+            }
+            std::size_t best = m_skyline.size();
+            int bestY = std::numeric_limits<int>::max();
+            int bestWidth = std::numeric_limits<int>::max();
+            for (std::size_t index = 0; index < m_skyline.size(); ++index)
+            {
+                std::optional<int> y = fit(index, width, height);
+                if (y && (*y < bestY || (*y == bestY && m_skyline[index].width < bestWidth)))
+                {
+                    best = index;
+                    bestY = *y;
+                    bestWidth = m_skyline[index].width;
+                }
+            }
+            if (best == m_skyline.size())
+            {
+                return std::nullopt;
+            }
+
+            PackedRect rect{m_skyline[best].x, bestY, width, height};
+            raise(best, rect);
+            m_usedArea += static_cast<std::int64_t>(width) * height;
+            return rect;
+        }
+
+        /**
+         * @brief Empties the page.
+         */
+        void reset()
+        {
+            m_skyline.assign(1, Segment{0, 0, m_width});
+            m_usedArea = 0;
+        }
+
+        [[nodiscard]] int getWidth() const
+        {
+            return m_width;
+        }
+
+        [[nodiscard]] int getHeight() const
+        {
+            return m_height;
+        }
+
+        /**
+         * @brief Get the ratio of the page covered by rectangles.
+         * @return Occupancy, in [0, 1].
+         */
+        [[nodiscard]] float getOccupancy() const
+        {
+            return static_cast<float>(m_usedArea) / (static_cast<float>(m_width) * static_cast<float>(m_height));
+        }
+
+    private:
+        struct Segment
+        {
+            int x;     ///< Left of the segment.
+            int y;     ///< Height of the skyline over the segment.
+            int width; ///< Width of the segment.
+        };
+
+        /**
+         * @brief Finds where a rectangle starting at a segment would rest.
+         * @param index Segment the left of the rectangle is on.
+         * @param width Width of the rectangle.
+         * @param height Height of the rectangle.
+         * @return Top of the rectangle, nothing if it leaves the page.
+         */
+        [[nodiscard]] std::optional<int> fit(std::size_t index, int width, int height) const
+        {
+            if (m_skyline[index].x + width > m_width)
+            {
+                return std::nullopt;
+            }
+            int y = 0;
+            for (int left = width; left > 0; ++index)
+            {
+                y = std::max(y, m_skyline[index].y);
+                if (y + height > m_height)
+                {
+                    return std::nullopt;
+                }
+                left -= m_skyline[index].width;
+            }
+            return y;
+        }
+
+        /**
+         * @brief Raises the skyline over a placed rectangle.
+         * @param index Segment the left of the rectangle is on.
+         * @param rect The placed rectangle.
+         */
+        void raise(std::size_t index, const PackedRect &rect)
+        {
+            m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(index), Segment{rect.x, rect.y + rect.height, rect.width});
+            const int right = rect.x + rect.width;
+            for (std::size_t next = index + 1; next < m_skyline.size();)
+            {
+                Segment &segment = m_skyline[next];
+                if (segment.x >= right)
+                {
+                    break;
+                }
+                const int shrink = right - segment.x;
+                if (segment.width <= shrink)
+                {
+                    m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(next));
+                    continue;
+                }
+                segment.x += shrink;
+                segment.width -= shrink;
+                break;
+            }
+            for (std::size_t next = 1; next < m_skyline.size();)
+            {
+                if (m_skyline[next - 1].y == m_skyline[next].y)
+                {
+                    m_skyline[next - 1].width += m_skyline[next].width;
+                    m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(next));
+                    continue;
+                }
+                ++next;
+            }
+        }
+
+        int m_width;                    ///< Width of the page.
+        int m_height;                   ///< Height of the page.
+        std::vector<Segment> m_skyline; ///< Segments of the skyline, left to right, covering the width.
+        std::int64_t m_usedArea = 0;    ///< Area of the placed rectangles.
+    };
+}
@@ -1,44 +1,31 @@
 #pragma once
 
 #include <GL/glew.h>
-#include <GLFW/glfw3.h>
-#include <iostream>
-#include <vector>
-#include <fstream>
-#include <sstream>
-#include <cmath>
+#include <string>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+#include <graphic/opengl/pipeline/texture/TextureResidency.hpp>
 
 class Texture
 {
 public:
-    Texture(const char *imagePath)
+    // The image is loaded by the residency on first use, and again after being evicted; the
+    // placeholder of the loader is bound until it is ready.
+    Texture(cenpy::graphic::opengl::pipeline::texture::OpenGLTextureResidency &residency, const std::string &imagePath)
+        : residency(residency), path(imagePath)
     {
-        glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-
-        int width, height, nrChannels;
-        stbi_set_flip_vertically_on_load(true);
-        unsigned char *data = stbi_load(imagePath, &width, &height, &nrChannels, 0);
-
-        if (data)
-        {
-            GLenum format = (nrChannels == 3) ? GL_RGB : GL_RGBA;
-            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(GL_TEXTURE_2D);
-        }
-        else
-        {
-            std::cerr << "Failed to load texture\n";
-        }
-
-        stbi_image_free(data);
     }
 
     void use() const
     {
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().bindTexture(0, GL_TEXTURE_2D, residency.use(path));
+    }
+
+    bool isReady() const
+    {
+        return residency.isResident(path);
     }
 
 private:
-    GLuint textureID;
-};
\ No newline at end of file
+    cenpy::graphic::opengl::pipeline::texture::OpenGLTextureResidency &residency;
+    std::string path;
+};
@@ -2,17 +2,45 @@
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <memory>
+#include <vector>
+#include <graphic/Api.hpp>
+
+namespace cenpy::common::io
+{
+    class FileWatcher;
+}
+
+namespace cenpy::graphic::pipeline
+{
+    template <typename API>
+    class IPipeline;
+}
 
 namespace cenpy::manager
 {
     class GameManager
     {
     public:
+        GameManager();
+        ~GameManager();
+
         void startMainLoop();
 
+        /**
+         * @brief Registers a pipeline whose shaders are reloaded between frames when their files change.
+         *
+         * Read the shaders of the pipeline first for the files they include to be watched too.
+         *
+         * @param pipeline Pipeline to reload.
+         */
+        void addPipeline(std::shared_ptr<graphic::pipeline::IPipeline<graphic::api::OpenGL>> pipeline);
+
     private:
         GLFWwindow *m_window;
         bool m_isRunning;
+        std::vector<std::shared_ptr<graphic::pipeline::IPipeline<graphic::api::OpenGL>>> m_pipelines;
+        std::unique_ptr<common::io::FileWatcher> m_shaderWatcher; ///< Watches the shader files, nullptr if unavailable.
 
         bool initialize();
 
@@ -20,6 +48,10 @@ namespace cenpy::manager
 
         void render();
 
+        void reloadShaders();
+
+        void watchShaders(const graphic::pipeline::IPipeline<graphic::api::OpenGL> &pipeline);
+
         void cleanup();
     };
 } // namespace cenpy::manager
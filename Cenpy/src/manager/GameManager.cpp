@@ -1,6 +1,13 @@
 
 #include <iostream>
 #include <manager/GameManager.hpp>
+#include <common/io/FileWatcher.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/context/PipelineContext.hpp>
+#include <graphic/pipeline/Pipeline.hpp>
+#include <graphic/opengl/context/ParallelCompile.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
 
 namespace cenpy::manager
 {
@@ -10,6 +17,26 @@ namespace cenpy::manager
         std::cerr << " [" << error << "] " << description << '\n';
     }
 
+    GameManager::GameManager()
+    {
+        try
+        {
+            m_shaderWatcher = std::make_unique<common::io::FileWatcher>();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Shader hot reload disabled: " << e.what() << '\n';
+        }
+    }
+
+    GameManager::~GameManager() = default;
+
+    void GameManager::addPipeline(std::shared_ptr<graphic::pipeline::IPipeline<graphic::api::OpenGL>> pipeline)
+    {
+        watchShaders(*pipeline);
+        m_pipelines.push_back(std::move(pipeline));
+    }
+
     void GameManager::startMainLoop()
     {
 
@@ -32,6 +59,9 @@ namespace cenpy::manager
 
             // Swap buffers
             glfwSwapBuffers(m_window);
+
+            // Apply the shader changes between frames
+            reloadShaders();
         }
 
         // Cleanup and terminate GLFW
@@ -65,6 +95,8 @@ namespace cenpy::manager
 
         // Make the OpenGL context current
         glfwMakeContextCurrent(m_window);
+        // The bindings shadowed for a previous context do not hold for this one
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
 
         // Initialize GLEW
         if (glewInit() != GLEW_OK)
@@ -72,6 +104,8 @@ namespace cenpy::manager
             std::cerr << "Failed to initialize GLEW.\n";
             return false;
         }
+        // Before the first shader compile, for the hint to apply to it
+        cenpy::graphic::opengl::context::enableParallelShaderCompile();
 
         // Additional initialization if needed
 
@@ -88,6 +122,71 @@ namespace cenpy::manager
         // Render game, including ECS rendering
     }
 
+    void GameManager::reloadShaders()
+    {
+        // The passes being rebuilt keep drawing with their current program until the new one is linked.
+        for (const auto &pipeline : m_pipelines)
+        {
+            if (!pipeline->isReloading())
+            {
+                continue;
+            }
+            try
+            {
+                if (pipeline->pollReloads() > 0)
+                {
+                    // The rebuilt shaders may include new files.
+                    watchShaders(*pipeline);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                // The passes that failed keep their program until their files are fixed and written again.
+                std::cerr << "Failed to reload shaders: " << e.what() << '\n';
+            }
+        }
+        if (!m_shaderWatcher)
+        {
+            return;
+        }
+        // Never blocks: an empty list when no watched file has been written since the last frame.
+        std::vector<std::filesystem::path> changed = m_shaderWatcher->poll();
+        if (changed.empty())
+        {
+            return;
+        }
+        for (const auto &pipeline : m_pipelines)
+        {
+            try
+            {
+                pipeline->reload(changed);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Failed to reload shaders: " << e.what() << '\n';
+            }
+        }
+    }
+
+    void GameManager::watchShaders(const graphic::pipeline::IPipeline<graphic::api::OpenGL> &pipeline)
+    {
+        if (!m_shaderWatcher)
+        {
+            return;
+        }
+        for (const auto &file : pipeline.getSourceFiles())
+        {
+            try
+            {
+                m_shaderWatcher->watch(file);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << e.what() << '\n';
+            }
+        }
+    }
+
     void GameManager::cleanup()
     {
         // Cleanup resources and terminate GLFW
@@ -20,6 +20,7 @@ namespace cenpy::mock::graphic
             class MockShaderContext;
             class MockPassContext;
             class MockUniformContext;
+            class MockUniformBlockContext;
             class MockAttributeContext;
             class MockPipelineContext;
         }
@@ -47,6 +48,7 @@ namespace cenpy::mock::graphic
             using ShaderContext = graphic::opengl::context::MockShaderContext;
             using PassContext = graphic::opengl::context::MockPassContext;
             using UniformContext = graphic::opengl::context::MockUniformContext;
+            using UniformBlockContext = graphic::opengl::context::MockUniformBlockContext;
             using AttributeContext = graphic::opengl::context::MockAttributeContext;
             using PipelineContext = graphic::opengl::context::MockPipelineContext;
             using Validator = graphic::opengl::validator::Validator;
@@ -12,6 +12,10 @@
 #include <graphic/opengl/pipeline/component/pass/MockUniformReader.hpp>
 #include <graphic/opengl/pipeline/component/pass/MockAttributeReader.hpp>
 #include <graphic/opengl/pipeline/component/pass/MockUser.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockBinaryLoader.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockLinker.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockPoller.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockWaiter.hpp>
 
 namespace cenpy::mock::graphic::opengl::context
 {
@@ -31,5 +35,13 @@ namespace cenpy::mock::graphic::opengl::context
         using AttributeReader = opengl::pipeline::component::pass::MockAttributeReader<PROFILE>;
         template <auto PROFILE>
         using User = opengl::pipeline::component::pass::MockUser<PROFILE>;
+        template <auto PROFILE>
+        using BinaryLoader = opengl::pipeline::component::pass::MockBinaryLoader<PROFILE>;
+        template <auto PROFILE>
+        using Linker = opengl::pipeline::component::pass::MockLinker<PROFILE>;
+        template <auto PROFILE>
+        using Poller = opengl::pipeline::component::pass::MockPoller<PROFILE>;
+        template <auto PROFILE>
+        using Waiter = opengl::pipeline::component::pass::MockWaiter<PROFILE>;
     };
 }
@@ -4,8 +4,10 @@
 
 #include <graphic/MockApi.hpp>
 #include <graphic/opengl/context/PipelineContext.hpp>
+#include <graphic/opengl/context/MockUniformBlockContext.hpp>
 #include <graphic/opengl/pipeline/component/pipeline/MockUser.hpp>
 #include <graphic/opengl/pipeline/component/pipeline/MockResetter.hpp>
+#include <graphic/opengl/pipeline/component/pipeline/MockDrawer.hpp>
 
 namespace cenpy::mock::graphic::opengl::context
 {
@@ -17,5 +19,7 @@ namespace cenpy::mock::graphic::opengl::context
         using User = opengl::pipeline::component::pipeline::MockUser<PROFILE>;
         template <auto PROFILE>
         using Resetter = opengl::pipeline::component::pipeline::MockResetter<PROFILE>;
+        template <auto PROFILE>
+        using Drawer = opengl::pipeline::component::pipeline::MockDrawer<PROFILE>;
     };
 }
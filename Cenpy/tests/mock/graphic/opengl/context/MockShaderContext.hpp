@@ -8,6 +8,8 @@
 #include <graphic/opengl/pipeline/component/shader/MockLoader.hpp>
 #include <graphic/opengl/pipeline/component/shader/MockFreer.hpp>
 #include <graphic/opengl/pipeline/component/shader/MockReader.hpp>
+#include <graphic/opengl/pipeline/component/shader/MockCompiler.hpp>
+#include <graphic/opengl/pipeline/component/shader/MockPreprocessor.hpp>
 
 namespace cenpy::mock::graphic::opengl::context
 {
@@ -21,6 +23,14 @@ namespace cenpy::mock::graphic::opengl::context
         using Freer = opengl::pipeline::component::shader::MockFreer< PROFILE>;
         template <auto PROFILE>
         using Reader = opengl::pipeline::component::shader::MockReader< PROFILE>;
+        template <auto PROFILE>
+        using Compiler = opengl::pipeline::component::shader::MockCompiler< PROFILE>;
+        template <auto PROFILE>
+        using Preprocessor = opengl::pipeline::component::shader::MockPreprocessor< PROFILE>;
+
+        void inheritSettings(const MockShaderContext &)
+        {
+        }
 
         MOCK_METHOD(void, setShaderID, (GLuint shaderID), ());
         MOCK_METHOD(GLuint, getShaderID, (), (const));
@@ -30,6 +40,6 @@ namespace cenpy::mock::graphic::opengl::context
         MOCK_METHOD(void, setShaderPath, (const std::string &shaderPath), (override));
         MOCK_METHOD(const std::string &, getShaderPath, (), (const, override));
         MOCK_METHOD(void, setShaderCode, (const std::string &shaderCode), (override));
-        MOCK_METHOD(const std::string &, getShaderCode, (), (const, override));
+        MOCK_METHOD(std::string_view, getShaderCode, (), (const, override));
     };
 }
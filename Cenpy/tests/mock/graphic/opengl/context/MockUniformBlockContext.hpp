@@ -0,0 +1,14 @@
+// UniformBlockContext.hpp
+
+#pragma once
+
+#include <graphic/MockApi.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+
+namespace cenpy::mock::graphic::opengl::context
+{
+
+    class MockUniformBlockContext : public cenpy::graphic::context::UniformBlockContext<graphic::api::MockOpenGL>
+    {
+    };
+}
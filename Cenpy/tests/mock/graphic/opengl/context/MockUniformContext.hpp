@@ -16,11 +16,23 @@ namespace cenpy::mock::graphic::opengl::context
         template <typename T>
         using Setter = opengl::pipeline::component::uniform::MockSetter<T>;
 
+        template <typename T>
+        static constexpr ValueType valueTypeOf()
+        {
+            return Setter<T>::glType;
+        }
+
         MOCK_METHOD(void, setUniformID, (GLuint uniformId), ());
         MOCK_METHOD(GLuint, getUniformID, (), (const));
         MOCK_METHOD(void, setGLType, (GLenum type), ());
         MOCK_METHOD(GLenum, getGLType, (), (const));
         MOCK_METHOD(void, setSize, (GLuint size), ());
         MOCK_METHOD(GLuint, getGLSize, (), (const));
+
+    protected:
+        [[nodiscard]] bool isCompatible(ValueType valueType) const override
+        {
+            return valueType != GL_INVALID_ENUM && valueType != GL_NONE;
+        }
     };
 }
@@ -9,6 +9,9 @@
 #include <graphic/opengl/pipeline/component/pass/MockUser.hpp>
 #include <graphic/opengl/pipeline/component/pass/MockFreer.hpp>
 #include <graphic/opengl/pipeline/component/pass/MockLoader.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockLinker.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockPoller.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockWaiter.hpp>
 #include <graphic/pipeline/Pass.hpp>
 
 namespace cenpy::mock::graphic::pipeline::opengl
@@ -25,17 +28,23 @@ namespace cenpy::mock::graphic::pipeline::opengl
 
         MOCK_METHOD(void, use, (), (override));
         MOCK_METHOD(void, load, (), (override));
+        MOCK_METHOD(void, loadAsync, (), (override));
+        MOCK_METHOD(bool, poll, (), (override));
+        MOCK_METHOD(std::shared_ptr<pipeline::IPass<API>>, rebuild, (const std::vector<std::shared_ptr<pipeline::IShader<API>>> &shaders), (const, override));
 
         MOCK_METHOD((const std::unordered_map<std::string, std::shared_ptr<pipeline::Uniform<API>>, collection_utils::StringHash, collection_utils::StringEqual> &), getUniforms, (), (const, override));
         MOCK_METHOD((const std::vector<std::shared_ptr<pipeline::IShader<API>>> &), getShaders, (), (const, override));
 
     protected:
+        MOCK_METHOD(std::shared_ptr<pipeline::IPass<API>>, createPass, (const std::vector<std::shared_ptr<pipeline::IShader<API>>> &shaders), (const, override));
+        MOCK_METHOD(void, link, (std::shared_ptr<typename API::PassContext> context), (override));
+        MOCK_METHOD(void, poll, (std::shared_ptr<typename API::PassContext> context), (override));
+        MOCK_METHOD(void, wait, (std::shared_ptr<typename API::PassContext> context), (override));
+        MOCK_METHOD(void, loadBinary, (std::shared_ptr<typename API::PassContext> context), (override));
         MOCK_METHOD(void, readUniforms, (std::shared_ptr<typename API::PassContext> context), (override));
         MOCK_METHOD(void, readAttributes, (std::shared_ptr<typename API::PassContext> context), (override));
         MOCK_METHOD(void, free, (std::shared_ptr<typename API::PassContext> context), (override));
         MOCK_METHOD(void, use, (std::shared_ptr<typename API::PassContext> context), (override));
         MOCK_METHOD(void, load, (std::shared_ptr<typename API::PassContext> context), (override));
-
-        MOCK_METHOD((std::shared_ptr<pipeline::IPass<API>>), shared, (), (const, override));
     };
 }
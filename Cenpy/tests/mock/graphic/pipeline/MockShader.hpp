@@ -21,12 +21,18 @@ namespace cenpy::mock::graphic::pipeline
 
         MOCK_METHOD(void, free, (), (override));
         MOCK_METHOD(void, load, (), (override));
+        MOCK_METHOD(void, read, (), (override));
+        MOCK_METHOD(void, compile, (), (override));
+        MOCK_METHOD(void, reload, (), (override));
         MOCK_METHOD(const std::shared_ptr<typename API::ShaderContext> &, getContext, (), (const, override));
+        MOCK_METHOD(std::shared_ptr<pipeline::IShader<API>>, createVariant, (std::vector<std::string> defines), (const, override));
 
     protected:
         MOCK_METHOD(void, load, (std::shared_ptr<typename API::ShaderContext>), (override));
+        MOCK_METHOD(void, compile, (std::shared_ptr<typename API::ShaderContext>), (override));
         MOCK_METHOD(void, free, (std::shared_ptr<typename API::ShaderContext>), (override));
         MOCK_METHOD(void, read, (std::shared_ptr<typename API::ShaderContext>), (override));
+        MOCK_METHOD(void, preprocess, (std::shared_ptr<typename API::ShaderContext>), (override));
     };
 
 }
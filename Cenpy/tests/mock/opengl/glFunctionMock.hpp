@@ -31,6 +31,7 @@
 #ifdef __mock_gl__
 
 #include <any>
+#include <algorithm>
 #include <vector>
 #include <GL/glew.h>
 #include <EnumClass.hpp>
@@ -62,6 +63,10 @@
 #define glEnableVertexAttribArray cenpy::mock::opengl::glFunctionMock::instance()->glEnableVertexAttribArray_mock
 #define glGetActiveAttrib cenpy::mock::opengl::glFunctionMock::instance()->glGetActiveAttrib_mock
 #define glGetActiveUniform cenpy::mock::opengl::glFunctionMock::instance()->glGetActiveUniform_mock
+#define glGetActiveUniformsiv cenpy::mock::opengl::glFunctionMock::instance()->glGetActiveUniformsiv_mock
+#define glGetActiveUniformBlockName cenpy::mock::opengl::glFunctionMock::instance()->glGetActiveUniformBlockName_mock
+#define glGetActiveUniformBlockiv cenpy::mock::opengl::glFunctionMock::instance()->glGetActiveUniformBlockiv_mock
+#define glUniformBlockBinding cenpy::mock::opengl::glFunctionMock::instance()->glUniformBlockBinding_mock
 #define glGetAttachedShaders cenpy::mock::opengl::glFunctionMock::instance()->glGetAttachedShaders_mock
 #define glGetAttribLocation cenpy::mock::opengl::glFunctionMock::instance()->glGetAttribLocation_mock
 #define glGetProgramInfoLog cenpy::mock::opengl::glFunctionMock::instance()->glGetProgramInfoLog_mock
@@ -78,8 +83,18 @@
 #define glGetVertexAttribiv cenpy::mock::opengl::glFunctionMock::instance()->glGetVertexAttribiv_mock
 #define glGenBuffers cenpy::mock::opengl::glFunctionMock::instance()->glGenBuffers_mock
 #define glBindBuffer cenpy::mock::opengl::glFunctionMock::instance()->glBindBuffer_mock
+#define glBindVertexArray cenpy::mock::opengl::glFunctionMock::instance()->glBindVertexArray_mock
 #define glBufferData cenpy::mock::opengl::glFunctionMock::instance()->glBufferData_mock
+#define glBufferSubData cenpy::mock::opengl::glFunctionMock::instance()->glBufferSubData_mock
+#define glBindBufferBase cenpy::mock::opengl::glFunctionMock::instance()->glBindBufferBase_mock
+#define glDeleteBuffers cenpy::mock::opengl::glFunctionMock::instance()->glDeleteBuffers_mock
 #define glVertexAttribPointer cenpy::mock::opengl::glFunctionMock::instance()->glVertexAttribPointer_mock
+#define glGetString cenpy::mock::opengl::glFunctionMock::instance()->glGetString_mock
+#define glGetProgramBinary cenpy::mock::opengl::glFunctionMock::instance()->glGetProgramBinary_mock
+#define glProgramBinary cenpy::mock::opengl::glFunctionMock::instance()->glProgramBinary_mock
+#define glProgramParameteri cenpy::mock::opengl::glFunctionMock::instance()->glProgramParameteri_mock
+#define glewIsSupported cenpy::mock::opengl::glFunctionMock::instance()->glewIsSupported_mock
+#define glMaxShaderCompilerThreadsKHR cenpy::mock::opengl::glFunctionMock::instance()->glMaxShaderCompilerThreadsKHR_mock
 #define glIsProgram cenpy::mock::opengl::glFunctionMock::instance()->glIsProgram_mock
 #define glIsShader cenpy::mock::opengl::glFunctionMock::instance()->glIsShader_mock
 #define glLinkProgram cenpy::mock::opengl::glFunctionMock::instance()->glLinkProgram_mock
@@ -87,6 +102,44 @@
 #define glStencilFuncSeparate cenpy::mock::opengl::glFunctionMock::instance()->glStencilFuncSeparate_mock
 #define glStencilMaskSeparate cenpy::mock::opengl::glFunctionMock::instance()->glStencilMaskSeparate_mock
 #define glStencilOpSeparate cenpy::mock::opengl::glFunctionMock::instance()->glStencilOpSeparate_mock
+#define glActiveTexture cenpy::mock::opengl::glFunctionMock::instance()->glActiveTexture_mock
+#define glBindTexture cenpy::mock::opengl::glFunctionMock::instance()->glBindTexture_mock
+#define glDrawArrays cenpy::mock::opengl::glFunctionMock::instance()->glDrawArrays_mock
+#define glDrawElements cenpy::mock::opengl::glFunctionMock::instance()->glDrawElements_mock
+#define glBufferStorage cenpy::mock::opengl::glFunctionMock::instance()->glBufferStorage_mock
+#define glMapBufferRange cenpy::mock::opengl::glFunctionMock::instance()->glMapBufferRange_mock
+#define glUnmapBuffer cenpy::mock::opengl::glFunctionMock::instance()->glUnmapBuffer_mock
+#define glFenceSync cenpy::mock::opengl::glFunctionMock::instance()->glFenceSync_mock
+#define glClientWaitSync cenpy::mock::opengl::glFunctionMock::instance()->glClientWaitSync_mock
+#define glDeleteSync cenpy::mock::opengl::glFunctionMock::instance()->glDeleteSync_mock
+#define glGenVertexArrays cenpy::mock::opengl::glFunctionMock::instance()->glGenVertexArrays_mock
+#define glDeleteVertexArrays cenpy::mock::opengl::glFunctionMock::instance()->glDeleteVertexArrays_mock
+#define glVertexAttribIPointer cenpy::mock::opengl::glFunctionMock::instance()->glVertexAttribIPointer_mock
+#define glVertexAttribDivisor cenpy::mock::opengl::glFunctionMock::instance()->glVertexAttribDivisor_mock
+#define glDrawElementsInstanced cenpy::mock::opengl::glFunctionMock::instance()->glDrawElementsInstanced_mock
+#define glDrawElementsInstancedBaseInstance cenpy::mock::opengl::glFunctionMock::instance()->glDrawElementsInstancedBaseInstance_mock
+#define glDrawArraysInstanced cenpy::mock::opengl::glFunctionMock::instance()->glDrawArraysInstanced_mock
+#define glDrawArraysInstancedBaseInstance cenpy::mock::opengl::glFunctionMock::instance()->glDrawArraysInstancedBaseInstance_mock
+#define glMultiDrawElementsIndirect cenpy::mock::opengl::glFunctionMock::instance()->glMultiDrawElementsIndirect_mock
+#define glMultiDrawArraysIndirect cenpy::mock::opengl::glFunctionMock::instance()->glMultiDrawArraysIndirect_mock
+#define glBindBufferRange cenpy::mock::opengl::glFunctionMock::instance()->glBindBufferRange_mock
+#define glGetIntegerv cenpy::mock::opengl::glFunctionMock::instance()->glGetIntegerv_mock
+#define glDrawElementsInstancedBaseVertex cenpy::mock::opengl::glFunctionMock::instance()->glDrawElementsInstancedBaseVertex_mock
+#define glDrawElementsInstancedBaseVertexBaseInstance cenpy::mock::opengl::glFunctionMock::instance()->glDrawElementsInstancedBaseVertexBaseInstance_mock
+#define glGenTextures cenpy::mock::opengl::glFunctionMock::instance()->glGenTextures_mock
+#define glDeleteTextures cenpy::mock::opengl::glFunctionMock::instance()->glDeleteTextures_mock
+#define glTexImage2D cenpy::mock::opengl::glFunctionMock::instance()->glTexImage2D_mock
+#define glTexSubImage2D cenpy::mock::opengl::glFunctionMock::instance()->glTexSubImage2D_mock
+#define glTexParameteri cenpy::mock::opengl::glFunctionMock::instance()->glTexParameteri_mock
+#define glGenerateMipmap cenpy::mock::opengl::glFunctionMock::instance()->glGenerateMipmap_mock
+#define glCompressedTexImage2D cenpy::mock::opengl::glFunctionMock::instance()->glCompressedTexImage2D_mock
+#define glCompressedTexSubImage2D cenpy::mock::opengl::glFunctionMock::instance()->glCompressedTexSubImage2D_mock
+#define glGenFramebuffers cenpy::mock::opengl::glFunctionMock::instance()->glGenFramebuffers_mock
+#define glDeleteFramebuffers cenpy::mock::opengl::glFunctionMock::instance()->glDeleteFramebuffers_mock
+#define glBindFramebuffer cenpy::mock::opengl::glFunctionMock::instance()->glBindFramebuffer_mock
+#define glFramebufferTexture2D cenpy::mock::opengl::glFunctionMock::instance()->glFramebufferTexture2D_mock
+#define glCheckFramebufferStatus cenpy::mock::opengl::glFunctionMock::instance()->glCheckFramebufferStatus_mock
+#define glViewport cenpy::mock::opengl::glFunctionMock::instance()->glViewport_mock
 
 namespace cenpy::mock::opengl
 {
@@ -95,6 +148,9 @@ namespace cenpy::mock::opengl
     public:
         static constexpr std::string UNIFORM_NAME = "uniform_test";
         static constexpr std::string ATTRIBUTE_NAME = "attribute_test";
+        static constexpr std::string UNIFORM_BLOCK_NAME = "block_test";
+        static constexpr GLint UNIFORM_BLOCK_SIZE = 16;
+        static constexpr std::string DRIVER_STRING = "mock driver";
         static std::shared_ptr<glFunctionMock> instance()
         {
             static std::shared_ptr<glFunctionMock> instance = std::make_shared<glFunctionMock>();
@@ -148,6 +204,24 @@ namespace cenpy::mock::opengl
                 (*size) = 1;
                 (*type) = GL_FLOAT; });
 
+            // Uniforms are loose (not in a block) unless a test says otherwise.
+            ON_CALL(*this, glGetActiveUniformsiv_mock).WillByDefault([this](GLuint program, GLsizei count, const GLuint *indices, GLenum pname, GLint *params)
+                                                                     { std::fill(params, params + count, -1); });
+
+            ON_CALL(*this, glGetActiveUniformBlockName_mock)
+                .WillByDefault([this](GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name)
+                               {
+                strncpy(name, UNIFORM_BLOCK_NAME.c_str(), bufSize);
+                if (length != NULL) {
+                    *length = UNIFORM_BLOCK_NAME.size();
+                } });
+
+            ON_CALL(*this, glGetActiveUniformBlockiv_mock).WillByDefault([this](GLuint program, GLuint index, GLenum pname, GLint *params)
+                                                                         { (*params) = UNIFORM_BLOCK_SIZE; });
+
+            ON_CALL(*this, glGetString_mock).WillByDefault([this](GLenum name)
+                                                           { return reinterpret_cast<const GLubyte *>(DRIVER_STRING.c_str()); });
+
             ON_CALL(*this, glGetUniformLocation_mock).WillByDefault([this](GLuint program, const GLchar *name)
                                                                     { return 1; });
 
@@ -159,6 +233,9 @@ namespace cenpy::mock::opengl
 
             ON_CALL(*this, glCreateProgram_mock).WillByDefault([this]()
                                                                { return 1; });
+
+            ON_CALL(*this, glCheckFramebufferStatus_mock).WillByDefault([this](GLenum target)
+                                                                        { return GL_FRAMEBUFFER_COMPLETE; });
         }
 
         MOCK_METHOD(void, glUniform1f_mock, (GLint, GLfloat));
@@ -187,6 +264,10 @@ namespace cenpy::mock::opengl
         MOCK_METHOD(void, glEnableVertexAttribArray_mock, (GLuint), ());
         MOCK_METHOD(void, glGetActiveAttrib_mock, (GLuint, GLuint, GLsizei, GLsizei *, GLint *, GLenum *, GLchar *), ());
         MOCK_METHOD(void, glGetActiveUniform_mock, (GLuint, GLuint, GLsizei, GLsizei *, GLint *, GLenum *, GLchar *), ());
+        MOCK_METHOD(void, glGetActiveUniformsiv_mock, (GLuint, GLsizei, const GLuint *, GLenum, GLint *), ());
+        MOCK_METHOD(void, glGetActiveUniformBlockName_mock, (GLuint, GLuint, GLsizei, GLsizei *, GLchar *), ());
+        MOCK_METHOD(void, glGetActiveUniformBlockiv_mock, (GLuint, GLuint, GLenum, GLint *), ());
+        MOCK_METHOD(void, glUniformBlockBinding_mock, (GLuint, GLuint, GLuint), ());
         MOCK_METHOD(void, glGetAttachedShaders_mock, (GLuint, GLsizei, GLsizei *, GLuint *), ());
         MOCK_METHOD(GLint, glGetAttribLocation_mock, (GLuint, const GLchar *), ());
         MOCK_METHOD(void, glGetProgramInfoLog_mock, (GLuint, GLsizei, GLsizei *, GLchar *), ());
@@ -203,8 +284,18 @@ namespace cenpy::mock::opengl
         MOCK_METHOD(void, glGetVertexAttribiv_mock, (GLuint, GLenum, GLint *), ());
         MOCK_METHOD(void, glGenBuffers_mock, (GLsizei, GLuint *), ());
         MOCK_METHOD(void, glBindBuffer_mock, (GLenum, GLuint), ());
+        MOCK_METHOD(void, glBindVertexArray_mock, (GLuint), ());
         MOCK_METHOD(void, glBufferData_mock, (GLenum, GLsizeiptr, const GLvoid *, GLenum), ());
+        MOCK_METHOD(void, glBufferSubData_mock, (GLenum, GLintptr, GLsizeiptr, const GLvoid *), ());
+        MOCK_METHOD(void, glBindBufferBase_mock, (GLenum, GLuint, GLuint), ());
+        MOCK_METHOD(void, glDeleteBuffers_mock, (GLsizei, const GLuint *), ());
         MOCK_METHOD(void, glVertexAttribPointer_mock, (GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid *), ());
+        MOCK_METHOD(const GLubyte *, glGetString_mock, (GLenum), ());
+        MOCK_METHOD(void, glGetProgramBinary_mock, (GLuint, GLsizei, GLsizei *, GLenum *, void *), ());
+        MOCK_METHOD(void, glProgramBinary_mock, (GLuint, GLenum, const void *, GLsizei), ());
+        MOCK_METHOD(void, glProgramParameteri_mock, (GLuint, GLenum, GLint), ());
+        MOCK_METHOD(GLboolean, glewIsSupported_mock, (const char *), ());
+        MOCK_METHOD(void, glMaxShaderCompilerThreadsKHR_mock, (GLuint), ());
         MOCK_METHOD(GLboolean, glIsProgram_mock, (GLuint), ());
         MOCK_METHOD(GLboolean, glIsShader_mock, (GLuint), ());
         MOCK_METHOD(void, glLinkProgram_mock, (GLuint), ());
@@ -212,6 +303,44 @@ namespace cenpy::mock::opengl
         MOCK_METHOD(void, glStencilFuncSeparate_mock, (GLenum, GLenum, GLint, GLuint), ());
         MOCK_METHOD(void, glStencilMaskSeparate_mock, (GLenum, GLuint), ());
         MOCK_METHOD(void, glStencilOpSeparate_mock, (GLenum, GLenum, GLenum, GLenum), ());
+        MOCK_METHOD(void, glActiveTexture_mock, (GLenum), ());
+        MOCK_METHOD(void, glBindTexture_mock, (GLenum, GLuint), ());
+        MOCK_METHOD(void, glDrawArrays_mock, (GLenum, GLint, GLsizei), ());
+        MOCK_METHOD(void, glDrawElements_mock, (GLenum, GLsizei, GLenum, const void *), ());
+        MOCK_METHOD(void, glBufferStorage_mock, (GLenum, GLsizeiptr, const void *, GLbitfield), ());
+        MOCK_METHOD(void *, glMapBufferRange_mock, (GLenum, GLintptr, GLsizeiptr, GLbitfield), ());
+        MOCK_METHOD(GLboolean, glUnmapBuffer_mock, (GLenum), ());
+        MOCK_METHOD(GLsync, glFenceSync_mock, (GLenum, GLbitfield), ());
+        MOCK_METHOD(GLenum, glClientWaitSync_mock, (GLsync, GLbitfield, GLuint64), ());
+        MOCK_METHOD(void, glDeleteSync_mock, (GLsync), ());
+        MOCK_METHOD(void, glGenVertexArrays_mock, (GLsizei, GLuint *), ());
+        MOCK_METHOD(void, glDeleteVertexArrays_mock, (GLsizei, const GLuint *), ());
+        MOCK_METHOD(void, glVertexAttribIPointer_mock, (GLuint, GLint, GLenum, GLsizei, const void *), ());
+        MOCK_METHOD(void, glVertexAttribDivisor_mock, (GLuint, GLuint), ());
+        MOCK_METHOD(void, glDrawElementsInstanced_mock, (GLenum, GLsizei, GLenum, const void *, GLsizei), ());
+        MOCK_METHOD(void, glDrawElementsInstancedBaseInstance_mock, (GLenum, GLsizei, GLenum, const void *, GLsizei, GLuint), ());
+        MOCK_METHOD(void, glDrawArraysInstanced_mock, (GLenum, GLint, GLsizei, GLsizei), ());
+        MOCK_METHOD(void, glDrawArraysInstancedBaseInstance_mock, (GLenum, GLint, GLsizei, GLsizei, GLuint), ());
+        MOCK_METHOD(void, glMultiDrawElementsIndirect_mock, (GLenum, GLenum, const void *, GLsizei, GLsizei), ());
+        MOCK_METHOD(void, glMultiDrawArraysIndirect_mock, (GLenum, const void *, GLsizei, GLsizei), ());
+        MOCK_METHOD(void, glBindBufferRange_mock, (GLenum, GLuint, GLuint, GLintptr, GLsizeiptr), ());
+        MOCK_METHOD(void, glGetIntegerv_mock, (GLenum, GLint *), ());
+        MOCK_METHOD(void, glDrawElementsInstancedBaseVertex_mock, (GLenum, GLsizei, GLenum, const void *, GLsizei, GLint), ());
+        MOCK_METHOD(void, glDrawElementsInstancedBaseVertexBaseInstance_mock, (GLenum, GLsizei, GLenum, const void *, GLsizei, GLint, GLuint), ());
+        MOCK_METHOD(void, glGenTextures_mock, (GLsizei, GLuint *), ());
+        MOCK_METHOD(void, glDeleteTextures_mock, (GLsizei, const GLuint *), ());
+        MOCK_METHOD(void, glTexImage2D_mock, (GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void *), ());
+        MOCK_METHOD(void, glTexSubImage2D_mock, (GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void *), ());
+        MOCK_METHOD(void, glTexParameteri_mock, (GLenum, GLenum, GLint), ());
+        MOCK_METHOD(void, glGenerateMipmap_mock, (GLenum target), ());
+        MOCK_METHOD(void, glCompressedTexImage2D_mock, (GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void *), ());
+        MOCK_METHOD(void, glCompressedTexSubImage2D_mock, (GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void *), ());
+        MOCK_METHOD(void, glGenFramebuffers_mock, (GLsizei, GLuint *), ());
+        MOCK_METHOD(void, glDeleteFramebuffers_mock, (GLsizei, const GLuint *), ());
+        MOCK_METHOD(void, glBindFramebuffer_mock, (GLenum, GLuint), ());
+        MOCK_METHOD(void, glFramebufferTexture2D_mock, (GLenum, GLenum, GLenum, GLuint, GLint), ());
+        MOCK_METHOD(GLenum, glCheckFramebufferStatus_mock, (GLenum), ());
+        MOCK_METHOD(void, glViewport_mock, (GLint, GLint, GLsizei, GLsizei), ());
     };
 } // namespace cenpy::mock::opengl
 
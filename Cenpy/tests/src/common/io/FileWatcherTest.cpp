@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <common/io/FileWatcher.hpp>
+
+using cenpy::common::io::FileWatcher;
+
+class FileWatcherTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "cenpy-file-watcher-test";
+        std::filesystem::create_directories(m_directory);
+        m_watched = (m_directory / "watched.frag").lexically_normal();
+        m_other = (m_directory / "other.frag").lexically_normal();
+        write(m_watched, "void main() {}\n");
+        write(m_other, "void main() {}\n");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    static void write(const std::filesystem::path &path, const std::string &content)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    static void touch(const std::filesystem::path &path)
+    {
+        // Modification times may be coarse where the watcher polls them.
+        std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+    }
+
+    std::filesystem::path m_directory;
+    std::filesystem::path m_watched;
+    std::filesystem::path m_other;
+};
+
+TEST_F(FileWatcherTest, NothingWritten_NoChange)
+{
+    FileWatcher watcher;
+    watcher.watch(m_watched);
+
+    EXPECT_TRUE(watcher.poll().empty());
+}
+
+TEST_F(FileWatcherTest, WatchedFileWritten_ReportedOnce)
+{
+    FileWatcher watcher;
+    watcher.watch(m_watched);
+    watcher.watch(m_watched);
+
+    write(m_watched, "void main() { discard; }\n");
+    write(m_watched, "void main() {}\n");
+    touch(m_watched);
+    auto changed = watcher.poll();
+
+    ASSERT_EQ(changed.size(), 1);
+    EXPECT_EQ(changed[0].generic_string(), m_watched.generic_string());
+    EXPECT_TRUE(watcher.poll().empty());
+    EXPECT_EQ(watcher.getWatchedCount(), 1);
+}
+
+TEST_F(FileWatcherTest, UnwatchedFileWritten_NoChange)
+{
+    FileWatcher watcher;
+    watcher.watch(m_watched);
+
+    write(m_other, "void main() { discard; }\n");
+    touch(m_other);
+
+    EXPECT_TRUE(watcher.poll().empty());
+}
+
+TEST_F(FileWatcherTest, WatchedFileReplaced_Reported)
+{
+    FileWatcher watcher;
+    watcher.watch(m_watched);
+
+    // Editors save to a temporary file and rename it over the original.
+    const auto temporary = m_directory / "watched.frag.swp";
+    write(temporary, "void main() { discard; }\n");
+    touch(temporary);
+    std::filesystem::rename(temporary, m_watched);
+    auto changed = watcher.poll();
+
+    ASSERT_EQ(changed.size(), 1);
+    EXPECT_EQ(changed[0].generic_string(), m_watched.generic_string());
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <common/io/MappedFile.hpp>
+
+using cenpy::common::io::MappedFile;
+
+class MappedFileTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_path = std::filesystem::temp_directory_path() / "cenpy-mapped-file-test.txt";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(m_path);
+    }
+
+    void write(const std::string &content) const
+    {
+        std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    std::filesystem::path m_path;
+};
+
+TEST_F(MappedFileTest, ViewContent)
+{
+    write("#version 330 core\n");
+
+    MappedFile file(m_path);
+
+    EXPECT_EQ(file.size(), 18);
+    EXPECT_EQ(file.view(), "#version 330 core\n");
+}
+
+TEST_F(MappedFileTest, EmptyFile)
+{
+    write("");
+
+    MappedFile file(m_path);
+
+    EXPECT_EQ(file.size(), 0);
+    EXPECT_TRUE(file.view().empty());
+}
+
+TEST_F(MappedFileTest, MoveKeepsMapping)
+{
+    write("content");
+    MappedFile file(m_path);
+
+    MappedFile moved(std::move(file));
+
+    EXPECT_EQ(moved.view(), "content");
+    EXPECT_TRUE(file.view().empty());
+}
+
+TEST_F(MappedFileTest, MissingFile)
+{
+    EXPECT_THROW(MappedFile(m_path.string() + ".missing"), cenpy::common::exception::TraceableException<std::runtime_error>);
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <common/thread/WorkerPool.hpp>
+
+using cenpy::common::thread::WorkerPool;
+
+TEST(WorkerPoolTest, Submit)
+{
+    WorkerPool pool(2);
+
+    auto result = pool.submit([]()
+                              { return 42; });
+
+    EXPECT_EQ(result.get(), 42);
+}
+
+TEST(WorkerPoolTest, ParallelForVisitsEachIndexOnce)
+{
+    WorkerPool pool(3);
+    std::vector<std::atomic<int>> visits(1000);
+
+    pool.parallelFor(visits.size(), [&visits](std::size_t index)
+                     { ++visits[index]; });
+
+    for (const auto &count : visits)
+    {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(WorkerPoolTest, ParallelForRethrows)
+{
+    WorkerPool pool(2);
+
+    EXPECT_THROW(pool.parallelFor(100, [](std::size_t index)
+                                  {
+                                      if (index == 50)
+                                      {
+                                          throw std::runtime_error("failed");
+                                      } }),
+                 std::runtime_error);
+}
@@ -0,0 +1,85 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/context/ParallelCompile.hpp>
+
+namespace mock = cenpy::mock;
+namespace context = cenpy::graphic::opengl::context;
+
+class ParallelCompileTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        context::forgetParallelShaderCompile();
+    }
+
+    void TearDown() override
+    {
+        context::forgetParallelShaderCompile();
+        mock::opengl::glFunctionMock::reset();
+    }
+};
+
+TEST_F(ParallelCompileTests, Enable_Supported_LetsDriverPickThreads)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_KHR_parallel_shader_compile")))
+        .WillOnce(::testing::Return(GL_TRUE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMaxShaderCompilerThreadsKHR_mock(0xFFFFFFFF)).Times(1);
+
+    // Act & Assert
+    EXPECT_TRUE(context::enableParallelShaderCompile());
+}
+
+TEST_F(ParallelCompileTests, Enable_Unsupported_NoHint)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_KHR_parallel_shader_compile")))
+        .WillOnce(::testing::Return(GL_FALSE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMaxShaderCompilerThreadsKHR_mock(::testing::_)).Times(0);
+
+    // Act & Assert
+    EXPECT_FALSE(context::enableParallelShaderCompile());
+}
+
+TEST_F(ParallelCompileTests, Supported_QueriedOnce)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_KHR_parallel_shader_compile")))
+        .WillOnce(::testing::Return(GL_TRUE));
+
+    // Act & Assert
+    EXPECT_TRUE(context::isParallelShaderCompileSupported());
+    EXPECT_TRUE(context::isParallelShaderCompileSupported());
+}
+
+TEST_F(ParallelCompileTests, Supported_CachedByEnable)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_KHR_parallel_shader_compile")))
+        .WillOnce(::testing::Return(GL_FALSE));
+
+    // Act
+    context::enableParallelShaderCompile();
+
+    // Assert
+    EXPECT_FALSE(context::isParallelShaderCompileSupported());
+}
+
+TEST_F(ParallelCompileTests, Forget_QueriesAgain)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_KHR_parallel_shader_compile")))
+        .WillOnce(::testing::Return(GL_FALSE))
+        .WillOnce(::testing::Return(GL_TRUE));
+
+    // Act & Assert
+    EXPECT_FALSE(context::isParallelShaderCompileSupported());
+    context::forgetParallelShaderCompile();
+    EXPECT_TRUE(context::isParallelShaderCompileSupported());
+}
+
+#endif // __mock_gl__
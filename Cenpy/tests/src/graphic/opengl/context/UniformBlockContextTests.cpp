@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <graphic/opengl/pipeline/component/uniform/Setter.hpp>
+#include <TestUtils.hpp>
+
+using namespace cenpy::graphic::opengl::context;
+using cenpy::graphic::context::UniformBlockMember;
+using cenpy::test::utils::expectSpecificError;
+
+// Test fixture for UniformBlockContext
+class UniformBlockContextTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_blockContext = std::make_unique<OpenGLUniformBlockContext>();
+        m_blockContext->setBlockName("Frame");
+    }
+
+    void TearDown() override
+    {
+        m_blockContext.reset();
+    }
+
+    template <typename T>
+    T readAt(std::size_t offset) const
+    {
+        T value;
+        std::memcpy(&value, m_blockContext->getData().data() + offset, sizeof(T));
+        return value;
+    }
+
+    std::unique_ptr<OpenGLUniformBlockContext> m_blockContext;
+};
+
+TEST_F(UniformBlockContextTests, Std140Offsets)
+{
+    m_blockContext->addMember({"time", GL_FLOAT});
+    m_blockContext->addMember({"color", GL_FLOAT_VEC3});
+    m_blockContext->addMember({"exposure", GL_FLOAT});
+    m_blockContext->addMember({"resolution", GL_FLOAT_VEC2});
+    m_blockContext->addMember({"projection", GL_FLOAT_MAT4});
+    m_blockContext->addMember({"weights", GL_FLOAT, 3});
+    m_blockContext->addMember({"normal", GL_FLOAT_MAT3});
+    m_blockContext->addMember({"origin", GL_DOUBLE_VEC3});
+
+    EXPECT_EQ(m_blockContext->getMember("time")->offset, 0);
+    EXPECT_EQ(m_blockContext->getMember("color")->offset, 16);
+    // A scalar fits in the padding of a vec3.
+    EXPECT_EQ(m_blockContext->getMember("exposure")->offset, 28);
+    EXPECT_EQ(m_blockContext->getMember("resolution")->offset, 32);
+    EXPECT_EQ(m_blockContext->getMember("projection")->offset, 48);
+    EXPECT_EQ(m_blockContext->getMember("projection")->matrixStride, 16);
+    EXPECT_EQ(m_blockContext->getMember("weights")->offset, 112);
+    EXPECT_EQ(m_blockContext->getMember("weights")->arrayStride, 16);
+    EXPECT_EQ(m_blockContext->getMember("normal")->offset, 160);
+    EXPECT_EQ(m_blockContext->getMember("normal")->matrixStride, 16);
+    EXPECT_EQ(m_blockContext->getMember("origin")->offset, 224);
+    EXPECT_EQ(m_blockContext->getDataSize(), 256);
+}
+
+TEST_F(UniformBlockContextTests, Std140MemberAfterArray)
+{
+    m_blockContext->addMember({"weights", GL_FLOAT, 3});
+    m_blockContext->addMember({"exposure", GL_FLOAT});
+    m_blockContext->addMember({"offsets", GL_FLOAT_VEC2, 2});
+    m_blockContext->addMember({"scale", GL_FLOAT_VEC2});
+
+    EXPECT_EQ(m_blockContext->getMember("weights")->offset, 0);
+    EXPECT_EQ(m_blockContext->getMember("exposure")->offset, 48);
+    EXPECT_EQ(m_blockContext->getMember("offsets")->offset, 64);
+    EXPECT_EQ(m_blockContext->getMember("scale")->offset, 96);
+    EXPECT_EQ(m_blockContext->getDataSize(), 112);
+}
+
+TEST_F(UniformBlockContextTests, SizeRoundedToVec4)
+{
+    m_blockContext->addMember({"time", GL_FLOAT});
+    EXPECT_EQ(m_blockContext->getDataSize(), 16);
+}
+
+TEST_F(UniformBlockContextTests, PackMatrixColumnsAtMatrixStride)
+{
+    m_blockContext->addMember({"normal", GL_FLOAT_MAT3});
+    glm::mat3 value(1.0f);
+    value[2][1] = 5.0f;
+
+    m_blockContext->setValue("normal", value);
+
+    EXPECT_EQ(readAt<glm::vec3>(0), value[0]);
+    EXPECT_EQ(readAt<glm::vec3>(16), value[1]);
+    EXPECT_EQ(readAt<glm::vec3>(32), value[2]);
+}
+
+TEST_F(UniformBlockContextTests, PackArrayElement)
+{
+    m_blockContext->addMember({"weights", GL_FLOAT, 3});
+
+    m_blockContext->setValue("weights", 2.5f, 2);
+
+    EXPECT_EQ(readAt<float>(32), 2.5f);
+}
+
+TEST_F(UniformBlockContextTests, DirtyRangeCoversChangedMembersOnly)
+{
+    m_blockContext->addMember({"time", GL_FLOAT});
+    m_blockContext->addMember({"resolution", GL_FLOAT_VEC2});
+    m_blockContext->addMember({"projection", GL_FLOAT_MAT4});
+    ASSERT_TRUE(m_blockContext->isDirty());
+    m_blockContext->markUploaded();
+
+    m_blockContext->setValue("resolution", glm::vec2(800.0f, 600.0f));
+
+    EXPECT_TRUE(m_blockContext->isDirty());
+    EXPECT_EQ(m_blockContext->getDirtyOffset(), 8);
+    EXPECT_EQ(m_blockContext->getDirtySize(), 8);
+}
+
+TEST_F(UniformBlockContextTests, UnchangedValueStaysClean)
+{
+    m_blockContext->addMember({"time", GL_FLOAT});
+    m_blockContext->setValue("time", 1.0f);
+    m_blockContext->markUploaded();
+
+    m_blockContext->setValue("time", 1.0f);
+
+    EXPECT_FALSE(m_blockContext->isDirty());
+    EXPECT_EQ(m_blockContext->getDirtySize(), 0);
+}
+
+TEST_F(UniformBlockContextTests, SetUnknownMember)
+{
+    expectSpecificError([this]()
+                        { m_blockContext->setValue("time", 1.0f); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::SET::MEMBER_NOT_FOUND"));
+}
+
+TEST_F(UniformBlockContextTests, SetMismatchingType)
+{
+    m_blockContext->addMember({"time", GL_FLOAT});
+    expectSpecificError([this]()
+                        { m_blockContext->setValue("time", 1); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::SET::TYPE_MISMATCH"));
+}
+
+TEST_F(UniformBlockContextTests, SetOutOfRangeIndex)
+{
+    m_blockContext->addMember({"weights", GL_FLOAT, 3});
+    expectSpecificError([this]()
+                        { m_blockContext->setValue("weights", 1.0f, 3); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::SET::INDEX_OUT_OF_RANGE"));
+}
+
+TEST_F(UniformBlockContextTests, AddMemberTwice)
+{
+    m_blockContext->addMember({"time", GL_FLOAT});
+    expectSpecificError([this]()
+                        { m_blockContext->addMember({"time", GL_FLOAT}); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::MEMBER_ALREADY_DEFINED"));
+}
+
+TEST_F(UniformBlockContextTests, Std140ArrayOfOne)
+{
+    m_blockContext->addMember({"weights[0]", GL_FLOAT, 1});
+    m_blockContext->addMember({"exposure", GL_FLOAT});
+    m_blockContext->addMember({"offsets", GL_FLOAT_VEC2, 1, true});
+    m_blockContext->addMember({"scale", GL_FLOAT});
+
+    ASSERT_NE(m_blockContext->getMember("weights"), nullptr);
+    EXPECT_TRUE(m_blockContext->getMember("weights")->isArray);
+    EXPECT_EQ(m_blockContext->getMember("weights")->arrayStride, 16);
+    // The member after an array of one starts past the padding of its element.
+    EXPECT_EQ(m_blockContext->getMember("exposure")->offset, 16);
+    EXPECT_EQ(m_blockContext->getMember("offsets")->offset, 32);
+    EXPECT_EQ(m_blockContext->getMember("scale")->offset, 48);
+    EXPECT_EQ(m_blockContext->getDataSize(), 64);
+}
+
+TEST_F(UniformBlockContextTests, PackBoolAsInt)
+{
+    m_blockContext->addMember({"enabled", GL_BOOL});
+    m_blockContext->addMember({"masks", GL_BOOL, 2});
+
+    m_blockContext->setValue("enabled", true);
+    m_blockContext->setValue("masks", true, 1);
+
+    EXPECT_EQ(readAt<std::int32_t>(0), 1);
+    EXPECT_EQ(readAt<std::int32_t>(16), 0);
+    EXPECT_EQ(readAt<std::int32_t>(32), 1);
+
+    m_blockContext->setValue("enabled", false);
+
+    EXPECT_EQ(readAt<std::int32_t>(0), 0);
+}
+
+TEST_F(UniformBlockContextTests, SetBoolOnFloatMember)
+{
+    m_blockContext->addMember({"time", GL_FLOAT});
+    expectSpecificError([this]()
+                        { m_blockContext->setValue("time", true); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::SET::TYPE_MISMATCH"));
+}
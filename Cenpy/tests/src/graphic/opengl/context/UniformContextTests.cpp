@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <graphic/opengl/context/UniformContext.hpp>
+#include <graphic/opengl/pipeline/component/uniform/Setter.hpp>
+#include <TestUtils.hpp>
+
+using namespace cenpy::graphic::opengl::context;
+using cenpy::test::utils::expectSpecificError;
+
+// Test fixture for UniformContext
+class UniformContextTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_uniformContext = std::make_unique<OpenGLUniformContext>();
+    }
+
+    void TearDown() override
+    {
+        m_uniformContext.reset();
+    }
+
+    std::unique_ptr<OpenGLUniformContext> m_uniformContext;
+};
+
+TEST_F(UniformContextTests, NoValueByDefault)
+{
+    EXPECT_FALSE(m_uniformContext->hasValue());
+    EXPECT_EQ(m_uniformContext->getValueType(), static_cast<GLenum>(GL_NONE));
+}
+
+TEST_F(UniformContextTests, SetAndGetFloat)
+{
+    m_uniformContext->setValue(3.14f);
+    EXPECT_TRUE(m_uniformContext->hasValue());
+    EXPECT_EQ(m_uniformContext->getValueType(), static_cast<GLenum>(GL_FLOAT));
+    EXPECT_EQ(m_uniformContext->getValue<float>(), 3.14f);
+}
+
+TEST_F(UniformContextTests, SetAndGetLargestType)
+{
+    glm::dmat4 value(2.0);
+    m_uniformContext->setValue(value);
+    EXPECT_EQ(m_uniformContext->getValue<glm::dmat4>(), value);
+}
+
+TEST_F(UniformContextTests, OverwriteValueOfSameType)
+{
+    m_uniformContext->setValue(glm::vec3(1.0f, 2.0f, 3.0f));
+    m_uniformContext->setValue(glm::vec3(4.0f, 5.0f, 6.0f));
+    EXPECT_EQ(m_uniformContext->getValue<glm::vec3>(), glm::vec3(4.0f, 5.0f, 6.0f));
+}
+
+TEST_F(UniformContextTests, SetValueMatchingReflectedType)
+{
+    m_uniformContext->setGLType(GL_FLOAT_MAT4);
+    ASSERT_NO_THROW(m_uniformContext->setValue(glm::mat4(1.0f)));
+}
+
+TEST_F(UniformContextTests, SetIntOnSamplerUniform)
+{
+    m_uniformContext->setGLType(GL_SAMPLER_2D);
+    ASSERT_NO_THROW(m_uniformContext->setValue(0));
+}
+
+TEST_F(UniformContextTests, SetValueMismatchingReflectedType)
+{
+    m_uniformContext->setGLType(GL_INT);
+    expectSpecificError([this]()
+                        { m_uniformContext->setValue(1.0f); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM::SET::TYPE_MISMATCH"));
+}
+
+TEST_F(UniformContextTests, SetValueMismatchingStoredType)
+{
+    m_uniformContext->setValue(1);
+    expectSpecificError([this]()
+                        { m_uniformContext->setValue(1.0f); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM::SET::TYPE_MISMATCH"));
+}
+
+TEST_F(UniformContextTests, GetValueMismatchingStoredType)
+{
+    m_uniformContext->setValue(1);
+    expectSpecificError([this]()
+                        { m_uniformContext->getValue<float>(); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM::GET::TYPE_MISMATCH"));
+}
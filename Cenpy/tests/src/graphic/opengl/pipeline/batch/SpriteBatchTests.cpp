@@ -0,0 +1,228 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/batch/SpriteBatch.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+namespace batch = cenpy::graphic::opengl::pipeline::batch;
+namespace render = cenpy::graphic::render;
+using cenpy::test::utils::expectSpecificError;
+
+class SpriteBatchTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenBuffers_mock(3, ::testing::_))
+            .WillByDefault([](GLsizei, GLuint *buffers)
+                           { buffers[0] = 1; buffers[1] = 2; buffers[2] = 3; });
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenVertexArrays_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *vertexArray)
+                           { *vertexArray = ++m_lastVertexArray; });
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+
+    void supportBaseInstance(bool supported) const
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_ARB_base_instance")))
+            .WillByDefault(::testing::Return(supported ? GL_TRUE : GL_FALSE));
+    }
+
+    static batch::Sprite sprite(std::uint32_t layer, GLuint texture, float x = 0.0f)
+    {
+        batch::Sprite sprite;
+        sprite.position = {x, 0.0f};
+        sprite.layer = layer;
+        sprite.texture = texture;
+        return sprite;
+    }
+
+    GLuint m_lastVertexArray = 0;
+};
+
+TEST_F(SpriteBatchTests, Construct_SharesOneQuad)
+{
+    // Arrange
+    supportBaseInstance(true);
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenBuffers_mock(3, ::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenVertexArrays_mock(1, ::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_ARRAY_BUFFER, 8 * sizeof(GLfloat), ::testing::_, GL_STATIC_DRAW)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_ELEMENT_ARRAY_BUFFER, 6 * sizeof(GLuint), ::testing::_, GL_STATIC_DRAW)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(0, 2, GL_FLOAT, GL_FALSE, 8, nullptr)).Times(1);
+    for (GLuint location = 1; location <= 5; ++location)
+    {
+        EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribDivisor_mock(location, 1)).Times(1);
+    }
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, 40, reinterpret_cast<const void *>(32))).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(5, 1, GL_FLOAT, GL_FALSE, 40, reinterpret_cast<const void *>(36))).Times(1);
+
+    // Act
+    batch::OpenGLSpriteBatch sprites;
+
+    // Assert
+    EXPECT_EQ(sprites.getInstanceLayout().getStride(), sizeof(batch::SpriteInstance));
+}
+
+TEST_F(SpriteBatchTests, Submit_OneCommandPerLayerAndTexture)
+{
+    // Arrange
+    supportBaseInstance(true);
+    batch::OpenGLSpriteBatch sprites;
+    render::RenderQueue queue;
+    sprites.add(sprite(1, 7, 0.0f));
+    sprites.add(sprite(0, 7, 1.0f));
+    sprites.add(sprite(1, 8, 2.0f));
+    sprites.add(sprite(1, 7, 3.0f));
+    sprites.add(sprite(0, 7, 4.0f));
+
+    // Expect: the instances are streamed once, in run order
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_ARRAY_BUFFER, 5 * sizeof(batch::SpriteInstance), nullptr, GL_STREAM_DRAW)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_ARRAY_BUFFER, 0, 5 * sizeof(batch::SpriteInstance), ::testing::_))
+        .WillOnce([](GLenum, GLintptr, GLsizeiptr, const GLvoid *data)
+                  {
+                      const auto *instances = static_cast<const batch::SpriteInstance *>(data);
+                      EXPECT_EQ(instances[0].position[0], 1.0f);
+                      EXPECT_EQ(instances[1].position[0], 4.0f);
+                      EXPECT_EQ(instances[2].position[0], 0.0f);
+                      EXPECT_EQ(instances[3].position[0], 3.0f);
+                      EXPECT_EQ(instances[4].position[0], 2.0f);
+                      EXPECT_EQ(instances[4].layer, 1.0f); });
+
+    // Act
+    sprites.submit(queue);
+
+    // Assert
+    ASSERT_EQ(queue.size(), 3);
+    EXPECT_EQ(sprites.getCommandsCount(), 3);
+    EXPECT_EQ(sprites.size(), 0);
+    const auto &commands = queue.getCommands();
+    EXPECT_EQ(commands[0].texture, 7);
+    EXPECT_EQ(commands[0].instanceCount, 2);
+    EXPECT_EQ(commands[0].firstInstance, 0);
+    EXPECT_EQ(commands[1].texture, 7);
+    EXPECT_EQ(commands[1].instanceCount, 2);
+    EXPECT_EQ(commands[1].firstInstance, 2);
+    EXPECT_EQ(commands[2].texture, 8);
+    EXPECT_EQ(commands[2].instanceCount, 1);
+    EXPECT_EQ(commands[2].firstInstance, 4);
+    for (const auto &command : commands)
+    {
+        EXPECT_EQ(command.vertexArray, 1);
+        EXPECT_EQ(command.count, 6);
+        EXPECT_TRUE(command.indexed);
+    }
+}
+
+TEST_F(SpriteBatchTests, Submit_WithoutBaseInstance_VertexArrayPerRun)
+{
+    // Arrange
+    supportBaseInstance(false);
+    batch::OpenGLSpriteBatch sprites;
+    render::RenderQueue queue;
+    sprites.add(sprite(0, 7));
+    sprites.add(sprite(0, 8));
+    sprites.add(sprite(0, 8));
+
+    // Expect: the second run points its instance attributes past the first one
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenVertexArrays_mock(1, ::testing::_)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(1, 2, GL_FLOAT, GL_FALSE, 40, nullptr)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(1, 2, GL_FLOAT, GL_FALSE, 40, reinterpret_cast<const void *>(40))).Times(1);
+
+    // Act
+    sprites.submit(queue);
+
+    // Assert
+    ASSERT_EQ(queue.size(), 2);
+    EXPECT_EQ(queue.getCommands()[0].vertexArray, 1);
+    EXPECT_EQ(queue.getCommands()[0].firstInstance, 0);
+    EXPECT_EQ(queue.getCommands()[1].vertexArray, 2);
+    EXPECT_EQ(queue.getCommands()[1].instanceCount, 2);
+    EXPECT_EQ(queue.getCommands()[1].firstInstance, 0);
+}
+
+TEST_F(SpriteBatchTests, Submit_WithoutBaseInstance_RunsInPlaceNotRepointed)
+{
+    // Arrange
+    supportBaseInstance(false);
+    batch::OpenGLSpriteBatch sprites;
+    render::RenderQueue queue;
+    sprites.add(sprite(0, 7));
+    sprites.add(sprite(0, 8));
+    sprites.submit(queue);
+    queue.clear();
+    sprites.add(sprite(0, 7));
+    sprites.add(sprite(0, 8));
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenVertexArrays_mock(1, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    // Act
+    sprites.submit(queue);
+
+    // Assert
+    EXPECT_EQ(queue.size(), 2);
+}
+
+TEST_F(SpriteBatchTests, Submit_FewerSprites_OrphansSameCapacity)
+{
+    // Arrange
+    supportBaseInstance(true);
+    batch::OpenGLSpriteBatch sprites;
+    render::RenderQueue queue;
+    sprites.add(sprite(0, 7));
+    sprites.add(sprite(0, 7));
+    sprites.submit(queue);
+    sprites.add(sprite(0, 7));
+
+    // Expect: fewer sprites orphan the storage of the previous frame
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_ARRAY_BUFFER, 2 * sizeof(batch::SpriteInstance), nullptr, GL_STREAM_DRAW)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_ARRAY_BUFFER, 0, sizeof(batch::SpriteInstance), ::testing::_)).Times(1);
+
+    // Act
+    sprites.submit(queue);
+}
+
+TEST_F(SpriteBatchTests, Submit_Empty_PushesNothing)
+{
+    // Arrange
+    supportBaseInstance(true);
+    batch::OpenGLSpriteBatch sprites;
+    render::RenderQueue queue;
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    // Act
+    sprites.submit(queue);
+
+    // Assert
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(sprites.getCommandsCount(), 0);
+}
+
+TEST_F(SpriteBatchTests, Add_LayerOutOfRange)
+{
+    // Arrange
+    supportBaseInstance(true);
+    batch::OpenGLSpriteBatch sprites;
+
+    // Act & Assert
+    expectSpecificError([&sprites]()
+                        { sprites.add(sprite(256, 7)); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::RENDER_QUEUE::KEY_OUT_OF_RANGE\nLayer 256 and pass 0 must fit in 8 bits"));
+}
+
+#endif // __mock_gl__
@@ -0,0 +1,142 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <array>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/buffer/IndirectBuffer.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+namespace buffer = cenpy::graphic::opengl::pipeline::buffer;
+namespace render = cenpy::graphic::render;
+
+class IndirectBufferTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StartsWith("GL_ARB_"))).WillByDefault(::testing::Return(GL_TRUE));
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGetIntegerv_mock(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, ::testing::_))
+            .WillByDefault([](GLenum, GLint *alignment)
+                           { *alignment = 32; });
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenBuffers_mock(2, ::testing::_))
+            .WillByDefault([](GLsizei, GLuint *buffers)
+                           { buffers[0] = 1; buffers[1] = 2; });
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+};
+
+TEST_F(IndirectBufferTests, Write_PacksIndexedDraws)
+{
+    // Arrange
+    buffer::OpenGLIndirectBuffer indirect;
+    std::array<render::RenderCommand, 2> commands;
+    commands[0] = {.vertexArray = 3, .first = 0, .count = 36, .indexed = true, .baseVertex = 0, .drawData = 10};
+    commands[1] = {.vertexArray = 3, .first = 36, .count = 6, .indexed = true, .instanceCount = 4, .firstInstance = 8, .baseVertex = 24, .drawData = 11};
+    std::vector<GLuint> draws;
+    std::vector<buffer::DrawRecord> records;
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_DRAW_INDIRECT_BUFFER, 1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_SHADER_STORAGE_BUFFER, 2)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_DRAW_INDIRECT_BUFFER, 10 * sizeof(GLuint), nullptr, GL_STREAM_DRAW)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_DRAW_INDIRECT_BUFFER, 0, 10 * sizeof(GLuint), ::testing::_))
+        .WillOnce([&draws](GLenum, GLintptr, GLsizeiptr size, const GLvoid *data)
+                  { draws.assign(static_cast<const GLuint *>(data), static_cast<const GLuint *>(data) + size / sizeof(GLuint)); });
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_SHADER_STORAGE_BUFFER, 0, 2 * sizeof(buffer::DrawRecord), ::testing::_))
+        .WillOnce([&records](GLenum, GLintptr, GLsizeiptr size, const GLvoid *data)
+                  { records.assign(static_cast<const buffer::DrawRecord *>(data), static_cast<const buffer::DrawRecord *>(data) + size / sizeof(buffer::DrawRecord)); });
+
+    // Act
+    const auto &batches = indirect.write(commands);
+
+    // Assert
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0].drawCount, 2);
+    EXPECT_EQ(batches[0].command, &commands[0]);
+    EXPECT_EQ(draws, (std::vector<GLuint>{36, 1, 0, 0, 0, 6, 4, 36, 24, 8}));
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[1].data, 11);
+    EXPECT_EQ(records[1].firstInstance, 8);
+    EXPECT_EQ(records[1].instanceCount, 4);
+    EXPECT_EQ(records[1].baseVertex, 24);
+}
+
+TEST_F(IndirectBufferTests, Write_BatchRecordsStartAligned)
+{
+    // Arrange
+    buffer::OpenGLIndirectBuffer indirect;
+    std::array<render::RenderCommand, 3> commands;
+    commands[0] = {.vertexArray = 3, .count = 3};
+    commands[1] = {.vertexArray = 4, .count = 3, .indexed = true};
+    commands[2] = {.vertexArray = 4, .count = 6, .indexed = true};
+
+    // Act
+    const auto &batches = indirect.write(commands);
+
+    // Assert: 32 bytes alignment, two records
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[0].indirectOffset, 0);
+    EXPECT_EQ(batches[0].recordsOffset, 0);
+    EXPECT_EQ(batches[1].indirectOffset, 4 * sizeof(GLuint));
+    EXPECT_EQ(batches[1].recordsOffset, 32);
+    EXPECT_EQ(batches[1].drawCount, 2);
+}
+
+TEST_F(IndirectBufferTests, BindRecords_BindsBatchRange)
+{
+    // Arrange
+    buffer::OpenGLIndirectBuffer indirect;
+    std::array<render::RenderCommand, 2> commands;
+    commands[0] = {.vertexArray = 3, .count = 3};
+    commands[1] = {.vertexArray = 4, .count = 3};
+    const auto &batches = indirect.write(commands);
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferRange_mock(GL_SHADER_STORAGE_BUFFER, buffer::OpenGLIndirectBuffer::DRAW_DATA_BINDING, 2, 32, sizeof(buffer::DrawRecord))).Times(1);
+
+    // Act
+    indirect.bindRecords(batches[1]);
+}
+
+TEST_F(IndirectBufferTests, Destroy_DeletesBuffers)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteBuffers_mock(2, ::testing::_)).Times(1);
+
+    // Act
+    buffer::OpenGLIndirectBuffer indirect;
+}
+
+TEST_F(IndirectBufferTests, Create_DrawParametersNotSupported)
+{
+    // Arrange
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::_)).WillRepeatedly(::testing::Return(GL_TRUE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_ARB_shader_draw_parameters"))).WillRepeatedly(::testing::Return(GL_FALSE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_VERSION_4_6"))).WillRepeatedly(::testing::Return(GL_FALSE));
+
+    // Act & Assert
+    cenpy::test::utils::expectSpecificError([]()
+                                            { buffer::OpenGLIndirectBuffer indirect; },
+                                            cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::BUFFER::DRAW_PARAMETERS_NOT_SUPPORTED"));
+}
+
+TEST_F(IndirectBufferTests, Create_DrawParametersCoreIn46)
+{
+    // Arrange
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::_)).WillRepeatedly(::testing::Return(GL_TRUE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_ARB_shader_draw_parameters"))).WillRepeatedly(::testing::Return(GL_FALSE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_VERSION_4_6"))).WillRepeatedly(::testing::Return(GL_TRUE));
+
+    // Act & Assert
+    ASSERT_NO_THROW(buffer::OpenGLIndirectBuffer indirect);
+}
+
+#endif // __mock_gl__
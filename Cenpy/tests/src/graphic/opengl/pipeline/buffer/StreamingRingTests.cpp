@@ -0,0 +1,150 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <array>
+#include <memory>
+#include <span>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/buffer/StreamingRing.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+using cenpy::graphic::opengl::pipeline::buffer::OpenGLStreamingRing;
+using cenpy::test::utils::expectSpecificError;
+
+class StreamingRingTests : public ::testing::Test
+{
+protected:
+    static constexpr std::size_t SEGMENT_SIZE = 32;
+
+    void SetUp() override
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_ARB_buffer_storage"))).WillByDefault(::testing::Return(GL_TRUE));
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenBuffers_mock(1, ::testing::_)).WillByDefault(::testing::SetArgPointee<1>(5));
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glMapBufferRange_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).WillByDefault(::testing::Return(m_mapped.data()));
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+
+    GLsync fence(std::uintptr_t id)
+    {
+        return reinterpret_cast<GLsync>(id);
+    }
+
+    std::array<std::byte, OpenGLStreamingRing::SEGMENTS * SEGMENT_SIZE> m_mapped{};
+};
+
+TEST_F(StreamingRingTests, Create_PersistentCoherentStorage)
+{
+    // Expect
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferStorage_mock(GL_ARRAY_BUFFER, 3 * SEGMENT_SIZE, nullptr, flags)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMapBufferRange_mock(GL_ARRAY_BUFFER, 0, 3 * SEGMENT_SIZE, flags)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteBuffers_mock(1, ::testing::Pointee(5))).Times(1);
+
+    // Act
+    OpenGLStreamingRing ring(GL_ARRAY_BUFFER, SEGMENT_SIZE);
+
+    // Assert
+    ASSERT_EQ(ring.getBufferID(), 5);
+}
+
+TEST_F(StreamingRingTests, Create_StorageNotSupported)
+{
+    // Arrange
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_ARB_buffer_storage"))).WillOnce(::testing::Return(GL_FALSE));
+
+    // Act & Assert
+    expectSpecificError([]()
+                        { OpenGLStreamingRing ring(GL_ARRAY_BUFFER, SEGMENT_SIZE); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::BUFFER::STORAGE_NOT_SUPPORTED"));
+}
+
+TEST_F(StreamingRingTests, Write_EachFrameInItsSegment)
+{
+    // Arrange
+    OpenGLStreamingRing ring(GL_ARRAY_BUFFER, SEGMENT_SIZE);
+    const std::array<float, 2> values{1.0f, 2.0f};
+
+    // Act & Assert
+    EXPECT_EQ(ring.write(std::span<const float>(values)), 0);
+    EXPECT_EQ(ring.write(std::span<const float>(values)), sizeof(values));
+    ring.endFrame();
+    ring.beginFrame();
+    EXPECT_EQ(ring.write(std::span<const float>(values)), SEGMENT_SIZE);
+    ring.endFrame();
+    ring.beginFrame();
+    EXPECT_EQ(ring.write(std::span<const float>(values)), 2 * SEGMENT_SIZE);
+    EXPECT_EQ(std::memcmp(m_mapped.data() + 2 * SEGMENT_SIZE, values.data(), sizeof(values)), 0);
+}
+
+TEST_F(StreamingRingTests, Write_SegmentOverflow)
+{
+    // Arrange
+    OpenGLStreamingRing ring(GL_ARRAY_BUFFER, SEGMENT_SIZE);
+    const std::array<std::byte, SEGMENT_SIZE - 4> bytes{};
+    ring.write(std::span<const std::byte>(bytes));
+
+    // Act & Assert
+    expectSpecificError([&ring, &bytes]()
+                        { ring.write(std::span<const std::byte>(bytes)); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::BUFFER::RING_SEGMENT_OVERFLOW\n28 bytes requested, 4 left"));
+}
+
+TEST_F(StreamingRingTests, BeginFrame_WaitsForSegmentStillRead)
+{
+    // Arrange
+    OpenGLStreamingRing ring(GL_ARRAY_BUFFER, SEGMENT_SIZE);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glFenceSync_mock(GL_SYNC_GPU_COMMANDS_COMPLETE, 0))
+        .WillOnce(::testing::Return(fence(1)))
+        .WillOnce(::testing::Return(fence(2)))
+        .WillOnce(::testing::Return(fence(3)));
+
+    // Expect: the first segment is still read by the GPU when it comes back, the second is not
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glClientWaitSync_mock(fence(1), 0, 0)).WillOnce(::testing::Return(GL_TIMEOUT_EXPIRED));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glClientWaitSync_mock(fence(1), GL_SYNC_FLUSH_COMMANDS_BIT, ::testing::_)).WillOnce(::testing::Return(GL_CONDITION_SATISFIED));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteSync_mock(fence(1))).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glClientWaitSync_mock(fence(2), 0, 0)).WillOnce(::testing::Return(GL_ALREADY_SIGNALED));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteSync_mock(fence(2))).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteSync_mock(fence(3))).Times(1);
+
+    // Act: three frames fill the ring, the next two reuse the first segments
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        if (frame > 0)
+        {
+            ring.beginFrame();
+        }
+        ring.endFrame();
+    }
+    ring.beginFrame();
+    ring.beginFrame();
+
+    // Assert
+    ASSERT_EQ(ring.getStalls(), 1);
+}
+
+TEST_F(StreamingRingTests, EndFrame_TwiceReplacesFence)
+{
+    // Arrange
+    OpenGLStreamingRing ring(GL_ARRAY_BUFFER, SEGMENT_SIZE);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glFenceSync_mock(GL_SYNC_GPU_COMMANDS_COMPLETE, 0))
+        .WillOnce(::testing::Return(fence(1)))
+        .WillOnce(::testing::Return(fence(2)));
+
+    // Expect: the first fence is deleted when replaced, the second when the ring is released
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteSync_mock(fence(1))).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteSync_mock(fence(2))).Times(1);
+
+    // Act
+    ring.endFrame();
+    ring.endFrame();
+}
+
+#endif // __mock_gl__
@@ -0,0 +1,72 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/cache/FusedPassCache.hpp>
+#include <graphic/pipeline/MockPass.hpp>
+#include <graphic/MockApi.hpp>
+
+namespace api = cenpy::mock::graphic::api;
+namespace cache = cenpy::graphic::opengl::pipeline::cache;
+namespace mock = cenpy::mock;
+namespace render = cenpy::graphic::render;
+
+using mock::graphic::pipeline::opengl::MockPass;
+
+class FusedPassCacheTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+    }
+
+    std::shared_ptr<cenpy::graphic::pipeline::IPass<api::MockOpenGL>> create(std::string_view vertexCode, const std::string &fragmentCode)
+    {
+        m_fragments.push_back(fragmentCode);
+        auto pass = std::make_shared<::testing::NiceMock<MockPass<api::MockOpenGL>>>();
+        EXPECT_CALL(*pass, load()).Times(1);
+        EXPECT_EQ(vertexCode, render::PassFusion::getVertexShader());
+        return pass;
+    }
+
+    std::vector<std::string> m_fragments;
+    cache::OpenGLFusedPassCache<api::MockOpenGL> m_cache{[this](std::string_view vertexCode, const std::string &fragmentCode)
+                                                         { return create(vertexCode, fragmentCode); }};
+    const render::PointwiseStage m_tint{"tint", "color.rgb *= tint;", {{"vec3", "tint"}}};
+    const render::PointwiseStage m_fade{"fade", "color.rgb *= 1.0 - amount;", {{"float", "amount"}}};
+};
+
+TEST_F(FusedPassCacheTests, Acquire_SameChain_SharesPass)
+{
+    // Act
+    auto first = m_cache.acquire({{&m_tint}, {&m_fade}});
+    auto second = m_cache.acquire({{&m_tint}, {&m_fade}});
+
+    // Assert
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(m_fragments.size(), 1);
+    EXPECT_EQ(m_fragments.front(), render::PassFusion::generate({{&m_tint}, {&m_fade}}));
+    EXPECT_EQ(m_cache.getHits(), 1);
+    EXPECT_EQ(m_cache.getMisses(), 1);
+}
+
+TEST_F(FusedPassCacheTests, Acquire_OtherOrder_OtherPass)
+{
+    // Act
+    auto first = m_cache.acquire({{&m_tint}, {&m_fade}});
+    auto second = m_cache.acquire({{&m_fade}, {&m_tint}});
+    auto alone = m_cache.acquire({{&m_tint}});
+
+    // Assert
+    EXPECT_NE(first, second);
+    EXPECT_NE(first, alone);
+    EXPECT_EQ(m_cache.getSize(), 3);
+    EXPECT_EQ(m_cache.getMisses(), 3);
+}
+
+#endif // __mock_gl__
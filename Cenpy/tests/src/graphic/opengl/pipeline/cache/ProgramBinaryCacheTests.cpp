@@ -0,0 +1,145 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <filesystem>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/Api.hpp>
+#include <graphic/pipeline/MockShader.hpp>
+#include <graphic/opengl/pipeline/component/uniform/MockSetter.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+#include <graphic/opengl/pipeline/cache/ProgramBinaryCache.hpp>
+
+namespace api = cenpy::graphic::api;
+namespace mock = cenpy::mock;
+namespace context = cenpy::graphic::opengl::context;
+namespace cache = cenpy::graphic::opengl::pipeline::cache;
+using MockShader = cenpy::mock::graphic::pipeline::MockShader<api::OpenGL>;
+
+class ProgramBinaryCacheTests : public ::testing::Test
+{
+protected:
+    static constexpr GLenum BINARY_FORMAT = 0x1234;
+
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / std::format("cenpy-program-binary-cache-{}", ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(m_directory);
+        m_cache = std::make_shared<cache::OpenGLProgramBinaryCache>(m_directory);
+
+        m_vertexContext = std::make_shared<context::OpenGLShaderContext>();
+        m_vertexContext->setShaderType(cenpy::graphic::context::ShaderType::VERTEX);
+        m_vertexContext->setShaderPath("minimal.vert");
+        m_vertexContext->setShaderCode("void main() {}");
+        m_vertexShader = std::make_shared<MockShader>();
+        ON_CALL(*m_vertexShader, getContext()).WillByDefault(::testing::ReturnRef(m_vertexContext));
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::shared_ptr<context::OpenGLPassContext> makePass(GLuint passID = 0)
+    {
+        auto passContext = std::make_shared<context::OpenGLPassContext>();
+        passContext->addShader(m_vertexShader);
+        passContext->setPassID(passID);
+        return passContext;
+    }
+
+    void storeBinary()
+    {
+        EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramBinary_mock(5, 1, ::testing::_, ::testing::_, ::testing::_))
+            .WillOnce(::testing::Invoke([](GLuint, GLsizei, GLsizei *length, GLenum *format, void *binary)
+                                        {
+                                            *length = 1;
+                                            *format = BINARY_FORMAT;
+                                            *static_cast<char *>(binary) = 'x'; }));
+        m_cache->store(*makePass(5));
+        ::testing::Mock::VerifyAndClearExpectations(mock::opengl::glFunctionMock::instance().get());
+    }
+
+    std::filesystem::path m_directory;
+    std::shared_ptr<cache::OpenGLProgramBinaryCache> m_cache;
+    std::shared_ptr<context::OpenGLShaderContext> m_vertexContext;
+    std::shared_ptr<MockShader> m_vertexShader;
+};
+
+TEST_F(ProgramBinaryCacheTests, StoreThenLoad_Hit)
+{
+    // Arrange
+    storeBinary();
+    auto passContext = makePass();
+
+    // Expect the stored binary to be handed back to the driver
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glProgramBinary_mock(1, BINARY_FORMAT, ::testing::_, 1))
+        .WillOnce(::testing::Invoke([](GLuint, GLenum, const void *binary, GLsizei)
+                                    { ASSERT_EQ(*static_cast<const char *>(binary), 'x'); }));
+
+    // Act & Assert
+    ASSERT_TRUE(m_cache->load(*passContext));
+    ASSERT_EQ(passContext->getPassID(), 1);
+    ASSERT_EQ(m_cache->getStores(), 1);
+    ASSERT_EQ(m_cache->getHits(), 1);
+}
+
+TEST_F(ProgramBinaryCacheTests, Load_NoEntry_Miss)
+{
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCreateProgram_mock()).Times(0);
+
+    ASSERT_FALSE(m_cache->load(*makePass()));
+    ASSERT_EQ(m_cache->getMisses(), 1);
+}
+
+TEST_F(ProgramBinaryCacheTests, Load_SourceChanged_Miss)
+{
+    // Arrange
+    storeBinary();
+    m_vertexContext->setShaderCode("void main() { gl_Position = vec4(0.0); }");
+    auto passContext = makePass();
+
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glProgramBinary_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    // Act & Assert
+    ASSERT_FALSE(m_cache->load(*passContext));
+    ASSERT_EQ(passContext->getPassID(), 0);
+    ASSERT_EQ(m_cache->getMisses(), 1);
+}
+
+TEST_F(ProgramBinaryCacheTests, StoreVariant_KeepsBaseEntry)
+{
+    // Arrange: a variant has the paths of its base pass, but its own macros and code
+    storeBinary();
+    m_vertexContext->setDefines({"SKINNED"});
+    m_vertexContext->setShaderCode("#define SKINNED\nvoid main() {}");
+    storeBinary();
+    m_vertexContext->setDefines({});
+    m_vertexContext->setShaderCode("void main() {}");
+
+    // Act & Assert: both entries are there
+    ASSERT_EQ(m_cache->getStores(), 2);
+    ASSERT_EQ(std::distance(std::filesystem::directory_iterator(m_directory), std::filesystem::directory_iterator()), 2);
+    ASSERT_TRUE(m_cache->load(*makePass()));
+    ASSERT_EQ(m_cache->getHits(), 1);
+}
+
+TEST_F(ProgramBinaryCacheTests, Load_DriverRejectsBinary_Miss)
+{
+    // Arrange
+    storeBinary();
+    auto passContext = makePass();
+
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_LINK_STATUS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(GL_FALSE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteProgram_mock(1)).Times(1);
+
+    // Act & Assert
+    ASSERT_FALSE(m_cache->load(*passContext));
+    ASSERT_EQ(passContext->getPassID(), 0);
+}
+
+#endif // __mock_gl__
@@ -0,0 +1,90 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+#include <graphic/opengl/pipeline/cache/ShaderCache.hpp>
+
+namespace mock = cenpy::mock;
+namespace context = cenpy::graphic::opengl::context;
+namespace cache = cenpy::graphic::opengl::pipeline::cache;
+
+class ShaderCacheTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+    }
+
+    static context::OpenGLShaderContext makeShader(const std::string &code, const std::string &path = "fullscreen.vert")
+    {
+        context::OpenGLShaderContext shaderContext;
+        shaderContext.setShaderType(cenpy::graphic::context::ShaderType::VERTEX);
+        shaderContext.setShaderPath(path);
+        shaderContext.setShaderCode(code);
+        return shaderContext;
+    }
+
+    cache::OpenGLShaderCache m_cache;
+};
+
+TEST_F(ShaderCacheTests, Acquire_SameSource_SharesObject)
+{
+    // Arrange
+    auto first = makeShader("void main() {}");
+    auto second = makeShader("void main() {}");
+
+    // Act
+    ASSERT_EQ(m_cache.acquire(first), 0);
+    m_cache.add(first, 7);
+
+    // Assert
+    ASSERT_EQ(m_cache.acquire(second), 7);
+    ASSERT_EQ(m_cache.getReferences(7), 2);
+    ASSERT_EQ(m_cache.getHits(), 1);
+    ASSERT_EQ(m_cache.getMisses(), 1);
+}
+
+TEST_F(ShaderCacheTests, Acquire_DifferentSource_Miss)
+{
+    // Arrange
+    m_cache.add(makeShader("void main() {}"), 7);
+
+    // Act & Assert
+    ASSERT_EQ(m_cache.acquire(makeShader("void main() { gl_Position = vec4(0.0); }")), 0);
+    ASSERT_EQ(m_cache.acquire(makeShader("void main() {}", "other.vert")), 0);
+    ASSERT_EQ(m_cache.getReferences(7), 1);
+}
+
+TEST_F(ShaderCacheTests, Release_DeletesWithLastReference)
+{
+    // Arrange
+    auto shaderContext = makeShader("void main() {}");
+    m_cache.add(shaderContext, 7);
+    m_cache.acquire(shaderContext);
+
+    // Expect calls: the first release leaves the object to the other user
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteShader_mock(7)).Times(0);
+    m_cache.release(7);
+    ::testing::Mock::VerifyAndClearExpectations(mock::opengl::glFunctionMock::instance().get());
+
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteShader_mock(7)).Times(1);
+    m_cache.release(7);
+
+    // Assert
+    ASSERT_EQ(m_cache.getSize(), 0);
+    ASSERT_EQ(m_cache.acquire(shaderContext), 0);
+}
+
+TEST_F(ShaderCacheTests, Release_NotShared_DeletesAtOnce)
+{
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteShader_mock(9)).Times(1);
+
+    m_cache.release(9);
+}
+
+#endif // __mock_gl__
@@ -0,0 +1,179 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/cache/StateCache.hpp>
+
+namespace mock = cenpy::mock;
+namespace cache = cenpy::graphic::opengl::pipeline::cache;
+
+class StateCacheTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+    }
+
+    cache::OpenGLStateCache m_cache;
+};
+
+TEST_F(StateCacheTests, UseProgram_SkipsCurrentProgram)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUseProgram_mock(1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUseProgram_mock(2)).Times(1);
+
+    // Act
+    EXPECT_TRUE(m_cache.useProgram(1));
+    EXPECT_FALSE(m_cache.useProgram(1));
+    EXPECT_TRUE(m_cache.useProgram(2));
+
+    // Assert
+    EXPECT_EQ(m_cache.getIssued(), 2);
+    EXPECT_EQ(m_cache.getSkipped(), 1);
+}
+
+TEST_F(StateCacheTests, BindBuffer_ShadowsEachTarget)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_ARRAY_BUFFER, 3)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_UNIFORM_BUFFER, 3)).Times(1);
+
+    // Act
+    EXPECT_TRUE(m_cache.bindBuffer(GL_ARRAY_BUFFER, 3));
+    EXPECT_TRUE(m_cache.bindBuffer(GL_UNIFORM_BUFFER, 3));
+    EXPECT_FALSE(m_cache.bindBuffer(GL_ARRAY_BUFFER, 3));
+    EXPECT_FALSE(m_cache.bindBuffer(GL_UNIFORM_BUFFER, 3));
+}
+
+TEST_F(StateCacheTests, BindBuffer_ElementArrayAlwaysIssued)
+{
+    // Expect: the element array binding follows the bound vertex array object
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_ELEMENT_ARRAY_BUFFER, 4)).Times(2);
+
+    // Act
+    m_cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 4);
+    m_cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 4);
+}
+
+TEST_F(StateCacheTests, BindBufferBase_AlsoBindsGenericTarget)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferBase_mock(GL_UNIFORM_BUFFER, 0, 5)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferBase_mock(GL_UNIFORM_BUFFER, 1, 5)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_UNIFORM_BUFFER, 5)).Times(0);
+
+    // Act
+    EXPECT_TRUE(m_cache.bindBufferBase(GL_UNIFORM_BUFFER, 0, 5));
+    EXPECT_FALSE(m_cache.bindBufferBase(GL_UNIFORM_BUFFER, 0, 5));
+    EXPECT_TRUE(m_cache.bindBufferBase(GL_UNIFORM_BUFFER, 1, 5));
+    EXPECT_FALSE(m_cache.bindBuffer(GL_UNIFORM_BUFFER, 5));
+}
+
+TEST_F(StateCacheTests, BindBufferRange_AlwaysIssued)
+{
+    // Expect: the next base bind of the binding point is issued too
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferRange_mock(GL_SHADER_STORAGE_BUFFER, 0, 5, 256, 64)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferBase_mock(GL_SHADER_STORAGE_BUFFER, 0, 5)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_SHADER_STORAGE_BUFFER, 5)).Times(0);
+
+    // Act
+    m_cache.bindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 5);
+    m_cache.bindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, 5, 256, 64);
+    m_cache.bindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, 5, 256, 64);
+    EXPECT_TRUE(m_cache.bindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 5));
+    EXPECT_FALSE(m_cache.bindBuffer(GL_SHADER_STORAGE_BUFFER, 5));
+}
+
+TEST_F(StateCacheTests, BindVertexArray_SkipsBoundVertexArray)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindVertexArray_mock(6)).Times(1);
+
+    // Act
+    EXPECT_TRUE(m_cache.bindVertexArray(6));
+    EXPECT_FALSE(m_cache.bindVertexArray(6));
+}
+
+TEST_F(StateCacheTests, BindFramebuffer_SkipsBoundFramebuffer)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindFramebuffer_mock(GL_FRAMEBUFFER, 2)).Times(1);
+
+    // Act
+    EXPECT_TRUE(m_cache.bindFramebuffer(2));
+    EXPECT_FALSE(m_cache.bindFramebuffer(2));
+    m_cache.forgetFramebuffer(2);
+    EXPECT_FALSE(m_cache.bindFramebuffer(0));
+}
+
+TEST_F(StateCacheTests, BindTexture_ActivatesUnitOnlyWhenBinding)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glActiveTexture_mock(GL_TEXTURE0)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glActiveTexture_mock(GL_TEXTURE1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindTexture_mock(GL_TEXTURE_2D, 4)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindTexture_mock(GL_TEXTURE_2D, 5)).Times(1);
+
+    // Act
+    EXPECT_TRUE(m_cache.bindTexture(0, GL_TEXTURE_2D, 4));
+    EXPECT_FALSE(m_cache.bindTexture(0, GL_TEXTURE_2D, 4));
+    EXPECT_TRUE(m_cache.bindTexture(0, GL_TEXTURE_2D, 5));
+    EXPECT_TRUE(m_cache.bindTexture(1, GL_TEXTURE_2D, 4));
+    m_cache.forgetTexture(4);
+    EXPECT_FALSE(m_cache.bindTexture(1, GL_TEXTURE_2D, 0));
+}
+
+TEST_F(StateCacheTests, ForgetBuffer_RevertsBindingsToZero)
+{
+    // Expect: the deleted buffer is unbound by GL, binding 0 again is redundant
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_ARRAY_BUFFER, 7)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_ARRAY_BUFFER, 0)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferBase_mock(GL_UNIFORM_BUFFER, 0, 7)).Times(2);
+
+    // Act
+    m_cache.bindBuffer(GL_ARRAY_BUFFER, 7);
+    m_cache.bindBufferBase(GL_UNIFORM_BUFFER, 0, 7);
+    m_cache.forgetBuffer(7);
+    EXPECT_FALSE(m_cache.bindBuffer(GL_ARRAY_BUFFER, 0));
+    EXPECT_TRUE(m_cache.bindBuffer(GL_ARRAY_BUFFER, 7));
+    EXPECT_TRUE(m_cache.bindBufferBase(GL_UNIFORM_BUFFER, 0, 7));
+}
+
+TEST_F(StateCacheTests, ForgetProgram_NextUseIssued)
+{
+    // Expect: a new program may reuse the name of the deleted one
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUseProgram_mock(8)).Times(2);
+
+    // Act
+    m_cache.useProgram(8);
+    m_cache.forgetProgram(8);
+    EXPECT_TRUE(m_cache.useProgram(8));
+}
+
+TEST_F(StateCacheTests, Invalidate_ReissuesEveryBind)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUseProgram_mock(1)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_ARRAY_BUFFER, 2)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindVertexArray_mock(3)).Times(2);
+
+    // Act
+    m_cache.useProgram(1);
+    m_cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+    m_cache.bindVertexArray(3);
+    m_cache.invalidate();
+    m_cache.useProgram(1);
+    m_cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+    m_cache.bindVertexArray(3);
+
+    // Assert
+    EXPECT_EQ(m_cache.getIssued(), 6);
+    m_cache.resetStatistics();
+    EXPECT_EQ(m_cache.getIssued(), 0);
+    EXPECT_EQ(m_cache.getSkipped(), 0);
+}
+
+#endif
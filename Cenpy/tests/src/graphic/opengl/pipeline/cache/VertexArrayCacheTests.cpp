@@ -0,0 +1,129 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/cache/VertexArrayCache.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+namespace cache = cenpy::graphic::opengl::pipeline::cache;
+using cenpy::graphic::opengl::pipeline::vertex::OpenGLVertexLayout;
+using cenpy::test::utils::expectSpecificError;
+
+class VertexArrayCacheTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_passLayout.add("position", 3).add("uv", 2);
+        m_meshLayout.add("position", 3).add("normal", 3).add("uv", 2);
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenVertexArrays_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *vertexArray)
+                           { *vertexArray = ++m_lastVertexArray; });
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cache::OpenGLStateCache::current().invalidate();
+    }
+
+    OpenGLVertexLayout m_passLayout;
+    OpenGLVertexLayout m_meshLayout;
+    GLuint m_lastVertexArray = 0;
+};
+
+TEST_F(VertexArrayCacheTests, Get_BuildsFromMeshLayout)
+{
+    // Arrange
+    cache::OpenGLVertexArrayCache vertexArrays;
+
+    // Expect: the attributes of the pass are sourced from their offsets in the mesh vertices
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_ARRAY_BUFFER, 3)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_ELEMENT_ARRAY_BUFFER, 4)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glEnableVertexAttribArray_mock(0)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glEnableVertexAttribArray_mock(1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(0, 3, GL_FLOAT, GL_FALSE, 32, (void *)0)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(1, 2, GL_FLOAT, GL_FALSE, 32, (void *)24)).Times(1);
+
+    // Act
+    GLuint vertexArray = vertexArrays.get(m_passLayout, {m_meshLayout, 3, 4});
+
+    // Assert
+    ASSERT_EQ(vertexArray, 1);
+}
+
+TEST_F(VertexArrayCacheTests, Bind_BuiltOnceThenSingleBind)
+{
+    // Arrange
+    cache::OpenGLVertexArrayCache vertexArrays;
+
+    // Expect: one vertex array per mesh, each specified once
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenVertexArrays_mock(1, ::testing::_)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(4);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindVertexArray_mock(1)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindVertexArray_mock(2)).Times(2);
+
+    // Act: switch between two meshes
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        vertexArrays.bind(m_passLayout, {m_meshLayout, 3});
+        vertexArrays.bind(m_passLayout, {m_meshLayout, 5});
+    }
+
+    // Assert
+    ASSERT_EQ(vertexArrays.getVertexArraysCount(), 2);
+}
+
+TEST_F(VertexArrayCacheTests, Get_IntegerAndMatrixAttributes)
+{
+    // Arrange
+    cache::OpenGLVertexArrayCache vertexArrays;
+    OpenGLVertexLayout instance;
+    instance.add("model", 4, GL_FLOAT, false, 4).add("material", 1, GL_INT);
+
+    // Expect: a matrix takes a location per column, integers are not converted to floats
+    for (GLuint column = 0; column < 4; ++column)
+    {
+        EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(column, 4, GL_FLOAT, GL_FALSE, 68, reinterpret_cast<void *>(column * 16))).Times(1);
+    }
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribIPointer_mock(4, 1, GL_INT, 68, reinterpret_cast<void *>(64))).Times(1);
+
+    // Act
+    vertexArrays.get(instance, {instance, 3});
+}
+
+TEST_F(VertexArrayCacheTests, Get_MissingAttribute)
+{
+    // Arrange
+    cache::OpenGLVertexArrayCache vertexArrays;
+    OpenGLVertexLayout positions;
+    positions.add("position", 3);
+
+    // Act & Assert
+    expectSpecificError([&]()
+                        { vertexArrays.get(m_passLayout, {positions, 3}); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::VERTEX_LAYOUT::MISSING_ATTRIBUTE\nuv"));
+}
+
+TEST_F(VertexArrayCacheTests, ForgetBuffer_DeletesItsVertexArrays)
+{
+    // Arrange
+    cache::OpenGLVertexArrayCache vertexArrays;
+    vertexArrays.get(m_passLayout, {m_meshLayout, 3});
+    vertexArrays.get(m_passLayout, {m_meshLayout, 5});
+
+    // Expect: the other vertex array is deleted with the cache
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteVertexArrays_mock(1, ::testing::Pointee(1))).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteVertexArrays_mock(1, ::testing::Pointee(2))).Times(1);
+
+    // Act
+    vertexArrays.forgetBuffer(3);
+
+    // Assert
+    ASSERT_EQ(vertexArrays.getVertexArraysCount(), 1);
+}
+
+#endif // __mock_gl__
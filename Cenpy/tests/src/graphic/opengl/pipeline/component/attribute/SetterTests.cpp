@@ -3,6 +3,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <memory>
+#include <array>
+#include <cstring>
+#include <span>
 #include <opengl/glFunctionMock.hpp>
 #include <graphic/Api.hpp>
 #include <graphic/opengl/context/AttributeContext.hpp>
@@ -23,6 +26,19 @@ protected:
     void TearDown() override
     {
         mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+
+    static std::shared_ptr<context::OpenGLAttributeContext> makeAttribute(GLenum usage, GLenum type = GL_FLOAT_VEC3)
+    {
+        auto attribute = std::make_shared<context::OpenGLAttributeContext>();
+        attribute->setBufferID(1);
+        attribute->setGLUsage(usage);
+        attribute->setAttributeID(2);
+        // As glGetActiveAttrib reports them: the array size, and the GLSL type rather than the component type
+        attribute->setGLSize(1);
+        attribute->setGLType(type);
+        return attribute;
     }
 };
 
@@ -36,7 +52,7 @@ TEST_F(AttributeSetterTests, SetAttributeTest_CallBufferData)
     attribute->setValue(attrValue);
 
     // Expected call
-    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_ARRAY_BUFFER, sizeof(attrValue.get()), attrValue.get(), GL_STATIC_DRAW))
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_ARRAY_BUFFER, sizeof(float), attrValue.get(), GL_STATIC_DRAW))
         .Times(1);
 
     // Act
@@ -51,12 +67,12 @@ TEST_F(AttributeSetterTests, SetAttributeTest_CallVertexAttribPointer)
     attribute->setGLUsage(GL_STATIC_DRAW);
     attribute->setAttributeID(1);
     attribute->setGLSize(1);
-    attribute->setGLType(GL_FLOAT);
+    attribute->setGLType(GL_FLOAT); // A float attribute is reflected as GL_FLOAT
     std::shared_ptr<float> attrValue = std::make_shared<float>(1.0f);
     attribute->setValue(attrValue);
 
     // Expected call
-    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(1, 1, GL_FLOAT, GL_FALSE, sizeof(attrValue.get()), (void *)nullptr))
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(1, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void *)nullptr))
         .Times(1);
 
     // Act
@@ -82,4 +98,130 @@ TEST_F(AttributeSetterTests, SetAttributeTest_ThrowExceptionWhenBufferIsNotSet)
                                             cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::ATTRIBUTE::SET::BUFFER_ID_NOT_SET"));
 }
 
+TEST_F(AttributeSetterTests, SetAttributeTest_SpanUploadsEveryVertex)
+{
+    // Arrange
+    auto attribute = makeAttribute(GL_STATIC_DRAW);
+    std::array<std::array<float, 3>, 4> positions{};
+    attribute->setValues(std::span<const std::array<float, 3>>(positions));
+
+    // Expected call
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_ARRAY_BUFFER, sizeof(positions), positions.data(), GL_STATIC_DRAW)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(2, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)nullptr)).Times(1);
+
+    // Act
+    attribute::OpenGLSetter<std::array<float, 3>>::on(attribute);
+
+    // Assert
+    ASSERT_EQ(attribute->getCapacity(), sizeof(positions));
+}
+
+TEST_F(AttributeSetterTests, SetAttributeTest_MatrixSourcesEveryColumn)
+{
+    // Arrange
+    auto attribute = makeAttribute(GL_STATIC_DRAW, GL_FLOAT_MAT4);
+    std::array<std::array<float, 16>, 2> transforms{};
+    attribute->setValues(std::span<const std::array<float, 16>>(transforms));
+
+    // Expected call: a location of 4 floats per column
+    for (GLuint column = 0; column < 4; ++column)
+    {
+        EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(2 + column, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(float), reinterpret_cast<void *>(column * 4 * sizeof(float))))
+            .Times(1);
+    }
+
+    // Act
+    attribute::OpenGLSetter<std::array<float, 16>>::on(attribute);
+}
+
+TEST_F(AttributeSetterTests, SetAttributeTest_IntegerAttribute)
+{
+    // Arrange
+    auto attribute = makeAttribute(GL_STATIC_DRAW, GL_INT_VEC2);
+    std::array<std::array<GLint, 2>, 3> indices{};
+    attribute->setValues(std::span<const std::array<GLint, 2>>(indices));
+
+    // Expected call: integers are not converted to floats
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribIPointer_mock(2, 2, GL_INT, 2 * sizeof(GLint), (void *)nullptr)).Times(1);
+
+    // Act
+    attribute::OpenGLSetter<std::array<GLint, 2>>::on(attribute);
+}
+
+TEST_F(AttributeSetterTests, SetAttributeTest_UnsupportedType)
+{
+    // Arrange
+    auto attribute = makeAttribute(GL_STATIC_DRAW, GL_SAMPLER_2D);
+    std::array<float, 1> values{};
+    attribute->setValues(std::span<const float>(values));
+
+    // Act & Assert
+    expectSpecificError<std::runtime_error>([&]()
+                                            { attribute::OpenGLSetter<float>::on(attribute); },
+                                            cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::VERTEX_LAYOUT::UNSUPPORTED_TYPE"));
+}
+
+TEST_F(AttributeSetterTests, SetAttributeTest_StaticUpdateInPlace)
+{
+    // Arrange
+    auto attribute = makeAttribute(GL_STATIC_DRAW, GL_FLOAT);
+    attribute->setCapacity(64);
+    std::array<float, 6> values{};
+    attribute->setValues(std::span<const float>(values));
+
+    // Expected call: the storage is reused, not reallocated
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_ARRAY_BUFFER, 0, sizeof(values), values.data())).Times(1);
+
+    // Act
+    attribute::OpenGLSetter<float>::on(attribute);
+}
+
+TEST_F(AttributeSetterTests, SetAttributeTest_DynamicUpdateOrphans)
+{
+    // Arrange
+    auto attribute = makeAttribute(GL_DYNAMIC_DRAW, GL_FLOAT);
+    attribute->setCapacity(64);
+    std::array<float, 6> values{};
+    attribute->setValues(std::span<const float>(values));
+
+    // Expected call
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_ARRAY_BUFFER, 64, nullptr, GL_DYNAMIC_DRAW)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_ARRAY_BUFFER, 0, sizeof(values), values.data())).Times(1);
+
+    // Act
+    attribute::OpenGLSetter<float>::on(attribute);
+}
+
+TEST_F(AttributeSetterTests, SetAttributeTest_StreamingRing)
+{
+    // Arrange
+    std::array<std::byte, 3 * 64> mapped{};
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_ARB_buffer_storage"))).WillOnce(::testing::Return(GL_TRUE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenBuffers_mock(1, ::testing::_)).WillOnce(::testing::SetArgPointee<1>(9));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMapBufferRange_mock(GL_ARRAY_BUFFER, 0, mapped.size(), ::testing::_)).WillOnce(::testing::Return(mapped.data()));
+    auto ring = std::make_shared<cenpy::graphic::opengl::pipeline::buffer::OpenGLStreamingRing>(GL_ARRAY_BUFFER, 64);
+    auto attribute = makeAttribute(GL_STREAM_DRAW);
+    attribute->setStreamingRing(ring);
+    std::array<float, 3> first{1.0f, 2.0f, 3.0f};
+    std::array<float, 3> second{4.0f, 5.0f, 6.0f};
+
+    // Expected call: written to the mapping, nothing uploaded
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(2, 3, GL_FLOAT, GL_FALSE, sizeof(first), (void *)0)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glVertexAttribPointer_mock(2, 3, GL_FLOAT, GL_FALSE, sizeof(first), (void *)sizeof(first))).Times(1);
+
+    // Act
+    attribute->setValues(std::span<const std::array<float, 3>>(&first, 1));
+    attribute::OpenGLSetter<std::array<float, 3>>::on(attribute);
+    attribute->setValues(std::span<const std::array<float, 3>>(&second, 1));
+    attribute::OpenGLSetter<std::array<float, 3>>::on(attribute);
+
+    // Assert
+    ASSERT_EQ(std::memcmp(mapped.data() + sizeof(first), second.data(), sizeof(second)), 0);
+}
+
 #endif // __mock_gl__
\ No newline at end of file
@@ -23,6 +23,7 @@ protected:
     void TearDown() override
     {
         mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
     }
 };
 
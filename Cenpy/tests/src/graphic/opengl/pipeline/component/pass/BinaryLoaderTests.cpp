@@ -0,0 +1,66 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <filesystem>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/pipeline/component/uniform/MockSetter.hpp>
+#include <graphic/opengl/profile/Pass.hpp>
+#include <graphic/opengl/pipeline/component/pass/BinaryLoader.hpp>
+#include <TestUtils.hpp>
+
+namespace context = cenpy::graphic::opengl::context;
+namespace pass = cenpy::graphic::opengl::pipeline::component::pass;
+namespace cache = cenpy::graphic::opengl::pipeline::cache;
+namespace mock = cenpy::mock;
+using cenpy::graphic::opengl::profile::Pass::Classic;
+using cenpy::test::utils::expectSpecificError;
+
+class BinaryLoaderTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+    }
+};
+
+TEST_F(BinaryLoaderTests, LoadBinary_NoCache)
+{
+    // Arrange
+    auto openglContext = std::make_shared<context::OpenGLPassContext>();
+
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCreateProgram_mock()).Times(0);
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLPassBinaryLoader<Classic>::on(openglContext));
+
+    // Assert
+    ASSERT_FALSE(openglContext->isLoadedFromBinary());
+}
+
+TEST_F(BinaryLoaderTests, LoadBinary_CacheMiss)
+{
+    // Arrange
+    auto openglContext = std::make_shared<context::OpenGLPassContext>();
+    auto binaryCache = std::make_shared<cache::OpenGLProgramBinaryCache>(std::filesystem::temp_directory_path() / "cenpy-binary-loader-missing");
+    openglContext->setProgramBinaryCache(binaryCache);
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLPassBinaryLoader<Classic>::on(openglContext));
+
+    // Assert
+    ASSERT_FALSE(openglContext->isLoadedFromBinary());
+    ASSERT_EQ(binaryCache->getMisses(), 1);
+}
+
+TEST_F(BinaryLoaderTests, LoadBinary_NullContext)
+{
+    expectSpecificError([]()
+                        { pass::OpenGLPassBinaryLoader<Classic>::on(nullptr); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::PASS::NON_OPENGL_CONTEXT"));
+}
+
+#endif // __mock_gl__
@@ -24,6 +24,7 @@ protected:
     void TearDown() override
     {
         mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
     }
 };
 
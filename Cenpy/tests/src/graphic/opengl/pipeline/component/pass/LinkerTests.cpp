@@ -0,0 +1,83 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/MockApi.hpp>
+#include <graphic/opengl/context/ParallelCompile.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/profile/Pass.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockShaderAttacher.hpp>
+#include <graphic/opengl/pipeline/component/pass/Linker.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+namespace context = cenpy::graphic::opengl::context;
+namespace pass = cenpy::graphic::opengl::pipeline::component::pass;
+
+using cenpy::graphic::opengl::profile::Pass::Classic;
+using cenpy::test::utils::expectSpecificError;
+
+class LinkerTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        context::forgetParallelShaderCompile();
+    }
+
+    void TearDown() override
+    {
+        context::forgetParallelShaderCompile();
+        mock::opengl::glFunctionMock::reset();
+    }
+};
+
+TEST_F(LinkerTests, LinkPassTest_submitsWithoutWaiting)
+{
+    // Arrange
+    auto openglContext = std::make_shared<context::OpenGLPassContext>();
+
+    // Expect calls: the link status would make the driver finish the link
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glLinkProgram_mock(1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(::testing::_, ::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMaxShaderCompilerThreadsKHR_mock(::testing::_)).Times(0);
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLLinker<Classic>::on(openglContext));
+
+    // Assert
+    ASSERT_EQ(openglContext->getPassID(), 1);
+    ASSERT_FALSE(openglContext->isParallelCompile());
+}
+
+TEST_F(LinkerTests, LinkPassTest_parallelCompile)
+{
+    // Arrange
+    auto openglContext = std::make_shared<context::OpenGLPassContext>();
+    auto otherContext = std::make_shared<context::OpenGLPassContext>();
+
+    // The extension is queried and the compiler threads are set when the context is created, not for each pass.
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_KHR_parallel_shader_compile")))
+        .WillOnce(::testing::Return(GL_TRUE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMaxShaderCompilerThreadsKHR_mock(::testing::_)).Times(1);
+    ASSERT_TRUE(context::enableParallelShaderCompile());
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLLinker<Classic>::on(openglContext));
+    ASSERT_NO_THROW(pass::OpenGLLinker<Classic>::on(otherContext));
+
+    // Assert
+    ASSERT_TRUE(openglContext->isParallelCompile());
+    ASSERT_TRUE(otherContext->isParallelCompile());
+}
+
+TEST_F(LinkerTests, LinkPassTest_nullContext)
+{
+    expectSpecificError([]()
+                        { pass::OpenGLLinker<Classic>::on(nullptr); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::NON_OPENGL_CONTEXT")));
+}
+
+#endif // __mock_gl__
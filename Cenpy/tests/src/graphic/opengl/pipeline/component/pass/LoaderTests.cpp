@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <memory>
+#include <filesystem>
 #include <opengl/glFunctionMock.hpp>
 #include <graphic/MockApi.hpp>
 #include <graphic/opengl/context/PassContext.hpp>
@@ -65,6 +66,29 @@ TEST_F(LoaderTests, LoadPassTest_linkPipeline)
     ASSERT_NO_THROW(pass::OpenGLLoader<Classic>::on(openglContext));
 }
 
+TEST_F(LoaderTests, LoadPassTest_storeBinary)
+{
+    // Arrange
+    auto directory = std::filesystem::temp_directory_path() / "cenpy-loader-store-binary";
+    std::filesystem::remove_all(directory);
+    auto openglContext = std::make_shared<context::OpenGLPassContext>();
+    auto binaryCache = std::make_shared<cenpy::graphic::opengl::pipeline::cache::OpenGLProgramBinaryCache>(directory);
+    openglContext->setProgramBinaryCache(binaryCache);
+
+    // Expect the binary to be made retrievable before linking, then read back
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glProgramParameteri_mock(1, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glLinkProgram_mock(1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramBinary_mock(1, ::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLLoader<Classic>::on(openglContext));
+
+    // Assert
+    ASSERT_EQ(binaryCache->getStores(), 1);
+    std::filesystem::remove_all(directory);
+}
+
 TEST_F(LoaderTests, LoadPassTest_nullContext)
 {
     // Arrange
@@ -0,0 +1,106 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/MockApi.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/profile/Pass.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockShaderAttacher.hpp>
+#include <graphic/opengl/pipeline/component/pass/Poller.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+namespace context = cenpy::graphic::opengl::context;
+namespace pass = cenpy::graphic::opengl::pipeline::component::pass;
+
+using cenpy::graphic::context::PassLoadState;
+using cenpy::graphic::opengl::profile::Pass::Classic;
+using cenpy::test::utils::expectSpecificError;
+
+class PollerTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_openglContext = std::make_shared<context::OpenGLPassContext>();
+        m_openglContext->setPassID(1);
+        m_openglContext->setLoadState(PassLoadState::PENDING);
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+    }
+
+protected:
+    std::shared_ptr<context::OpenGLPassContext> m_openglContext;
+};
+
+TEST_F(PollerTests, PollPassTest_stillCompiling)
+{
+    // Arrange
+    m_openglContext->setParallelCompile(true);
+
+    // Expect calls: the link status is not asked while the driver is busy
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_COMPLETION_STATUS_KHR, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(GL_FALSE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_LINK_STATUS, ::testing::_)).Times(0);
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLPassPoller<Classic>::on(m_openglContext));
+
+    // Assert
+    ASSERT_EQ(m_openglContext->getLoadState(), PassLoadState::PENDING);
+}
+
+TEST_F(PollerTests, PollPassTest_completed)
+{
+    // Arrange
+    m_openglContext->setParallelCompile(true);
+
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_COMPLETION_STATUS_KHR, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(GL_TRUE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_LINK_STATUS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(GL_TRUE));
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLPassPoller<Classic>::on(m_openglContext));
+
+    // Assert
+    ASSERT_EQ(m_openglContext->getLoadState(), PassLoadState::READY);
+}
+
+TEST_F(PollerTests, PollPassTest_withoutParallelCompile)
+{
+    // Expect calls: without the extension the completion status cannot be asked
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_COMPLETION_STATUS_KHR, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_LINK_STATUS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(GL_TRUE));
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLPassPoller<Classic>::on(m_openglContext));
+
+    // Assert
+    ASSERT_EQ(m_openglContext->getLoadState(), PassLoadState::READY);
+}
+
+TEST_F(PollerTests, PollPassTest_linkFailed)
+{
+    // Arrange
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_LINK_STATUS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(GL_FALSE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_INFO_LOG_LENGTH, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(1));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteProgram_mock(1)).Times(1);
+
+    // Act & Assert
+    expectSpecificError([this]()
+                        { pass::OpenGLPassPoller<Classic>::on(m_openglContext); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::LINK_FAILED")));
+    ASSERT_EQ(m_openglContext->getPassID(), 0);
+    ASSERT_EQ(m_openglContext->getLoadState(), PassLoadState::UNLOADED);
+}
+
+#endif // __mock_gl__
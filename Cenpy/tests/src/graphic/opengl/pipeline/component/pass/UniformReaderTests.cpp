@@ -38,6 +38,8 @@ TEST_F(UniformReaderTests, ReadUniforms_ValidContext)
     GLint numUniforms = 1; // For example, 2 uniforms
     EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_ACTIVE_UNIFORMS, ::testing::_))
         .WillOnce(::testing::SetArgPointee<2>(numUniforms));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_ACTIVE_UNIFORM_BLOCKS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(0));
 
     // Mock calls to glGetActiveUniform and glGetUniformLocation for each uniform
     EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetActiveUniform_mock(1, 0, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(1);
@@ -52,6 +54,35 @@ TEST_F(UniformReaderTests, ReadUniforms_ValidContext)
     ASSERT_TRUE(openglContext->getUniforms().contains(mock::opengl::glFunctionMock::UNIFORM_NAME));
 }
 
+TEST_F(UniformReaderTests, ReadUniforms_UniformBlock)
+{
+    // Arrange
+    auto openglContext = std::make_shared<context::OpenGLPassContext>();
+    openglContext->setPassID(1);
+
+    // One uniform, member of the only block
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_ACTIVE_UNIFORMS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(1));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_ACTIVE_UNIFORM_BLOCKS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(1));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetActiveUniformsiv_mock(1, 1, ::testing::_, GL_UNIFORM_BLOCK_INDEX, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<4>(0));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetUniformLocation_mock(::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetActiveUniformBlockiv_mock(1, 0, GL_UNIFORM_BLOCK_DATA_SIZE, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<3>(64));
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLPassUniformReader<Classic>::on(openglContext));
+
+    // Assert
+    ASSERT_TRUE(openglContext->getUniforms().empty());
+    auto *block = openglContext->getUniformBlock(mock::opengl::glFunctionMock::UNIFORM_BLOCK_NAME);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(block->index, 0);
+    ASSERT_EQ(block->dataSize, 64);
+    ASSERT_EQ(block->binding, GL_INVALID_INDEX);
+}
+
 TEST_F(UniformReaderTests, ReadUniforms_NullContext)
 {
     // Arrange
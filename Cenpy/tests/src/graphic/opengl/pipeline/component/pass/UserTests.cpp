@@ -8,6 +8,8 @@
 #include <graphic/opengl/pipeline/component/uniform/MockSetter.hpp>
 #include <graphic/opengl/validator/Validator.hpp>
 #include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/context/UniformContext.hpp>
+#include <graphic/opengl/pipeline/component/uniform/Setter.hpp>
 #include <graphic/opengl/profile/Pass.hpp>
 #include <graphic/opengl/pipeline/component/pass/User.hpp>
 #include <TestUtils.hpp>
@@ -24,6 +26,7 @@ protected:
     void TearDown() override
     {
         mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
     }
 };
 
@@ -42,6 +45,46 @@ TEST_F(UserTests, UsePass_ValidContext)
     // Additional validations can be performed here if necessary
 }
 
+TEST_F(UserTests, UsePass_CurrentProgramNotRebound)
+{
+    // Arrange
+    auto openglContext = std::make_shared<context::OpenGLPassContext>();
+    openglContext->setPassID(3);
+
+    // Expect: the program stays current between the two uses
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUseProgram_mock(3)).Times(1);
+
+    // Act
+    pass::OpenGLPassUser<Classic>::on(openglContext);
+    pass::OpenGLPassUser<Classic>::on(openglContext);
+}
+
+TEST_F(UserTests, UsePass_CommitsStagedUniforms)
+{
+    // Arrange
+    auto openglContext = std::make_shared<context::OpenGLPassContext>();
+    openglContext->setPassID(1);
+    auto uniformContext = std::make_shared<context::OpenGLUniformContext>();
+    uniformContext->setUniformID(7);
+    auto uniform = std::make_shared<cenpy::graphic::pipeline::Uniform<cenpy::graphic::api::OpenGL>>(uniformContext);
+    openglContext->addUniform("time", uniform);
+    auto handle = openglContext->getUniformHandle("time");
+    ASSERT_TRUE(uniform->stage(2.0f));
+    openglContext->markUniformPending(handle);
+
+    // Expect the program to be bound before the staged value is uploaded, and both to happen once
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUseProgram_mock(1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniform1f_mock(7, 2.0f)).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLPassUser<Classic>::on(openglContext));
+    ASSERT_NO_THROW(pass::OpenGLPassUser<Classic>::on(openglContext));
+
+    // Assert
+    ASSERT_EQ(openglContext->getPendingUniformsCount(), 0);
+}
+
 TEST_F(UserTests, UsePass_NullContext)
 {
     // Arrange
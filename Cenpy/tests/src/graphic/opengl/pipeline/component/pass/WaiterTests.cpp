@@ -0,0 +1,82 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/MockApi.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/profile/Pass.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockShaderAttacher.hpp>
+#include <graphic/opengl/pipeline/component/pass/Waiter.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+namespace context = cenpy::graphic::opengl::context;
+namespace pass = cenpy::graphic::opengl::pipeline::component::pass;
+
+using cenpy::graphic::context::PassLoadState;
+using cenpy::graphic::opengl::profile::Pass::Classic;
+using cenpy::test::utils::expectSpecificError;
+
+class WaiterTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_openglContext = std::make_shared<context::OpenGLPassContext>();
+        m_openglContext->setPassID(1);
+        m_openglContext->setLoadState(PassLoadState::PENDING);
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+    }
+
+protected:
+    std::shared_ptr<context::OpenGLPassContext> m_openglContext;
+};
+
+TEST_F(WaiterTests, WaitPassTest_parallelCompile)
+{
+    // Arrange
+    m_openglContext->setParallelCompile(true);
+
+    // Expect calls: the link status is asked at once, which blocks until the link is complete
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_COMPLETION_STATUS_KHR, ::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_LINK_STATUS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(GL_TRUE));
+
+    // Act
+    ASSERT_NO_THROW(pass::OpenGLPassWaiter<Classic>::on(m_openglContext));
+
+    // Assert
+    ASSERT_EQ(m_openglContext->getLoadState(), PassLoadState::READY);
+}
+
+TEST_F(WaiterTests, WaitPassTest_linkFailed)
+{
+    // Arrange
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_LINK_STATUS, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(GL_FALSE));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetProgramiv_mock(1, GL_INFO_LOG_LENGTH, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<2>(1));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteProgram_mock(1)).Times(1);
+
+    // Act & Assert
+    expectSpecificError([this]()
+                        { pass::OpenGLPassWaiter<Classic>::on(m_openglContext); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::LINK_FAILED")));
+    ASSERT_EQ(m_openglContext->getPassID(), 0);
+    ASSERT_EQ(m_openglContext->getLoadState(), PassLoadState::UNLOADED);
+}
+
+TEST_F(WaiterTests, WaitPassTest_nullContext)
+{
+    expectSpecificError([]()
+                        { pass::OpenGLPassWaiter<Classic>::on(nullptr); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::PROGRAM::NON_OPENGL_CONTEXT")));
+}
+
+#endif // __mock_gl__
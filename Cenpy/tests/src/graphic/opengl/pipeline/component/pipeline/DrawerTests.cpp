@@ -0,0 +1,219 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <array>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/context/PipelineContext.hpp>
+#include <graphic/opengl/profile/Pipeline.hpp>
+#include <graphic/opengl/pipeline/component/pipeline/Drawer.hpp>
+#include <graphic/render/RenderQueue.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+namespace render = cenpy::graphic::render;
+using cenpy::graphic::opengl::context::OpenGLPipelineContext;
+using cenpy::graphic::opengl::pipeline::component::pipeline::OpenGLPipelineDrawer;
+using cenpy::graphic::opengl::profile::Pipeline::Classic;
+using cenpy::graphic::opengl::profile::Pipeline::Indirect;
+using cenpy::test::utils::expectSpecificError;
+
+class DrawerTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+};
+
+TEST_F(DrawerTests, Draw_IndexedCommand)
+{
+    // Arrange
+    auto context = std::make_shared<OpenGLPipelineContext>();
+    render::RenderCommand command;
+    command.vertexArray = 4;
+    command.texture = 9;
+    command.first = 6;
+    command.count = 12;
+    command.indexed = true;
+    context->setCurrentCommands({&command, 1});
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindTexture_mock(GL_TEXTURE_2D, 9)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindVertexArray_mock(4)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawElements_mock(GL_TRIANGLES, 12, GL_UNSIGNED_INT, reinterpret_cast<const void *>(6 * sizeof(GLuint)))).Times(1);
+
+    // Act
+    OpenGLPipelineDrawer<Classic>::on(context);
+}
+
+TEST_F(DrawerTests, Draw_SharedStateBoundOnce)
+{
+    // Arrange
+    auto context = std::make_shared<OpenGLPipelineContext>();
+    std::array<render::RenderCommand, 2> commands;
+    commands[0].vertexArray = 2;
+    commands[0].texture = 5;
+    commands[0].count = 3;
+    commands[0].primitive = render::Primitive::TRIANGLE_STRIP;
+    commands[1] = commands[0];
+    commands[1].first = 3;
+    context->setCurrentCommands(commands);
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindTexture_mock(GL_TEXTURE_2D, 5)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindVertexArray_mock(2)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawArrays_mock(GL_TRIANGLE_STRIP, 0, 3)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawArrays_mock(GL_TRIANGLE_STRIP, 3, 3)).Times(1);
+
+    // Act
+    OpenGLPipelineDrawer<Classic>::on(context);
+}
+
+TEST_F(DrawerTests, Draw_InstancedCommand)
+{
+    // Arrange
+    auto context = std::make_shared<OpenGLPipelineContext>();
+    render::RenderCommand first;
+    first.vertexArray = 3;
+    first.count = 6;
+    first.indexed = true;
+    first.instanceCount = 20;
+    render::RenderCommand second = first;
+    second.instanceCount = 5;
+    second.firstInstance = 20;
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawElementsInstanced_mock(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, 20)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawElementsInstancedBaseInstance_mock(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, 5, 20)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawElements_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    // Act
+    context->setCurrentCommands({&first, 1});
+    OpenGLPipelineDrawer<Classic>::on(context);
+    context->setCurrentCommands({&second, 1});
+    OpenGLPipelineDrawer<Classic>::on(context);
+}
+
+TEST_F(DrawerTests, Draw_InstancedArrays)
+{
+    // Arrange
+    auto context = std::make_shared<OpenGLPipelineContext>();
+    render::RenderCommand command;
+    command.vertexArray = 3;
+    command.count = 4;
+    command.primitive = render::Primitive::TRIANGLE_STRIP;
+    command.instanceCount = 8;
+    command.firstInstance = 2;
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawArraysInstancedBaseInstance_mock(GL_TRIANGLE_STRIP, 0, 4, 8, 2)).Times(1);
+
+    // Act
+    context->setCurrentCommands({&command, 1});
+    OpenGLPipelineDrawer<Classic>::on(context);
+}
+
+TEST_F(DrawerTests, Draw_BaseVertex)
+{
+    // Arrange
+    auto context = std::make_shared<OpenGLPipelineContext>();
+    render::RenderCommand command;
+    command.vertexArray = 3;
+    command.count = 36;
+    command.indexed = true;
+    command.baseVertex = 24;
+    context->setCurrentCommands({&command, 1});
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawElementsInstancedBaseVertex_mock(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr, 1, 24)).Times(1);
+
+    // Act
+    OpenGLPipelineDrawer<Classic>::on(context);
+}
+
+TEST_F(DrawerTests, DrawIndirect_OneMultiDrawPerBatch)
+{
+    // Arrange
+    ON_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StartsWith("GL_ARB_"))).WillByDefault(::testing::Return(GL_TRUE));
+    auto context = std::make_shared<OpenGLPipelineContext>();
+    std::array<render::RenderCommand, 3> commands;
+    for (std::size_t index = 0; index < commands.size(); ++index)
+    {
+        commands[index].vertexArray = 4;
+        commands[index].count = 6 * static_cast<std::uint32_t>(index + 1);
+        commands[index].indexed = true;
+    }
+    commands[2].texture = 7;
+    context->setCurrentCommands(commands);
+
+    // Expect: meshes of the shared vertex array are drawn by one call, the texture change splits
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMultiDrawElementsIndirect_mock(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, 2, 0)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMultiDrawElementsIndirect_mock(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void *>(2 * 5 * sizeof(GLuint)), 1, 0)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindVertexArray_mock(4)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferRange_mock(GL_SHADER_STORAGE_BUFFER, 0, ::testing::_, ::testing::_, ::testing::_)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawElements_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    // Act
+    OpenGLPipelineDrawer<Indirect>::on(context);
+
+    // Assert
+    EXPECT_NE(context->getIndirectBuffer(), nullptr);
+}
+
+TEST_F(DrawerTests, DrawIndirect_Arrays)
+{
+    // Arrange
+    ON_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StartsWith("GL_ARB_"))).WillByDefault(::testing::Return(GL_TRUE));
+    auto context = std::make_shared<OpenGLPipelineContext>();
+    std::array<render::RenderCommand, 2> commands;
+    commands[0].vertexArray = 4;
+    commands[0].count = 3;
+    commands[0].primitive = render::Primitive::LINES;
+    commands[1] = commands[0];
+    commands[1].first = 3;
+    context->setCurrentCommands(commands);
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMultiDrawArraysIndirect_mock(GL_LINES, nullptr, 2, 0)).Times(1);
+
+    // Act
+    OpenGLPipelineDrawer<Indirect>::on(context);
+}
+
+TEST_F(DrawerTests, DrawIndirect_NotSupported)
+{
+    // Arrange
+    ON_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StartsWith("GL_ARB_"))).WillByDefault(::testing::Return(GL_FALSE));
+    auto context = std::make_shared<OpenGLPipelineContext>();
+    render::RenderCommand command;
+    context->setCurrentCommands({&command, 1});
+
+    // Act & Assert
+    expectSpecificError([&context]()
+                        { OpenGLPipelineDrawer<Indirect>::on(context); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::BUFFER::INDIRECT_NOT_SUPPORTED"));
+}
+
+TEST_F(DrawerTests, Draw_NoCurrentCommand)
+{
+    // Arrange
+    auto context = std::make_shared<OpenGLPipelineContext>();
+
+    // Act & Assert
+    expectSpecificError([&context]()
+                        { OpenGLPipelineDrawer<Classic>::on(context); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::RENDER_QUEUE::NO_CURRENT_COMMAND"));
+}
+
+TEST_F(DrawerTests, Draw_NullContext)
+{
+    expectSpecificError([]()
+                        { OpenGLPipelineDrawer<Classic>::on(nullptr); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::SHADER::NON_VALID_CONTEXT"));
+}
+
+#endif // __mock_gl__
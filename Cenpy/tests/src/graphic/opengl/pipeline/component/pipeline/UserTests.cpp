@@ -1,12 +1,19 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <memory>
+#include <opengl/glFunctionMock.hpp>
 #include <graphic/pipeline/MockPass.hpp>
 
 #include <graphic/opengl/validator/Validator.hpp>
 
 #include <graphic/opengl/profile/Pipeline.hpp>
 #include <graphic/opengl/pipeline/component/pipeline/User.hpp>
+#include <graphic/opengl/pipeline/component/uniform/Setter.hpp>
+#include <graphic/opengl/pipeline/component/uniformblock/Loader.hpp>
+#include <graphic/opengl/pipeline/component/uniformblock/Updater.hpp>
+#include <graphic/opengl/pipeline/component/uniformblock/Binder.hpp>
+#include <graphic/opengl/pipeline/component/uniformblock/Freer.hpp>
+#include <graphic/pipeline/UniformBlock.hpp>
 #include <graphic/Api.hpp>
 #include <TestUtils.hpp>
 
@@ -15,14 +22,21 @@ namespace api = cenpy::graphic::api;
 
 using cenpy::graphic::opengl::pipeline::component::pipeline::OpenGLPipelineUser;
 using cenpy::graphic::opengl::profile::Pipeline::Classic;
+using cenpy::graphic::pipeline::UniformBlock;
+namespace profile = cenpy::graphic::opengl::profile;
 using cenpy::mock::graphic::pipeline::opengl::MockPass;
 using cenpy::test::utils::expectSpecificError;
 
-class UserTests : public ::testing::Test
+class PipelineUserTests : public ::testing::Test
 {
+protected:
+    void TearDown() override
+    {
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
 };
 
-TEST_F(UserTests, useProgram_ValidContext)
+TEST_F(PipelineUserTests, useProgram_ValidContext)
 {
     // Arrange
     auto context = std::make_shared<context::OpenGLPipelineContext>();
@@ -37,11 +51,82 @@ TEST_F(UserTests, useProgram_ValidContext)
     OpenGLPipelineUser<Classic>::on(context);
 }
 
-TEST_F(UserTests, useProgram_NullContext)
+TEST_F(PipelineUserTests, useProgram_NullContext)
 {
     // Arrange
     // Act & Assert
     expectSpecificError([]()
                         { OpenGLPipelineUser<Classic>::on(nullptr); },
                         cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::SHADER::NON_VALID_CONTEXT")));
-}
\ No newline at end of file
+}
+
+#ifdef __mock_gl__
+
+TEST_F(PipelineUserTests, useProgram_SharedUniformBlock)
+{
+    // Arrange
+    namespace mock = cenpy::mock;
+    auto context = std::make_shared<context::OpenGLPipelineContext>();
+    auto first = std::make_shared<MockPass<api::OpenGL>>();
+    auto second = std::make_shared<MockPass<api::OpenGL>>();
+    first->getContext()->setPassID(1);
+    first->getContext()->addUniformBlock("Frame", 0, 16);
+    second->getContext()->setPassID(2);
+    second->getContext()->addUniformBlock("Frame", 1, 16);
+    context->addPass(first);
+    context->addPass(second);
+    auto block = std::make_shared<UniformBlock<api::OpenGL, profile::UniformBlock::Classic>>("Frame", 2, std::initializer_list<cenpy::graphic::context::UniformBlockMember>{{"time", GL_FLOAT}});
+    context->addUniformBlock(block);
+
+    // Expect: one upload per frame, one bind as the block stays bound, and one glUniformBlockBinding per program
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenBuffers_mock(1, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<1>(42));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_UNIFORM_BUFFER, 16, ::testing::_, GL_DYNAMIC_DRAW)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_UNIFORM_BUFFER, 0, 4, ::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferBase_mock(GL_UNIFORM_BUFFER, 2, 42)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniformBlockBinding_mock(1, 0, 2)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniformBlockBinding_mock(2, 1, 2)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteBuffers_mock(1, ::testing::_)).Times(1);
+    EXPECT_CALL(*first, use()).Times(2);
+    EXPECT_CALL(*second, use()).Times(2);
+
+    // Act: two frames, the time changes in between
+    for (float time : {0.0f, 1.0f})
+    {
+        block->set("time", time);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            context->setCurrentPass(pass);
+            OpenGLPipelineUser<Classic>::on(context);
+        }
+    }
+    block.reset();
+    context.reset();
+    mock::opengl::glFunctionMock::reset();
+}
+
+TEST_F(PipelineUserTests, useProgram_UniformBlockLayoutMismatch)
+{
+    // Arrange
+    namespace mock = cenpy::mock;
+    auto context = std::make_shared<context::OpenGLPipelineContext>();
+    context->setCurrentPass(0);
+    auto pass = std::make_shared<MockPass<api::OpenGL>>();
+    pass->getContext()->setPassID(1);
+    pass->getContext()->addUniformBlock("Frame", 0, 32);
+    context->addPass(pass);
+    auto block = std::make_shared<UniformBlock<api::OpenGL, profile::UniformBlock::Classic>>("Frame", 0, std::initializer_list<cenpy::graphic::context::UniformBlockMember>{{"time", GL_FLOAT}});
+    context->addUniformBlock(block);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenBuffers_mock(1, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<1>(42));
+
+    // Act & Assert
+    expectSpecificError([&context]()
+                        { OpenGLPipelineUser<Classic>::on(context); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::LAYOUT_MISMATCH"));
+    block.reset();
+    context.reset();
+    mock::opengl::glFunctionMock::reset();
+}
+
+#endif // __mock_gl__
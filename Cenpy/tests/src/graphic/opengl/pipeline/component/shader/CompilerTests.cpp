@@ -0,0 +1,91 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/MockApi.hpp>
+#include <graphic/opengl/profile/Shader.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+#include <graphic/opengl/pipeline/component/shader/Compiler.hpp>
+#include <graphic/opengl/pipeline/cache/ShaderCache.hpp>
+
+namespace mock = cenpy::mock;
+namespace context = cenpy::graphic::opengl::context;
+namespace shader = cenpy::graphic::opengl::pipeline::component::shader;
+namespace cache = cenpy::graphic::opengl::pipeline::cache;
+using cenpy::graphic::opengl::profile::Shader::Classic;
+
+class CompilerTests : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+    }
+};
+
+TEST_F(CompilerTests, CompileShaderTest_submitsWithoutWaiting)
+{
+    // Arrange
+    auto shaderContext = std::make_shared<context::OpenGLShaderContext>();
+    shaderContext->setShaderType(cenpy::graphic::context::ShaderType::FRAGMENT);
+
+    // Except calls: the compile status would make the driver finish the compilation
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCreateShader_mock(GL_FRAGMENT_SHADER)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompileShader_mock(1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGetShaderiv_mock(::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    // Act
+    ASSERT_NO_THROW(shader::OpenGLShaderCompiler<Classic>::on(shaderContext));
+
+    // Assert
+    ASSERT_EQ(shaderContext->getShaderID(), 1);
+}
+
+TEST_F(CompilerTests, CompileShaderTest_alreadyCompiled)
+{
+    // Arrange
+    auto shaderContext = std::make_shared<context::OpenGLShaderContext>();
+    shaderContext->setShaderType(cenpy::graphic::context::ShaderType::FRAGMENT);
+    shaderContext->setShaderID(3);
+
+    // Except calls
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCreateShader_mock(::testing::_)).Times(0);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompileShader_mock(::testing::_)).Times(0);
+
+    // Act
+    ASSERT_NO_THROW(shader::OpenGLShaderCompiler<Classic>::on(shaderContext));
+
+    // Assert
+    ASSERT_EQ(shaderContext->getShaderID(), 3);
+}
+
+TEST_F(CompilerTests, CompileShaderTest_sharedThroughCache)
+{
+    // Arrange
+    auto shaderCache = std::make_shared<cache::OpenGLShaderCache>();
+    auto first = std::make_shared<context::OpenGLShaderContext>();
+    auto second = std::make_shared<context::OpenGLShaderContext>();
+    for (const auto &shaderContext : {first, second})
+    {
+        shaderContext->setShaderType(cenpy::graphic::context::ShaderType::VERTEX);
+        shaderContext->setShaderPath("fullscreen.vert");
+        shaderContext->setShaderCode("void main() {}");
+        shaderContext->setShaderCache(shaderCache);
+    }
+
+    // Except calls: identical shaders are compiled once
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCreateShader_mock(GL_VERTEX_SHADER)).WillOnce(::testing::Return(4));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompileShader_mock(4)).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(shader::OpenGLShaderCompiler<Classic>::on(first));
+    ASSERT_NO_THROW(shader::OpenGLShaderCompiler<Classic>::on(second));
+
+    // Assert
+    ASSERT_EQ(second->getShaderID(), 4);
+    ASSERT_EQ(shaderCache->getReferences(4), 2);
+}
+
+#endif // __mock_gl__
@@ -8,6 +8,7 @@
 #include <graphic/opengl/profile/Shader.hpp>
 #include <graphic/opengl/context/ShaderContext.hpp>
 #include <graphic/opengl/pipeline/component/shader/Freer.hpp>
+#include <graphic/opengl/pipeline/cache/ShaderCache.hpp>
 
 namespace mock = cenpy::mock;
 namespace api = cenpy::graphic::api;
@@ -68,4 +69,26 @@ TEST_F(FreerTests, FreeShader_doNothing_whenShaderIDIsZero)
     ASSERT_EQ(shaderContext->getShaderID(), 0);
 }
 
+TEST_F(FreerTests, FreeShader_sharedShader_keptForOtherUsers)
+{
+    // Arrange
+    auto shaderCache = std::make_shared<cenpy::graphic::opengl::pipeline::cache::OpenGLShaderCache>();
+    auto shaderContext = std::make_shared<context::OpenGLShaderContext>();
+    shaderContext->setShaderType(cenpy::graphic::context::ShaderType::VERTEX);
+    shaderContext->setShaderCache(shaderCache);
+    shaderCache->add(*shaderContext, 666);
+    shaderCache->acquire(*shaderContext);
+    shaderContext->setShaderID(666);
+
+    // Except calls
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteShader_mock(666)).Times(0);
+
+    // Act
+    ASSERT_NO_THROW(shader::OpenGLShaderFreer<Classic>::on(shaderContext));
+
+    // Assert
+    ASSERT_EQ(shaderContext->getShaderID(), 0);
+    ASSERT_EQ(shaderCache->getReferences(666), 1);
+}
+
 #endif // __mock_gl__
\ No newline at end of file
@@ -0,0 +1,189 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <opengl/glFunctionMock.hpp>
+#include <TestUtils.hpp>
+#include <graphic/MockApi.hpp>
+#include <graphic/opengl/profile/Shader.hpp>
+#include <graphic/opengl/context/ShaderContext.hpp>
+#include <graphic/opengl/pipeline/component/shader/Reader.hpp>
+#include <graphic/opengl/pipeline/component/shader/Preprocessor.hpp>
+
+namespace context = cenpy::graphic::opengl::context;
+namespace shader = cenpy::graphic::opengl::pipeline::component::shader;
+namespace mock = cenpy::mock;
+using cenpy::graphic::opengl::profile::Shader::Classic;
+using cenpy::graphic::opengl::profile::Shader::Mapped;
+
+class PreprocessorTests : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+    }
+};
+
+TEST_F(PreprocessorTests, Preprocess_NoInclude_CodeUntouched)
+{
+    // Arrange
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath("test-datas/shaders/vertex/good/minimal.vert");
+    shader::OpenGLShaderReader<Mapped>::on(context);
+    const char *code = context->getShaderCode().data();
+
+    // Act
+    shader::OpenGLShaderPreprocessor<Mapped>::on(context);
+
+    // Assert
+    ASSERT_EQ(context->getShaderCode().data(), code);
+    ASSERT_TRUE(context->getIncludes().empty());
+}
+
+TEST_F(PreprocessorTests, Preprocess_Defines_AfterVersion)
+{
+    // Arrange
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath("test-datas/shaders/vertex/good/minimal.vert");
+    context->setDefines({"TINT", "MASK"});
+    shader::OpenGLShaderReader<Mapped>::on(context);
+    std::string expected = R"(#version 330 core
+#define TINT
+#define MASK
+#line 2 0
+
+uniform int testUniform;
+layout (location = 0) in vec3 aPos;
+
+void main()
+{
+    gl_Position = vec4(aPos, 1.0) * float(testUniform);
+}
+)";
+
+    // Act
+    shader::OpenGLShaderPreprocessor<Mapped>::on(context);
+
+    // Assert
+    ASSERT_EQ(context->getShaderCode(), expected);
+    ASSERT_TRUE(context->getIncludes().empty());
+}
+
+TEST_F(PreprocessorTests, Preprocess_NestedIncludes_ExpandedOnce)
+{
+    // Arrange
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath("test-datas/shaders/include/main.frag");
+    shader::OpenGLShaderReader<Classic>::on(context);
+    std::string expected = R"(#version 330 core
+#line 1 1
+#line 1 2
+float half(float value) { return value * 0.5; }
+#line 2 1
+vec4 tint(vec4 color) { return color * half(2.0); }
+#line 3 0
+
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = tint(vec4(half(1.0)));
+}
+)";
+    std::vector<std::string> includes{"test-datas/shaders/include/common/color.glsl",
+                                      "test-datas/shaders/include/common/math.glsl"};
+
+    // Act
+    shader::OpenGLShaderPreprocessor<Classic>::on(context);
+
+    // Assert
+    ASSERT_EQ(context->getShaderCode(), expected);
+    ASSERT_EQ(context->getIncludes(), includes);
+}
+
+TEST_F(PreprocessorTests, Preprocess_DependsOnIncludes)
+{
+    // Arrange
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath("test-datas/shaders/include/main.frag");
+    shader::OpenGLShaderReader<Classic>::on(context);
+
+    // Act
+    shader::OpenGLShaderPreprocessor<Classic>::on(context);
+
+    // Assert
+    ASSERT_TRUE(context->dependsOn("test-datas/shaders/include/main.frag"));
+    ASSERT_TRUE(context->dependsOn("test-datas/shaders/include/../include/common/math.glsl"));
+    ASSERT_FALSE(context->dependsOn("test-datas/shaders/vertex/good/minimal.vert"));
+}
+
+TEST_F(PreprocessorTests, Preprocess_MissingInclude_Throws)
+{
+    // Arrange
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath("test-datas/shaders/include/missing.frag");
+    shader::OpenGLShaderReader<Classic>::on(context);
+
+    // Act & Assert
+    cenpy::test::utils::expectSpecificError(
+        [&context]()
+        { shader::OpenGLShaderPreprocessor<Classic>::on(context); },
+        cenpy::common::exception::TraceableException<std::runtime_error>(
+            "ERROR::SHADER::INCLUDE_NOT_FOUND\ntest-datas/shaders/include/common/missing.glsl included from test-datas/shaders/include/missing.frag"));
+}
+
+TEST_F(PreprocessorTests, Preprocess_CommentedIncludes_Ignored)
+{
+    // Arrange
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath("test-datas/shaders/include/main.frag");
+    context->setShaderCode(R"(#version 330 core
+// #include "common/missing.glsl"
+/* Disabled:
+#include "common/missing.glsl"
+*/
+#include "common/math.glsl"
+)");
+    std::string expected = R"(#version 330 core
+// #include "common/missing.glsl"
+/* Disabled:
+#include "common/missing.glsl"
+*/
+#line 1 1
+float half(float value) { return value * 0.5; }
+#line 7 0
+)";
+    std::vector<std::string> includes{"test-datas/shaders/include/common/math.glsl"};
+
+    // Act
+    shader::OpenGLShaderPreprocessor<Classic>::on(context);
+
+    // Assert
+    ASSERT_EQ(context->getShaderCode(), expected);
+    ASSERT_EQ(context->getIncludes(), includes);
+}
+
+TEST_F(PreprocessorTests, Preprocess_OnlyCommentedIncludes_CodeUntouched)
+{
+    // Arrange
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath("test-datas/shaders/include/main.frag");
+    context->setShaderCode(R"(#version 330 core
+int value; // #include "common/missing.glsl"
+/* #include "common/missing.glsl" */
+)");
+    const char *code = context->getShaderCode().data();
+
+    // Act
+    shader::OpenGLShaderPreprocessor<Classic>::on(context);
+
+    // Assert
+    ASSERT_EQ(context->getShaderCode().data(), code);
+    ASSERT_TRUE(context->getIncludes().empty());
+}
+
+#endif // __mock_gl__
@@ -1,9 +1,12 @@
 #ifdef __mock_gl__
 
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <opengl/glFunctionMock.hpp>
+#include <TestUtils.hpp>
 #include <graphic/MockApi.hpp>
 #include <graphic/opengl/profile/Shader.hpp>
 #include <graphic/opengl/context/ShaderContext.hpp>
@@ -14,6 +17,7 @@ namespace shader = cenpy::graphic::opengl::pipeline::component::shader;
 namespace mock = cenpy::mock;
 namespace api = cenpy::graphic::api;
 using cenpy::graphic::opengl::profile::Shader::Classic;
+using cenpy::graphic::opengl::profile::Shader::Mapped;
 
 class ReaderTests : public ::testing::Test
 {
@@ -47,4 +51,51 @@ void main()
     ASSERT_EQ(context->getShaderCode(), code);
 }
 
+TEST_F(ReaderTests, ReadShaderTest_mapped)
+{
+    // Arrange
+    auto classicContext = std::make_shared<context::OpenGLShaderContext>();
+    classicContext->setShaderPath("test-datas/shaders/vertex/good/minimal.vert");
+    auto mappedContext = std::make_shared<context::OpenGLShaderContext>();
+    mappedContext->setShaderPath("test-datas/shaders/vertex/good/minimal.vert");
+
+    // Act
+    shader::OpenGLShaderReader<Classic>::on(classicContext);
+    shader::OpenGLShaderReader<Mapped>::on(mappedContext);
+
+    // Assert
+    ASSERT_FALSE(mappedContext->getShaderCode().empty());
+    ASSERT_EQ(mappedContext->getShaderCode(), classicContext->getShaderCode());
+}
+
+TEST_F(ReaderTests, ReadShaderTest_mappedFileRewritten)
+{
+    // Arrange
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "cenpy-reader-test.vert";
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "void main() {}\n";
+    }
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath(path.string());
+
+    // Act: an editor truncating the file while it is being reloaded
+    shader::OpenGLShaderReader<Mapped>::on(context);
+    std::filesystem::resize_file(path, 0);
+
+    // Assert: the code read is still there
+    ASSERT_EQ(context->getShaderCode(), "void main() {}\n");
+    std::filesystem::remove(path);
+}
+
+TEST_F(ReaderTests, ReadShaderTest_mappedMissingFile)
+{
+    // Arrange
+    auto context = std::make_shared<context::OpenGLShaderContext>();
+    context->setShaderPath("test-datas/shaders/vertex/good/missing.vert");
+
+    // Act & Assert
+    ASSERT_THROW(shader::OpenGLShaderReader<Mapped>::on(context), cenpy::common::exception::TraceableException<std::runtime_error>);
+}
+
 #endif // __mock_gl__
\ No newline at end of file
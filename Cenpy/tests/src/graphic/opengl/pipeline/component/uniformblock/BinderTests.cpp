@@ -0,0 +1,53 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <graphic/opengl/pipeline/component/uniform/Setter.hpp>
+#include <graphic/opengl/pipeline/component/uniformblock/Binder.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <TestUtils.hpp>
+
+namespace api = cenpy::graphic::api;
+namespace mock = cenpy::mock;
+namespace uniformblock = cenpy::graphic::opengl::pipeline::component::uniformblock;
+using cenpy::graphic::opengl::profile::UniformBlock::Classic;
+using cenpy::test::utils::expectSpecificError;
+
+class UniformBlockBinderTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+};
+
+TEST_F(UniformBlockBinderTests, Bind_BindsBufferToBindingPoint)
+{
+    // Arrange
+    auto blockContext = std::make_shared<api::OpenGL::UniformBlockContext>();
+    blockContext->setBufferID(42);
+    blockContext->setBindingPoint(3);
+
+    // Expected call
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBufferBase_mock(GL_UNIFORM_BUFFER, 3, 42)).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(uniformblock::OpenGLUniformBlockBinder<Classic>::on(blockContext));
+}
+
+TEST_F(UniformBlockBinderTests, Bind_BufferNotCreated)
+{
+    auto blockContext = std::make_shared<api::OpenGL::UniformBlockContext>();
+
+    expectSpecificError([&blockContext]()
+                        { uniformblock::OpenGLUniformBlockBinder<Classic>::on(blockContext); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::BIND::BUFFER_ID_NOT_SET"));
+}
+
+#endif // __mock_gl__
@@ -0,0 +1,58 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <graphic/opengl/pipeline/component/uniform/Setter.hpp>
+#include <graphic/opengl/pipeline/component/uniformblock/Freer.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <TestUtils.hpp>
+
+namespace api = cenpy::graphic::api;
+namespace mock = cenpy::mock;
+namespace uniformblock = cenpy::graphic::opengl::pipeline::component::uniformblock;
+using cenpy::graphic::opengl::profile::UniformBlock::Classic;
+using cenpy::test::utils::expectSpecificError;
+
+class UniformBlockFreerTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+};
+
+TEST_F(UniformBlockFreerTests, Free_DeletesBuffer)
+{
+    // Arrange
+    auto blockContext = std::make_shared<api::OpenGL::UniformBlockContext>();
+    blockContext->addMember({"time", GL_FLOAT});
+    blockContext->setBufferID(42);
+    blockContext->markUploaded();
+
+    // Expected call
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteBuffers_mock(1, ::testing::Pointee(42))).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(uniformblock::OpenGLUniformBlockFreer<Classic>::on(blockContext));
+
+    // Assert
+    ASSERT_EQ(blockContext->getBufferID(), 0);
+    ASSERT_TRUE(blockContext->isDirty());
+}
+
+TEST_F(UniformBlockFreerTests, Free_NoBuffer)
+{
+    auto blockContext = std::make_shared<api::OpenGL::UniformBlockContext>();
+
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteBuffers_mock(::testing::_, ::testing::_)).Times(0);
+
+    ASSERT_NO_THROW(uniformblock::OpenGLUniformBlockFreer<Classic>::on(blockContext));
+}
+
+#endif // __mock_gl__
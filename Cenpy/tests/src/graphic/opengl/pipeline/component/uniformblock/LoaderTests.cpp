@@ -0,0 +1,57 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <graphic/opengl/pipeline/component/uniform/Setter.hpp>
+#include <graphic/opengl/pipeline/component/uniformblock/Loader.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <TestUtils.hpp>
+
+namespace api = cenpy::graphic::api;
+namespace mock = cenpy::mock;
+namespace uniformblock = cenpy::graphic::opengl::pipeline::component::uniformblock;
+using cenpy::graphic::opengl::profile::UniformBlock::Classic;
+using cenpy::test::utils::expectSpecificError;
+
+class UniformBlockLoaderTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+};
+
+TEST_F(UniformBlockLoaderTests, Load_CreatesAndFillsBuffer)
+{
+    // Arrange
+    auto blockContext = std::make_shared<api::OpenGL::UniformBlockContext>();
+    blockContext->addMember({"time", GL_FLOAT});
+
+    // Expected call
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenBuffers_mock(1, ::testing::_))
+        .WillOnce(::testing::SetArgPointee<1>(42));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_UNIFORM_BUFFER, 42)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferData_mock(GL_UNIFORM_BUFFER, 16, ::testing::_, GL_DYNAMIC_DRAW)).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(uniformblock::OpenGLUniformBlockLoader<Classic>::on(blockContext));
+
+    // Assert
+    ASSERT_EQ(blockContext->getBufferID(), 42);
+    ASSERT_FALSE(blockContext->isDirty());
+}
+
+TEST_F(UniformBlockLoaderTests, Load_NullContext)
+{
+    expectSpecificError([]()
+                        { uniformblock::OpenGLUniformBlockLoader<Classic>::on(nullptr); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::LOAD::NON_OPENGL_CONTEXT"));
+}
+
+#endif // __mock_gl__
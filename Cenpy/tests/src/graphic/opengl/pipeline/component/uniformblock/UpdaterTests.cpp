@@ -0,0 +1,76 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/context/UniformBlockContext.hpp>
+#include <graphic/opengl/pipeline/component/uniform/Setter.hpp>
+#include <graphic/opengl/pipeline/component/uniformblock/Updater.hpp>
+#include <common/exception/TraceableException.hpp>
+#include <TestUtils.hpp>
+
+namespace api = cenpy::graphic::api;
+namespace mock = cenpy::mock;
+namespace uniformblock = cenpy::graphic::opengl::pipeline::component::uniformblock;
+using cenpy::graphic::opengl::profile::UniformBlock::Classic;
+using cenpy::test::utils::expectSpecificError;
+
+class UniformBlockUpdaterTests : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+};
+
+TEST_F(UniformBlockUpdaterTests, Update_UploadsDirtyRangeOnly)
+{
+    // Arrange
+    auto blockContext = std::make_shared<api::OpenGL::UniformBlockContext>();
+    blockContext->addMember({"time", GL_FLOAT});
+    blockContext->addMember({"resolution", GL_FLOAT_VEC2});
+    blockContext->setBufferID(42);
+    blockContext->markUploaded();
+    blockContext->setValue("resolution", glm::vec2(800.0f, 600.0f));
+
+    // Expected call
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindBuffer_mock(GL_UNIFORM_BUFFER, 42)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_UNIFORM_BUFFER, 8, 8, blockContext->getData().data() + 8)).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(uniformblock::OpenGLUniformBlockUpdater<Classic>::on(blockContext));
+
+    // Assert
+    ASSERT_FALSE(blockContext->isDirty());
+}
+
+TEST_F(UniformBlockUpdaterTests, Update_CleanBlockSkipsUpload)
+{
+    // Arrange
+    auto blockContext = std::make_shared<api::OpenGL::UniformBlockContext>();
+    blockContext->addMember({"time", GL_FLOAT});
+    blockContext->setBufferID(42);
+    blockContext->markUploaded();
+
+    // Expected call
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+
+    // Act
+    ASSERT_NO_THROW(uniformblock::OpenGLUniformBlockUpdater<Classic>::on(blockContext));
+}
+
+TEST_F(UniformBlockUpdaterTests, Update_BufferNotCreated)
+{
+    auto blockContext = std::make_shared<api::OpenGL::UniformBlockContext>();
+    blockContext->addMember({"time", GL_FLOAT});
+
+    expectSpecificError([&blockContext]()
+                        { uniformblock::OpenGLUniformBlockUpdater<Classic>::on(blockContext); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::UNIFORM_BLOCK::UPDATE::BUFFER_ID_NOT_SET"));
+}
+
+#endif // __mock_gl__
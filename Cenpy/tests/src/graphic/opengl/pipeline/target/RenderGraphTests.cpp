@@ -0,0 +1,223 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <stdexcept>
+#include <vector>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/profile/Pipeline.hpp>
+#include <graphic/opengl/validator/Validator.hpp>
+#include <graphic/opengl/pipeline/cache/FusedPassCache.hpp>
+#include <graphic/opengl/pipeline/target/RenderGraph.hpp>
+#include <graphic/pipeline/MockPass.hpp>
+#include <graphic/opengl/context/MockPipelineContext.hpp>
+#include <graphic/MockApi.hpp>
+
+namespace api = cenpy::mock::graphic::api;
+namespace pipeline = cenpy::graphic::pipeline;
+namespace mock = cenpy::mock;
+
+using mock::graphic::opengl::pipeline::component::pipeline::MockResetter;
+using mock::graphic::opengl::pipeline::component::pipeline::MockUser;
+using mock::graphic::pipeline::opengl::MockPass;
+
+using cenpy::graphic::opengl::pipeline::cache::OpenGLFusedPassCache;
+using cenpy::graphic::opengl::pipeline::target::OpenGLRenderGraph;
+using cenpy::graphic::opengl::pipeline::target::OpenGLRenderTargetPool;
+using cenpy::graphic::opengl::profile::Pipeline::Classic;
+using cenpy::graphic::pipeline::UniformHandle;
+using cenpy::graphic::render::PointwiseStage;
+using cenpy::graphic::render::TargetDesc;
+using cenpy::graphic::render::TargetFormat;
+
+class OpenGLRenderGraphTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenTextures_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *texture)
+                           { *texture = ++m_lastTexture; });
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenFramebuffers_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *framebuffer)
+                           { *framebuffer = ++m_lastFramebuffer; });
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        MockUser<Classic>::reset();
+        MockResetter<Classic>::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+
+    GLuint m_lastTexture = 0;
+    GLuint m_lastFramebuffer = 0;
+    pipeline::Pipeline<api::MockOpenGL, Classic> m_pipeline{{std::make_shared<MockPass<api::MockOpenGL>>(), std::make_shared<MockPass<api::MockOpenGL>>(), std::make_shared<MockPass<api::MockOpenGL>>()}};
+    OpenGLRenderTargetPool m_pool;
+};
+
+TEST_F(OpenGLRenderGraphTests, Execute_UsesPassesInGraphOrder)
+{
+    // Arrange: composite declared before the scene it reads
+    OpenGLRenderGraph<api::MockOpenGL> graph(m_pipeline, m_pool);
+    const int backbuffer = graph.importBackbuffer(1280, 720);
+    const int scene = graph.addTarget("scene", {1280, 720, TargetFormat::RGBA8});
+    std::vector<int> drawn;
+    graph.addPass("composite", 1, {scene}, {backbuffer}, [&drawn]
+                  { drawn.push_back(1); });
+    graph.addPass("scene", 0, {}, {scene}, [&drawn]
+                  { drawn.push_back(0); });
+    std::vector<int> used;
+
+    // Expect: the scene renders offscreen, the composite to the window with the scene on unit 0
+    EXPECT_CALL(*MockUser<Classic>::instance(), mockOn(::testing::_))
+        .Times(2)
+        .WillRepeatedly([&used](auto context)
+                        { used.push_back(context->getCurrentPass()); });
+    EXPECT_CALL(*MockResetter<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindFramebuffer_mock(GL_FRAMEBUFFER, 1)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBindFramebuffer_mock(GL_FRAMEBUFFER, 0)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glViewport_mock(0, 0, 1280, 720)).Times(2);
+
+    // Act
+    graph.execute();
+
+    // Assert
+    EXPECT_EQ(used, (std::vector<int>{0, 1}));
+    EXPECT_EQ(drawn, (std::vector<int>{0, 1}));
+    EXPECT_EQ(graph.getTexture(backbuffer), 0);
+    EXPECT_NE(graph.getTexture(scene), 0);
+}
+
+TEST_F(OpenGLRenderGraphTests, Execute_AllocatesOnceAndAliases)
+{
+    // Arrange: ping-pong blur, the second blur reusing the memory of the bright pass
+    OpenGLRenderGraph<api::MockOpenGL> graph(m_pipeline, m_pool);
+    const int backbuffer = graph.importBackbuffer(1280, 720);
+    const int bright = graph.addTarget("bright", {640, 360, TargetFormat::RGBA8});
+    const int blurX = graph.addTarget("blurX", {640, 360, TargetFormat::RGBA8});
+    const int blurY = graph.addTarget("blurY", {640, 360, TargetFormat::RGBA8});
+    graph.addPass("bright", 0, {}, {bright}, {});
+    graph.addPass("blurX", 1, {bright}, {blurX}, {});
+    graph.addPass("blurY", 1, {blurX}, {blurY}, {});
+    graph.addPass("composite", 2, {blurY}, {backbuffer}, {});
+
+    // Expect: two textures and the framebuffers of the three offscreen passes, once
+    EXPECT_CALL(*MockUser<Classic>::instance(), mockOn(::testing::_)).Times(8);
+    EXPECT_CALL(*MockResetter<Classic>::instance(), mockOn(::testing::_)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenTextures_mock(1, ::testing::_)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenFramebuffers_mock(1, ::testing::_)).Times(2);
+
+    // Act
+    graph.execute();
+    graph.execute();
+
+    // Assert
+    EXPECT_EQ(graph.getTexture(blurY), graph.getTexture(bright));
+    EXPECT_EQ(m_pool.getAllocations(), 2);
+}
+
+TEST_F(OpenGLRenderGraphTests, Resize_ReallocatesOnNextExecution)
+{
+    // Arrange
+    OpenGLRenderGraph<api::MockOpenGL> graph(m_pipeline, m_pool);
+    const int backbuffer = graph.importBackbuffer(1280, 720);
+    const int scene = graph.addTarget("scene", {1280, 720, TargetFormat::RGBA8});
+    graph.addPass("scene", 0, {}, {scene}, {});
+    graph.addPass("composite", 1, {scene}, {backbuffer}, {});
+    EXPECT_CALL(*MockUser<Classic>::instance(), mockOn(::testing::_)).Times(4);
+    EXPECT_CALL(*MockResetter<Classic>::instance(), mockOn(::testing::_)).Times(2);
+    graph.execute();
+    const GLuint before = graph.getTexture(scene);
+
+    // Expect: the old texture is trimmed, the new one allocated
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteTextures_mock(1, ::testing::Pointee(before))).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexImage2D_mock(GL_TEXTURE_2D, 0, GL_RGBA8, 800, 600, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr)).Times(1);
+
+    // Act
+    graph.resize(scene, 800, 600);
+    graph.resize(backbuffer, 800, 600);
+    graph.execute();
+
+    // Assert
+    EXPECT_NE(graph.getTexture(scene), before);
+    EXPECT_EQ(m_pool.getTexturesCount(), 1);
+    ::testing::Mock::VerifyAndClearExpectations(mock::opengl::glFunctionMock::instance().get());
+}
+
+TEST_F(OpenGLRenderGraphTests, Compile_BackbufferWithTargets)
+{
+    // Arrange
+    OpenGLRenderGraph<api::MockOpenGL> graph(m_pipeline, m_pool);
+    const int backbuffer = graph.importBackbuffer(1280, 720);
+    const int scene = graph.addTarget("scene", {1280, 720, TargetFormat::RGBA8});
+    graph.addPass("both", 0, {}, {backbuffer, scene}, {});
+
+    // Act & Assert
+    EXPECT_THROW(graph.compile(), std::runtime_error);
+}
+
+TEST_F(OpenGLRenderGraphTests, Execute_FusesPointwiseChain)
+{
+    // Arrange: scene -> tint -> vignette -> backbuffer
+    std::vector<std::shared_ptr<MockPass<api::MockOpenGL>>> fused;
+    const std::unordered_map<std::string, std::shared_ptr<pipeline::Uniform<api::MockOpenGL>>, cenpy::collection_utils::StringHash, cenpy::collection_utils::StringEqual> uniforms;
+    auto fusedPasses = std::make_shared<OpenGLFusedPassCache<api::MockOpenGL>>([&fused, &uniforms](std::string_view, const std::string &)
+                                                                                {
+        auto pass = std::make_shared<::testing::NiceMock<MockPass<api::MockOpenGL>>>();
+        ON_CALL(*pass, getUniforms()).WillByDefault(::testing::ReturnRef(uniforms));
+        fused.push_back(pass);
+        return pass; });
+    OpenGLRenderGraph<api::MockOpenGL> graph(m_pipeline, m_pool, fusedPasses);
+    const int backbuffer = graph.importBackbuffer(1280, 720);
+    const int scene = graph.addTarget("scene", {1280, 720, TargetFormat::RGBA8});
+    const int tinted = graph.addTarget("tinted", {1280, 720, TargetFormat::RGBA8});
+    graph.addPass("scene", 0, {}, {scene}, {});
+    std::vector<std::string> bound;
+    graph.addPointwisePass("tint", {"tint", "color.rgb *= tint;", {{"vec3", "tint"}}}, scene, tinted,
+                           [&bound](auto &, const std::vector<UniformHandle> &handles)
+                           { bound.push_back("tint");
+                             EXPECT_EQ(handles.size(), 1);
+                             EXPECT_FALSE(handles.front().isValid()); });
+    graph.addPointwisePass("vignette", {"vignette", "color.rgb *= 1.0 - length(uv - 0.5);", {}}, tinted, backbuffer,
+                           [&bound](auto &, const std::vector<UniformHandle> &handles)
+                           { bound.push_back("vignette");
+                             EXPECT_TRUE(handles.empty()); });
+
+    ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenVertexArrays_mock(1, ::testing::_))
+        .WillByDefault(::testing::SetArgPointee<1>(9));
+
+    // Expect: one fullscreen triangle to the window, the scene on unit 0
+    EXPECT_CALL(*MockUser<Classic>::instance(), mockOn(::testing::_)).Times(2);
+    EXPECT_CALL(*MockResetter<Classic>::instance(), mockOn(::testing::_)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexImage2D_mock(GL_TEXTURE_2D, 0, GL_RGBA8, 1280, 720, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenVertexArrays_mock(1, ::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDrawArrays_mock(GL_TRIANGLES, 0, 3)).Times(2);
+
+    // Act
+    graph.execute();
+    graph.execute();
+
+    // Assert
+    ASSERT_EQ(fused.size(), 1);
+    EXPECT_EQ(bound, (std::vector<std::string>{"tint", "vignette", "tint", "vignette"}));
+    EXPECT_EQ(graph.getTexture(tinted), 0);
+    EXPECT_EQ(fusedPasses->getMisses(), 1);
+}
+
+TEST_F(OpenGLRenderGraphTests, AddPointwisePass_NoFusedPassCache)
+{
+    // Arrange
+    OpenGLRenderGraph<api::MockOpenGL> graph(m_pipeline, m_pool);
+    const int backbuffer = graph.importBackbuffer(1280, 720);
+    const int scene = graph.addTarget("scene", {1280, 720, TargetFormat::RGBA8});
+
+    // Act & Assert
+    EXPECT_THROW(graph.addPointwisePass("tint", {"tint", "", {}}, scene, backbuffer), std::runtime_error);
+}
+
+#endif // __mock_gl__
@@ -0,0 +1,117 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdexcept>
+#include <vector>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/target/RenderTargetPool.hpp>
+
+namespace mock = cenpy::mock;
+using cenpy::graphic::opengl::pipeline::target::OpenGLRenderTargetPool;
+using cenpy::graphic::render::TargetDesc;
+using cenpy::graphic::render::TargetFormat;
+
+class RenderTargetPoolTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenTextures_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *texture)
+                           { *texture = ++m_lastTexture; });
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenFramebuffers_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *framebuffer)
+                           { *framebuffer = ++m_lastFramebuffer; });
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+
+    GLuint m_lastTexture = 0;
+    GLuint m_lastFramebuffer = 0;
+};
+
+TEST_F(RenderTargetPoolTests, Acquire_ReusesReleasedTexture)
+{
+    // Arrange
+    OpenGLRenderTargetPool pool;
+
+    // Expect: one texture of each description
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexImage2D_mock(GL_TEXTURE_2D, 0, GL_RGBA8, 64, 32, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexImage2D_mock(GL_TEXTURE_2D, 0, GL_RGBA16F, 64, 32, 0, GL_RGBA, GL_HALF_FLOAT, nullptr)).Times(1);
+
+    // Act
+    const GLuint first = pool.acquire({64, 32, TargetFormat::RGBA8});
+    pool.release(first);
+    const GLuint again = pool.acquire({64, 32, TargetFormat::RGBA8});
+    const GLuint other = pool.acquire({64, 32, TargetFormat::RGBA16F});
+
+    // Assert
+    EXPECT_EQ(again, first);
+    EXPECT_NE(other, first);
+    EXPECT_EQ(pool.getAllocations(), 2);
+}
+
+TEST_F(RenderTargetPoolTests, GetFramebuffer_CachedByAttachments)
+{
+    // Arrange
+    OpenGLRenderTargetPool pool;
+    const GLuint color = pool.acquire({64, 32, TargetFormat::RGBA8});
+    const GLuint depth = pool.acquire({64, 32, TargetFormat::DEPTH24_STENCIL8});
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenFramebuffers_mock(1, ::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glFramebufferTexture2D_mock(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glFramebufferTexture2D_mock(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depth, 0)).Times(1);
+
+    // Act
+    const GLuint framebuffer = pool.getFramebuffer({color}, depth);
+
+    // Assert
+    EXPECT_EQ(pool.getFramebuffer({color}, depth), framebuffer);
+}
+
+TEST_F(RenderTargetPoolTests, GetFramebuffer_Incomplete)
+{
+    // Arrange
+    OpenGLRenderTargetPool pool;
+    const GLuint color = pool.acquire({64, 32, TargetFormat::RGBA8});
+    ON_CALL(*mock::opengl::glFunctionMock::instance(), glCheckFramebufferStatus_mock(GL_FRAMEBUFFER))
+        .WillByDefault(::testing::Return(GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT));
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteFramebuffers_mock(1, ::testing::_)).Times(1);
+
+    // Act & Assert
+    EXPECT_THROW(pool.getFramebuffer({color}, 0), std::runtime_error);
+    ON_CALL(*mock::opengl::glFunctionMock::instance(), glCheckFramebufferStatus_mock(GL_FRAMEBUFFER))
+        .WillByDefault(::testing::Return(GL_FRAMEBUFFER_COMPLETE));
+}
+
+TEST_F(RenderTargetPoolTests, Trim_DeletesReleasedTexturesAndTheirFramebuffers)
+{
+    // Arrange
+    OpenGLRenderTargetPool pool;
+    const GLuint kept = pool.acquire({64, 32, TargetFormat::RGBA8});
+    const GLuint released = pool.acquire({64, 32, TargetFormat::RGBA8});
+    pool.getFramebuffer({kept}, 0);
+    pool.getFramebuffer({released}, 0);
+    pool.release(released);
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteFramebuffers_mock(1, ::testing::Pointee(2))).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteTextures_mock(1, ::testing::Pointee(released))).Times(1);
+
+    // Act
+    pool.trim();
+
+    // Assert
+    EXPECT_EQ(pool.getTexturesCount(), 1);
+    ::testing::Mock::VerifyAndClearExpectations(mock::opengl::glFunctionMock::instance().get());
+}
+
+#endif // __mock_gl__
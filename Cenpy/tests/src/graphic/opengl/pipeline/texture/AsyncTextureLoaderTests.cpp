@@ -0,0 +1,241 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/texture/AsyncTextureLoader.hpp>
+
+namespace mock = cenpy::mock;
+using cenpy::common::thread::WorkerPool;
+using cenpy::graphic::opengl::pipeline::texture::DecodedImage;
+using cenpy::graphic::opengl::pipeline::texture::OpenGLAsyncTextureLoader;
+using cenpy::graphic::opengl::pipeline::texture::OpenGLTextureHandle;
+
+class AsyncTextureLoaderTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenTextures_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *texture)
+                           { *texture = ++m_lastTexture; });
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+
+    // Decodes "WxH" into an image whose rows are filled with their index.
+    static DecodedImage decode(const std::string &path)
+    {
+        DecodedImage image;
+        if (std::sscanf(path.c_str(), "%dx%d", &image.width, &image.height) != 2)
+        {
+            throw std::runtime_error("cannot decode " + path);
+        }
+        for (int row = 0; row < image.height; ++row)
+        {
+            image.rgba.insert(image.rgba.end(), static_cast<std::size_t>(image.width) * 4, static_cast<std::uint8_t>(row));
+        }
+        return image;
+    }
+
+    // Updates the loader until the worker has decoded the image.
+    static void waitDecoded(OpenGLAsyncTextureLoader &loader, const OpenGLTextureHandle &handle)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (handle.getState() == OpenGLTextureHandle::State::DECODING && std::chrono::steady_clock::now() < deadline)
+        {
+            loader.update();
+            std::this_thread::yield();
+        }
+    }
+
+    WorkerPool m_pool{1};
+    GLuint m_lastTexture = 0;
+};
+
+TEST_F(AsyncTextureLoaderTests, Load_BindsPlaceholderUntilReady)
+{
+    // Arrange
+    OpenGLAsyncTextureLoader loader(decode, 1024, m_pool);
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenerateMipmap_mock(GL_TEXTURE_2D)).Times(1);
+
+    // Act
+    auto handle = loader.load("4x4");
+
+    // Assert
+    EXPECT_EQ(handle->getTexture(), loader.getPlaceholder());
+    waitDecoded(loader, *handle);
+    ASSERT_TRUE(handle->isReady());
+    EXPECT_NE(handle->getTexture(), loader.getPlaceholder());
+    EXPECT_EQ(handle->getWidth(), 4);
+    EXPECT_EQ(handle->getHeight(), 4);
+    EXPECT_EQ(loader.getPendingCount(), 0);
+}
+
+TEST_F(AsyncTextureLoaderTests, Update_SpreadsUploadOverFrames)
+{
+    // Arrange: a frame uploads two rows of 16 bytes
+    OpenGLAsyncTextureLoader loader(decode, 32, m_pool);
+    std::vector<std::uint8_t> staging(32);
+    std::vector<std::uint8_t> uploadedRows;
+    ON_CALL(*mock::opengl::glFunctionMock::instance(), glMapBufferRange_mock(GL_PIXEL_UNPACK_BUFFER, 0, 32, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT))
+        .WillByDefault(::testing::Return(staging.data()));
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexSubImage2D_mock(GL_TEXTURE_2D, 0, 0, ::testing::_, 4, 2, GL_RGBA, GL_UNSIGNED_BYTE, nullptr))
+        .Times(2)
+        .WillRepeatedly([&staging, &uploadedRows](GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void *)
+                        { uploadedRows.push_back(staging[0]); uploadedRows.push_back(staging[16]); });
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUnmapBuffer_mock(GL_PIXEL_UNPACK_BUFFER)).Times(2);
+
+    // Act
+    auto handle = loader.load("4x4");
+    waitDecoded(loader, *handle);
+
+    // Assert: the decoding frame uploaded the first half, the next one finishes
+    EXPECT_EQ(handle->getState(), OpenGLTextureHandle::State::UPLOADING);
+    EXPECT_EQ(handle->getTexture(), loader.getPlaceholder());
+    EXPECT_EQ(loader.update(), 32);
+    EXPECT_TRUE(handle->isReady());
+    EXPECT_EQ(loader.update(), 0);
+    EXPECT_EQ(uploadedRows, (std::vector<std::uint8_t>{0, 1, 2, 3}));
+}
+
+TEST_F(AsyncTextureLoaderTests, Update_UploadsAtLeastOneRow)
+{
+    // Arrange
+    OpenGLAsyncTextureLoader loader(decode, 1, m_pool);
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexSubImage2D_mock(GL_TEXTURE_2D, 0, 0, ::testing::_, 8, 1, GL_RGBA, GL_UNSIGNED_BYTE, nullptr)).Times(2);
+
+    // Act
+    auto handle = loader.load("8x2");
+    waitDecoded(loader, *handle);
+
+    // Assert
+    EXPECT_EQ(loader.update(), 32);
+    EXPECT_TRUE(handle->isReady());
+}
+
+TEST_F(AsyncTextureLoaderTests, Load_DecoderFailure)
+{
+    // Arrange
+    OpenGLAsyncTextureLoader loader(decode, 1024, m_pool);
+
+    // Act
+    auto handle = loader.load("missing.png");
+    waitDecoded(loader, *handle);
+
+    // Assert: the placeholder stays bound
+    EXPECT_EQ(handle->getState(), OpenGLTextureHandle::State::FAILED);
+    EXPECT_EQ(handle->getError(), "cannot decode missing.png");
+    EXPECT_EQ(handle->getTexture(), loader.getPlaceholder());
+}
+
+TEST_F(AsyncTextureLoaderTests, Load_InvalidImage)
+{
+    // Arrange
+    OpenGLAsyncTextureLoader loader([](const std::string &)
+                                    { return DecodedImage{2, 2, std::vector<std::uint8_t>(4)}; },
+                                    1024, m_pool);
+
+    // Act
+    auto handle = loader.load("short.png");
+    waitDecoded(loader, *handle);
+
+    // Assert
+    EXPECT_EQ(handle->getState(), OpenGLTextureHandle::State::FAILED);
+    EXPECT_THAT(handle->getError(), ::testing::HasSubstr("ERROR::TEXTURE::INVALID_IMAGE\nshort.png: 2x2 with 4 bytes"));
+}
+
+TEST_F(AsyncTextureLoaderTests, Update_UploadsCompressedLevels)
+{
+    // Arrange: a 8x4 BC1 chain of 16, 8, 8 and 8 bytes, two levels a frame
+    OpenGLAsyncTextureLoader loader([](const std::string &)
+                                    { return DecodedImage{8, 4, {}, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, {std::vector<std::uint8_t>(16), std::vector<std::uint8_t>(8), std::vector<std::uint8_t>(8), std::vector<std::uint8_t>(8)}}; },
+                                    24, m_pool);
+
+    // Expect: the stored levels, without generated mipmaps
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexParameteri_mock).Times(::testing::AnyNumber());
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexParameteri_mock(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 3)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompressedTexImage2D_mock(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 8, 4, 0, 16, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompressedTexImage2D_mock(GL_TEXTURE_2D, 1, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 4, 2, 0, 8, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompressedTexImage2D_mock(GL_TEXTURE_2D, 2, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 2, 1, 0, 8, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompressedTexImage2D_mock(GL_TEXTURE_2D, 3, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 1, 1, 0, 8, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenerateMipmap_mock).Times(0);
+
+    // Act
+    auto handle = loader.load("bc1.png");
+    waitDecoded(loader, *handle);
+
+    // Assert: the decoding frame uploaded the first two levels
+    EXPECT_EQ(handle->getState(), OpenGLTextureHandle::State::UPLOADING);
+    EXPECT_EQ(loader.update(), 16);
+    EXPECT_TRUE(handle->isReady());
+    EXPECT_EQ(handle->getCompressedBytes(), 40);
+}
+
+TEST_F(AsyncTextureLoaderTests, Update_SplitsLargeCompressedLevel)
+{
+    // Arrange: a 8x12 BC1 base level of three rows of blocks of 16 bytes, filled with their index, then a 4x6 level of 16 bytes
+    std::vector<std::uint8_t> base(48);
+    for (std::size_t byte = 0; byte < base.size(); ++byte)
+    {
+        base[byte] = static_cast<std::uint8_t>(byte / 16);
+    }
+    OpenGLAsyncTextureLoader loader([&base](const std::string &)
+                                    { return DecodedImage{8, 12, {}, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, {base, std::vector<std::uint8_t>(16, 9)}}; },
+                                    32, m_pool);
+    std::vector<std::uint8_t> staged;
+
+    // Expect: the base level allocated, then filled two rows of blocks the first frame and the last one the next
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glMapBufferRange_mock).WillRepeatedly(::testing::Return(nullptr));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glBufferSubData_mock(GL_PIXEL_UNPACK_BUFFER, 0, ::testing::_, ::testing::_))
+        .WillRepeatedly([&staged](GLenum, GLintptr, GLsizeiptr, const void *data)
+                        { staged.push_back(*static_cast<const std::uint8_t *>(data)); });
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompressedTexImage2D_mock(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 8, 12, 0, 48, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompressedTexSubImage2D_mock(GL_TEXTURE_2D, 0, 0, 0, 8, 8, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 32, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompressedTexSubImage2D_mock(GL_TEXTURE_2D, 0, 0, 8, 8, 4, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 16, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glCompressedTexImage2D_mock(GL_TEXTURE_2D, 1, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 4, 6, 0, 16, nullptr)).Times(1);
+
+    // Act
+    auto handle = loader.load("bc1.png");
+    waitDecoded(loader, *handle);
+
+    // Assert: no frame goes over the budget
+    EXPECT_EQ(handle->getState(), OpenGLTextureHandle::State::UPLOADING);
+    EXPECT_EQ(loader.update(), 32);
+    EXPECT_TRUE(handle->isReady());
+    EXPECT_EQ(staged, (std::vector<std::uint8_t>{0, 2, 9}));
+}
+
+TEST_F(AsyncTextureLoaderTests, Destroy_DeletesTextures)
+{
+    // Expect: the placeholder, then the texture with its handle
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteTextures_mock(1, ::testing::_)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteBuffers_mock(1, ::testing::_)).Times(1);
+
+    // Act
+    std::shared_ptr<OpenGLTextureHandle> handle;
+    {
+        OpenGLAsyncTextureLoader loader(decode, 1024, m_pool);
+        handle = loader.load("2x2");
+        waitDecoded(loader, *handle);
+    }
+    handle.reset();
+}
+
+#endif // __mock_gl__
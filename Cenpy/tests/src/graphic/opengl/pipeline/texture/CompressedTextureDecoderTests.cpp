@@ -0,0 +1,162 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/texture/CompressedTextureDecoder.hpp>
+#include <graphic/texture/BlockCompressor.hpp>
+
+namespace mock = cenpy::mock;
+namespace vk_format = cenpy::graphic::texture::vk_format;
+using cenpy::graphic::opengl::pipeline::texture::DecodedImage;
+using cenpy::graphic::opengl::pipeline::texture::OpenGLCompressedTextureDecoder;
+using cenpy::graphic::texture::BlockCompressor;
+using cenpy::graphic::texture::Ktx2;
+
+class CompressedTextureDecoderTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "cenpy-compressed-texture-test";
+        std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        std::filesystem::remove_all(m_directory);
+    }
+
+    static void supportS3tc(bool supported)
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glewIsSupported_mock(::testing::StrEq("GL_EXT_texture_compression_s3tc")))
+            .WillByDefault(::testing::Return(supported ? GL_TRUE : GL_FALSE));
+    }
+
+    // KTX2 of an opaque 8x8 image, stored as the converter does.
+    static std::vector<std::uint8_t> opaqueKtx2(bool bottomUp = true)
+    {
+        cenpy::graphic::texture::CompressedImage image = BlockCompressor::compress(std::vector<std::uint8_t>(8 * 8 * 4, 255), 8, 8);
+        image.bottomUp = bottomUp;
+        return Ktx2::write(image);
+    }
+
+    // Writes a KTX2 next to "image.png".
+    void writeKtx2(const std::vector<std::uint8_t> &content) const
+    {
+        std::ofstream file(m_directory / "image.ktx2", std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(content.data()), static_cast<std::streamsize>(content.size()));
+    }
+
+    static DecodedImage fallback(const std::string &)
+    {
+        return DecodedImage{1, 1, {0, 0, 0, 255}};
+    }
+
+    [[nodiscard]] std::string source() const
+    {
+        return (m_directory / "image.png").string();
+    }
+
+    std::filesystem::path m_directory;
+};
+
+TEST_F(CompressedTextureDecoderTests, Decode_PrefersKtx2)
+{
+    // Arrange
+    supportS3tc(true);
+    writeKtx2(opaqueKtx2());
+    OpenGLCompressedTextureDecoder decoder(fallback);
+
+    // Act
+    DecodedImage image = decoder(source());
+
+    // Assert: 8x8, 4x4, 2x2, 1x1
+    EXPECT_EQ(image.compressedFormat, GL_COMPRESSED_RGB_S3TC_DXT1_EXT);
+    EXPECT_EQ(image.width, 8);
+    EXPECT_EQ(image.height, 8);
+    ASSERT_EQ(image.levels.size(), 4);
+    EXPECT_EQ(image.levels[0].size(), 32);
+    EXPECT_TRUE(image.rgba.empty());
+}
+
+TEST_F(CompressedTextureDecoderTests, Decode_UnsupportedFormatFallsBack)
+{
+    // Arrange
+    supportS3tc(false);
+    writeKtx2(opaqueKtx2());
+    OpenGLCompressedTextureDecoder decoder(fallback);
+
+    // Act
+    DecodedImage image = decoder(source());
+
+    // Assert
+    EXPECT_EQ(decoder.getInternalFormat(vk_format::BC1_RGB_UNORM), 0);
+    EXPECT_EQ(image.compressedFormat, 0);
+    EXPECT_EQ(image.rgba.size(), 4);
+}
+
+TEST_F(CompressedTextureDecoderTests, Decode_KeepsBottomRowFirst)
+{
+    // Arrange: 4x8 image, black bottom half then white top half, rows bottom first as the fallback gives them
+    supportS3tc(true);
+    std::vector<std::uint8_t> rgba(4 * 8 * 4, 255);
+    for (std::size_t byte = 0; byte < 4 * 4 * 4; byte += 4)
+    {
+        rgba[byte] = rgba[byte + 1] = rgba[byte + 2] = 0;
+    }
+    cenpy::graphic::texture::CompressedImage compressed = BlockCompressor::compress(rgba, 4, 8);
+    compressed.bottomUp = true;
+    writeKtx2(Ktx2::write(compressed));
+    const std::vector<std::uint8_t> black = BlockCompressor::compress(std::vector<std::uint8_t>(rgba.begin(), rgba.begin() + 4 * 4 * 4), 4, 4).levels[0].data;
+    OpenGLCompressedTextureDecoder decoder(fallback);
+
+    // Act
+    DecodedImage image = decoder(source());
+
+    // Assert: the first row of blocks uploaded is the bottom, black one
+    ASSERT_EQ(image.compressedFormat, GL_COMPRESSED_RGB_S3TC_DXT1_EXT);
+    ASSERT_EQ(image.levels[0].size(), 16);
+    EXPECT_EQ(std::vector<std::uint8_t>(image.levels[0].begin(), image.levels[0].begin() + 8), black);
+    EXPECT_NE(std::vector<std::uint8_t>(image.levels[0].begin() + 8, image.levels[0].end()), black);
+}
+
+TEST_F(CompressedTextureDecoderTests, Decode_TopDownKtx2FallsBack)
+{
+    // Arrange: written by a tool keeping the top row first
+    supportS3tc(true);
+    writeKtx2(opaqueKtx2(false));
+    OpenGLCompressedTextureDecoder decoder(fallback);
+
+    // Act
+    DecodedImage image = decoder(source());
+
+    // Assert
+    EXPECT_EQ(image.compressedFormat, 0);
+    EXPECT_EQ(image.rgba.size(), 4);
+}
+
+TEST_F(CompressedTextureDecoderTests, Decode_MissingOrBrokenKtx2FallsBack)
+{
+    // Arrange
+    supportS3tc(true);
+    OpenGLCompressedTextureDecoder decoder(fallback);
+
+    // Act
+    DecodedImage missing = decoder(source());
+    writeKtx2({1, 2, 3});
+    DecodedImage broken = decoder(source());
+
+    // Assert
+    EXPECT_EQ(missing.compressedFormat, 0);
+    EXPECT_EQ(broken.compressedFormat, 0);
+    EXPECT_EQ(broken.rgba.size(), 4);
+}
+
+#endif // __mock_gl__
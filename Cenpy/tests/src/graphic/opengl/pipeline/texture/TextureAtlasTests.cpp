@@ -0,0 +1,166 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <vector>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/texture/TextureAtlas.hpp>
+#include <TestUtils.hpp>
+
+namespace mock = cenpy::mock;
+using cenpy::graphic::opengl::pipeline::texture::OpenGLTextureAtlas;
+using cenpy::test::utils::expectSpecificError;
+
+class TextureAtlasTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenTextures_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *texture)
+                           { *texture = ++m_lastTexture; });
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+
+    static std::vector<std::uint8_t> image(int width, int height, std::uint8_t value = 0)
+    {
+        return std::vector<std::uint8_t>(static_cast<std::size_t>(width) * height * 4, value);
+    }
+
+    GLuint m_lastTexture = 0;
+};
+
+TEST_F(TextureAtlasTests, Add_SharesPage)
+{
+    // Arrange
+    OpenGLTextureAtlas atlas(64, 1);
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glGenTextures_mock(1, ::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexImage2D_mock(GL_TEXTURE_2D, 0, GL_RGBA8, 64, 64, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexSubImage2D_mock(GL_TEXTURE_2D, 0, 0, 0, 10, 10, GL_RGBA, GL_UNSIGNED_BYTE, ::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexSubImage2D_mock(GL_TEXTURE_2D, 0, 10, 0, 10, 10, GL_RGBA, GL_UNSIGNED_BYTE, ::testing::_)).Times(1);
+
+    // Act
+    const auto &smile = atlas.add("smile", 8, 8, image(8, 8));
+    const auto &frown = atlas.add("frown", 8, 8, image(8, 8));
+
+    // Assert: the images share the page, inside their border
+    EXPECT_EQ(atlas.getPagesCount(), 1);
+    EXPECT_EQ(smile.texture, frown.texture);
+    EXPECT_FLOAT_EQ(smile.uvRect[0], 1.0f / 64.0f);
+    EXPECT_FLOAT_EQ(smile.uvRect[2], 9.0f / 64.0f);
+    EXPECT_FLOAT_EQ(frown.uvRect[0], 11.0f / 64.0f);
+    EXPECT_EQ(atlas.find("frown"), &frown);
+    EXPECT_EQ(atlas.find("missing"), nullptr);
+}
+
+TEST_F(TextureAtlasTests, Add_RepeatsEdgesInBorder)
+{
+    // Arrange
+    OpenGLTextureAtlas atlas(16, 1);
+    std::vector<std::uint8_t> pixels{1, 1, 1, 1, 2, 2, 2, 2};
+    std::vector<std::uint8_t> uploaded;
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glTexSubImage2D_mock(GL_TEXTURE_2D, 0, 0, 0, 4, 3, GL_RGBA, GL_UNSIGNED_BYTE, ::testing::_))
+        .WillOnce([&uploaded](GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum, GLenum, const void *data)
+                  { uploaded.assign(static_cast<const std::uint8_t *>(data), static_cast<const std::uint8_t *>(data) + width * height * 4); });
+
+    // Act
+    atlas.add("line", 2, 1, pixels);
+
+    // Assert: each row is 1 1 2 2, every row repeats the single one
+    ASSERT_EQ(uploaded.size(), 4 * 3 * 4);
+    for (int row = 0; row < 3; ++row)
+    {
+        EXPECT_EQ(uploaded[row * 16 + 0], 1);
+        EXPECT_EQ(uploaded[row * 16 + 4], 1);
+        EXPECT_EQ(uploaded[row * 16 + 8], 2);
+        EXPECT_EQ(uploaded[row * 16 + 12], 2);
+    }
+}
+
+TEST_F(TextureAtlasTests, Add_NewPageWhenFull)
+{
+    // Arrange
+    OpenGLTextureAtlas atlas(16, 0);
+    atlas.add("first", 16, 16, image(16, 16));
+
+    // Act
+    const auto &second = atlas.add("second", 16, 16, image(16, 16));
+
+    // Assert
+    EXPECT_EQ(atlas.getPagesCount(), 2);
+    EXPECT_EQ(second.texture, 2);
+}
+
+TEST_F(TextureAtlasTests, Add_RepacksFragmentedPage)
+{
+    // Arrange: the removed 8x16 column is a hole under the skyline
+    OpenGLTextureAtlas atlas(16, 0);
+    atlas.add("left", 8, 16, image(8, 16));
+    atlas.add("top", 8, 8, image(8, 8));
+    atlas.add("bottom", 8, 8, image(8, 8));
+    atlas.remove("left");
+
+    // Act
+    const auto &swapped = atlas.add("swapped", 8, 16, image(8, 16));
+
+    // Assert: no page was created, the remaining images moved
+    EXPECT_EQ(atlas.getPagesCount(), 1);
+    EXPECT_EQ(atlas.getRepacks(), 1);
+    EXPECT_EQ(atlas.getImagesCount(), 3);
+    EXPECT_EQ(swapped.texture, 1);
+    EXPECT_FLOAT_EQ(swapped.uvRect[0], 0.0f);
+    EXPECT_FLOAT_EQ(atlas.find("top")->uvRect[0], 0.5f);
+}
+
+TEST_F(TextureAtlasTests, Add_ReplacesImageOfSameName)
+{
+    // Arrange
+    OpenGLTextureAtlas atlas(16, 0);
+    atlas.add("face", 16, 16, image(16, 16));
+
+    // Act: the page emptied by the replaced image is reused
+    atlas.add("face", 16, 16, image(16, 16, 255));
+
+    // Assert
+    EXPECT_EQ(atlas.getPagesCount(), 1);
+    EXPECT_EQ(atlas.getImagesCount(), 1);
+}
+
+TEST_F(TextureAtlasTests, Add_InvalidImage)
+{
+    // Arrange
+    OpenGLTextureAtlas atlas(16, 1);
+
+    // Act & Assert
+    expectSpecificError([&atlas]()
+                        { atlas.add("wrong", 2, 2, image(1, 1)); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::TEXTURE_ATLAS::INVALID_IMAGE\nwrong: 2x2 with 4 bytes"));
+    expectSpecificError([&atlas]()
+                        { atlas.add("large", 15, 15, image(15, 15)); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::TEXTURE_ATLAS::IMAGE_TOO_LARGE\nlarge: 15x15 in pages of 16"));
+}
+
+TEST_F(TextureAtlasTests, Destroy_DeletesPages)
+{
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteTextures_mock(1, ::testing::_)).Times(2);
+
+    // Act
+    {
+        OpenGLTextureAtlas atlas(16, 0);
+        atlas.add("first", 16, 16, image(16, 16));
+        atlas.add("second", 16, 16, image(16, 16));
+    }
+}
+
+#endif // __mock_gl__
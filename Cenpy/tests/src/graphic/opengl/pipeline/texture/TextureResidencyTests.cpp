@@ -0,0 +1,186 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/opengl/pipeline/texture/TextureResidency.hpp>
+
+namespace mock = cenpy::mock;
+using cenpy::common::thread::WorkerPool;
+using cenpy::graphic::opengl::pipeline::texture::DecodedImage;
+using cenpy::graphic::opengl::pipeline::texture::OpenGLAsyncTextureLoader;
+using cenpy::graphic::opengl::pipeline::texture::OpenGLTextureResidency;
+
+class TextureResidencyTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(*mock::opengl::glFunctionMock::instance(), glGenTextures_mock(1, ::testing::_))
+            .WillByDefault([this](GLsizei, GLuint *texture)
+                           { *texture = ++m_lastTexture; });
+    }
+
+    void TearDown() override
+    {
+        mock::opengl::glFunctionMock::reset();
+        cenpy::graphic::opengl::pipeline::cache::OpenGLStateCache::current().invalidate();
+    }
+
+    // Decodes "<name>:WxH" into a blank image, failing while s_failures is positive.
+    static DecodedImage decode(const std::string &path)
+    {
+        if (s_failures.load() > 0)
+        {
+            --s_failures;
+            throw std::runtime_error("ERROR::TEXTURE::DECODE_FAILED");
+        }
+        DecodedImage image;
+        std::sscanf(path.c_str() + path.find(':') + 1, "%dx%d", &image.width, &image.height);
+        image.rgba.resize(static_cast<std::size_t>(image.width) * image.height * 4);
+        return image;
+    }
+
+    // Ends frames, using the given textures, until the loader has nothing pending.
+    void settle(OpenGLTextureResidency &residency, const std::vector<std::string> &paths)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        do
+        {
+            for (const auto &path : paths)
+            {
+                residency.use(path);
+            }
+            residency.update();
+            std::this_thread::yield();
+        } while (m_loader.getPendingCount() != 0 && std::chrono::steady_clock::now() < deadline);
+    }
+
+    static inline std::atomic<int> s_failures = 0;
+    WorkerPool m_pool{1};
+    GLuint m_lastTexture = 0;
+    OpenGLAsyncTextureLoader m_loader{decode, 1 << 20, m_pool};
+};
+
+TEST_F(TextureResidencyTests, TextureBytes_CountsMipChain)
+{
+    // Act & Assert
+    EXPECT_EQ(OpenGLTextureResidency::textureBytes(4, 4), (16 + 4 + 1) * 4);
+    EXPECT_EQ(OpenGLTextureResidency::textureBytes(4, 1), (4 + 2 + 1) * 4);
+    EXPECT_EQ(OpenGLTextureResidency::textureBytes(1, 1), 4);
+}
+
+TEST_F(TextureResidencyTests, Use_AccountsReadyTexture)
+{
+    // Arrange
+    OpenGLTextureResidency residency(m_loader, 1024);
+
+    // Act
+    GLuint first = residency.use("a:4x4");
+    settle(residency, {"a:4x4"});
+
+    // Assert
+    EXPECT_EQ(first, m_loader.getPlaceholder());
+    EXPECT_TRUE(residency.isResident("a:4x4"));
+    EXPECT_NE(residency.use("a:4x4"), m_loader.getPlaceholder());
+    EXPECT_EQ(residency.getResidentBytes(), 84);
+    EXPECT_EQ(residency.getEvictions(), 0);
+}
+
+TEST_F(TextureResidencyTests, Update_EvictsLeastRecentlyUsed)
+{
+    // Arrange: two textures fit the budget, not three
+    OpenGLTextureResidency residency(m_loader, 200);
+    settle(residency, {"a:4x4"});
+    settle(residency, {"b:4x4"});
+
+    // Expect
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glDeleteTextures_mock(1, ::testing::_)).Times(1);
+
+    // Act
+    settle(residency, {"b:4x4", "c:4x4"});
+
+    // Assert
+    EXPECT_FALSE(residency.isResident("a:4x4"));
+    EXPECT_TRUE(residency.isResident("b:4x4"));
+    EXPECT_TRUE(residency.isResident("c:4x4"));
+    EXPECT_EQ(residency.getResidentBytes(), 168);
+    EXPECT_EQ(residency.getEvictions(), 1);
+    ::testing::Mock::VerifyAndClearExpectations(mock::opengl::glFunctionMock::instance().get());
+}
+
+TEST_F(TextureResidencyTests, Use_ReloadsEvictedTexture)
+{
+    // Arrange
+    OpenGLTextureResidency residency(m_loader, 100);
+    settle(residency, {"a:4x4"});
+    settle(residency, {"b:4x4"});
+    ASSERT_EQ(residency.getEvictions(), 1);
+
+    // Act
+    GLuint reloading = residency.use("a:4x4");
+    settle(residency, {"a:4x4"});
+
+    // Assert: b made room for a
+    EXPECT_EQ(reloading, m_loader.getPlaceholder());
+    EXPECT_TRUE(residency.isResident("a:4x4"));
+    EXPECT_EQ(residency.getReloads(), 1);
+    EXPECT_EQ(residency.getEvictions(), 2);
+}
+
+TEST_F(TextureResidencyTests, Update_KeepsTexturesUsedThisFrame)
+{
+    // Arrange
+    OpenGLTextureResidency residency(m_loader, 100);
+
+    // Act
+    settle(residency, {"a:4x4", "b:4x4"});
+
+    // Assert: over budget until a texture stops being used
+    EXPECT_EQ(residency.getResidentBytes(), 168);
+    EXPECT_EQ(residency.getEvictions(), 0);
+    residency.use("b:4x4");
+    residency.update();
+    EXPECT_EQ(residency.getResidentBytes(), 84);
+    EXPECT_TRUE(residency.isResident("b:4x4"));
+}
+
+TEST_F(TextureResidencyTests, SetBudget_EvictsAtEndOfFrame)
+{
+    // Arrange
+    OpenGLTextureResidency residency(m_loader, 1024);
+    settle(residency, {"a:4x4", "b:4x4"});
+
+    // Act
+    residency.setBudget(0);
+    residency.update();
+
+    // Assert
+    EXPECT_EQ(residency.getResidentBytes(), 0);
+    EXPECT_EQ(residency.getEvictions(), 2);
+}
+
+TEST_F(TextureResidencyTests, Update_RetriesFailedTexture)
+{
+    // Arrange
+    OpenGLTextureResidency residency(m_loader, 1024);
+    s_failures = 1;
+
+    // Act & Assert: the failed load is dropped, the next use loads the texture again
+    settle(residency, {"a:4x4"});
+    EXPECT_EQ(residency.getFailures(), 1);
+    EXPECT_NE(residency.getLastError().find("ERROR::TEXTURE::DECODE_FAILED"), std::string::npos);
+    EXPECT_FALSE(residency.isResident("a:4x4"));
+    settle(residency, {"a:4x4"});
+    EXPECT_EQ(residency.getFailures(), 1);
+    EXPECT_TRUE(residency.isResident("a:4x4"));
+    EXPECT_EQ(residency.getResidentBytes(), 84);
+}
+
+#endif // __mock_gl__
@@ -0,0 +1,100 @@
+#ifdef __mock_gl__
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <opengl/glFunctionMock.hpp>
+#include <graphic/Api.hpp>
+#include <graphic/opengl/validator/Validator.hpp>
+#include <graphic/opengl/context/PassContext.hpp>
+#include <graphic/opengl/context/AttributeContext.hpp>
+#include <graphic/opengl/pipeline/component/attribute/Binder.hpp>
+#include <graphic/opengl/pipeline/component/attribute/Setter.hpp>
+#include <graphic/opengl/pipeline/component/attribute/Unbinder.hpp>
+#include <graphic/opengl/pipeline/vertex/VertexLayout.hpp>
+#include <graphic/pipeline/Attribute.hpp>
+#include <TestUtils.hpp>
+
+namespace api = cenpy::graphic::api;
+namespace context = cenpy::graphic::opengl::context;
+using cenpy::graphic::opengl::pipeline::vertex::OpenGLVertexLayout;
+using cenpy::test::utils::expectSpecificError;
+
+class VertexLayoutTests : public ::testing::Test
+{
+protected:
+    static void addAttribute(context::OpenGLPassContext &pass, const std::string &name, GLuint location, GLenum type)
+    {
+        auto attributeContext = std::make_shared<context::OpenGLAttributeContext>();
+        attributeContext->setAttributeID(location);
+        attributeContext->setGLSize(1);
+        attributeContext->setGLType(type);
+        pass.addAttribute(name, std::make_shared<cenpy::graphic::pipeline::Attribute<api::OpenGL, cenpy::graphic::opengl::profile::Attribute::Classic>>(attributeContext));
+    }
+};
+
+TEST_F(VertexLayoutTests, Add_InterleavesAttributes)
+{
+    // Act
+    OpenGLVertexLayout layout;
+    layout.add("position", 3).add("uv", 2).add("color", 4, GL_UNSIGNED_BYTE, true);
+
+    // Assert
+    ASSERT_EQ(layout.getStride(), 24);
+    EXPECT_EQ(layout.find("position")->offset, 0);
+    EXPECT_EQ(layout.find("uv")->offset, 12);
+    EXPECT_EQ(layout.find("color")->offset, 20);
+    EXPECT_FALSE(layout.find("color")->isInteger());
+    EXPECT_EQ(layout.find("normal"), nullptr);
+}
+
+TEST_F(VertexLayoutTests, FromPass_InLocationOrder)
+{
+    // Arrange
+    context::OpenGLPassContext pass;
+    addAttribute(pass, "model", 2, GL_FLOAT_MAT4);
+    addAttribute(pass, "uv", 1, GL_FLOAT_VEC2);
+    addAttribute(pass, "position", 0, GL_FLOAT_VEC3);
+    addAttribute(pass, "material", 6, GL_INT);
+
+    // Act
+    OpenGLVertexLayout layout = OpenGLVertexLayout::fromPass(pass);
+
+    // Assert
+    ASSERT_EQ(layout.getElements().size(), 4);
+    EXPECT_EQ(layout.getElements()[0].name, "position");
+    EXPECT_EQ(layout.getElements()[1].offset, 12);
+    EXPECT_EQ(layout.getElements()[2].locations, 4);
+    EXPECT_EQ(layout.getElements()[2].offset, 20);
+    EXPECT_TRUE(layout.getElements()[3].isInteger());
+    EXPECT_EQ(layout.getStride(), 12 + 8 + 64 + 4);
+}
+
+TEST_F(VertexLayoutTests, FromPass_SameAttributesSameSignature)
+{
+    // Arrange
+    context::OpenGLPassContext first;
+    context::OpenGLPassContext second;
+    context::OpenGLPassContext third;
+    addAttribute(first, "position", 0, GL_FLOAT_VEC3);
+    addAttribute(second, "position", 0, GL_FLOAT_VEC3);
+    addAttribute(third, "position", 0, GL_FLOAT_VEC4);
+
+    // Act & Assert
+    EXPECT_EQ(OpenGLVertexLayout::fromPass(first).getSignature(), OpenGLVertexLayout::fromPass(second).getSignature());
+    EXPECT_NE(OpenGLVertexLayout::fromPass(first).getSignature(), OpenGLVertexLayout::fromPass(third).getSignature());
+}
+
+TEST_F(VertexLayoutTests, FromPass_UnsupportedType)
+{
+    // Arrange
+    context::OpenGLPassContext pass;
+    addAttribute(pass, "flag", 0, GL_BOOL);
+
+    // Act & Assert
+    expectSpecificError([&pass]()
+                        { static_cast<void>(OpenGLVertexLayout::fromPass(pass)); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>(std::format("ERROR::VERTEX_LAYOUT::UNSUPPORTED_TYPE\n{:#x}", GL_BOOL)));
+}
+
+#endif // __mock_gl__
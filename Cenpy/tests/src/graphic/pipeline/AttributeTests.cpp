@@ -1,4 +1,6 @@
 #include <any>
+#include <array>
+#include <span>
 #include <iostream>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -68,6 +70,26 @@ TEST_F(AttributeTest, SetTest)
     ASSERT_NO_THROW(attribute.set(std::make_shared<int>(1)));
 }
 
+TEST_F(AttributeTest, SetValuesTest_ValuesForgottenOnceUploaded)
+{
+    // Arrange
+    auto attributeContext = std::make_shared<api::MockOpenGL::AttributeContext>();
+    pipeline::Attribute<api::MockOpenGL, Classic> attribute(attributeContext);
+    const std::array<int, 3> values{1, 2, 3};
+
+    // Expect calls: the values are uploaded from the caller's memory
+    EXPECT_CALL(*mock::MockSetter<int>::instance(), mockOn(::testing::_))
+        .WillOnce([&values](auto context)
+                  { EXPECT_EQ(context->getBytes().data(), reinterpret_cast<const std::byte *>(values.data())); });
+
+    // Act
+    attribute.set(std::span<const int>(values));
+
+    // Assert
+    ASSERT_TRUE(attributeContext->getBytes().empty());
+    ASSERT_EQ(attributeContext->getStride(), sizeof(int));
+}
+
 TEST_F(AttributeTest, GetContextTest)
 {
     // Arrange
@@ -15,6 +15,10 @@
 #include <graphic/opengl/pipeline/component/pass/MockUser.hpp>
 #include <graphic/opengl/pipeline/component/pass/MockFreer.hpp>
 #include <graphic/opengl/pipeline/component/pass/MockLoader.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockBinaryLoader.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockLinker.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockPoller.hpp>
+#include <graphic/opengl/pipeline/component/pass/MockWaiter.hpp>
 #include <graphic/pipeline/MockShader.hpp>
 #include <graphic/pipeline/MockUniform.hpp>
 #include <graphic/pipeline/MockAttribute.hpp>
@@ -28,11 +32,15 @@ namespace pipeline = cenpy::graphic::pipeline;
 namespace mock = cenpy::mock;
 
 using mock::graphic::opengl::pipeline::component::pass::MockAttributeReader;
+using mock::graphic::opengl::pipeline::component::pass::MockBinaryLoader;
+using mock::graphic::opengl::pipeline::component::pass::MockLinker;
+using mock::graphic::opengl::pipeline::component::pass::MockPoller;
 using mock::graphic::opengl::pipeline::component::pass::MockFreer;
 using mock::graphic::opengl::pipeline::component::pass::MockLoader;
 using mock::graphic::opengl::pipeline::component::pass::MockShaderAttacher;
 using mock::graphic::opengl::pipeline::component::pass::MockUniformReader;
 using mock::graphic::opengl::pipeline::component::pass::MockUser;
+using mock::graphic::opengl::pipeline::component::pass::MockWaiter;
 using mock::graphic::pipeline::MockAttribute;
 using mock::graphic::pipeline::MockShader;
 using mock::graphic::pipeline::MockUniform;
@@ -51,6 +59,10 @@ public:
         MockUniformReader<Classic>::reset();
         MockUser<Classic>::reset();
         MockAttributeReader<Classic>::reset();
+        MockBinaryLoader<Classic>::reset();
+        MockLinker<Classic>::reset();
+        MockPoller<Classic>::reset();
+        MockWaiter<Classic>::reset();
     }
 };
 
@@ -68,6 +80,59 @@ TEST_F(PassTest, LoadPass)
     ASSERT_NO_THROW(pass.load());
 }
 
+TEST_F(PassTest, LoadPass_FromBinary)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+
+    // Expect calls: a cached binary skips compiling and linking, but not the reflection
+    EXPECT_CALL(*api::MockOpenGL::PassContext::BinaryLoader<Classic>::instance(), mockOn(::testing::_)).WillOnce(::testing::Invoke([](std::shared_ptr<api::MockOpenGL::PassContext> context)
+                                                                                                                                   { context->setLoadedFromBinary(true); }));
+    EXPECT_CALL(*mockShader, load()).Times(0);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Loader<Classic>::instance(), mockOn(::testing::_)).Times(0);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::UniformReader<Classic>::instance(), mockOn(::testing::_)).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(pass.load());
+}
+
+TEST_F(PassTest, LoadAsync_PendingUntilPolledReady)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+    bool linked = false;
+
+    // Expect calls: the shaders are compiled without waiting, the reflection waits for the link
+    EXPECT_CALL(*mockShader, compile()).Times(1);
+    EXPECT_CALL(*mockShader, load()).Times(0);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Loader<Classic>::instance(), mockOn(::testing::_)).Times(0);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Linker<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Poller<Classic>::instance(), mockOn(::testing::_)).Times(2).WillRepeatedly(::testing::Invoke([&linked](std::shared_ptr<api::MockOpenGL::PassContext> context)
+                                                                                                                                               {
+                                                                                                                                                   if (linked)
+                                                                                                                                                   {
+                                                                                                                                                       context->setLoadState(cenpy::graphic::context::PassLoadState::READY);
+                                                                                                                                                   } }));
+
+    // Act & Assert
+    pass.loadAsync();
+    ASSERT_TRUE(pass.isPending());
+
+    EXPECT_CALL(*api::MockOpenGL::PassContext::UniformReader<Classic>::instance(), mockOn(::testing::_)).Times(0);
+    ASSERT_FALSE(pass.poll());
+    ::testing::Mock::VerifyAndClearExpectations(api::MockOpenGL::PassContext::UniformReader<Classic>::instance().get());
+
+    linked = true;
+    EXPECT_CALL(*api::MockOpenGL::PassContext::UniformReader<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    ASSERT_TRUE(pass.poll());
+    ASSERT_TRUE(pass.isReady());
+
+    // A ready pass is not polled again
+    ASSERT_TRUE(pass.poll());
+}
+
 TEST_F(PassTest, WithUniforms)
 {
     // Arrange
@@ -86,6 +151,34 @@ TEST_F(PassTest, WithUniforms)
     ASSERT_NO_THROW(pass.withUniform("test", 1.0f));
 }
 
+TEST_F(PassTest, WithUniforms_Chaining)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto mockFloatUniform = std::make_shared<MockUniform<api::MockOpenGL>>();
+    auto mockIntUniform = std::make_shared<MockUniform<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+
+    // Expect calls
+    EXPECT_CALL(*api::MockOpenGL::PassContext::UniformReader<Classic>::instance(), mockOn(::testing::_)).WillOnce(::testing::Invoke([&](std::shared_ptr<context::PassContext<api::MockOpenGL>> context)
+                                                                                                                                    {
+                                                                                                                                        context->addUniform("float", mockFloatUniform);
+                                                                                                                                        context->addUniform("int", mockIntUniform); }));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniform1f_mock(::testing::_, ::testing::_)).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniform1i_mock(::testing::_, ::testing::_)).Times(1);
+    // Chaining must not copy the pass: the program is only freed when the pass is destroyed
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Freer<Classic>::instance(), mockOn(::testing::_)).Times(1);
+
+    pass.load();
+    pipeline::UniformHandle intHandle = pass.getUniformHandle("int");
+
+    // Act
+    pipeline::IPass<api::MockOpenGL> &chained = pass.withUniform("float", 1.0f).withUniform(intHandle, 2);
+
+    // Assert
+    ASSERT_EQ(&chained, &pass);
+}
+
 TEST_F(PassTest, WithUniforms_NoUniform)
 {
     // Arrange
@@ -100,6 +193,273 @@ TEST_F(PassTest, WithUniforms_NoUniform)
                         cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::SHADER::UNIFORM_NOT_FOUND"));
 }
 
+TEST_F(PassTest, SetUniformByHandle)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto mockUniform = std::make_shared<MockUniform<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+
+    // Expect calls
+    EXPECT_CALL(*api::MockOpenGL::PassContext::UniformReader<Classic>::instance(), mockOn(::testing::_)).WillOnce(::testing::Invoke([&](std::shared_ptr<context::PassContext<api::MockOpenGL>> context)
+                                                                                                                                    { context->addUniform("test", mockUniform); }));
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniform1f_mock(::testing::_, ::testing::_)).Times(2);
+
+    pass.load();
+    pipeline::UniformHandle handle = pass.getUniformHandle("test");
+
+    // Act
+    ASSERT_TRUE(handle.isValid());
+    ASSERT_NO_THROW(pass.setUniform(handle, 1.0f));
+    ASSERT_NO_THROW(pass.setUniform(handle, 2.0f));
+    ASSERT_EQ(mockUniform->get<float>(), 2.0f);
+}
+
+TEST_F(PassTest, DeferredUniforms_StagedUntilCommit)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto mockUniform = std::make_shared<MockUniform<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+
+    // Expect calls
+    EXPECT_CALL(*api::MockOpenGL::PassContext::UniformReader<Classic>::instance(), mockOn(::testing::_)).WillOnce(::testing::Invoke([&](std::shared_ptr<context::PassContext<api::MockOpenGL>> context)
+                                                                                                                                    { context->addUniform("test", mockUniform); }));
+
+    pass.load();
+    pass.deferUniforms();
+
+    // Act: only the last staged value is uploaded, once, at commit
+    {
+        EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniform1f_mock(::testing::_, ::testing::_)).Times(0);
+        pass.withUniform("test", 1.0f).withUniform("test", 2.0f);
+        ::testing::Mock::VerifyAndClearExpectations(mock::opengl::glFunctionMock::instance().get());
+    }
+    ASSERT_EQ(pass.getContext()->getPendingUniformsCount(), 1);
+
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniform1f_mock(::testing::_, ::testing::_)).Times(1);
+    pass.getContext()->commitUniforms();
+    pass.getContext()->commitUniforms();
+
+    // Assert
+    ASSERT_EQ(pass.getContext()->getPendingUniformsCount(), 0);
+    ASSERT_EQ(mockUniform->get<float>(), 2.0f);
+}
+
+TEST_F(PassTest, Reload_KeepsUniformValues)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto loadedUniform = std::make_shared<MockUniform<api::MockOpenGL>>();
+    auto reloadedUniform = std::make_shared<MockUniform<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+
+    // Expect calls: the uniforms are reflected again from the relinked program
+    EXPECT_CALL(*api::MockOpenGL::PassContext::UniformReader<Classic>::instance(), mockOn(::testing::_))
+        .WillOnce(::testing::Invoke([&](std::shared_ptr<context::PassContext<api::MockOpenGL>> context)
+                                    { context->addUniform("test", loadedUniform); }))
+        .WillOnce(::testing::Invoke([&](std::shared_ptr<context::PassContext<api::MockOpenGL>> context)
+                                    { context->addUniform("test", reloadedUniform); }));
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Loader<Classic>::instance(), mockOn(::testing::_)).Times(2);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniform1f_mock(::testing::_, ::testing::_)).Times(2);
+
+    pass.load();
+    pipeline::UniformHandle handle = pass.getUniformHandle("test");
+    pass.setUniform(handle, 2.0f);
+
+    // Act
+    pass.reload();
+
+    // Assert: the value is restored and uploaded on the next use
+    ASSERT_EQ(pass.getUniformHandle("test"), handle);
+    ASSERT_EQ(pass.getContext()->getUniform(handle), reloadedUniform.get());
+    ASSERT_EQ(reloadedUniform->get<float>(), 2.0f);
+    ASSERT_EQ(pass.getContext()->getPendingUniformsCount(), 1);
+    pass.getContext()->commitUniforms();
+    ASSERT_EQ(pass.getContext()->getPendingUniformsCount(), 0);
+}
+
+TEST_F(PassTest, Rebuild_ReplacesProgramOnceLinked)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto rebuiltShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto loadedUniform = std::make_shared<MockUniform<api::MockOpenGL>>();
+    auto rebuiltUniform = std::make_shared<MockUniform<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+
+    // Expect calls: the new program is only submitted, then reflected once linked
+    EXPECT_CALL(*api::MockOpenGL::PassContext::UniformReader<Classic>::instance(), mockOn(::testing::_))
+        .WillOnce(::testing::Invoke([&](std::shared_ptr<context::PassContext<api::MockOpenGL>> context)
+                                    { context->addUniform("test", loadedUniform); }))
+        .WillOnce(::testing::Invoke([&](std::shared_ptr<context::PassContext<api::MockOpenGL>> context)
+                                    { context->addUniform("test", rebuiltUniform); }));
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Loader<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Linker<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Poller<Classic>::instance(), mockOn(::testing::_)).WillOnce(::testing::Invoke([](std::shared_ptr<api::MockOpenGL::PassContext> context)
+                                                                                                                              { context->setLoadState(cenpy::graphic::context::PassLoadState::READY); }));
+    EXPECT_CALL(*rebuiltShader, compile()).Times(1);
+    EXPECT_CALL(*mock::opengl::glFunctionMock::instance(), glUniform1f_mock(::testing::_, ::testing::_)).Times(2);
+
+    pass.load();
+    pass.setUniform(pass.getUniformHandle("test"), 2.0f);
+    const auto loadedContext = pass.getContext();
+
+    // Act
+    auto rebuilt = pass.rebuild({rebuiltShader});
+    ASSERT_TRUE(rebuilt->isPending());
+    ASSERT_EQ(pass.getContext(), loadedContext);
+    ASSERT_TRUE(rebuilt->poll());
+    pass.replaceWith(*rebuilt);
+
+    // Assert: the pass uses the new program with the previous values, the former program goes with the rebuilt pass
+    ASSERT_EQ(pass.getShaders().front(), rebuiltShader);
+    ASSERT_EQ(pass.getContext()->getUniform(pass.getUniformHandle("test")), rebuiltUniform.get());
+    ASSERT_EQ(rebuiltUniform->get<float>(), 2.0f);
+    ASSERT_EQ(pass.getContext()->getPendingUniformsCount(), 1);
+    ASSERT_EQ(rebuilt->getContext(), loadedContext);
+    pass.getContext()->commitUniforms();
+}
+
+TEST_F(PassTest, Rebuild_VariantsFollowNewShaders)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto rebuiltShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto staleVariantShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto variantShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+    pass.withVariantKeys({"TINT", "MASK"});
+    ON_CALL(*api::MockOpenGL::PassContext::Poller<Classic>::instance(), mockOn(::testing::_)).WillByDefault(::testing::Invoke([](std::shared_ptr<api::MockOpenGL::PassContext> context)
+                                                                                                                                { context->setLoadState(cenpy::graphic::context::PassLoadState::READY); }));
+
+    // Expect calls: the variant requested after the reload is made of the new shaders
+    EXPECT_CALL(*mockShader, createVariant(std::vector<std::string>{"MASK"})).WillOnce(::testing::Return(staleVariantShader));
+    EXPECT_CALL(*rebuiltShader, createVariant(std::vector<std::string>{"MASK"})).WillOnce(::testing::Return(variantShader));
+
+    pass.load();
+    pass.variant({"MASK"});
+
+    // Act
+    auto rebuilt = pass.rebuild({rebuiltShader});
+    ASSERT_TRUE(rebuilt->poll());
+    pass.replaceWith(*rebuilt);
+    auto &variant = pass.variant({"MASK"});
+
+    // Assert: the keys survived, the former variant went away with the former program
+    ASSERT_EQ(pass.getVariantMask({"TINT", "MASK"}), 3);
+    ASSERT_EQ(variant.getShaders().front(), variantShader);
+    ASSERT_EQ(pass.getContext()->getVariantsCount(), 1);
+    ASSERT_EQ(rebuilt->getContext()->getVariantsCount(), 0);
+}
+
+TEST_F(PassTest, Variant_CompiledOnFirstUseAndCached)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto variantShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+    pass.withVariantKeys({"TINT", "MASK", "BLUR"});
+
+    // Expect calls: the macros follow the order of the keys
+    EXPECT_CALL(*mockShader, createVariant(std::vector<std::string>{"TINT", "BLUR"})).WillOnce(::testing::Return(variantShader));
+    EXPECT_CALL(*variantShader, load()).Times(1);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Loader<Classic>::instance(), mockOn(::testing::_)).Times(1);
+
+    // Act
+    auto &variant = pass.variant({"BLUR", "TINT"});
+    auto &cached = pass.variant(pass.getVariantMask({"TINT", "BLUR"}));
+
+    // Assert
+    ASSERT_EQ(&variant, &cached);
+    ASSERT_NE(&variant, &pass);
+    ASSERT_TRUE(variant.isReady());
+    ASSERT_EQ(variant.getShaders().front(), variantShader);
+    ASSERT_EQ(&pass.variant(0), &pass);
+    ASSERT_EQ(pass.getContext()->getVariantsCount(), 1);
+}
+
+TEST_F(PassTest, Variant_UnknownKey)
+{
+    // Arrange
+    pipeline::Pass<api::MockOpenGL, Classic> pass({});
+    pass.withVariantKeys({"TINT"});
+
+    // Act
+    expectSpecificError([&pass]()
+                        { pass.variant({"MASK"}); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::PASS::UNKNOWN_VARIANT_KEY\nMASK"));
+}
+
+TEST_F(PassTest, PrecompileVariants_SubmittedTogether)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+    pass.withVariantKeys({"TINT", "MASK"});
+    ON_CALL(*mockShader, createVariant(::testing::_)).WillByDefault(::testing::Invoke([](std::vector<std::string>)
+                                                                                      { return std::make_shared<MockShader<api::MockOpenGL>>(); }));
+    int submitted = 0;
+
+    // Expect calls: every link is submitted before the first one is waited for, in the driver rather than by polling
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Linker<Classic>::instance(), mockOn(::testing::_)).Times(2).WillRepeatedly(::testing::Invoke([&submitted](auto)
+                                                                                                                                               { ++submitted; }));
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Waiter<Classic>::instance(), mockOn(::testing::_)).Times(2).WillRepeatedly(::testing::Invoke([&submitted](std::shared_ptr<api::MockOpenGL::PassContext> context)
+                                                                                                                                               {
+                                                                                                                                                   ASSERT_EQ(submitted, 2);
+                                                                                                                                                   context->setLoadState(cenpy::graphic::context::PassLoadState::READY); }));
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Poller<Classic>::instance(), mockOn(::testing::_)).Times(0);
+    EXPECT_CALL(*api::MockOpenGL::PassContext::Loader<Classic>::instance(), mockOn(::testing::_)).Times(0);
+
+    // Act
+    pass.precompileVariants({pass.getVariantMask({"TINT"}), pass.getVariantMask({"TINT", "MASK"}), 0});
+
+    // Assert: precompiled variants are not compiled again on use
+    ASSERT_EQ(pass.getContext()->getVariantsCount(), 2);
+    ASSERT_TRUE(pass.variant({"MASK", "TINT"}).isReady());
+}
+
+TEST_F(PassTest, Free_DropsVariants)
+{
+    // Arrange
+    auto mockShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    pipeline::Pass<api::MockOpenGL, Classic> pass({mockShader});
+    pass.withVariantKeys({"TINT"});
+    ON_CALL(*mockShader, createVariant(::testing::_)).WillByDefault(::testing::Invoke([](std::vector<std::string>)
+                                                                                      { return std::make_shared<MockShader<api::MockOpenGL>>(); }));
+    pass.variant({"TINT"});
+
+    // Act
+    pass.free();
+
+    // Assert
+    ASSERT_EQ(pass.getContext()->getVariantsCount(), 0);
+}
+
+TEST_F(PassTest, GetUniformHandle_NoUniform)
+{
+    // Arrange
+    pipeline::Pass<api::MockOpenGL, Classic> pass({});
+    pass.load();
+
+    // Act
+    expectSpecificError([&pass]()
+                        { auto handle = pass.getUniformHandle("test"); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::SHADER::UNIFORM_NOT_FOUND"));
+}
+
+TEST_F(PassTest, SetUniform_InvalidHandle)
+{
+    // Arrange
+    pipeline::Pass<api::MockOpenGL, Classic> pass({});
+    pass.load();
+
+    // Act
+    expectSpecificError([&pass]()
+                        { pass.setUniform(pipeline::UniformHandle{}, 1.0f); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::SHADER::INVALID_UNIFORM_HANDLE"));
+}
+
 TEST_F(PassTest, UsePass)
 {
     // Arrange
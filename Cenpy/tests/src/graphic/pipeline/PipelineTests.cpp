@@ -9,9 +9,11 @@
 
 #include <graphic/pipeline/Pipeline.hpp>
 #include <graphic/pipeline/MockPass.hpp>
+#include <graphic/pipeline/MockShader.hpp>
 #include <graphic/opengl/context/MockPipelineContext.hpp>
 #include <graphic/opengl/pipeline/component/pipeline/MockUser.hpp>
 #include <graphic/opengl/pipeline/component/pipeline/MockResetter.hpp>
+#include <graphic/opengl/pipeline/component/pipeline/MockDrawer.hpp>
 #include <graphic/MockApi.hpp>
 #include <TestUtils.hpp>
 
@@ -20,8 +22,10 @@ namespace context = cenpy::graphic::context;
 namespace pipeline = cenpy::graphic::pipeline;
 namespace mock = cenpy::mock;
 
+using mock::graphic::opengl::pipeline::component::pipeline::MockDrawer;
 using mock::graphic::opengl::pipeline::component::pipeline::MockResetter;
 using mock::graphic::opengl::pipeline::component::pipeline::MockUser;
+using mock::graphic::pipeline::MockShader;
 using mock::graphic::pipeline::opengl::MockPass;
 
 using cenpy::graphic::opengl::profile::Pipeline::Classic;
@@ -45,6 +49,157 @@ TEST_F(PipelineTest, UseTest)
     pipeline.use(0); // Using first pass
 }
 
+TEST_F(PipelineTest, ReadShaders_SharedShaderReadOnce)
+{
+    // Arrange
+    auto sharedShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto firstShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto secondShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>> firstShaders{sharedShader, firstShader};
+    std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>> secondShaders{sharedShader, secondShader};
+    auto mockPass1 = std::make_shared<MockPass<api::MockOpenGL>>();
+    auto mockPass2 = std::make_shared<MockPass<api::MockOpenGL>>();
+    ON_CALL(*mockPass1, getShaders()).WillByDefault(::testing::ReturnRef(firstShaders));
+    ON_CALL(*mockPass2, getShaders()).WillByDefault(::testing::ReturnRef(secondShaders));
+    pipeline::Pipeline<api::MockOpenGL, Classic> pipeline({mockPass1, mockPass2});
+    cenpy::common::thread::WorkerPool pool(2);
+
+    // Expect calls
+    EXPECT_CALL(*sharedShader, read()).Times(1);
+    EXPECT_CALL(*firstShader, read()).Times(1);
+    EXPECT_CALL(*secondShader, read()).Times(1);
+
+    // Act
+    ASSERT_NO_THROW(pipeline.readShaders(pool));
+}
+
+TEST_F(PipelineTest, Reload_OnlyAffectedPasses)
+{
+    // Arrange
+    auto sharedShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto firstShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto secondShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto rebuiltShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>> firstShaders{sharedShader, firstShader};
+    std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>> secondShaders{sharedShader, secondShader};
+    std::vector<std::shared_ptr<api::MockOpenGL::ShaderContext>> contexts;
+    contexts.reserve(3); // The shaders return references to the elements
+    for (const auto &[shader, path] : {std::pair{sharedShader, "fullscreen.vert"}, {firstShader, "blur.frag"}, {secondShader, "tonemap.frag"}})
+    {
+        const auto &shaderContext = contexts.emplace_back(std::make_shared<api::MockOpenGL::ShaderContext>());
+        ON_CALL(*shaderContext, getShaderPath()).WillByDefault(::testing::ReturnRefOfCopy(std::string(path)));
+        ON_CALL(*shader, getContext()).WillByDefault(::testing::ReturnRef(shaderContext));
+    }
+    contexts[1]->setIncludes({"common/kernel.glsl"});
+    contexts[1]->setDefines({"WIDE"});
+    auto mockPass1 = std::make_shared<MockPass<api::MockOpenGL>>();
+    auto mockPass2 = std::make_shared<MockPass<api::MockOpenGL>>();
+    ON_CALL(*mockPass1, getShaders()).WillByDefault(::testing::ReturnRef(firstShaders));
+    ON_CALL(*mockPass2, getShaders()).WillByDefault(::testing::ReturnRef(secondShaders));
+    pipeline::Pipeline<api::MockOpenGL, Classic> pipeline({mockPass1, mockPass2});
+
+    // Expect calls: only the pass whose shader includes the file is rebuilt, from a new shader
+    EXPECT_CALL(*firstShader, createVariant(std::vector<std::string>{"WIDE"})).WillOnce(::testing::Return(rebuiltShader));
+    EXPECT_CALL(*sharedShader, createVariant(::testing::_)).Times(0);
+    EXPECT_CALL(*secondShader, createVariant(::testing::_)).Times(0);
+    EXPECT_CALL(*firstShader, reload()).Times(0);
+    EXPECT_CALL(*mockPass1, rebuild(std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>>{sharedShader, rebuiltShader}))
+        .WillOnce(::testing::Return(std::make_shared<MockPass<api::MockOpenGL>>()));
+    EXPECT_CALL(*mockPass2, rebuild(::testing::_)).Times(0);
+    EXPECT_CALL(*mockPass1, load()).Times(0);
+
+    // Act & Assert
+    ASSERT_EQ(pipeline.reload("common/./kernel.glsl"), 1);
+    ASSERT_TRUE(pipeline.isReloading());
+}
+
+TEST_F(PipelineTest, Reload_SharedShaderRebuiltOnce)
+{
+    // Arrange
+    auto sharedShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    auto rebuiltShader = std::make_shared<MockShader<api::MockOpenGL>>();
+    std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>> shaders{sharedShader};
+    std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>> rebuiltShaders{rebuiltShader};
+    auto shaderContext = std::make_shared<api::MockOpenGL::ShaderContext>();
+    ON_CALL(*shaderContext, getShaderPath()).WillByDefault(::testing::ReturnRefOfCopy(std::string("fullscreen.vert")));
+    ON_CALL(*sharedShader, getContext()).WillByDefault(::testing::ReturnRef(shaderContext));
+    auto mockPass1 = std::make_shared<MockPass<api::MockOpenGL>>();
+    auto mockPass2 = std::make_shared<MockPass<api::MockOpenGL>>();
+    ON_CALL(*mockPass1, getShaders()).WillByDefault(::testing::ReturnRef(shaders));
+    ON_CALL(*mockPass2, getShaders()).WillByDefault(::testing::ReturnRef(shaders));
+    pipeline::Pipeline<api::MockOpenGL, Classic> pipeline({mockPass1, mockPass2});
+
+    // Expect calls
+    EXPECT_CALL(*sharedShader, createVariant(::testing::_)).WillOnce(::testing::Return(rebuiltShader));
+    EXPECT_CALL(*mockPass1, rebuild(rebuiltShaders)).WillOnce(::testing::Return(std::make_shared<MockPass<api::MockOpenGL>>()));
+    EXPECT_CALL(*mockPass2, rebuild(rebuiltShaders)).WillOnce(::testing::Return(std::make_shared<MockPass<api::MockOpenGL>>()));
+
+    // Act & Assert
+    ASSERT_EQ(pipeline.reload("fullscreen.vert"), 2);
+}
+
+TEST_F(PipelineTest, PollReloads_KeepsProgramUntilLinked)
+{
+    // Arrange
+    auto shader = std::make_shared<MockShader<api::MockOpenGL>>();
+    std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>> shaders{shader};
+    auto shaderContext = std::make_shared<api::MockOpenGL::ShaderContext>();
+    ON_CALL(*shaderContext, getShaderPath()).WillByDefault(::testing::ReturnRefOfCopy(std::string("blur.frag")));
+    ON_CALL(*shader, getContext()).WillByDefault(::testing::ReturnRef(shaderContext));
+    ON_CALL(*shader, createVariant(::testing::_)).WillByDefault(::testing::Return(std::make_shared<MockShader<api::MockOpenGL>>()));
+    auto mockPass = std::make_shared<MockPass<api::MockOpenGL>>();
+    auto rebuiltPass = std::make_shared<MockPass<api::MockOpenGL>>();
+    ON_CALL(*mockPass, getShaders()).WillByDefault(::testing::ReturnRef(shaders));
+    pipeline::Pipeline<api::MockOpenGL, Classic> pipeline({mockPass});
+    const auto currentContext = mockPass->getContext();
+    const auto rebuiltContext = rebuiltPass->getContext();
+
+    // Expect calls: the link completes on the second frame
+    EXPECT_CALL(*mockPass, rebuild(::testing::_)).WillOnce(::testing::Return(rebuiltPass));
+    EXPECT_CALL(*rebuiltPass, poll()).WillOnce(::testing::Return(false)).WillOnce(::testing::Return(true));
+
+    // Act & Assert
+    ASSERT_EQ(pipeline.reload("blur.frag"), 1);
+    ASSERT_EQ(pipeline.pollReloads(), 0);
+    ASSERT_EQ(mockPass->getContext(), currentContext);
+    ASSERT_TRUE(pipeline.isReloading());
+    ASSERT_EQ(pipeline.pollReloads(), 1);
+    ASSERT_FALSE(pipeline.isReloading());
+
+    // Assert: the pass holds the new program, the former one is freed with the rebuilt pass
+    ASSERT_EQ(pipeline.forPass(0), mockPass);
+    ASSERT_EQ(mockPass->getContext(), rebuiltContext);
+    ASSERT_EQ(rebuiltPass->getContext(), currentContext);
+}
+
+TEST_F(PipelineTest, PollReloads_FailureKeepsProgram)
+{
+    // Arrange
+    auto shader = std::make_shared<MockShader<api::MockOpenGL>>();
+    std::vector<std::shared_ptr<pipeline::IShader<api::MockOpenGL>>> shaders{shader};
+    auto shaderContext = std::make_shared<api::MockOpenGL::ShaderContext>();
+    ON_CALL(*shaderContext, getShaderPath()).WillByDefault(::testing::ReturnRefOfCopy(std::string("blur.frag")));
+    ON_CALL(*shader, getContext()).WillByDefault(::testing::ReturnRef(shaderContext));
+    ON_CALL(*shader, createVariant(::testing::_)).WillByDefault(::testing::Return(std::make_shared<MockShader<api::MockOpenGL>>()));
+    auto mockPass = std::make_shared<MockPass<api::MockOpenGL>>();
+    auto rebuiltPass = std::make_shared<MockPass<api::MockOpenGL>>();
+    ON_CALL(*mockPass, getShaders()).WillByDefault(::testing::ReturnRef(shaders));
+    pipeline::Pipeline<api::MockOpenGL, Classic> pipeline({mockPass});
+    const auto currentContext = mockPass->getContext();
+
+    // Expect calls
+    EXPECT_CALL(*mockPass, rebuild(::testing::_)).WillOnce(::testing::Return(rebuiltPass));
+    EXPECT_CALL(*rebuiltPass, poll()).WillOnce(::testing::Throw(cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::SHADER::PROGRAM::LINKING_FAILED")));
+
+    // Act & Assert
+    ASSERT_EQ(pipeline.reload("blur.frag"), 1);
+    expectSpecificError([&pipeline]()
+                        { pipeline.pollReloads(); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::PIPELINE::RELOAD_FAILED\nPass 0: ERROR::SHADER::PROGRAM::LINKING_FAILED"));
+    ASSERT_FALSE(pipeline.isReloading());
+    ASSERT_EQ(mockPass->getContext(), currentContext);
+}
+
 TEST_F(PipelineTest, IteratePassesTest)
 {
     // Arrange
@@ -86,4 +241,60 @@ TEST_F(PipelineTest, GetContext)
 
     // Assert
     ASSERT_NE(context, nullptr);
-}
\ No newline at end of file
+}
+TEST_F(PipelineTest, Draw_SortedQueue)
+{
+    // Arrange
+    auto mockPass1 = std::make_shared<MockPass<api::MockOpenGL>>();
+    auto mockPass2 = std::make_shared<MockPass<api::MockOpenGL>>();
+    pipeline::Pipeline<api::MockOpenGL, Classic> pipeline({mockPass1, mockPass2});
+    cenpy::graphic::render::RenderQueue queue;
+    for (auto [pass, vertexArray] : {std::pair{1, 1u}, std::pair{0, 2u}, std::pair{1, 3u}, std::pair{0, 4u}})
+    {
+        cenpy::graphic::render::RenderCommand command;
+        command.pass = pass;
+        command.vertexArray = vertexArray;
+        queue.push(command, 0, 0.5f);
+    }
+    std::vector<int> usedPasses;
+    std::vector<std::uint32_t> drawn;
+
+    // Expect: each pass used once, its commands drawn at once while it is in use
+    EXPECT_CALL(*MockUser<Classic>::instance(), mockOn(::testing::_)).Times(2).WillRepeatedly([&usedPasses](auto context)
+                                                                                              { usedPasses.push_back(context->getCurrentPass()); });
+    EXPECT_CALL(*MockDrawer<Classic>::instance(), mockOn(::testing::_)).Times(2).WillRepeatedly([&drawn](auto context)
+                                                                                                {
+                                                                                                    for (const auto &command : context->getCurrentCommands())
+                                                                                                    {
+                                                                                                        drawn.push_back(command.vertexArray);
+                                                                                                    } });
+    EXPECT_CALL(*MockResetter<Classic>::instance(), mockOn(::testing::_)).Times(1);
+
+    // Act
+    pipeline.draw(queue);
+
+    // Assert
+    EXPECT_EQ(usedPasses, (std::vector<int>{0, 1}));
+    EXPECT_EQ(drawn, (std::vector<std::uint32_t>{2, 4, 1, 3}));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(pipeline.getContext()->getCurrentCommands().empty());
+    MockUser<Classic>::reset();
+    MockDrawer<Classic>::reset();
+    MockResetter<Classic>::reset();
+}
+
+TEST_F(PipelineTest, Draw_UnknownPass)
+{
+    // Arrange
+    auto mockPass = std::make_shared<MockPass<api::MockOpenGL>>();
+    pipeline::Pipeline<api::MockOpenGL, Classic> pipeline({mockPass});
+    cenpy::graphic::render::RenderQueue queue;
+    cenpy::graphic::render::RenderCommand command;
+    command.pass = 1;
+    queue.push(command, 0, 0.0f);
+
+    // Act & Assert
+    expectSpecificError([&pipeline, &queue]()
+                        { pipeline.draw(queue); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::RENDER_QUEUE::UNKNOWN_PASS\nPass 1 of 1"));
+}
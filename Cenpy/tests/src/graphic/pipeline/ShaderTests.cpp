@@ -12,6 +12,7 @@
 #include <graphic/opengl/pipeline/component/shader/MockReader.hpp>
 #include <graphic/opengl/pipeline/component/shader/MockLoader.hpp>
 #include <graphic/opengl/pipeline/component/shader/MockFreer.hpp>
+#include <graphic/opengl/pipeline/component/shader/MockPreprocessor.hpp>
 #include <graphic/opengl/context/MockShaderContext.hpp>
 #include <graphic/MockApi.hpp>
 
@@ -22,6 +23,7 @@ namespace mock = cenpy::mock;
 
 using mock::graphic::opengl::pipeline::component::shader::MockFreer;
 using mock::graphic::opengl::pipeline::component::shader::MockLoader;
+using mock::graphic::opengl::pipeline::component::shader::MockPreprocessor;
 using mock::graphic::opengl::pipeline::component::shader::MockReader;
 
 using cenpy::graphic::opengl::profile::Shader::Classic;
@@ -35,6 +37,7 @@ public:
         MockFreer<Classic>::reset();
         MockLoader<Classic>::reset();
         MockReader<Classic>::reset();
+        MockPreprocessor<Classic>::reset();
     }
 };
 
@@ -45,8 +48,9 @@ TEST_F(ShaderTest, CreateShader)
 
     // Expect calls
     std::string code("");
-    ON_CALL(*shader.getContext(), getShaderCode()).WillByDefault(::testing::ReturnRef(code));
+    ON_CALL(*shader.getContext(), getShaderCode()).WillByDefault(::testing::Return(std::string_view(code)));
     EXPECT_CALL(*MockReader<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    EXPECT_CALL(*MockPreprocessor<Classic>::instance(), mockOn(::testing::_)).Times(1);
     EXPECT_CALL(*MockLoader<Classic>::instance(), mockOn(::testing::_)).Times(1);
     // Act
     ASSERT_NO_THROW(shader.load());
@@ -59,13 +63,53 @@ TEST_F(ShaderTest, CreateShader_codeAlreadyRead)
 
     // Expect calls
     std::string code("test");
-    ON_CALL(*shader.getContext(), getShaderCode()).WillByDefault(::testing::ReturnRef(code));
+    ON_CALL(*shader.getContext(), getShaderCode()).WillByDefault(::testing::Return(std::string_view(code)));
     EXPECT_CALL(*MockReader<Classic>::instance(), mockOn(::testing::_)).Times(0);
+    EXPECT_CALL(*MockPreprocessor<Classic>::instance(), mockOn(::testing::_)).Times(0);
     EXPECT_CALL(*MockLoader<Classic>::instance(), mockOn(::testing::_)).Times(1);
     // Act
     ASSERT_NO_THROW(shader.load());
 }
 
+TEST_F(ShaderTest, Reload)
+{
+    // Arrange
+    pipeline::Shader<api::MockOpenGL, Classic> shader("test-datas/shaders/vertex/good/minimal.vert", context::ShaderType::VERTEX);
+
+    // Expect calls: the source is read from the disk again
+    std::string code("");
+    ON_CALL(*shader.getContext(), getShaderCode()).WillByDefault(::testing::Return(std::string_view(code)));
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*MockFreer<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    EXPECT_CALL(*shader.getContext(), setShaderCode("")).Times(1);
+    EXPECT_CALL(*MockReader<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    EXPECT_CALL(*MockPreprocessor<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    EXPECT_CALL(*MockLoader<Classic>::instance(), mockOn(::testing::_)).Times(1);
+    // Act
+    ASSERT_NO_THROW(shader.reload());
+    MockFreer<Classic>::reset();
+}
+
+TEST_F(ShaderTest, CreateVariant)
+{
+    // Arrange
+    pipeline::Shader<api::MockOpenGL, Classic> shader("test-datas/shaders/vertex/good/minimal.vert", context::ShaderType::VERTEX);
+    ON_CALL(*shader.getContext(), getShaderPath()).WillByDefault(::testing::ReturnRefOfCopy(std::string("test-datas/shaders/vertex/good/minimal.vert")));
+    ON_CALL(*shader.getContext(), getShaderType()).WillByDefault(::testing::Return(context::ShaderType::VERTEX));
+
+    // Expect calls: the variant is created without being read nor compiled
+    EXPECT_CALL(*MockReader<Classic>::instance(), mockOn(::testing::_)).Times(0);
+    EXPECT_CALL(*MockLoader<Classic>::instance(), mockOn(::testing::_)).Times(0);
+
+    // Act
+    auto variant = shader.createVariant({"TINT"});
+
+    // Assert
+    ASSERT_NE(variant, nullptr);
+    ASSERT_EQ(variant->getContext()->getDefines(), std::vector<std::string>{"TINT"});
+    ASSERT_TRUE(shader.getContext()->getDefines().empty());
+}
+
 TEST_F(ShaderTest, Free)
 {
     // Arrange
@@ -217,4 +217,109 @@ TEST_F(UniformTest, SetMat4Uniform)
     ASSERT_NO_THROW(uniform.set(value));
 }
 
+TEST_F(UniformTest, SetSameValueSkipsUpload)
+{
+    // Arrange
+    GLuint location = 42;
+    GLfloat value = 3.14f;
+    auto uniformContext = std::make_shared<api::OpenGL::UniformContext>();
+    uniformContext->setUniformID(location);
+
+    pipeline::Uniform<api::OpenGL> uniform(uniformContext);
+
+    // Expected call
+    EXPECT_CALL(*mock::glFunctionMock::instance(), glUniform1f_mock(location, value))
+        .Times(1);
+
+    // Act
+    ASSERT_NO_THROW(uniform.set(value));
+    ASSERT_NO_THROW(uniform.set(value));
+    ASSERT_NO_THROW(uniform.set(value));
+
+    // Assert
+    EXPECT_EQ(uniformContext->getUploads(), 1);
+    EXPECT_EQ(uniformContext->getCacheHits(), 2);
+}
+
+TEST_F(UniformTest, SetChangedValueUploads)
+{
+    // Arrange
+    GLuint location = 42;
+    auto uniformContext = std::make_shared<api::OpenGL::UniformContext>();
+    uniformContext->setUniformID(location);
+
+    pipeline::Uniform<api::OpenGL> uniform(uniformContext);
+
+    // Expected call
+    EXPECT_CALL(*mock::glFunctionMock::instance(), glUniformMatrix4fv_mock(location, 0, GL_FALSE, ::testing::_))
+        .Times(2);
+
+    // Act
+    ASSERT_NO_THROW(uniform.set(glm::mat4(1.0f)));
+    ASSERT_NO_THROW(uniform.set(glm::mat4(2.0f)));
+
+    // Assert
+    EXPECT_EQ(uniformContext->getUploads(), 2);
+    EXPECT_EQ(uniformContext->getCacheHits(), 0);
+}
+
+TEST_F(UniformTest, InvalidateForcesUpload)
+{
+    // Arrange
+    GLuint location = 42;
+    GLint value = 7;
+    auto uniformContext = std::make_shared<api::OpenGL::UniformContext>();
+    uniformContext->setUniformID(location);
+
+    pipeline::Uniform<api::OpenGL> uniform(uniformContext);
+
+    // Expected call
+    EXPECT_CALL(*mock::glFunctionMock::instance(), glUniform1i_mock(location, value))
+        .Times(2);
+
+    // Act
+    ASSERT_NO_THROW(uniform.set(value));
+    uniformContext->invalidate();
+    ASSERT_NO_THROW(uniform.set(value));
+}
+
+TEST_F(UniformTest, StageDoesNotUpload)
+{
+    // Arrange
+    auto uniformContext = std::make_shared<api::OpenGL::UniformContext>();
+    uniformContext->setUniformID(42);
+    pipeline::Uniform<api::OpenGL> uniform(uniformContext);
+
+    // Expected call
+    EXPECT_CALL(*mock::glFunctionMock::instance(), glUniform1f_mock(::testing::_, ::testing::_)).Times(0);
+
+    // Act
+    ASSERT_TRUE(uniform.stage(3.14f));
+
+    // Assert
+    ASSERT_TRUE(uniformContext->isDirty());
+    ASSERT_EQ(uniformContext->getUploads(), 0);
+}
+
+TEST_F(UniformTest, CommitUploadsStagedValueOnce)
+{
+    // Arrange
+    auto uniformContext = std::make_shared<api::OpenGL::UniformContext>();
+    uniformContext->setUniformID(42);
+    pipeline::Uniform<api::OpenGL> uniform(uniformContext);
+    uniform.stage(1.0f);
+    uniform.stage(3.14f);
+
+    // Expected call
+    EXPECT_CALL(*mock::glFunctionMock::instance(), glUniform1f_mock(42, 3.14f)).Times(1);
+
+    // Act
+    uniform.commit();
+    uniform.commit();
+
+    // Assert
+    ASSERT_FALSE(uniform.stage(3.14f));
+    ASSERT_EQ(uniformContext->getUploads(), 1);
+}
+
 #endif // __mock_gl__
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <graphic/render/PassFusion.hpp>
+
+using cenpy::graphic::render::FusedStage;
+using cenpy::graphic::render::PassFusion;
+using cenpy::graphic::render::PointwiseStage;
+
+namespace
+{
+    const PointwiseStage TINT{"tint", "color.rgb *= tint;", {{"vec3", "tint"}}};
+    const PointwiseStage FADE{"fade", "color.rgb = mix(color.rgb, vec3(0.0), amount);", {{"float", "amount"}}};
+}
+
+TEST(PassFusionTests, Generate_ChainsStagesInOrder)
+{
+    // Act
+    const std::string code = PassFusion::generate({{&TINT}, {&FADE}});
+
+    // Assert
+    EXPECT_NE(code.find("uniform vec3 s0_tint;"), std::string::npos);
+    EXPECT_NE(code.find("uniform float s1_amount;"), std::string::npos);
+    EXPECT_NE(code.find("#define tint s0_tint\ncolor.rgb *= tint;\n#undef tint"), std::string::npos);
+    const auto first = code.find("    stage0(color, v_uv);");
+    const auto second = code.find("    stage1(color, v_uv);");
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_NE(second, std::string::npos);
+    EXPECT_LT(first, second);
+    EXPECT_EQ(code.find("clamp"), std::string::npos);
+}
+
+TEST(PassFusionTests, Generate_SameStageTwice)
+{
+    // Act
+    const std::string code = PassFusion::generate({{&TINT}, {&TINT}});
+
+    // Assert
+    EXPECT_NE(code.find("uniform vec3 s0_tint;"), std::string::npos);
+    EXPECT_NE(code.find("uniform vec3 s1_tint;"), std::string::npos);
+    EXPECT_EQ(PassFusion::getUniformName(1, "tint"), "s1_tint");
+}
+
+TEST(PassFusionTests, Generate_SaturatesNormalizedIntermediates)
+{
+    // Act
+    const std::string code = PassFusion::generate({{&TINT, true}, {&FADE}});
+
+    // Assert
+    EXPECT_NE(code.find("stage0(color, v_uv);\n    color = clamp(color, 0.0, 1.0);\n    stage1"), std::string::npos);
+}
+
+TEST(PassFusionTests, Generate_Invalid)
+{
+    // Arrange
+    const PointwiseStage invalid{"tint", "", {{"vec3", "1tint"}}};
+
+    // Act & Assert
+    EXPECT_THROW((void)PassFusion::generate({}), std::runtime_error);
+    EXPECT_THROW((void)PassFusion::generate({{&invalid}}), std::runtime_error);
+}
@@ -0,0 +1,281 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include <graphic/render/RenderGraph.hpp>
+
+using cenpy::graphic::render::RenderGraph;
+using cenpy::graphic::render::TargetDesc;
+using cenpy::graphic::render::TargetFormat;
+
+namespace
+{
+    constexpr TargetDesc FULL{1280, 720, TargetFormat::RGBA8};
+    constexpr TargetDesc HALF{640, 360, TargetFormat::RGBA8};
+}
+
+TEST(RenderGraphTests, Compile_OrdersWritersBeforeReaders)
+{
+    // Arrange: passes added consumer first
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int scene = graph.addTarget("scene", FULL);
+    const int composite = graph.addPass("composite", {scene}, {backbuffer});
+    const int draw = graph.addPass("scene", {}, {scene});
+
+    // Act
+    graph.compile();
+
+    // Assert
+    EXPECT_EQ(graph.getOrder(), (std::vector<int>{draw, composite}));
+    EXPECT_EQ(graph.getSlot(backbuffer), -1);
+    EXPECT_EQ(graph.getSlot(scene), 0);
+}
+
+TEST(RenderGraphTests, Compile_CullsPassesNotReachingAnOutput)
+{
+    // Arrange
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int scene = graph.addTarget("scene", FULL);
+    const int debug = graph.addTarget("debug", FULL);
+    const int draw = graph.addPass("scene", {}, {scene});
+    const int overlay = graph.addPass("debug", {scene}, {debug});
+    const int composite = graph.addPass("composite", {scene}, {backbuffer});
+
+    // Act
+    graph.compile();
+
+    // Assert
+    EXPECT_EQ(graph.getOrder(), (std::vector<int>{draw, composite}));
+    EXPECT_TRUE(graph.isCulled(overlay));
+    EXPECT_EQ(graph.getSlot(debug), -1);
+    EXPECT_EQ(graph.getSlots().size(), 1);
+}
+
+TEST(RenderGraphTests, Compile_AliasesDisjointLifetimes)
+{
+    // Arrange: scene -> bright -> blur -> composite; bright is dead once blurred
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int scene = graph.addTarget("scene", FULL);
+    const int bright = graph.addTarget("bright", HALF);
+    const int blurX = graph.addTarget("blurX", HALF);
+    const int blurY = graph.addTarget("blurY", HALF);
+    graph.addPass("scene", {}, {scene});
+    graph.addPass("bright", {scene}, {bright});
+    graph.addPass("blurX", {bright}, {blurX});
+    graph.addPass("blurY", {blurX}, {blurY});
+    graph.addPass("composite", {scene, blurY}, {backbuffer});
+
+    // Act
+    graph.compile();
+
+    // Assert: blurY reuses the memory of bright, read and written passes never share
+    EXPECT_EQ(graph.getSlots().size(), 3);
+    EXPECT_EQ(graph.getSlot(blurY), graph.getSlot(bright));
+    EXPECT_NE(graph.getSlot(blurX), graph.getSlot(bright));
+    EXPECT_NE(graph.getSlot(blurY), graph.getSlot(blurX));
+    EXPECT_NE(graph.getSlot(scene), graph.getSlot(bright));
+}
+
+TEST(RenderGraphTests, Compile_DoesNotAliasDifferentDescriptions)
+{
+    // Arrange
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int first = graph.addTarget("first", FULL);
+    const int second = graph.addTarget("second", FULL);
+    const int third = graph.addTarget("third", {1280, 720, TargetFormat::RGBA16F});
+    graph.addPass("first", {}, {first});
+    graph.addPass("second", {first}, {second});
+    graph.addPass("third", {second}, {third});
+    graph.addPass("composite", {third}, {backbuffer});
+
+    // Act
+    graph.compile();
+
+    // Assert: third outlives first but has another format
+    EXPECT_EQ(graph.getSlots().size(), 3);
+}
+
+TEST(RenderGraphTests, Compile_KeepsWritersInOrder)
+{
+    // Arrange: two passes accumulating into the same target
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int lights = graph.addTarget("lights", FULL);
+    const int composite = graph.addPass("composite", {lights}, {backbuffer});
+    const int sun = graph.addPass("sun", {}, {lights});
+    const int lamps = graph.addPass("lamps", {}, {lights});
+
+    // Act
+    graph.compile();
+
+    // Assert
+    EXPECT_EQ(graph.getOrder(), (std::vector<int>{sun, lamps, composite}));
+}
+
+TEST(RenderGraphTests, Compile_Cycle)
+{
+    // Arrange
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int first = graph.addTarget("first", FULL);
+    const int second = graph.addTarget("second", FULL);
+    graph.addPass("first", {second}, {first});
+    graph.addPass("second", {first}, {second});
+    graph.addPass("composite", {first}, {backbuffer});
+
+    // Act & Assert
+    EXPECT_THROW(graph.compile(), std::runtime_error);
+}
+
+TEST(RenderGraphTests, AddPass_FeedbackLoop)
+{
+    // Arrange
+    RenderGraph graph;
+    const int target = graph.addTarget("target", FULL);
+
+    // Act & Assert
+    EXPECT_THROW(graph.addPass("pass", {target}, {target}), std::runtime_error);
+    EXPECT_THROW(graph.addPass("pass", {}, {target + 1}), std::runtime_error);
+}
+
+TEST(RenderGraphTests, SetDesc_InvalidatesOnlyOnChange)
+{
+    // Arrange
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    graph.addPass("pass", {}, {backbuffer});
+    graph.compile();
+
+    // Act & Assert
+    graph.setDesc(backbuffer, FULL);
+    EXPECT_TRUE(graph.isCompiled());
+    graph.setDesc(backbuffer, HALF);
+    EXPECT_FALSE(graph.isCompiled());
+}
+
+TEST(RenderGraphTests, Compile_FusesPointwiseChain)
+{
+    // Arrange: scene -> tint -> vignette -> fade -> backbuffer
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int scene = graph.addTarget("scene", FULL);
+    const int tinted = graph.addTarget("tinted", FULL);
+    const int vignetted = graph.addTarget("vignetted", FULL);
+    const int draw = graph.addPass("scene", {}, {scene});
+    const int tint = graph.addPointwisePass("tint", scene, tinted);
+    const int vignette = graph.addPointwisePass("vignette", tinted, vignetted);
+    const int fade = graph.addPointwisePass("fade", vignetted, backbuffer);
+
+    // Act
+    graph.compile();
+
+    // Assert: the chain runs as tint, from the scene to the backbuffer
+    EXPECT_EQ(graph.getOrder(), (std::vector<int>{draw, tint}));
+    EXPECT_EQ(graph.getChain(tint), (std::vector<int>{tint, vignette, fade}));
+    EXPECT_TRUE(graph.getChain(fade).empty());
+    EXPECT_TRUE(graph.isCulled(vignette));
+    EXPECT_EQ(graph.getInputs(tint), (std::vector<int>{scene}));
+    EXPECT_EQ(graph.getOutputs(tint), (std::vector<int>{backbuffer}));
+    EXPECT_EQ(graph.getSlot(tinted), -1);
+    EXPECT_EQ(graph.getSlot(vignetted), -1);
+    EXPECT_EQ(graph.getSlots().size(), 1);
+}
+
+TEST(RenderGraphTests, Compile_DoesNotFuseSharedOrResizedTargets)
+{
+    // Arrange: tinted is also read by the debug view, half is downsampled
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int debugOutput = graph.importTarget("debug", FULL);
+    const int scene = graph.addTarget("scene", FULL);
+    const int tinted = graph.addTarget("tinted", FULL);
+    const int half = graph.addTarget("half", HALF);
+    graph.addPass("scene", {}, {scene});
+    const int tint = graph.addPointwisePass("tint", scene, tinted);
+    const int debug = graph.addPointwisePass("debug", tinted, debugOutput);
+    const int downsample = graph.addPointwisePass("downsample", tinted, half);
+    const int upsample = graph.addPointwisePass("upsample", half, backbuffer);
+
+    // Act
+    graph.compile();
+
+    // Assert
+    EXPECT_EQ(graph.getChain(tint), (std::vector<int>{tint}));
+    EXPECT_EQ(graph.getChain(debug), (std::vector<int>{debug}));
+    EXPECT_EQ(graph.getChain(downsample), (std::vector<int>{downsample}));
+    EXPECT_EQ(graph.getChain(upsample), (std::vector<int>{upsample}));
+    EXPECT_NE(graph.getSlot(half), -1);
+}
+
+TEST(RenderGraphTests, SetFusion_ExecutesEachPass)
+{
+    // Arrange
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int scene = graph.addTarget("scene", FULL);
+    const int tinted = graph.addTarget("tinted", FULL);
+    const int draw = graph.addPass("scene", {}, {scene});
+    const int tint = graph.addPointwisePass("tint", scene, tinted);
+    const int fade = graph.addPointwisePass("fade", tinted, backbuffer);
+    graph.compile();
+
+    // Act
+    graph.setFusion(false);
+
+    // Assert
+    EXPECT_FALSE(graph.isCompiled());
+    graph.compile();
+    EXPECT_EQ(graph.getOrder(), (std::vector<int>{draw, tint, fade}));
+    EXPECT_NE(graph.getSlot(tinted), -1);
+}
+
+TEST(RenderGraphTests, Compile_DoesNotFusePointwiseCycle)
+{
+    // Arrange: first and second read each other, nothing else uses their targets
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int firstTarget = graph.addTarget("first", FULL);
+    const int secondTarget = graph.addTarget("second", FULL);
+    const int first = graph.addPointwisePass("first", secondTarget, firstTarget);
+    const int second = graph.addPointwisePass("second", firstTarget, secondTarget);
+    const int draw = graph.addPass("scene", {}, {backbuffer});
+
+    // Act
+    graph.compile();
+
+    // Assert: each pass of the cycle stays its own chain, culled as without fusion
+    EXPECT_EQ(graph.getChain(first), (std::vector<int>{first}));
+    EXPECT_EQ(graph.getChain(second), (std::vector<int>{second}));
+    EXPECT_TRUE(graph.isCulled(first));
+    EXPECT_TRUE(graph.isCulled(second));
+    EXPECT_EQ(graph.getOrder(), (std::vector<int>{draw}));
+}
+
+TEST(RenderGraphTests, Compile_PointwiseCycle)
+{
+    // Arrange: the composite keeps the cycle, whose second pass would otherwise be fused into the first
+    RenderGraph graph;
+    const int backbuffer = graph.importTarget("backbuffer", FULL);
+    const int firstTarget = graph.addTarget("first", FULL);
+    const int secondTarget = graph.addTarget("second", FULL);
+    graph.addPointwisePass("first", secondTarget, firstTarget);
+    graph.addPointwisePass("second", firstTarget, secondTarget);
+    graph.addPass("composite", {secondTarget}, {backbuffer});
+
+    // Act & Assert
+    EXPECT_THROW(graph.compile(), std::runtime_error);
+}
+
+TEST(RenderGraphTests, AddPointwisePass_DepthTarget)
+{
+    // Arrange
+    RenderGraph graph;
+    const int scene = graph.addTarget("scene", FULL);
+    const int depth = graph.addTarget("depth", {1280, 720, TargetFormat::DEPTH24_STENCIL8});
+
+    // Act & Assert
+    EXPECT_THROW(graph.addPointwisePass("linearize", scene, depth), std::runtime_error);
+}
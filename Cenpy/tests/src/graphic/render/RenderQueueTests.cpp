@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <graphic/render/RenderQueue.hpp>
+#include <TestUtils.hpp>
+
+using cenpy::graphic::render::DepthOrder;
+using cenpy::graphic::render::RenderCommand;
+using cenpy::graphic::render::RenderQueue;
+using cenpy::test::utils::expectSpecificError;
+
+class RenderQueueTests : public ::testing::Test
+{
+protected:
+    static RenderCommand command(int pass, std::uint32_t texture, std::uint32_t vertexArray)
+    {
+        RenderCommand command;
+        command.pass = pass;
+        command.texture = texture;
+        command.vertexArray = vertexArray;
+        return command;
+    }
+
+    static std::vector<std::uint32_t> vertexArrays(const RenderQueue &queue)
+    {
+        std::vector<std::uint32_t> order;
+        for (const auto &command : queue.getCommands())
+        {
+            order.push_back(command.vertexArray);
+        }
+        return order;
+    }
+};
+
+TEST_F(RenderQueueTests, MakeKey_FieldsByPriority)
+{
+    // Act & Assert: a higher field outweighs every lower one
+    EXPECT_LT(RenderQueue::makeKey(0, 1, 0xFFFFFF, 1.0f), RenderQueue::makeKey(1, 0, 0, 0.0f));
+    EXPECT_LT(RenderQueue::makeKey(0, 0, 0xFFFFFF, 1.0f), RenderQueue::makeKey(0, 1, 0, 0.0f));
+    EXPECT_LT(RenderQueue::makeKey(0, 0, 1, 1.0f), RenderQueue::makeKey(0, 0, 2, 0.0f));
+    EXPECT_LT(RenderQueue::makeKey(0, 0, 1, 0.25f), RenderQueue::makeKey(0, 0, 1, 0.5f));
+    EXPECT_GT(RenderQueue::makeKey(0, 0, 1, 0.25f, DepthOrder::BACK_TO_FRONT), RenderQueue::makeKey(0, 0, 1, 0.5f, DepthOrder::BACK_TO_FRONT));
+}
+
+TEST_F(RenderQueueTests, MakeKey_OutOfRange)
+{
+    expectSpecificError([]()
+                        { static_cast<void>(RenderQueue::makeKey(256, 0, 0, 0.0f)); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::RENDER_QUEUE::KEY_OUT_OF_RANGE\nLayer 256 and pass 0 must fit in 8 bits"));
+    expectSpecificError([]()
+                        { static_cast<void>(RenderQueue::makeKey(0, 256, 0, 0.0f)); },
+                        cenpy::common::exception::TraceableException<std::runtime_error>("ERROR::RENDER_QUEUE::KEY_OUT_OF_RANGE\nLayer 0 and pass 256 must fit in 8 bits"));
+}
+
+TEST_F(RenderQueueTests, Sort_GroupsByLayerPassAndTexture)
+{
+    // Arrange
+    RenderQueue queue;
+    queue.push(command(1, 7, 1), 0, 0.5f);
+    queue.push(command(0, 9, 2), 1, 0.1f);
+    queue.push(command(0, 7, 3), 0, 0.9f);
+    queue.push(command(1, 8, 4), 0, 0.2f);
+    queue.push(command(0, 7, 5), 0, 0.3f);
+    queue.push(command(1, 7, 6), 0, 0.4f);
+
+    // Act
+    queue.sort();
+
+    // Assert
+    EXPECT_TRUE(queue.isSorted());
+    EXPECT_EQ(vertexArrays(queue), (std::vector<std::uint32_t>{5, 3, 6, 1, 4, 2}));
+}
+
+TEST_F(RenderQueueTests, Sort_EqualKeysKeepRecordingOrder)
+{
+    // Arrange
+    RenderQueue queue;
+    for (std::uint32_t vertexArray = 1; vertexArray <= 4; ++vertexArray)
+    {
+        queue.push(command(vertexArray % 2, 3, vertexArray), 0, 0.5f);
+    }
+
+    // Act
+    queue.sort();
+
+    // Assert
+    EXPECT_EQ(vertexArrays(queue), (std::vector<std::uint32_t>{2, 4, 1, 3}));
+}
+
+TEST_F(RenderQueueTests, Sort_MatchesStableSort)
+{
+    // Arrange
+    RenderQueue queue;
+    std::mt19937 random(42);
+    std::vector<RenderCommand> expected;
+    for (std::uint32_t vertexArray = 0; vertexArray < 1000; ++vertexArray)
+    {
+        queue.push(command(random() % 4, random() % 16, vertexArray), random() % 3, static_cast<float>(random() % 100) / 100.0f);
+        expected.push_back(queue.getCommands().back());
+    }
+    std::ranges::stable_sort(expected, {}, &RenderCommand::key);
+
+    // Act
+    queue.sort();
+
+    // Assert
+    ASSERT_EQ(queue.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(queue.getCommands()[i].vertexArray, expected[i].vertexArray);
+    }
+}
+
+TEST_F(RenderQueueTests, Clear_KeepsMemory)
+{
+    // Arrange
+    RenderQueue queue;
+    queue.push(command(0, 1, 1), 0, 0.0f);
+    queue.push(command(0, 2, 2), 0, 0.0f);
+    const auto *data = queue.getCommands().data();
+
+    // Act
+    queue.clear();
+    queue.push(command(0, 3, 3), 0, 0.0f);
+
+    // Assert
+    EXPECT_EQ(queue.size(), 1);
+    EXPECT_EQ(queue.getCommands().data(), data);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include <graphic/texture/BlockCompressor.hpp>
+
+namespace vk_format = cenpy::graphic::texture::vk_format;
+using cenpy::graphic::texture::BlockCompressor;
+using cenpy::graphic::texture::CompressedImage;
+
+namespace
+{
+    std::vector<std::uint8_t> fill(int width, int height, std::uint8_t red, std::uint8_t green, std::uint8_t blue, std::uint8_t alpha)
+    {
+        std::vector<std::uint8_t> rgba;
+        for (int texel = 0; texel < width * height; ++texel)
+        {
+            rgba.insert(rgba.end(), {red, green, blue, alpha});
+        }
+        return rgba;
+    }
+}
+
+TEST(BlockCompressorTests, CompressLevel_SolidColor)
+{
+    // Arrange
+    std::vector<std::uint8_t> red = fill(4, 4, 255, 0, 0, 255);
+
+    // Act
+    std::vector<std::uint8_t> block = BlockCompressor::compressLevel(red, 4, 4, false);
+
+    // Assert: both endpoints red, every texel on the first one
+    EXPECT_EQ(block, (std::vector<std::uint8_t>{0x00, 0xF8, 0x00, 0xF8, 0, 0, 0, 0}));
+}
+
+TEST(BlockCompressorTests, CompressLevel_TwoColors)
+{
+    // Arrange: white top half, black bottom half
+    std::vector<std::uint8_t> rgba = fill(4, 2, 255, 255, 255, 255);
+    std::vector<std::uint8_t> black = fill(4, 2, 0, 0, 0, 255);
+    rgba.insert(rgba.end(), black.begin(), black.end());
+
+    // Act
+    std::vector<std::uint8_t> block = BlockCompressor::compressLevel(rgba, 4, 4, false);
+
+    // Assert: white endpoint first, the black texels select the second one
+    EXPECT_EQ(block, (std::vector<std::uint8_t>{0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55}));
+}
+
+TEST(BlockCompressorTests, CompressLevel_Alpha)
+{
+    // Arrange: opaque left half, transparent right half
+    std::vector<std::uint8_t> rgba = fill(4, 4, 0, 0, 0, 255);
+    for (int texel = 0; texel < 16; ++texel)
+    {
+        rgba[texel * 4 + 3] = texel % 4 < 2 ? 255 : 0;
+    }
+
+    // Act
+    std::vector<std::uint8_t> block = BlockCompressor::compressLevel(rgba, 4, 4, true);
+
+    // Assert: the alpha block comes first, the transparent texels select the second alpha
+    ASSERT_EQ(block.size(), 16);
+    EXPECT_EQ(block[0], 255);
+    EXPECT_EQ(block[1], 0);
+    std::uint64_t indices = 0;
+    for (int byte = 0; byte < 6; ++byte)
+    {
+        indices |= static_cast<std::uint64_t>(block[2 + byte]) << (8 * byte);
+    }
+    for (int texel = 0; texel < 16; ++texel)
+    {
+        EXPECT_EQ(indices >> (texel * 3) & 7, texel % 4 < 2 ? 0 : 1) << "texel " << texel;
+    }
+}
+
+TEST(BlockCompressorTests, CompressLevel_PartialBlocks)
+{
+    // Act
+    std::vector<std::uint8_t> blocks = BlockCompressor::compressLevel(fill(5, 3, 0, 0, 255, 255), 5, 3, false);
+
+    // Assert
+    EXPECT_EQ(blocks.size(), vk_format::levelBytes(vk_format::BC1_RGB_UNORM, 5, 3));
+}
+
+TEST(BlockCompressorTests, Downsample_AveragesQuads)
+{
+    // Arrange
+    std::vector<std::uint8_t> rgba = fill(2, 2, 0, 0, 0, 255);
+    rgba[0] = 200;
+    rgba[4] = 100;
+
+    // Act
+    std::vector<std::uint8_t> half = BlockCompressor::downsample(rgba, 2, 2);
+
+    // Assert
+    EXPECT_EQ(half, (std::vector<std::uint8_t>{75, 0, 0, 255}));
+}
+
+TEST(BlockCompressorTests, Compress_BuildsMipChain)
+{
+    // Act
+    CompressedImage opaque = BlockCompressor::compress(fill(8, 2, 10, 20, 30, 255), 8, 2);
+    CompressedImage translucent = BlockCompressor::compress(fill(8, 2, 10, 20, 30, 128), 8, 2);
+
+    // Assert: 8x2, 4x1, 2x1, 1x1
+    EXPECT_EQ(opaque.format, vk_format::BC1_RGB_UNORM);
+    EXPECT_EQ(translucent.format, vk_format::BC3_UNORM);
+    ASSERT_EQ(opaque.levels.size(), 4);
+    EXPECT_EQ(opaque.levels[1].width, 4);
+    EXPECT_EQ(opaque.levels[1].height, 1);
+    EXPECT_EQ(opaque.levels[0].data.size(), 16);
+    EXPECT_EQ(opaque.levels[3].data.size(), 8);
+    EXPECT_EQ(translucent.levels[3].data.size(), 16);
+}
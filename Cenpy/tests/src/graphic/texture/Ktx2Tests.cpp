@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <graphic/texture/Ktx2.hpp>
+
+namespace vk_format = cenpy::graphic::texture::vk_format;
+using cenpy::graphic::texture::CompressedImage;
+using cenpy::graphic::texture::Ktx2;
+
+namespace
+{
+    // 8x4 BC1 texture with its chain down to 1x1, each level filled with its index.
+    CompressedImage chain()
+    {
+        CompressedImage image{vk_format::BC1_RGB_UNORM, 8, 4, {}};
+        for (int level = 0, width = 8, height = 4; level < 4; ++level, width = std::max(1, width / 2), height = std::max(1, height / 2))
+        {
+            image.levels.push_back({width, height, std::vector<std::uint8_t>(vk_format::levelBytes(image.format, width, height), static_cast<std::uint8_t>(level))});
+        }
+        return image;
+    }
+
+    std::string_view view(const std::vector<std::uint8_t> &bytes)
+    {
+        return {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+    }
+}
+
+TEST(Ktx2Tests, LevelBytes_RoundsUpToBlocks)
+{
+    // Act & Assert
+    EXPECT_EQ(vk_format::levelBytes(vk_format::BC1_RGB_UNORM, 8, 4), 16);
+    EXPECT_EQ(vk_format::levelBytes(vk_format::BC1_RGB_UNORM, 1, 1), 8);
+    EXPECT_EQ(vk_format::levelBytes(vk_format::BC7_UNORM, 5, 5), 64);
+    EXPECT_EQ(vk_format::blockBytes(37), 0);
+}
+
+TEST(Ktx2Tests, WriteRead_RoundTrip)
+{
+    // Arrange
+    CompressedImage image = chain();
+
+    // Act
+    std::vector<std::uint8_t> bytes = Ktx2::write(image);
+    CompressedImage read = Ktx2::read(view(bytes), "chain.ktx2");
+
+    // Assert
+    EXPECT_EQ(read.format, vk_format::BC1_RGB_UNORM);
+    EXPECT_EQ(read.width, 8);
+    EXPECT_EQ(read.height, 4);
+    ASSERT_EQ(read.levels.size(), 4);
+    for (std::size_t level = 0; level < read.levels.size(); ++level)
+    {
+        EXPECT_EQ(read.levels[level].width, image.levels[level].width);
+        EXPECT_EQ(read.levels[level].height, image.levels[level].height);
+        EXPECT_EQ(read.levels[level].data, image.levels[level].data);
+    }
+}
+
+TEST(Ktx2Tests, Write_StoresSmallestLevelFirst)
+{
+    // Act
+    std::vector<std::uint8_t> bytes = Ktx2::write(chain());
+
+    // Assert: the base level ends the file, each level is aligned on its blocks
+    EXPECT_EQ(std::vector<std::uint8_t>(bytes.end() - 16, bytes.end()), std::vector<std::uint8_t>(16, 0));
+    const std::uint64_t smallest = bytes[80 + 3 * 24] | bytes[80 + 3 * 24 + 1] << 8;
+    EXPECT_EQ(smallest % 8, 0);
+    EXPECT_EQ(bytes[smallest], 3);
+}
+
+TEST(Ktx2Tests, WriteRead_Orientation)
+{
+    // Arrange
+    CompressedImage bottomUp = chain();
+    bottomUp.bottomUp = true;
+
+    // Act
+    std::vector<std::uint8_t> bytes = Ktx2::write(bottomUp);
+
+    // Assert
+    EXPECT_NE(view(bytes).find(std::string_view("KTXorientation\0ru\0", 18)), std::string_view::npos);
+    EXPECT_TRUE(Ktx2::read(view(bytes), "chain.ktx2").bottomUp);
+    EXPECT_FALSE(Ktx2::read(view(Ktx2::write(chain())), "chain.ktx2").bottomUp);
+}
+
+TEST(Ktx2Tests, Read_WithoutOrientationIsTopDown)
+{
+    // Arrange: no key/value data
+    CompressedImage image = chain();
+    image.bottomUp = true;
+    std::vector<std::uint8_t> bytes = Ktx2::write(image);
+    std::fill(bytes.begin() + 56, bytes.begin() + 64, 0);
+
+    // Act & Assert
+    EXPECT_FALSE(Ktx2::read(view(bytes), "chain.ktx2").bottomUp);
+}
+
+TEST(Ktx2Tests, Write_DescriptorSampleBits)
+{
+    // Arrange: the single sample of BC7 spans the whole 128 bits block
+    CompressedImage bc7{vk_format::BC7_UNORM, 4, 4, {{4, 4, std::vector<std::uint8_t>(16)}}};
+    const auto sampleBits = [](const std::vector<std::uint8_t> &bytes)
+    {
+        const std::size_t descriptor = bytes[48] | bytes[49] << 8;
+        return bytes[descriptor + 28 + 2] + 1;
+    };
+
+    // Act & Assert: stored minus one
+    EXPECT_EQ(sampleBits(Ktx2::write(bc7)), 128);
+    EXPECT_EQ(sampleBits(Ktx2::write(chain())), 64);
+}
+
+TEST(Ktx2Tests, Read_NotKtx2)
+{
+    // Arrange
+    std::vector<std::uint8_t> bytes(128, 0);
+
+    // Act & Assert
+    EXPECT_THROW((void)Ktx2::read(view(bytes), "image.png"), std::runtime_error);
+}
+
+TEST(Ktx2Tests, Read_Supercompressed)
+{
+    // Arrange: zstd supercompression
+    std::vector<std::uint8_t> bytes = Ktx2::write(chain());
+    bytes[44] = 2;
+
+    // Act & Assert
+    EXPECT_THROW((void)Ktx2::read(view(bytes), "chain.ktx2"), std::runtime_error);
+}
+
+TEST(Ktx2Tests, Read_Truncated)
+{
+    // Arrange
+    std::vector<std::uint8_t> bytes = Ktx2::write(chain());
+    bytes.resize(bytes.size() - 1);
+
+    // Act & Assert
+    EXPECT_THROW((void)Ktx2::read(view(bytes), "chain.ktx2"), std::runtime_error);
+}
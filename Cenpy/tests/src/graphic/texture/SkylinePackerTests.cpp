@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <graphic/texture/SkylinePacker.hpp>
+
+using cenpy::graphic::texture::PackedRect;
+using cenpy::graphic::texture::SkylinePacker;
+
+namespace
+{
+    bool overlaps(const PackedRect &left, const PackedRect &right)
+    {
+        return left.x < right.x + right.width && right.x < left.x + left.width &&
+               left.y < right.y + right.height && right.y < left.y + left.height;
+    }
+}
+
+TEST(SkylinePackerTests, Insert_FillsRowFirst)
+{
+    // Arrange
+    SkylinePacker packer(64, 64);
+
+    // Act
+    auto first = packer.insert(32, 16);
+    auto second = packer.insert(32, 8);
+    auto third = packer.insert(32, 8);
+
+    // Assert: the third rests on the lower second one
+    ASSERT_TRUE(first && second && third);
+    EXPECT_EQ(first->x, 0);
+    EXPECT_EQ(first->y, 0);
+    EXPECT_EQ(second->x, 32);
+    EXPECT_EQ(second->y, 0);
+    EXPECT_EQ(third->x, 32);
+    EXPECT_EQ(third->y, 8);
+}
+
+TEST(SkylinePackerTests, Insert_FullPage)
+{
+    // Arrange
+    SkylinePacker packer(32, 32);
+
+    // Act & Assert
+    EXPECT_TRUE(packer.insert(32, 32));
+    EXPECT_FALSE(packer.insert(1, 1));
+    EXPECT_FLOAT_EQ(packer.getOccupancy(), 1.0f);
+}
+
+TEST(SkylinePackerTests, Insert_TooLarge)
+{
+    // Arrange
+    SkylinePacker packer(32, 32);
+
+    // Act & Assert
+    EXPECT_FALSE(packer.insert(33, 1));
+    EXPECT_FALSE(packer.insert(1, 33));
+    EXPECT_FALSE(packer.insert(0, 1));
+}
+
+TEST(SkylinePackerTests, Insert_RandomRectsNeverOverlap)
+{
+    // Arrange
+    SkylinePacker packer(256, 256);
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> size(4, 40);
+    std::vector<PackedRect> rects;
+
+    // Act
+    for (int index = 0; index < 200; ++index)
+    {
+        if (auto rect = packer.insert(size(random), size(random)))
+        {
+            rects.push_back(*rect);
+        }
+    }
+
+    // Assert
+    ASSERT_GT(rects.size(), 40);
+    for (std::size_t left = 0; left < rects.size(); ++left)
+    {
+        EXPECT_LE(rects[left].x + rects[left].width, 256);
+        EXPECT_LE(rects[left].y + rects[left].height, 256);
+        for (std::size_t right = left + 1; right < rects.size(); ++right)
+        {
+            EXPECT_FALSE(overlaps(rects[left], rects[right]));
+        }
+    }
+    EXPECT_GT(packer.getOccupancy(), 0.6f);
+}
+
+TEST(SkylinePackerTests, Reset_EmptiesPage)
+{
+    // Arrange
+    SkylinePacker packer(32, 32);
+    packer.insert(32, 32);
+
+    // Act
+    packer.reset();
+
+    // Assert
+    auto rect = packer.insert(32, 32);
+    ASSERT_TRUE(rect);
+    EXPECT_EQ(rect->y, 0);
+}
@@ -0,0 +1,74 @@
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <graphic/texture/BlockCompressor.hpp>
+#include <graphic/texture/Ktx2.hpp>
+
+namespace texture = cenpy::graphic::texture;
+
+namespace
+{
+    // Writes "name.ktx2" next to "name.png", which the compressed texture decoder then prefers.
+    // The rows are stored bottom first, as the engine loads the PNG.
+    bool convert(const std::filesystem::path &source)
+    {
+        stbi_set_flip_vertically_on_load(true);
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> pixels(stbi_load(source.string().c_str(), &width, &height, &channels, 4), &stbi_image_free);
+        if (!pixels)
+        {
+            std::cerr << source.string() << ": " << stbi_failure_reason() << '\n';
+            return false;
+        }
+        const std::vector<std::uint8_t> rgba(pixels.get(), pixels.get() + static_cast<std::size_t>(width) * height * 4);
+        texture::CompressedImage image = texture::BlockCompressor::compress(rgba, width, height);
+        image.bottomUp = true;
+        const std::vector<std::uint8_t> content = texture::Ktx2::write(image);
+
+        const std::filesystem::path destination = std::filesystem::path(source).replace_extension(".ktx2");
+        std::ofstream file(destination, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(content.data()), static_cast<std::streamsize>(content.size()));
+        if (!file)
+        {
+            std::cerr << destination.string() << ": cannot be written\n";
+            return false;
+        }
+        std::cout << source.string() << " -> " << destination.string() << " (" << content.size() << " bytes)\n";
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <image.png|directory>...\n";
+        return 2;
+    }
+    bool succeeded = true;
+    for (int argument = 1; argument < argc; ++argument)
+    {
+        const std::filesystem::path path(argv[argument]);
+        if (!std::filesystem::is_directory(path))
+        {
+            succeeded = convert(path) && succeeded;
+            continue;
+        }
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(path))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".png")
+            {
+                succeeded = convert(entry.path()) && succeeded;
+            }
+        }
+    }
+    return succeeded ? 0 : 1;
+}
@@ -0,0 +1,2 @@
+#include "math.glsl"
+vec4 tint(vec4 color) { return color * half(2.0); }
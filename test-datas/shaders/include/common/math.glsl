@@ -0,0 +1 @@
+float half(float value) { return value * 0.5; }
@@ -0,0 +1,10 @@
+#version 330 core
+#include "common/color.glsl"
+#include "common/math.glsl"
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = tint(vec4(half(1.0)));
+}
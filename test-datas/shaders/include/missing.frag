@@ -0,0 +1,6 @@
+#version 330 core
+#include <common/missing.glsl>
+
+void main()
+{
+}